@@ -1,6 +1,8 @@
 #include "app_startup.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "config_store.h"
+#include "diag.h"
 #include "event_bus.h"
 #include "config_mgr.h"
 #include "wdt_mgr.h"
@@ -11,91 +13,332 @@
 #include "ota_mgr.h"
 #include "udp_broadcast.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
 #include "freertos/task.h"
+#include <string.h>
 
 static const char *TAG = "app_startup";
 
-void app_startup_run_generic(void) {
-    ESP_LOGI(TAG, "====================================");
-    ESP_LOGI(TAG, "Generic Startup Orchestration");
-    ESP_LOGI(TAG, "====================================");
+#define STAGE_WORKER_PRIORITY   5
+#define STAGE_EXIT              (-1)    // Job that ends a worker; echoed on the done queue
+#define TRACE_MAX               (2 * APP_STARTUP_MAX_STAGES)
 
-    // ========================================
-    // Phase 1: Core Infrastructure (no dependencies)
-    // ========================================
-    ESP_LOGI(TAG, "Phase 1: Initializing core infrastructure...");
+#define TIME_SYNCED_BIT         BIT0
 
-    // Initialize NVS storage first (config_store wraps NVS)
-    ESP_ERROR_CHECK(config_store_init());
-    ESP_LOGI(TAG, "  [✓] Config store initialized (NVS)");
+static app_startup_trace_t s_trace[TRACE_MAX];
+static size_t s_trace_count;
+static portMUX_TYPE s_trace_lock = portMUX_INITIALIZER_UNLOCKED;
 
-    ESP_ERROR_CHECK(event_bus_init());
-    ESP_LOGI(TAG, "  [✓] Event bus initialized");
+static EventGroupHandle_t s_time_events;
 
-    ESP_ERROR_CHECK(config_mgr_init());
-    ESP_LOGI(TAG, "  [✓] Config manager initialized");
+static uint32_t now_ms(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
 
-#ifndef CONFIG_RUN_UNIT_TESTS
-    // Watchdog manager (skipped if already initialized for unit tests)
-    ESP_ERROR_CHECK(wdt_mgr_init());
-    ESP_LOGI(TAG, "  [✓] Watchdog manager initialized");
-#else
-    ESP_LOGI(TAG, "  [✓] Watchdog manager (already initialized for tests)");
-#endif
+// ========================================
+// Stage graph
+// ========================================
 
-    // ========================================
-    // Phase 2: Network Layer
-    // ========================================
-    ESP_LOGI(TAG, "Phase 2: Starting network layer...");
+typedef struct {
+    const app_startup_stage_t* stages;
+    app_startup_trace_t* trace;
+    QueueHandle_t jobs;         // Stage index to run, or STAGE_EXIT
+    QueueHandle_t done;         // Stage index finished, or STAGE_EXIT once a worker quits
+} stage_run_t;
 
-    ESP_ERROR_CHECK(net_mgr_start());
-    ESP_LOGI(TAG, "  [✓] Network manager started");
+static void stage_worker(void* arg) {
+    stage_run_t* run = (stage_run_t*)arg;
+    int idx;
 
-    // Provisioning may fail if BLE is not enabled - log warning instead of crashing
-    esp_err_t prov_ret = provisioning_mgr_start_if_needed();
-    if (prov_ret != ESP_OK) {
-        ESP_LOGW(TAG, "  [!] Provisioning skipped/failed: %s", esp_err_to_name(prov_ret));
-    } else {
-        ESP_LOGI(TAG, "  [✓] Provisioning manager started");
+    while (xQueueReceive(run->jobs, &idx, portMAX_DELAY) == pdTRUE && idx != STAGE_EXIT) {
+        app_startup_trace_t* t = &run->trace[idx];
+        int64_t start_us = esp_timer_get_time();
+        t->start_ms = (uint32_t)(start_us / 1000);
+        t->err = run->stages[idx].init();
+        t->duration_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+        xQueueSend(run->done, &idx, portMAX_DELAY);
     }
 
-    // ========================================
-    // Phase 3: Network-Dependent Services
-    // ========================================
-    ESP_LOGI(TAG, "Phase 3: Starting network-dependent services...");
+    // run lives on the caller's stack; it waits for this before returning
+    idx = STAGE_EXIT;
+    xQueueSend(run->done, &idx, portMAX_DELAY);
+    vTaskDelete(NULL);
+}
 
-    // Start SNTP client (network-aware, event-driven)
-    esp_err_t err = sntp_client_start();
-    if (err != ESP_OK) {
-        ESP_LOGW(TAG, "  [!] SNTP client failed: %s", esp_err_to_name(err));
-    } else {
-        ESP_LOGI(TAG, "  [✓] SNTP client started");
+static esp_err_t stage_resolve_deps(const app_startup_stage_t* stages, size_t count, uint32_t* masks) {
+    for (size_t i = 0; i < count; i++) {
+        masks[i] = 0;
+        for (const char* const* dep = stages[i].deps; dep && *dep; dep++) {
+            size_t j = 0;
+            while (j < count && strcmp(stages[j].name, *dep) != 0) {
+                j++;
+            }
+            if (j == count) {
+                ESP_LOGE(TAG, "Stage %s depends on unknown stage %s", stages[i].name, *dep);
+                return ESP_ERR_INVALID_ARG;
+            }
+            masks[i] |= 1u << j;
+        }
+    }
+    return ESP_OK;
+}
+
+static void stage_skip(const app_startup_stage_t* stage, app_startup_trace_t* t, const char* why) {
+    t->start_ms = now_ms();
+    t->duration_ms = 0;
+    t->err = ESP_ERR_NOT_FINISHED;
+    ESP_LOGW(TAG, "  [-] %s skipped (%s)", stage->name, why);
+}
+
+esp_err_t app_startup_run(const app_startup_stage_t* stages, size_t count) {
+    if (stages == NULL || count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (count > APP_STARTUP_MAX_STAGES) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint32_t deps[APP_STARTUP_MAX_STAGES];
+    esp_err_t ret = stage_resolve_deps(stages, count, deps);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    app_startup_trace_t trace[APP_STARTUP_MAX_STAGES] = {0};
+    for (size_t i = 0; i < count; i++) {
+        trace[i].name = stages[i].name;
+    }
+
+    stage_run_t run = {
+        .stages = stages,
+        .trace = trace,
+        .jobs = xQueueCreate(count + CONFIG_APP_STARTUP_WORKERS, sizeof(int)),
+        .done = xQueueCreate(count + CONFIG_APP_STARTUP_WORKERS, sizeof(int)),
+    };
+    int workers = 0;
+    if (run.jobs && run.done) {
+        while (workers < CONFIG_APP_STARTUP_WORKERS && workers < (int)count) {
+            if (xTaskCreate(stage_worker, "startup", CONFIG_APP_STARTUP_STAGE_STACK, &run,
+                            STAGE_WORKER_PRIORITY, NULL) != pdPASS) {
+                break;
+            }
+            workers++;
+        }
+    }
+    if (workers == 0) {
+        if (run.jobs) vQueueDelete(run.jobs);
+        if (run.done) vQueueDelete(run.done);
+        return ESP_ERR_NO_MEM;
     }
 
-    // Start HTTP UI (may fail if default password is in use)
-    err = http_ui_start();
-    if (err != ESP_OK) {
-        ESP_LOGW(TAG, "  [!] HTTP UI failed: %s", esp_err_to_name(err));
-        if (err == ESP_ERR_INVALID_STATE) {
-            ESP_LOGW(TAG, "  [!] HTTP UI disabled due to weak password");
+    const uint32_t all = (1u << count) - 1;
+    uint32_t started = 0;       // Dispatched or skipped
+    uint32_t finished = 0;      // Completed, failed or skipped
+    uint32_t failed = 0;        // Failed or skipped: dependents are skipped
+    int running = 0;
+    bool stop = false;
+
+    for (;;) {
+        // Dispatch in table order; a skip may unblock (and skip) later stages
+        bool progress = !stop;
+        while (progress) {
+            progress = false;
+            for (size_t i = 0; i < count; i++) {
+                uint32_t bit = 1u << i;
+                if ((started & bit) || (deps[i] & ~finished)) {
+                    continue;
+                }
+                started |= bit;
+                if (deps[i] & failed) {
+                    stage_skip(&stages[i], &trace[i], "dependency failed");
+                    finished |= bit;
+                    failed |= bit;
+                    progress = true;
+                    continue;
+                }
+                int idx = (int)i;
+                xQueueSend(run.jobs, &idx, portMAX_DELAY);
+                running++;
+            }
+        }
+        if (running == 0) {
+            break;
+        }
+
+        int idx;
+        xQueueReceive(run.done, &idx, portMAX_DELAY);
+        running--;
+        finished |= 1u << idx;
+
+        const app_startup_stage_t* stage = &stages[idx];
+        esp_err_t err = trace[idx].err;
+        if (err == ESP_OK) {
+            ESP_LOGI(TAG, "  [✓] %s (%lu ms)", stage->name, (unsigned long)trace[idx].duration_ms);
+            continue;
+        }
+        failed |= 1u << idx;
+        if (stage->critical) {
+            ESP_LOGE(TAG, "  [✗] %s failed: %s", stage->name, esp_err_to_name(err));
+            if (!stop) {
+                ret = err;
+                stop = true;
+            }
+        } else {
+            ESP_LOGW(TAG, "  [!] %s failed: %s", stage->name, esp_err_to_name(err));
         }
+    }
+
+    if (started != all) {
+        for (size_t i = 0; i < count; i++) {
+            if (!(started & (1u << i))) {
+                stage_skip(&stages[i], &trace[i], stop ? "startup aborted" : "dependency cycle");
+            }
+        }
+        if (ret == ESP_OK) {
+            ret = ESP_ERR_INVALID_STATE;
+        }
+    }
+
+    int exit_job = STAGE_EXIT;
+    for (int i = 0; i < workers; i++) {
+        xQueueSend(run.jobs, &exit_job, portMAX_DELAY);
+    }
+    for (int quit = 0; quit < workers; ) {
+        int idx;
+        xQueueReceive(run.done, &idx, portMAX_DELAY);
+        if (idx == STAGE_EXIT) {
+            quit++;
+        }
+    }
+    vQueueDelete(run.jobs);
+    vQueueDelete(run.done);
+
+    taskENTER_CRITICAL(&s_trace_lock);
+    for (size_t i = 0; i < count && s_trace_count < TRACE_MAX; i++) {
+        s_trace[s_trace_count++] = trace[i];
+    }
+    taskEXIT_CRITICAL(&s_trace_lock);
+
+    return ret;
+}
+
+esp_err_t app_startup_get_trace(app_startup_trace_t* out, size_t max, size_t* count) {
+    if (out == NULL || count == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    taskENTER_CRITICAL(&s_trace_lock);
+    size_t n = (s_trace_count < max) ? s_trace_count : max;
+    memcpy(out, s_trace, n * sizeof(*out));
+    taskEXIT_CRITICAL(&s_trace_lock);
+    *count = n;
+    return ESP_OK;
+}
+
+static void log_trace(void) {
+    ESP_LOGI(TAG, "  %-16s %8s %8s  %s", "stage", "start", "ms", "result");
+    for (size_t i = 0; i < s_trace_count; i++) {
+        const app_startup_trace_t* t = &s_trace[i];
+        ESP_LOGI(TAG, "  %-16s %8lu %8lu  %s", t->name, (unsigned long)t->start_ms,
+                 (unsigned long)t->duration_ms,
+                 t->err == ESP_ERR_NOT_FINISHED ? "skipped" : esp_err_to_name(t->err));
+    }
+}
+
+// ========================================
+// Generic graph
+// ========================================
+
+static void time_synced_handler(void* arg, esp_event_base_t base, int32_t id, void* data) {
+    xEventGroupSetBits(s_time_events, TIME_SYNCED_BIT);
+}
+
+// A sync before this registers is caught by the status check in the wait
+static esp_err_t stage_time_sync(void) {
+    s_time_events = xEventGroupCreate();
+    if (s_time_events == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    return event_bus_register(DEVICE_EVENT_TIME_SYNCED, &time_synced_handler, NULL);
+}
+
+static esp_err_t stage_profiler(void) {
+    return diag_profiler_start(CONFIG_DIAG_PROFILER_INTERVAL_MS);
+}
+
+static esp_err_t stage_wdt_mgr(void) {
+#ifndef CONFIG_RUN_UNIT_TESTS
+    return wdt_mgr_init();
+#else
+    // Already initialized for unit tests
+    return ESP_OK;
+#endif
+}
+
+static esp_err_t stage_http_ui(void) {
+    esp_err_t err = http_ui_start();
+    if (err == ESP_ERR_INVALID_STATE) {
+        ESP_LOGW(TAG, "  [!] HTTP UI disabled due to weak password");
+    }
+    return err;
+}
+
+static const char* const DEPS_CONFIG_STORE[] = { "config_store", NULL };
+static const char* const DEPS_EVENT_BUS[] = { "event_bus", NULL };
+static const char* const DEPS_CORE[] = { "config_mgr", "event_bus", NULL };
+static const char* const DEPS_NET[] = { "net_mgr", NULL };
+static const char* const DEPS_UDP[] = { "net_mgr", "wdt_mgr", NULL };
+
+// Services after net_mgr only need its netif and config; they start in parallel
+static const app_startup_stage_t GENERIC_STAGES[] = {
+    { "config_store",  config_store_init,                 NULL,              true  },
+    { "event_bus",     event_bus_init,                    NULL,              true  },
+    { "wdt_mgr",       stage_wdt_mgr,                     NULL,              true  },
+    { "profiler",      stage_profiler,                    NULL,              false },
+    { "config_mgr",    config_mgr_init,                   DEPS_CONFIG_STORE, true  },
+    { "time_sync",     stage_time_sync,                   DEPS_EVENT_BUS,    false },
+    { "net_mgr",       net_mgr_start,                     DEPS_CORE,         true  },
+    { "provisioning",  provisioning_mgr_start_if_needed,  DEPS_NET,          false },
+    { "sntp_client",   sntp_client_start,                 DEPS_NET,          false },
+    { "http_ui",       stage_http_ui,                     DEPS_NET,          false },
+    { "ota_mgr",       ota_mgr_init,                      DEPS_NET,          true  },
+    { "udp_broadcast", udp_broadcast_start,               DEPS_UDP,          true  },
+};
+
+void app_startup_run_generic(void) {
+    ESP_LOGI(TAG, "====================================");
+    ESP_LOGI(TAG, "Generic Startup Orchestration");
+    ESP_LOGI(TAG, "====================================");
+
+    // Memory policy first: the log ring and every cJSON tree allocate through it
+    diag_mem_init();
+
+    // Mirror logs into RAM before the graph so /logs covers the whole boot
+    if (diag_log_ring_init() == ESP_OK) {
+        ESP_LOGI(TAG, "  [✓] Log ring installed");
     } else {
-        ESP_LOGI(TAG, "  [✓] HTTP UI started");
+        ESP_LOGW(TAG, "  [!] Log ring unavailable");
     }
 
-    // Initialize OTA manager
-    ESP_ERROR_CHECK(ota_mgr_init());
-    ESP_LOGI(TAG, "  [✓] OTA manager initialized");
+    ESP_LOGI(TAG, "Starting %u stages on %d workers...",
+             (unsigned)(sizeof(GENERIC_STAGES) / sizeof(GENERIC_STAGES[0])), CONFIG_APP_STARTUP_WORKERS);
+    esp_err_t err = app_startup_run(GENERIC_STAGES, sizeof(GENERIC_STAGES) / sizeof(GENERIC_STAGES[0]));
+    uint32_t ready_ms = now_ms();
 
-    // Start UDP broadcast
-    ESP_ERROR_CHECK(udp_broadcast_start());
-    ESP_LOGI(TAG, "  [✓] UDP broadcast started");
+    log_trace();
+    ESP_ERROR_CHECK(err);
+
+    diag_metric_set(diag_metric_gauge("boot_ready_ms", "Time from boot to the end of generic startup (ms)"),
+                    (int32_t)ready_ms);
+#if CONFIG_APP_STARTUP_BOOT_BUDGET_MS > 0
+    if (ready_ms > CONFIG_APP_STARTUP_BOOT_BUDGET_MS) {
+        ESP_LOGW(TAG, "Boot took %lu ms, over the %d ms budget", (unsigned long)ready_ms,
+                 CONFIG_APP_STARTUP_BOOT_BUDGET_MS);
+    }
+#endif
 
-    // ========================================
-    // Generic Startup Complete
-    // ========================================
     ESP_LOGI(TAG, "====================================");
-    ESP_LOGI(TAG, "Generic Startup Complete");
+    ESP_LOGI(TAG, "Generic Startup Complete (%lu ms)", (unsigned long)ready_ms);
     ESP_LOGI(TAG, "Ready for application-specific init");
     ESP_LOGI(TAG, "====================================");
 }
@@ -112,18 +355,21 @@ bool app_startup_is_time_synced(void) {
 esp_err_t app_startup_wait_for_time_sync(uint32_t timeout_ms) {
     ESP_LOGI(TAG, "Waiting for time sync (timeout: %lu ms)...", timeout_ms);
 
-    uint32_t elapsed_ms = 0;
-    const uint32_t poll_interval_ms = 100;
-
-    while (elapsed_ms < timeout_ms) {
-        sntp_status_t status;
-        if (sntp_client_get_status(&status) == ESP_OK && status == SNTP_STATUS_SYNCED) {
-            ESP_LOGI(TAG, "Time sync completed");
-            return ESP_OK;
-        }
+    if (app_startup_is_time_synced()) {
+        ESP_LOGI(TAG, "Time sync completed");
+        return ESP_OK;
+    }
+    if (s_time_events == NULL) {
+        // Generic startup has not run (or could not register for TIME_SYNCED)
+        return ESP_FAIL;
+    }
 
-        vTaskDelay(pdMS_TO_TICKS(poll_interval_ms));
-        elapsed_ms += poll_interval_ms;
+    // The bit stays set once the clock has been set, even if SNTP later resyncs
+    EventBits_t bits = xEventGroupWaitBits(s_time_events, TIME_SYNCED_BIT, pdFALSE, pdFALSE,
+                                           pdMS_TO_TICKS(timeout_ms));
+    if (bits & TIME_SYNCED_BIT) {
+        ESP_LOGI(TAG, "Time sync completed");
+        return ESP_OK;
     }
 
     ESP_LOGW(TAG, "Time sync timeout after %lu ms", timeout_ms);
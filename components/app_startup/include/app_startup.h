@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "esp_err.h"
 
@@ -9,16 +10,70 @@ extern "C" {
 #endif
 
 /**
- * @brief Run generic application startup (Phases 1-3)
+ * @brief One node of the startup graph
  *
- * Orchestrates the standard startup sequence for generic components:
- * - Phase 1: Core infrastructure (event_bus, config_mgr, wdt_mgr)
- * - Phase 2: Network layer (net_mgr, provisioning)
- * - Phase 3: Network-dependent services (SNTP, HTTP UI, OTA, UDP broadcast)
+ * A stage runs once every stage named in deps has completed with ESP_OK.
+ * Stages whose dependencies are met run in parallel on
+ * CONFIG_APP_STARTUP_WORKERS worker tasks, so init must not rely on
+ * anything it does not list. A stage is skipped when one of its
+ * dependencies failed or was skipped.
+ */
+typedef struct {
+    const char* name;
+    esp_err_t (*init)(void);
+    const char* const* deps;    // NULL-terminated stage names, or NULL
+    bool critical;              // A failure stops the graph and is returned
+} app_startup_stage_t;
+
+#define APP_STARTUP_MAX_STAGES 16
+
+/**
+ * @brief Boot trace entry, one per stage run (or skipped)
+ *
+ * Times are in ms since boot (esp_timer).
+ */
+typedef struct {
+    const char* name;
+    uint32_t start_ms;
+    uint32_t duration_ms;
+    esp_err_t err;              // ESP_ERR_NOT_FINISHED if the stage was skipped
+} app_startup_trace_t;
+
+/**
+ * @brief Run a startup graph
+ *
+ * Blocks until every runnable stage is done. Once a critical stage fails
+ * no further stages are started; the ones already running are waited for.
+ * Optional failures are logged and only skip their dependents.
+ *
+ * @return ESP_OK, the first critical stage's error, ESP_ERR_INVALID_ARG
+ *         for an unknown dependency, ESP_ERR_INVALID_SIZE for more than
+ *         APP_STARTUP_MAX_STAGES stages, ESP_ERR_INVALID_STATE if
+ *         stages were left unrunnable by a dependency cycle
+ */
+esp_err_t app_startup_run(const app_startup_stage_t* stages, size_t count);
+
+/**
+ * @brief Copy the boot trace of every app_startup_run() so far
+ *
+ * @param out Array of max entries
+ * @param count Entries written
+ */
+esp_err_t app_startup_get_trace(app_startup_trace_t* out, size_t max, size_t* count);
+
+/**
+ * @brief Run generic application startup
+ *
+ * Runs the generic components as one app_startup_run() graph:
+ * - config_store, event_bus, wdt_mgr and the profiler have no dependencies
+ * - config_mgr after config_store; net_mgr after config_mgr and event_bus
+ * - provisioning, SNTP, HTTP UI and OTA after net_mgr, in parallel
+ * - UDP broadcast after net_mgr and wdt_mgr
  *
- * This function ensures all dependencies are met before starting each subsystem.
  * After this completes, applications can add their own Phase 4+ initialization
- * (e.g., GNSS, NTRIP, custom services).
+ * (e.g., GNSS, NTRIP, custom services), as another graph if they like.
+ * The time from boot to here is checked against
+ * CONFIG_APP_STARTUP_BOOT_BUDGET_MS and exported as boot_ready_ms.
  *
  * @note This is a blocking function that will abort on critical errors.
  *       Non-critical errors (e.g., provisioning, SNTP) are logged as warnings.
@@ -37,7 +92,9 @@ bool app_startup_is_time_synced(void);
 /**
  * @brief Wait for time synchronization with timeout
  *
- * This function blocks until time is synced or timeout expires.
+ * This function blocks until time is synced or timeout expires. It sleeps
+ * on an event group set by DEVICE_EVENT_TIME_SYNCED, so it returns as soon
+ * as SNTP sets the clock.
  * Useful for ensuring time is valid before TLS connections.
  *
  * Example usage for NTRIP with TLS:
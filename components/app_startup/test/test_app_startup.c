@@ -0,0 +1,217 @@
+#include "unity.h"
+#include "app_startup.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdatomic.h>
+
+/*
+ * Test stages: each one records when it started and finished on a shared
+ * sequence, sleeps for its delay, and returns its configured result
+ */
+#define TEST_STAGES 6
+
+static atomic_int s_seq;
+static atomic_int s_started[TEST_STAGES];
+static atomic_int s_done[TEST_STAGES];
+static esp_err_t s_result[TEST_STAGES];
+static uint32_t s_delay_ms[TEST_STAGES];
+
+static esp_err_t stage_body(int i)
+{
+    atomic_store(&s_started[i], atomic_fetch_add(&s_seq, 1) + 1);
+    if (s_delay_ms[i] > 0) {
+        vTaskDelay(pdMS_TO_TICKS(s_delay_ms[i]));
+    }
+    atomic_store(&s_done[i], atomic_fetch_add(&s_seq, 1) + 1);
+    return s_result[i];
+}
+
+static esp_err_t stage_0(void) { return stage_body(0); }
+static esp_err_t stage_1(void) { return stage_body(1); }
+static esp_err_t stage_2(void) { return stage_body(2); }
+static esp_err_t stage_3(void) { return stage_body(3); }
+static esp_err_t stage_4(void) { return stage_body(4); }
+static esp_err_t stage_5(void) { return stage_body(5); }
+
+static void stages_reset(void)
+{
+    atomic_store(&s_seq, 0);
+    for (int i = 0; i < TEST_STAGES; i++) {
+        atomic_store(&s_started[i], 0);
+        atomic_store(&s_done[i], 0);
+        s_result[i] = ESP_OK;
+        s_delay_ms[i] = 0;
+    }
+}
+
+static bool ran(int i)
+{
+    return atomic_load(&s_started[i]) != 0;
+}
+
+/**
+ * Stage i started only after stage dep had finished
+ */
+static void assert_after(int i, int dep)
+{
+    TEST_ASSERT_TRUE(ran(i));
+    TEST_ASSERT_TRUE(atomic_load(&s_done[dep]) != 0);
+    TEST_ASSERT_TRUE(atomic_load(&s_done[dep]) < atomic_load(&s_started[i]));
+}
+
+static const char* const DEPS_A[] = { "a", NULL };
+static const char* const DEPS_B[] = { "b", NULL };
+static const char* const DEPS_C[] = { "c", NULL };
+static const char* const DEPS_BC[] = { "b", "c", NULL };
+static const char* const DEPS_CRIT[] = { "crit", NULL };
+static const char* const DEPS_SLOW[] = { "slow", NULL };
+
+#define TRACE_ENTRIES (2 * APP_STARTUP_MAX_STAGES)
+
+static size_t trace_count(app_startup_trace_t* trace)
+{
+    size_t n = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, app_startup_get_trace(trace, TRACE_ENTRIES, &n));
+    return n;
+}
+
+TEST_CASE("app_startup_runs_stages_in_dependency_order", "[app_startup]")
+{
+    // Listed out of order: d waits for b and c, which both wait for a
+    const app_startup_stage_t stages[] = {
+        { "d", stage_3, DEPS_BC, true },
+        { "b", stage_1, DEPS_A,  true },
+        { "c", stage_2, DEPS_A,  true },
+        { "a", stage_0, NULL,    true },
+        { "e", stage_4, NULL,    false },
+    };
+
+    stages_reset();
+    s_delay_ms[0] = 20;
+    s_delay_ms[1] = 10;
+    TEST_ASSERT_EQUAL(ESP_OK, app_startup_run(stages, sizeof(stages) / sizeof(stages[0])));
+    TEST_ASSERT_TRUE(ran(0));
+    TEST_ASSERT_TRUE(ran(4));
+    assert_after(1, 0);
+    assert_after(2, 0);
+    assert_after(3, 1);
+    assert_after(3, 2);
+}
+
+TEST_CASE("app_startup_optional_failure_skips_dependents", "[app_startup]")
+{
+    // b fails; c and d (through c) are skipped, e and f still run
+    const app_startup_stage_t stages[] = {
+        { "a", stage_0, NULL,   true },
+        { "b", stage_1, DEPS_A, false },
+        { "c", stage_2, DEPS_B, false },
+        { "d", stage_3, DEPS_C, true },
+        { "e", stage_4, DEPS_A, true },
+        { "f", stage_5, NULL,   false },
+    };
+
+    const size_t count = sizeof(stages) / sizeof(stages[0]);
+    static app_startup_trace_t trace[TRACE_ENTRIES];
+    size_t before = trace_count(trace);
+
+    stages_reset();
+    s_result[1] = ESP_FAIL;
+    TEST_ASSERT_EQUAL(ESP_OK, app_startup_run(stages, count));
+    TEST_ASSERT_TRUE(ran(1));
+    TEST_ASSERT_FALSE(ran(2));
+    TEST_ASSERT_FALSE(ran(3));
+    assert_after(4, 0);
+    TEST_ASSERT_TRUE(ran(5));
+
+    // The trace keeps every run since boot until it is full
+    if (before + count <= TRACE_ENTRIES) {
+        TEST_ASSERT_EQUAL(before + count, trace_count(trace));
+        const app_startup_trace_t* t = &trace[before];
+        TEST_ASSERT_EQUAL_STRING("b", t[1].name);
+        TEST_ASSERT_EQUAL(ESP_FAIL, t[1].err);
+        TEST_ASSERT_EQUAL(ESP_ERR_NOT_FINISHED, t[2].err);
+        TEST_ASSERT_EQUAL(ESP_ERR_NOT_FINISHED, t[3].err);
+        TEST_ASSERT_EQUAL(ESP_OK, t[4].err);
+    }
+}
+
+TEST_CASE("app_startup_critical_failure_aborts", "[app_startup]")
+{
+    // crit fails while slow is still running (or queued, with one worker):
+    // slow is waited for, but nothing new starts, not even after, whose
+    // only dependency succeeded
+    const app_startup_stage_t stages[] = {
+        { "crit",  stage_1, NULL,      true },
+        { "dep",   stage_2, DEPS_CRIT, false },
+        { "slow",  stage_3, NULL,      false },
+        { "after", stage_4, DEPS_SLOW, false },
+    };
+
+    stages_reset();
+    s_result[1] = ESP_ERR_NO_MEM;
+    s_delay_ms[3] = 100;
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, app_startup_run(stages, sizeof(stages) / sizeof(stages[0])));
+    TEST_ASSERT_TRUE(ran(1));
+    TEST_ASSERT_FALSE(ran(2));
+    TEST_ASSERT_TRUE(atomic_load(&s_done[3]) != 0);
+    TEST_ASSERT_FALSE(ran(4));
+
+    // The same error from an optional stage is only logged
+    const app_startup_stage_t optional[] = {
+        { "crit",  stage_1, NULL,      false },
+        { "dep",   stage_2, DEPS_CRIT, false },
+        { "other", stage_3, NULL,      true },
+    };
+    stages_reset();
+    s_result[1] = ESP_ERR_NO_MEM;
+    TEST_ASSERT_EQUAL(ESP_OK, app_startup_run(optional, sizeof(optional) / sizeof(optional[0])));
+    TEST_ASSERT_FALSE(ran(2));
+    TEST_ASSERT_TRUE(ran(3));
+}
+
+TEST_CASE("app_startup_rejects_bad_graphs", "[app_startup]")
+{
+    static const char* const DEPS_UNKNOWN[] = { "a", "nope", NULL };
+
+    // b and c wait on each other; d waits on the cycle; a is unaffected
+    const app_startup_stage_t cycle[] = {
+        { "a", stage_0, NULL,   true },
+        { "b", stage_1, DEPS_C, false },
+        { "c", stage_2, DEPS_B, false },
+        { "d", stage_3, DEPS_C, false },
+    };
+    stages_reset();
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, app_startup_run(cycle, sizeof(cycle) / sizeof(cycle[0])));
+    TEST_ASSERT_TRUE(ran(0));
+    TEST_ASSERT_FALSE(ran(1));
+    TEST_ASSERT_FALSE(ran(2));
+    TEST_ASSERT_FALSE(ran(3));
+
+    // A stage that depends on itself is a cycle too
+    const app_startup_stage_t self[] = {
+        { "a", stage_0, DEPS_A, false },
+    };
+    stages_reset();
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, app_startup_run(self, 1));
+    TEST_ASSERT_FALSE(ran(0));
+
+    // Unknown dependencies are caught before anything runs
+    const app_startup_stage_t unknown[] = {
+        { "a", stage_0, NULL,         true },
+        { "b", stage_1, DEPS_UNKNOWN, false },
+    };
+    stages_reset();
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, app_startup_run(unknown, sizeof(unknown) / sizeof(unknown[0])));
+    TEST_ASSERT_FALSE(ran(0));
+    TEST_ASSERT_FALSE(ran(1));
+
+    app_startup_stage_t many[APP_STARTUP_MAX_STAGES + 1];
+    for (size_t i = 0; i < sizeof(many) / sizeof(many[0]); i++) {
+        many[i] = (app_startup_stage_t){ "a", stage_0, NULL, false };
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, app_startup_run(many, sizeof(many) / sizeof(many[0])));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, app_startup_run(NULL, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, app_startup_run(cycle, 0));
+    TEST_ASSERT_FALSE(ran(0));
+}
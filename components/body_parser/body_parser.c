@@ -0,0 +1,628 @@
+/* Streaming request body parser - see body_parser.h */
+
+#include "body_parser.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    // JSON
+    ST_VALUE = 0,               // Expecting a value
+    ST_VALUE_OR_END,            // After '['
+    ST_KEY_OR_END,              // After '{'
+    ST_KEY,                     // After ',' in an object
+    ST_COLON,
+    ST_NEXT,                    // After a value: ',' or the closing bracket
+    ST_STRING,
+    ST_ESCAPE,
+    ST_UNICODE,
+    ST_LITERAL,                 // Number, true, false, null
+    ST_DONE,
+    // Form
+    ST_FORM,
+    ST_FORM_HEX,
+};
+
+void body_parser_init(body_parser_t* p, body_parser_format_t format, body_parser_cb_t cb, void* ctx)
+{
+    memset(p, 0, sizeof(*p));
+    p->format = format;
+    p->cb = cb;
+    p->ctx = ctx;
+    p->index = -1;
+    p->err = cb ? ESP_OK : ESP_ERR_INVALID_ARG;
+    if (format == BODY_PARSER_FORM) {
+        p->state = ST_FORM;
+        p->in_key = true;
+        p->keep = true;
+    } else {
+        p->state = ST_VALUE;
+    }
+}
+
+static void fail(body_parser_t* p, esp_err_t err)
+{
+    if (p->err == ESP_OK) {
+        p->err = err;
+    }
+}
+
+static int hex_digit(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static void append(body_parser_t* p, char c)
+{
+    if (!p->keep) {
+        return;
+    }
+    if (p->len + 1 >= sizeof(p->value)) {
+        fail(p, ESP_ERR_INVALID_SIZE);
+        return;
+    }
+    p->value[p->len++] = c;
+}
+
+static void append_utf8(body_parser_t* p, uint32_t cp)
+{
+    if (cp < 0x80) {
+        append(p, (char)cp);
+    } else if (cp < 0x800) {
+        append(p, (char)(0xC0 | (cp >> 6)));
+        append(p, (char)(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        append(p, (char)(0xE0 | (cp >> 12)));
+        append(p, (char)(0x80 | ((cp >> 6) & 0x3F)));
+        append(p, (char)(0x80 | (cp & 0x3F)));
+    } else {
+        append(p, (char)(0xF0 | (cp >> 18)));
+        append(p, (char)(0x80 | ((cp >> 12) & 0x3F)));
+        append(p, (char)(0x80 | ((cp >> 6) & 0x3F)));
+        append(p, (char)(0x80 | (cp & 0x3F)));
+    }
+}
+
+static void emit(body_parser_t* p, body_value_type_t type, int index, const char* subkey)
+{
+    p->value[p->len] = '\0';
+    body_field_t f = {
+        .key = p->key,
+        .index = index,
+        .subkey = subkey,
+        .type = type,
+        .value = p->value,
+        .len = p->len,
+    };
+    esp_err_t err = p->cb(p->ctx, &f);
+    if (err != ESP_OK) {
+        fail(p, err);
+    }
+}
+
+/*
+ * JSON
+ *
+ * depth counts open containers, so members of the top-level object sit at
+ * depth 1. Only the first few levels carry a reportable path.
+ */
+static bool is_array(const body_parser_t* p, int depth)
+{
+    return (p->arrays >> depth) & 1;
+}
+
+/**
+ * Path of a value at the current depth; false if it is too deep to report
+ */
+static bool value_path(const body_parser_t* p, int* index, const char** subkey)
+{
+    *index = -1;
+    *subkey = NULL;
+    switch (p->depth) {
+        case 1:
+            return true;
+        case 2:
+            if (is_array(p, 2)) {
+                *index = p->index;
+            } else {
+                *subkey = p->subkey;
+            }
+            return true;
+        case 3:
+            if (is_array(p, 2) && !is_array(p, 3)) {
+                *index = p->index;
+                *subkey = p->subkey;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Where a member name at the current depth goes (NULL: not reported)
+ */
+static char* key_target(body_parser_t* p)
+{
+    if (p->depth == 1) {
+        return p->key;
+    }
+    if ((p->depth == 2 && !is_array(p, 2)) ||
+        (p->depth == 3 && is_array(p, 2) && !is_array(p, 3))) {
+        return p->subkey;
+    }
+    return NULL;
+}
+
+static void begin_string(body_parser_t* p, bool key)
+{
+    int index;
+    const char* subkey;
+
+    p->in_key = key;
+    p->keep = key ? key_target(p) != NULL : value_path(p, &index, &subkey);
+    p->len = 0;
+    p->state = ST_STRING;
+}
+
+static void end_string(body_parser_t* p)
+{
+    if (p->in_key) {
+        char* target = key_target(p);
+        if (target) {
+            if (p->len >= BODY_PARSER_KEY_MAX) {
+                fail(p, ESP_ERR_INVALID_SIZE);
+                return;
+            }
+            memcpy(target, p->value, p->len);
+            target[p->len] = '\0';
+        }
+        p->state = ST_COLON;
+        return;
+    }
+
+    int index;
+    const char* subkey;
+    if (p->keep && value_path(p, &index, &subkey)) {
+        emit(p, BODY_VALUE_STRING, index, subkey);
+    }
+    p->state = ST_NEXT;
+}
+
+static bool is_number(const char* s)
+{
+    if (*s == '-') {
+        s++;
+    }
+    if (*s == '0') {
+        s++;
+    } else if (isdigit((unsigned char)*s)) {
+        while (isdigit((unsigned char)*s)) {
+            s++;
+        }
+    } else {
+        return false;
+    }
+    if (*s == '.') {
+        s++;
+        if (!isdigit((unsigned char)*s)) {
+            return false;
+        }
+        while (isdigit((unsigned char)*s)) {
+            s++;
+        }
+    }
+    if (*s == 'e' || *s == 'E') {
+        s++;
+        if (*s == '+' || *s == '-') {
+            s++;
+        }
+        if (!isdigit((unsigned char)*s)) {
+            return false;
+        }
+        while (isdigit((unsigned char)*s)) {
+            s++;
+        }
+    }
+    return *s == '\0';
+}
+
+static void end_literal(body_parser_t* p)
+{
+    body_value_type_t type;
+
+    p->value[p->len] = '\0';
+    if (strcmp(p->value, "true") == 0 || strcmp(p->value, "false") == 0) {
+        type = BODY_VALUE_BOOL;
+    } else if (strcmp(p->value, "null") == 0) {
+        type = BODY_VALUE_NULL;
+    } else if (is_number(p->value)) {
+        type = BODY_VALUE_NUMBER;
+    } else {
+        fail(p, ESP_ERR_INVALID_ARG);
+        return;
+    }
+
+    int index;
+    const char* subkey;
+    if (value_path(p, &index, &subkey)) {
+        emit(p, type, index, subkey);
+    }
+    p->state = ST_NEXT;
+}
+
+static void open_container(body_parser_t* p, bool array)
+{
+    if (p->depth + 1 >= BODY_PARSER_MAX_DEPTH) {
+        fail(p, ESP_ERR_INVALID_SIZE);
+        return;
+    }
+
+    // Report containers opened at key, or at key/index, so "[]" and "{}" are seen
+    if (p->depth == 1 || (p->depth == 2 && is_array(p, 2) && !array)) {
+        p->len = 0;
+        emit(p, array ? BODY_VALUE_ARRAY : BODY_VALUE_OBJECT,
+             p->depth == 2 ? p->index : -1, NULL);
+    }
+
+    p->depth++;
+    if (array) {
+        p->arrays |= 1u << p->depth;
+    } else {
+        p->arrays &= ~(1u << p->depth);
+    }
+    if (p->depth == 2) {
+        p->index = -1;
+    }
+    p->state = array ? ST_VALUE_OR_END : ST_KEY_OR_END;
+}
+
+static void close_container(body_parser_t* p, char c)
+{
+    if (c != (is_array(p, p->depth) ? ']' : '}')) {
+        fail(p, ESP_ERR_INVALID_ARG);
+        return;
+    }
+    p->depth--;
+    p->state = p->depth == 0 ? ST_DONE : ST_NEXT;
+}
+
+static void begin_value(body_parser_t* p, char c)
+{
+    // The body itself must be an object
+    if (p->depth == 0 && c != '{') {
+        fail(p, ESP_ERR_INVALID_ARG);
+        return;
+    }
+    if (p->depth == 2 && is_array(p, 2)) {
+        p->index++;
+    }
+
+    if (c == '{' || c == '[') {
+        open_container(p, c == '[');
+    } else if (c == '"') {
+        begin_string(p, false);
+    } else if (c == '-' || isdigit((unsigned char)c) || c == 't' || c == 'f' || c == 'n') {
+        // Literals are short, so they are always kept and checked
+        p->keep = true;
+        p->len = 0;
+        append(p, c);
+        p->state = ST_LITERAL;
+    } else {
+        fail(p, ESP_ERR_INVALID_ARG);
+    }
+}
+
+static void structural(body_parser_t* p, char c)
+{
+    switch (p->state) {
+        case ST_VALUE_OR_END:
+            if (c == ']') {
+                close_container(p, c);
+                return;
+            }
+            /* fall through */
+        case ST_VALUE:
+            begin_value(p, c);
+            return;
+        case ST_KEY_OR_END:
+            if (c == '}') {
+                close_container(p, c);
+                return;
+            }
+            /* fall through */
+        case ST_KEY:
+            if (c != '"') {
+                fail(p, ESP_ERR_INVALID_ARG);
+                return;
+            }
+            begin_string(p, true);
+            return;
+        case ST_COLON:
+            if (c != ':') {
+                fail(p, ESP_ERR_INVALID_ARG);
+                return;
+            }
+            p->state = ST_VALUE;
+            return;
+        case ST_NEXT:
+            if (c == ',') {
+                p->state = is_array(p, p->depth) ? ST_VALUE : ST_KEY;
+            } else if (c == '}' || c == ']') {
+                close_container(p, c);
+            } else {
+                fail(p, ESP_ERR_INVALID_ARG);
+            }
+            return;
+        default:
+            // Anything but whitespace after the document
+            fail(p, ESP_ERR_INVALID_ARG);
+            return;
+    }
+}
+
+static void unicode(body_parser_t* p, uint32_t cp)
+{
+    if (p->surrogate) {
+        if (cp < 0xDC00 || cp > 0xDFFF) {
+            fail(p, ESP_ERR_INVALID_ARG);
+            return;
+        }
+        cp = 0x10000 + ((uint32_t)(p->surrogate - 0xD800) << 10) + (cp - 0xDC00);
+        p->surrogate = 0;
+    } else if (cp >= 0xD800 && cp <= 0xDBFF) {
+        p->surrogate = (uint16_t)cp;
+        return;
+    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+        fail(p, ESP_ERR_INVALID_ARG);
+        return;
+    }
+
+    // Values are C strings
+    if (cp == 0) {
+        fail(p, ESP_ERR_INVALID_ARG);
+        return;
+    }
+    append_utf8(p, cp);
+}
+
+static void string_char(body_parser_t* p, char c)
+{
+    // A high surrogate must be followed by its \u pair
+    if (p->surrogate && c != '\\') {
+        fail(p, ESP_ERR_INVALID_ARG);
+    } else if (c == '"') {
+        end_string(p);
+    } else if (c == '\\') {
+        p->state = ST_ESCAPE;
+    } else if ((unsigned char)c < 0x20) {
+        fail(p, ESP_ERR_INVALID_ARG);
+    } else {
+        append(p, c);
+    }
+}
+
+static void escape_char(body_parser_t* p, char c)
+{
+    static const char from[] = "\"\\/bfnrt";
+    static const char to[] = "\"\\/\b\f\n\r\t";
+
+    if (c == 'u') {
+        p->hex = 0;
+        p->hex_len = 0;
+        p->state = ST_UNICODE;
+        return;
+    }
+    const char* e = strchr(from, c);
+    if (!e || c == '\0' || p->surrogate) {
+        fail(p, ESP_ERR_INVALID_ARG);
+        return;
+    }
+    append(p, to[e - from]);
+    p->state = ST_STRING;
+}
+
+static void feed_json(body_parser_t* p, const char* data, size_t len)
+{
+    size_t i = 0;
+
+    while (i < len && p->err == ESP_OK) {
+        char c = data[i];
+        int v;
+
+        switch (p->state) {
+            case ST_STRING:
+                string_char(p, c);
+                break;
+            case ST_ESCAPE:
+                escape_char(p, c);
+                break;
+            case ST_UNICODE:
+                v = hex_digit(c);
+                if (v < 0) {
+                    fail(p, ESP_ERR_INVALID_ARG);
+                    break;
+                }
+                p->hex = (uint16_t)((p->hex << 4) | v);
+                if (++p->hex_len == 4) {
+                    p->state = ST_STRING;
+                    unicode(p, p->hex);
+                }
+                break;
+            case ST_LITERAL:
+                if (isalnum((unsigned char)c) || c == '+' || c == '-' || c == '.') {
+                    append(p, c);
+                    break;
+                }
+                // Delimiter: finish the literal, then handle c as structure
+                end_literal(p);
+                continue;
+            default:
+                if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+                    structural(p, c);
+                }
+                break;
+        }
+        i++;
+    }
+}
+
+/*
+ * Form (application/x-www-form-urlencoded)
+ */
+static void form_pair_end(body_parser_t* p)
+{
+    if (p->in_key) {
+        // "key" without '=' is an empty value; "&&" is nothing at all
+        if (p->len == 0) {
+            return;
+        }
+        if (p->len >= BODY_PARSER_KEY_MAX) {
+            fail(p, ESP_ERR_INVALID_SIZE);
+            return;
+        }
+        memcpy(p->key, p->value, p->len);
+        p->key[p->len] = '\0';
+        p->len = 0;
+    }
+    emit(p, BODY_VALUE_STRING, -1, NULL);
+    p->in_key = true;
+    p->len = 0;
+}
+
+static void form_char(body_parser_t* p, char c)
+{
+    if (c == '&') {
+        form_pair_end(p);
+    } else if (c == '=' && p->in_key) {
+        if (p->len >= BODY_PARSER_KEY_MAX) {
+            fail(p, ESP_ERR_INVALID_SIZE);
+            return;
+        }
+        memcpy(p->key, p->value, p->len);
+        p->key[p->len] = '\0';
+        p->len = 0;
+        p->in_key = false;
+    } else if (c == '+') {
+        append(p, ' ');
+    } else if (c == '%') {
+        p->hex = 0;
+        p->hex_len = 0;
+        p->state = ST_FORM_HEX;
+    } else {
+        append(p, c);
+    }
+}
+
+static void feed_form(body_parser_t* p, const char* data, size_t len)
+{
+    for (size_t i = 0; i < len && p->err == ESP_OK; i++) {
+        char c = data[i];
+
+        if (p->state != ST_FORM_HEX) {
+            form_char(p, c);
+            continue;
+        }
+
+        int v = hex_digit(c);
+        if (v < 0) {
+            fail(p, ESP_ERR_INVALID_ARG);
+            break;
+        }
+        p->hex = (uint16_t)((p->hex << 4) | v);
+        if (++p->hex_len == 2) {
+            if (p->hex == 0) {
+                fail(p, ESP_ERR_INVALID_ARG);
+                break;
+            }
+            append(p, (char)p->hex);
+            p->state = ST_FORM;
+        }
+    }
+}
+
+esp_err_t body_parser_feed(body_parser_t* p, const char* data, size_t len)
+{
+    if (p->err != ESP_OK) {
+        return p->err;
+    }
+    if (!data && len > 0) {
+        fail(p, ESP_ERR_INVALID_ARG);
+        return p->err;
+    }
+
+    if (p->format == BODY_PARSER_FORM) {
+        feed_form(p, data, len);
+    } else {
+        feed_json(p, data, len);
+    }
+    return p->err;
+}
+
+esp_err_t body_parser_finish(body_parser_t* p)
+{
+    if (p->err != ESP_OK) {
+        return p->err;
+    }
+
+    if (p->format == BODY_PARSER_FORM) {
+        if (p->state == ST_FORM_HEX) {
+            fail(p, ESP_ERR_INVALID_ARG);
+        } else if (!p->in_key || p->len > 0) {
+            form_pair_end(p);
+        }
+    } else if (p->state != ST_DONE) {
+        fail(p, ESP_ERR_INVALID_ARG);
+    }
+    return p->err;
+}
+
+bool body_field_number(const body_field_t* f, double* out)
+{
+    if (f->type != BODY_VALUE_NUMBER && f->type != BODY_VALUE_STRING) {
+        return false;
+    }
+    if (f->len == 0) {
+        return false;
+    }
+
+    char* end = NULL;
+    double v = strtod(f->value, &end);
+    if (end != f->value + f->len || !isfinite(v)) {
+        return false;
+    }
+    *out = v;
+    return true;
+}
+
+bool body_field_bool(const body_field_t* f, bool* out)
+{
+    if (f->type != BODY_VALUE_BOOL && f->type != BODY_VALUE_STRING) {
+        return false;
+    }
+    if (strcmp(f->value, "true") == 0 || strcmp(f->value, "1") == 0 || strcmp(f->value, "on") == 0) {
+        *out = true;
+        return true;
+    }
+    if (strcmp(f->value, "false") == 0 || strcmp(f->value, "0") == 0 || strcmp(f->value, "off") == 0) {
+        *out = false;
+        return true;
+    }
+    return false;
+}
+
+bool body_field_is(const body_field_t* f, const char* key)
+{
+    return f->index < 0 && !f->subkey && strcmp(f->key, key) == 0;
+}
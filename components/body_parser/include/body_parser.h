@@ -0,0 +1,119 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Streaming request body parser
+ *
+ * Parses a JSON object or an application/x-www-form-urlencoded body fed in
+ * chunks of any size, straight off the socket, and hands each value to a
+ * callback as soon as it is complete. Nothing is allocated: the parser
+ * holds one key path and one value, so memory use does not depend on the
+ * body size and a body never has to be held in full.
+ *
+ * Values are reported with their path in the body:
+ *   {"a":1}                    key "a"
+ *   {"a":[1,2]}                key "a", index 0 and 1
+ *   {"a":[{"b":1}]}            key "a", index 0, subkey "b"
+ *   {"a":{"b":1}}              key "a", subkey "b"
+ * Opening a top-level array, or an object inside one, is reported too
+ * (BODY_VALUE_ARRAY / BODY_VALUE_OBJECT) so empty containers are seen.
+ * Anything nested deeper is checked for syntax and skipped.
+ *
+ * Form bodies are flat: every pair is a top-level BODY_VALUE_STRING with
+ * '+' and %XX already decoded.
+ */
+#define BODY_PARSER_KEY_MAX 32      // Longest key, including the terminator
+#define BODY_PARSER_VALUE_MAX 256   // Longest reported value, including the terminator (fits an OTA URL)
+#define BODY_PARSER_MAX_DEPTH 8
+
+typedef enum {
+    BODY_PARSER_JSON = 0,
+    BODY_PARSER_FORM,
+} body_parser_format_t;
+
+typedef enum {
+    BODY_VALUE_STRING = 0,
+    BODY_VALUE_NUMBER,          // value holds the literal, e.g. "1.5e3"
+    BODY_VALUE_BOOL,            // value is "true" or "false"
+    BODY_VALUE_NULL,
+    BODY_VALUE_ARRAY,           // A top-level member opened an array
+    BODY_VALUE_OBJECT,          // An object opened at key (and index, inside an array)
+} body_value_type_t;
+
+typedef struct {
+    const char* key;            // Top-level member name
+    int index;                  // Element of the array at key, -1 if none
+    const char* subkey;         // Member of the object at key/index, NULL if none
+    body_value_type_t type;
+    const char* value;          // Decoded, NUL-terminated ("" for containers)
+    size_t len;
+} body_field_t;
+
+/**
+ * Called for every reported value; anything but ESP_OK stops the parse
+ * and is returned from body_parser_feed()
+ */
+typedef esp_err_t (*body_parser_cb_t)(void* ctx, const body_field_t* field);
+
+typedef struct {
+    body_parser_format_t format;
+    body_parser_cb_t cb;
+    void* ctx;
+    esp_err_t err;              // First error, ESP_OK while healthy
+    uint8_t state;
+    uint8_t depth;              // Open containers
+    uint16_t arrays;            // Bit n: container at depth n is an array
+    bool in_key;                // Token being read is a member name
+    bool keep;                  // Token is reported, so it is stored
+    uint8_t hex_len;            // Digits collected of a \uXXXX or %XX escape
+    uint16_t hex;
+    uint16_t surrogate;         // Pending high surrogate of a \u pair
+    int index;
+    size_t len;                 // Bytes in value
+    char key[BODY_PARSER_KEY_MAX];
+    char subkey[BODY_PARSER_KEY_MAX];
+    char value[BODY_PARSER_VALUE_MAX];
+} body_parser_t;
+
+/**
+ * Start parsing a body (the struct is meant to live on the stack)
+ */
+void body_parser_init(body_parser_t* p, body_parser_format_t format, body_parser_cb_t cb, void* ctx);
+
+/**
+ * Feed the next len bytes of the body
+ * Errors are latched: ESP_ERR_INVALID_ARG for malformed input,
+ * ESP_ERR_INVALID_SIZE for a key, value or nesting over the limits above,
+ * or whatever the callback returned.
+ */
+esp_err_t body_parser_feed(body_parser_t* p, const char* data, size_t len);
+
+/**
+ * End of body: reports a trailing form pair and checks that a JSON
+ * document was complete
+ */
+esp_err_t body_parser_finish(body_parser_t* p);
+
+/**
+ * Value helpers; strings are accepted so form bodies work unchanged
+ * number: BODY_VALUE_NUMBER, or a string holding only a number
+ * bool: BODY_VALUE_BOOL, or "true"/"false", "1"/"0", "on"/"off"
+ */
+bool body_field_number(const body_field_t* f, double* out);
+bool body_field_bool(const body_field_t* f, bool* out);
+
+/**
+ * true if f is a top-level value (no index/subkey) named key
+ */
+bool body_field_is(const body_field_t* f, const char* key);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,321 @@
+#include "unity.h"
+#include "body_parser.h"
+#include "esp_err.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Every reported field is flattened to one line, "key[index].subkey=type:value",
+ * so a whole parse compares as a single string.
+ */
+typedef struct {
+    char out[1024];
+    size_t used;
+    int fields;
+    int fail_at;                // Callback returns ESP_FAIL on this field, -1: never
+} recorder_t;
+
+static esp_err_t record(void* ctx, const body_field_t* f)
+{
+    recorder_t* r = ctx;
+    int n = snprintf(r->out + r->used, sizeof(r->out) - r->used, "%s", f->key);
+    r->used += n;
+    if (f->index >= 0) {
+        r->used += snprintf(r->out + r->used, sizeof(r->out) - r->used, "[%d]", f->index);
+    }
+    if (f->subkey) {
+        r->used += snprintf(r->out + r->used, sizeof(r->out) - r->used, ".%s", f->subkey);
+    }
+    r->used += snprintf(r->out + r->used, sizeof(r->out) - r->used, "=%d:%s\n", (int)f->type, f->value);
+    TEST_ASSERT_TRUE(r->used < sizeof(r->out));
+    TEST_ASSERT_EQUAL(strlen(f->value), f->len);
+
+    return r->fields++ == r->fail_at ? ESP_FAIL : ESP_OK;
+}
+
+static void recorder_init(recorder_t* r)
+{
+    memset(r, 0, sizeof(*r));
+    r->fail_at = -1;
+}
+
+/**
+ * Parse body in one go; returns the first error from feed or finish
+ */
+static esp_err_t parse(body_parser_format_t format, const char* body, recorder_t* r)
+{
+    body_parser_t p;
+
+    recorder_init(r);
+    body_parser_init(&p, format, record, r);
+    esp_err_t err = body_parser_feed(&p, body, strlen(body));
+    return err != ESP_OK ? err : body_parser_finish(&p);
+}
+
+/**
+ * Parse body split in two at every offset, and one byte at a time, and
+ * check each run reports exactly what the one-shot parse did
+ */
+static void check_split(body_parser_format_t format, const char* body)
+{
+    recorder_t whole;
+    recorder_t part;
+    size_t len = strlen(body);
+
+    esp_err_t expect = parse(format, body, &whole);
+
+    for (size_t cut = 0; cut <= len; cut++) {
+        body_parser_t p;
+        recorder_init(&part);
+        body_parser_init(&p, format, record, &part);
+        esp_err_t err = body_parser_feed(&p, body, cut);
+        if (err == ESP_OK) {
+            err = body_parser_feed(&p, body + cut, len - cut);
+        }
+        if (err == ESP_OK) {
+            err = body_parser_finish(&p);
+        }
+        TEST_ASSERT_EQUAL(expect, err);
+        TEST_ASSERT_EQUAL_STRING(whole.out, part.out);
+    }
+
+    body_parser_t p;
+    recorder_init(&part);
+    body_parser_init(&p, format, record, &part);
+    esp_err_t err = ESP_OK;
+    for (size_t i = 0; i < len && err == ESP_OK; i++) {
+        err = body_parser_feed(&p, body + i, 1);
+    }
+    if (err == ESP_OK) {
+        err = body_parser_finish(&p);
+    }
+    TEST_ASSERT_EQUAL(expect, err);
+    TEST_ASSERT_EQUAL_STRING(whole.out, part.out);
+}
+
+TEST_CASE("body_parser_json_paths_and_types", "[body_parser]")
+{
+    recorder_t r;
+
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON,
+        "{\"ssid\":\"lab\", \"ch\":-6.5e2, \"on\":true, \"pw\":null,"
+        " \"list\":[1,\"x\",{\"b\":2,\"deep\":{\"c\":3}}],"
+        " \"obj\":{\"k\":\"v\",\"arr\":[9]}, \"e\":[], \"o\":{}}", &r));
+    TEST_ASSERT_EQUAL_STRING(
+        "ssid=0:lab\n"
+        "ch=1:-6.5e2\n"
+        "on=2:true\n"
+        "pw=3:null\n"
+        "list=4:\n"
+        "list[0]=1:1\n"
+        "list[1]=0:x\n"
+        "list[2]=5:\n"
+        "list[2].b=1:2\n"
+        "obj=5:\n"
+        "obj.k=0:v\n"
+        "e=4:\n"
+        "o=5:\n", r.out);
+}
+
+TEST_CASE("body_parser_json_split_at_every_offset", "[body_parser]")
+{
+    // Cuts land inside keys, literals, \uXXXX escapes and surrogate pairs
+    check_split(BODY_PARSER_JSON,
+        "{\"name\":\"caf\\u00e9 \\\"q\\\" \\\\ \\/ \\n\","
+        " \"emoji\":\"\\ud83d\\ude00\", \"n\":12345, \"f\":false,"
+        " \"a\":[true,{\"k\":\"\\u20AC\"}], \"o\":{\"s\":\"x\\ty\"}}");
+
+    recorder_t r;
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON,
+        "{\"u\":\"\\u00e9\\u20ac\\ud83d\\ude00\"}", &r));
+    TEST_ASSERT_EQUAL_STRING("u=0:\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\n", r.out);
+}
+
+TEST_CASE("body_parser_form_split_at_every_offset", "[body_parser]")
+{
+    // Cuts land between '%' and its hex digits
+    check_split(BODY_PARSER_FORM, "ssid=my+lab%21&pw=a%26b%3Dc&flag&&empty=&url=http%3A%2F%2Fh%2Fx");
+
+    recorder_t r;
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_FORM,
+        "ssid=my+lab%21&pw=a%26b%3dc&flag&&empty=&k%20=v", &r));
+    TEST_ASSERT_EQUAL_STRING(
+        "ssid=0:my lab!\n"
+        "pw=0:a&b=c\n"
+        "flag=0:\n"
+        "empty=0:\n"
+        "k =0:v\n", r.out);
+}
+
+TEST_CASE("body_parser_empty_body", "[body_parser]")
+{
+    recorder_t r;
+
+    // A JSON body has to be an object; an empty form is just no fields
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, parse(BODY_PARSER_JSON, "", &r));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, parse(BODY_PARSER_JSON, " \r\n", &r));
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON, " {} ", &r));
+    TEST_ASSERT_EQUAL(0, r.fields);
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_FORM, "", &r));
+    TEST_ASSERT_EQUAL(0, r.fields);
+}
+
+TEST_CASE("body_parser_rejects_malformed_json", "[body_parser]")
+{
+    static const char* bad[] = {
+        "[1,2]",                    // Not an object
+        "\"x\"",
+        "{\"a\":}",
+        "{\"a\" 1}",
+        "{\"a\":1,}",
+        "{a:1}",
+        "{\"a\":1]",
+        "{\"a\":[1}",
+        "{\"a\":tru}",
+        "{\"a\":01}",
+        "{\"a\":1.}",
+        "{\"a\":\"x\ny\"}",         // Raw control character
+        "{\"a\":\"\\x\"}",
+        "{\"a\":\"\\u12G4\"}",
+        "{\"a\":\"\\u0000\"}",
+        "{\"a\":\"\\ude00\"}",      // Lone low surrogate
+        "{\"a\":\"\\ud83dx\"}",     // High surrogate without its pair
+        "{\"a\":1} x",
+    };
+    recorder_t r;
+
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(ESP_ERR_INVALID_ARG, parse(BODY_PARSER_JSON, bad[i], &r), bad[i]);
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, parse(BODY_PARSER_FORM, "a=%4", &r));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, parse(BODY_PARSER_FORM, "a=%zz", &r));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, parse(BODY_PARSER_FORM, "a=%00", &r));
+}
+
+TEST_CASE("body_parser_rejects_truncated_json", "[body_parser]")
+{
+    const char* body = "{\"a\":[1,{\"b\":\"\\u00e9\"}],\"c\":true}";
+    size_t len = strlen(body);
+    recorder_t r;
+
+    // Every proper prefix feeds cleanly but does not finish
+    for (size_t cut = 0; cut < len; cut++) {
+        body_parser_t p;
+        recorder_init(&r);
+        body_parser_init(&p, BODY_PARSER_JSON, record, &r);
+        TEST_ASSERT_EQUAL(ESP_OK, body_parser_feed(&p, body, cut));
+        TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, body_parser_finish(&p));
+    }
+}
+
+TEST_CASE("body_parser_enforces_limits", "[body_parser]")
+{
+    char body[BODY_PARSER_VALUE_MAX + 64];
+    char text[BODY_PARSER_VALUE_MAX + 1];
+    recorder_t r;
+
+    // Key: BODY_PARSER_KEY_MAX includes the terminator
+    memset(text, 'k', BODY_PARSER_KEY_MAX - 1);
+    text[BODY_PARSER_KEY_MAX - 1] = '\0';
+    snprintf(body, sizeof(body), "{\"%s\":1}", text);
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON, body, &r));
+    snprintf(body, sizeof(body), "{\"o\":{\"%s\":1}}", text);
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON, body, &r));
+    snprintf(body, sizeof(body), "%s=1", text);
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_FORM, body, &r));
+    strcat(text, "k");
+    snprintf(body, sizeof(body), "{\"%s\":1}", text);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, parse(BODY_PARSER_JSON, body, &r));
+    snprintf(body, sizeof(body), "{\"o\":{\"%s\":1}}", text);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, parse(BODY_PARSER_JSON, body, &r));
+    snprintf(body, sizeof(body), "%s=1", text);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, parse(BODY_PARSER_FORM, body, &r));
+    snprintf(body, sizeof(body), "%s", text);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, parse(BODY_PARSER_FORM, body, &r));
+
+    // Value: likewise BODY_PARSER_VALUE_MAX
+    memset(text, 'v', BODY_PARSER_VALUE_MAX - 1);
+    text[BODY_PARSER_VALUE_MAX - 1] = '\0';
+    snprintf(body, sizeof(body), "{\"a\":\"%s\"}", text);
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON, body, &r));
+    TEST_ASSERT_EQUAL(BODY_PARSER_VALUE_MAX - 1 + strlen("a=0:\n"), strlen(r.out));
+    snprintf(body, sizeof(body), "a=%s", text);
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_FORM, body, &r));
+    strcat(text, "v");
+    snprintf(body, sizeof(body), "{\"a\":\"%s\"}", text);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, parse(BODY_PARSER_JSON, body, &r));
+    snprintf(body, sizeof(body), "a=%s", text);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, parse(BODY_PARSER_FORM, body, &r));
+
+    // Values too deep to report are only syntax-checked, so length is free
+    snprintf(body, sizeof(body), "{\"a\":{\"b\":{\"c\":\"%s\"}}}", text);
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON, body, &r));
+    TEST_ASSERT_EQUAL_STRING("a=5:\n", r.out);
+
+    // Depth: BODY_PARSER_MAX_DEPTH - 1 containers may be open at once
+    body[0] = '\0';
+    for (int d = 0; d < BODY_PARSER_MAX_DEPTH - 1; d++) {
+        strcat(body, d == 0 ? "{" : "\"k\":{");
+    }
+    for (int d = 0; d < BODY_PARSER_MAX_DEPTH - 1; d++) {
+        strcat(body, "}");
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON, body, &r));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, parse(BODY_PARSER_JSON,
+        "{\"a\":[[[[[[[1]]]]]]]}", &r));
+    TEST_ASSERT_EQUAL(ESP_OK, parse(BODY_PARSER_JSON, "{\"a\":[[[[[[1]]]]]]}", &r));
+}
+
+TEST_CASE("body_parser_latches_callback_error", "[body_parser]")
+{
+    const char* body = "{\"a\":1,\"b\":2,\"c\":3";
+    body_parser_t p;
+    recorder_t r;
+
+    // The second field fails; nothing is reported after it
+    recorder_init(&r);
+    r.fail_at = 1;
+    body_parser_init(&p, BODY_PARSER_JSON, record, &r);
+    TEST_ASSERT_EQUAL(ESP_FAIL, body_parser_feed(&p, body, strlen(body)));
+    TEST_ASSERT_EQUAL(2, r.fields);
+    TEST_ASSERT_EQUAL(ESP_FAIL, body_parser_feed(&p, "}", 1));
+    TEST_ASSERT_EQUAL(ESP_FAIL, body_parser_finish(&p));
+    TEST_ASSERT_EQUAL(2, r.fields);
+
+    body_parser_init(&p, BODY_PARSER_JSON, NULL, NULL);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, body_parser_feed(&p, "{}", 2));
+    body_parser_init(&p, BODY_PARSER_JSON, record, &r);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, body_parser_feed(&p, NULL, 1));
+}
+
+TEST_CASE("body_parser_field_helpers", "[body_parser]")
+{
+    body_field_t f = { .key = "a", .index = -1, .type = BODY_VALUE_STRING, .value = "42.5", .len = 4 };
+    double d = 0;
+    bool b = false;
+
+    TEST_ASSERT_TRUE(body_field_is(&f, "a"));
+    TEST_ASSERT_FALSE(body_field_is(&f, "ab"));
+    TEST_ASSERT_TRUE(body_field_number(&f, &d));
+    TEST_ASSERT_TRUE(d == 42.5);
+    TEST_ASSERT_FALSE(body_field_bool(&f, &b));
+
+    f.value = "on";
+    f.len = 2;
+    TEST_ASSERT_FALSE(body_field_number(&f, &d));
+    TEST_ASSERT_TRUE(body_field_bool(&f, &b));
+    TEST_ASSERT_TRUE(b);
+
+    f.index = 0;
+    TEST_ASSERT_FALSE(body_field_is(&f, "a"));
+    f.index = -1;
+    f.subkey = "s";
+    TEST_ASSERT_FALSE(body_field_is(&f, "a"));
+
+    f.subkey = NULL;
+    f.type = BODY_VALUE_NULL;
+    f.value = "";
+    f.len = 0;
+    TEST_ASSERT_FALSE(body_field_number(&f, &d));
+    TEST_ASSERT_FALSE(body_field_bool(&f, &b));
+}
@@ -3,12 +3,16 @@
  */
 
 #include "config_mgr.h"
+#include "config_store.h"
 #include "nvs_flash.h"
 #include "nvs.h"
 #include "esp_log.h"
 #include "esp_mac.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 static const char *TAG = "config_mgr";
 static const char *NS = "cfg";          // Runtime configuration (writable)
@@ -39,12 +43,19 @@ static const char *NS_FACTORY = "factory"; // Hardware info (readonly after prov
 #define DEFAULT_UDP_FREQ_HZ 1000  // Stored as millihertz (1 Hz = 1000 mHz)
 #define DEFAULT_UDP_TTL 1
 #define DEFAULT_UDP_MODE 0  // 0=broadcast, 1=multicast, 2=unicast
+#define DEFAULT_UDP_FORMAT 0  // 0=json, 1=binary
+#define DEFAULT_UDP_STREAM_EN false
+#define DEFAULT_UDP_STREAM_N 10     // GNSS samples per stream datagram
+#define DEFAULT_UDP_STREAM_MS 100   // Max age of a queued sample before flush
+
+#define DEFAULT_WIFI_POWER 1  // 0=low_latency, 1=balanced, 2=power_save (net_mgr_power_profile_t)
 
 #define DEFAULT_NTRIP_PORT 2101
 #define DEFAULT_NTRIP_USE_TLS false
 
 #define DEFAULT_HTTP_UI_USER "admin"
 #define DEFAULT_HTTP_UI_PASS "admin"  // WEAK - user must change
+#define DEFAULT_UI_LIVE_MS 1000         // /ws status push period
 
 #define DEFAULT_LOG_LEVEL 3  // ESP_LOG_INFO
 #define DEFAULT_NTP_SERVER "pool.ntp.org"  // Legacy - to be removed
@@ -56,6 +67,344 @@ static const char *NS_FACTORY = "factory"; // Hardware info (readonly after prov
 
 // Validation limits
 #define MAX_STRING_LENGTH 512
+#define MAX_BLOB_LENGTH 4096
+
+// Keys tracked per transaction for cache invalidation; beyond this the
+// whole cache is dropped on commit
+#define TXN_MAX_TRACKED_KEYS 24
+
+// RAM cache for the cfg and factory namespaces
+// Sized for the full default schema plus provisioning keys with headroom
+#define CACHE_MAX_ENTRIES 64
+
+typedef enum {
+    CACHE_NS_CFG = 0,
+    CACHE_NS_FACTORY,
+    CACHE_NS_COUNT
+} cache_ns_t;
+
+typedef enum {
+    CACHE_TYPE_FREE = 0,    // Slot unused
+    CACHE_TYPE_U32,         // Value cached in val.u32
+    CACHE_TYPE_STR,         // Value cached in val.str (heap copy)
+    CACHE_TYPE_OTHER,       // Key exists with a type we don't cache (e.g. blob) - always read NVS
+    CACHE_TYPE_STALE        // Invalidated - next read goes to NVS and refills the slot
+} cache_type_t;
+
+typedef struct {
+    uint8_t ns;
+    uint8_t type;
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    union {
+        uint32_t u32;
+        char* str;
+    } val;
+} cache_entry_t;
+
+static cache_entry_t s_cache[CACHE_MAX_ENTRIES];
+static bool s_cache_complete[CACHE_NS_COUNT];  // true = a key absent from the cache is absent from NVS
+static bool s_cache_loaded = false;
+static SemaphoreHandle_t s_cache_mutex = NULL;
+static uint32_t s_cache_hits = 0;
+static uint32_t s_cache_misses = 0;
+
+static const char* cache_ns_name(cache_ns_t ns)
+{
+    return (ns == CACHE_NS_FACTORY) ? NS_FACTORY : NS;
+}
+
+/**
+ * Find cache slot for ns/key
+ * Caller must hold s_cache_mutex
+ */
+static int cache_find(cache_ns_t ns, const char* key)
+{
+    for (int i = 0; i < CACHE_MAX_ENTRIES; i++) {
+        if (s_cache[i].type != CACHE_TYPE_FREE && s_cache[i].ns == ns &&
+            strcmp(s_cache[i].key, key) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void cache_entry_clear(cache_entry_t* e)
+{
+    if (e->type == CACHE_TYPE_STR) {
+        free(e->val.str);
+    }
+    memset(e, 0, sizeof(*e));
+}
+
+/**
+ * Find existing slot for ns/key or claim a free one
+ * If the cache is full the namespace is marked incomplete so misses fall
+ * through to NVS instead of reporting ESP_ERR_NVS_NOT_FOUND.
+ * Caller must hold s_cache_mutex
+ */
+static cache_entry_t* cache_slot_for(cache_ns_t ns, const char* key)
+{
+    if (strlen(key) >= NVS_KEY_NAME_MAX_SIZE) {
+        return NULL;
+    }
+
+    int idx = cache_find(ns, key);
+    if (idx >= 0) {
+        cache_entry_clear(&s_cache[idx]);
+    } else {
+        for (int i = 0; i < CACHE_MAX_ENTRIES; i++) {
+            if (s_cache[i].type == CACHE_TYPE_FREE) {
+                idx = i;
+                break;
+            }
+        }
+    }
+
+    if (idx < 0) {
+        if (s_cache_complete[ns]) {
+            ESP_LOGW(TAG, "Config cache full (%d entries), '%s' namespace falls back to NVS",
+                     CACHE_MAX_ENTRIES, cache_ns_name(ns));
+        }
+        s_cache_complete[ns] = false;
+        return NULL;
+    }
+
+    cache_entry_t* e = &s_cache[idx];
+    e->ns = (uint8_t)ns;
+    strlcpy(e->key, key, sizeof(e->key));
+    return e;
+}
+
+static void cache_store_u32(cache_ns_t ns, const char* key, uint32_t val)
+{
+    if (!s_cache_loaded) {
+        return;
+    }
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    cache_entry_t* e = cache_slot_for(ns, key);
+    if (e) {
+        e->type = CACHE_TYPE_U32;
+        e->val.u32 = val;
+    }
+    xSemaphoreGive(s_cache_mutex);
+}
+
+static void cache_store_str(cache_ns_t ns, const char* key, const char* val)
+{
+    if (!s_cache_loaded) {
+        return;
+    }
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    cache_entry_t* e = cache_slot_for(ns, key);
+    if (e) {
+        e->val.str = strdup(val);
+        if (e->val.str) {
+            e->type = CACHE_TYPE_STR;
+        } else {
+            // Out of memory - leave a marker so reads go to NVS
+            e->type = CACHE_TYPE_STALE;
+        }
+    }
+    xSemaphoreGive(s_cache_mutex);
+}
+
+/**
+ * Record ns/key with a marker type (OTHER or STALE) so reads bypass the cache
+ */
+static void cache_store_marker(cache_ns_t ns, const char* key, cache_type_t type)
+{
+    if (!s_cache_loaded) {
+        return;
+    }
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    cache_entry_t* e = cache_slot_for(ns, key);
+    if (e) {
+        e->type = type;
+    }
+    xSemaphoreGive(s_cache_mutex);
+}
+
+/**
+ * Drop ns/key after NVS reported it missing
+ */
+static void cache_remove(cache_ns_t ns, const char* key)
+{
+    if (!s_cache_loaded) {
+        return;
+    }
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    int idx = cache_find(ns, key);
+    if (idx >= 0) {
+        cache_entry_clear(&s_cache[idx]);
+    }
+    xSemaphoreGive(s_cache_mutex);
+}
+
+/**
+ * Answer a string read from RAM
+ * Returns true on a hit (result in *err, mirrors nvs_get_str semantics)
+ * Returns false if the caller must read NVS
+ */
+static bool cache_lookup_str(cache_ns_t ns, const char* key, char* out, size_t out_len, esp_err_t* err)
+{
+    if (!s_cache_loaded) {
+        return false;
+    }
+
+    bool hit = false;
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    int idx = cache_find(ns, key);
+    if (idx >= 0) {
+        if (s_cache[idx].type == CACHE_TYPE_STR) {
+            size_t need = strlen(s_cache[idx].val.str) + 1;
+            if (need > out_len) {
+                *err = ESP_ERR_NVS_INVALID_LENGTH;
+            } else {
+                memcpy(out, s_cache[idx].val.str, need);
+                *err = ESP_OK;
+            }
+            hit = true;
+        }
+    } else if (s_cache_complete[ns]) {
+        *err = ESP_ERR_NVS_NOT_FOUND;
+        hit = true;
+    }
+
+    if (hit) {
+        s_cache_hits++;
+    } else {
+        s_cache_misses++;
+    }
+    xSemaphoreGive(s_cache_mutex);
+    return hit;
+}
+
+static bool cache_lookup_u32(cache_ns_t ns, const char* key, uint32_t* out, esp_err_t* err)
+{
+    if (!s_cache_loaded) {
+        return false;
+    }
+
+    bool hit = false;
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    int idx = cache_find(ns, key);
+    if (idx >= 0) {
+        if (s_cache[idx].type == CACHE_TYPE_U32) {
+            *out = s_cache[idx].val.u32;
+            *err = ESP_OK;
+            hit = true;
+        }
+    } else if (s_cache_complete[ns]) {
+        *err = ESP_ERR_NVS_NOT_FOUND;
+        hit = true;
+    }
+
+    if (hit) {
+        s_cache_hits++;
+    } else {
+        s_cache_misses++;
+    }
+    xSemaphoreGive(s_cache_mutex);
+    return hit;
+}
+
+/**
+ * Populate the cache with every entry of one namespace
+ * Uses the NVS entry iterator so keys written by other modules are included
+ */
+static esp_err_t cache_load_namespace(cache_ns_t ns)
+{
+    const char* name = cache_ns_name(ns);
+    nvs_iterator_t it = NULL;
+    esp_err_t ret = nvs_entry_find(NVS_DEFAULT_PART_NAME, name, NVS_TYPE_ANY, &it);
+    if (ret == ESP_ERR_NVS_NOT_FOUND) {
+        // Namespace empty or never created (e.g. factory before provisioning)
+        s_cache_complete[ns] = true;
+        return ESP_OK;
+    }
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    nvs_handle_t h;
+    ret = nvs_open(name, NVS_READONLY, &h);
+    if (ret != ESP_OK) {
+        nvs_release_iterator(it);
+        return ret;
+    }
+
+    // Assume complete; cache_slot_for() clears this if we run out of slots
+    s_cache_complete[ns] = true;
+    int loaded = 0;
+
+    while (ret == ESP_OK) {
+        nvs_entry_info_t info;
+        nvs_entry_info(it, &info);
+
+        if (info.type == NVS_TYPE_U32) {
+            uint32_t val = 0;
+            if (nvs_get_u32(h, info.key, &val) == ESP_OK) {
+                cache_store_u32(ns, info.key, val);
+            } else {
+                cache_store_marker(ns, info.key, CACHE_TYPE_STALE);
+            }
+        } else if (info.type == NVS_TYPE_STR) {
+            size_t len = 0;
+            char* val = NULL;
+            if (nvs_get_str(h, info.key, NULL, &len) == ESP_OK && (val = malloc(len)) != NULL &&
+                nvs_get_str(h, info.key, val, &len) == ESP_OK) {
+                cache_store_str(ns, info.key, val);
+            } else {
+                cache_store_marker(ns, info.key, CACHE_TYPE_STALE);
+            }
+            free(val);
+        } else {
+            cache_store_marker(ns, info.key, CACHE_TYPE_OTHER);
+        }
+        loaded++;
+
+        ret = nvs_entry_next(&it);
+    }
+
+    nvs_release_iterator(it);
+    nvs_close(h);
+
+    ESP_LOGI(TAG, "Cached %d keys from '%s' namespace%s", loaded, name,
+             s_cache_complete[ns] ? "" : " (partial)");
+    return ESP_OK;
+}
+
+static esp_err_t cache_load(void)
+{
+    if (!s_cache_mutex) {
+        s_cache_mutex = xSemaphoreCreateMutex();
+        if (!s_cache_mutex) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    for (int i = 0; i < CACHE_MAX_ENTRIES; i++) {
+        cache_entry_clear(&s_cache[i]);
+    }
+    memset(s_cache_complete, 0, sizeof(s_cache_complete));
+    xSemaphoreGive(s_cache_mutex);
+
+    // Store helpers are no-ops until loaded
+    s_cache_loaded = true;
+
+    for (int ns = 0; ns < CACHE_NS_COUNT; ns++) {
+        esp_err_t ret = cache_load_namespace((cache_ns_t)ns);
+        if (ret != ESP_OK) {
+            // Not fatal - misses for this namespace simply read NVS
+            ESP_LOGW(TAG, "Failed to cache '%s' namespace: %s",
+                     cache_ns_name((cache_ns_t)ns), esp_err_to_name(ret));
+            s_cache_complete[ns] = false;
+        }
+    }
+
+    return ESP_OK;
+}
 
 /**
  * Generate device ID from MAC address
@@ -138,6 +487,12 @@ esp_err_t config_mgr_init(void)
         return ret;
     }
 
+    // Load cfg/factory namespaces into RAM; getters are served from here afterwards
+    ret = cache_load();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Config cache disabled: %s", esp_err_to_name(ret));
+    }
+
     // Check for weak password and warn user
     if (config_mgr_has_weak_password()) {
         ESP_LOGW(TAG, "***********************************************");
@@ -200,6 +555,9 @@ esp_err_t config_mgr_load_defaults_if_needed(void)
         goto cleanup;
     }
 
+    ret = set_default_if_missing_u32(h, "wifi/power", DEFAULT_WIFI_POWER);
+    if (ret != ESP_OK) goto cleanup;
+
     // Set UDP defaults if not present
     ret = set_default_if_missing_u32(h, "udp/enabled", DEFAULT_UDP_ENABLED ? 1 : 0);
     if (ret != ESP_OK) goto cleanup;
@@ -223,6 +581,14 @@ esp_err_t config_mgr_load_defaults_if_needed(void)
     if (ret != ESP_OK) goto cleanup;
     ret = set_default_if_missing_u32(h, "udp/mode", DEFAULT_UDP_MODE);
     if (ret != ESP_OK) goto cleanup;
+    ret = set_default_if_missing_u32(h, "udp/format", DEFAULT_UDP_FORMAT);
+    if (ret != ESP_OK) goto cleanup;
+    ret = set_default_if_missing_u32(h, "udp/stream_en", DEFAULT_UDP_STREAM_EN ? 1 : 0);
+    if (ret != ESP_OK) goto cleanup;
+    ret = set_default_if_missing_u32(h, "udp/stream_n", DEFAULT_UDP_STREAM_N);
+    if (ret != ESP_OK) goto cleanup;
+    ret = set_default_if_missing_u32(h, "udp/stream_ms", DEFAULT_UDP_STREAM_MS);
+    if (ret != ESP_OK) goto cleanup;
 
     // Set NTRIP defaults if not present
     ret = set_default_if_missing_u32(h, "ntrip/port", DEFAULT_NTRIP_PORT);
@@ -235,6 +601,8 @@ esp_err_t config_mgr_load_defaults_if_needed(void)
     if (ret != ESP_OK) goto cleanup;
     ret = set_default_if_missing_str(h, KEY_AUTH_PASS, DEFAULT_HTTP_UI_PASS);
     if (ret != ESP_OK) goto cleanup;
+    ret = set_default_if_missing_u32(h, "ui/live_ms", DEFAULT_UI_LIVE_MS);
+    if (ret != ESP_OK) goto cleanup;
 
     // Set system defaults if not present
     ret = set_default_if_missing_u32(h, "sys/log_level", DEFAULT_LOG_LEVEL);
@@ -272,8 +640,13 @@ esp_err_t config_mgr_get_string(const char* key, char* out, size_t out_len)
         return ESP_ERR_INVALID_ARG;
     }
 
+    esp_err_t err;
+    if (cache_lookup_str(CACHE_NS_CFG, key, out, out_len, &err)) {
+        return err;
+    }
+
     nvs_handle_t h;
-    esp_err_t err = nvs_open(NS, NVS_READONLY, &h);
+    err = nvs_open(NS, NVS_READONLY, &h);
     if (err != ESP_OK) {
         ESP_LOGW(TAG, "Failed to open NVS for key '%s': %s", key, esp_err_to_name(err));
         return err;
@@ -286,6 +659,13 @@ esp_err_t config_mgr_get_string(const char* key, char* out, size_t out_len)
     }
 
     nvs_close(h);
+
+    // Read-through: refill the slot so the next read is served from RAM
+    if (err == ESP_OK) {
+        cache_store_str(CACHE_NS_CFG, key, out);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        cache_remove(CACHE_NS_CFG, key);
+    }
     return err;
 }
 
@@ -319,6 +699,9 @@ esp_err_t config_mgr_set_string(const char* key, const char* val)
 
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to set string key '%s': %s", key, esp_err_to_name(err));
+        cache_store_marker(CACHE_NS_CFG, key, CACHE_TYPE_STALE);
+    } else {
+        cache_store_str(CACHE_NS_CFG, key, val);
     }
 
     nvs_close(h);
@@ -333,14 +716,25 @@ esp_err_t config_mgr_get_u32(const char* key, uint32_t* out)
         return ESP_ERR_INVALID_ARG;
     }
 
+    esp_err_t err;
+    if (cache_lookup_u32(CACHE_NS_CFG, key, out, &err)) {
+        return err;
+    }
+
     nvs_handle_t h;
-    esp_err_t err = nvs_open(NS, NVS_READONLY, &h);
+    err = nvs_open(NS, NVS_READONLY, &h);
     if (err != ESP_OK) {
         return err;
     }
 
     err = nvs_get_u32(h, key, out);
     nvs_close(h);
+
+    if (err == ESP_OK) {
+        cache_store_u32(CACHE_NS_CFG, key, *out);
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        cache_remove(CACHE_NS_CFG, key);
+    }
     return err;
 }
 
@@ -366,6 +760,9 @@ esp_err_t config_mgr_set_u32(const char* key, uint32_t val)
 
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to set u32 key '%s': %s", key, esp_err_to_name(err));
+        cache_store_marker(CACHE_NS_CFG, key, CACHE_TYPE_STALE);
+    } else {
+        cache_store_u32(CACHE_NS_CFG, key, val);
     }
 
     nvs_close(h);
@@ -428,9 +825,9 @@ esp_err_t config_mgr_set_blob(const char* key, const void* data, size_t data_len
     }
 
     // Validate blob size (NVS maximum is ~500KB per namespace, but keep reasonable)
-    if (data_len > 4096) {
-        ESP_LOGE(TAG, "Blob too large for key '%s' (max 4096 bytes, got %zu)",
-                 key, data_len);
+    if (data_len > MAX_BLOB_LENGTH) {
+        ESP_LOGE(TAG, "Blob too large for key '%s' (max %d bytes, got %zu)",
+                 key, MAX_BLOB_LENGTH, data_len);
         return ESP_ERR_INVALID_SIZE;
     }
 
@@ -451,6 +848,9 @@ esp_err_t config_mgr_set_blob(const char* key, const void* data, size_t data_len
         ESP_LOGE(TAG, "Failed to set blob key '%s': %s", key, esp_err_to_name(err));
     }
 
+    // Blobs are not cached; record the key so typed getters still consult NVS
+    cache_store_marker(CACHE_NS_CFG, key, CACHE_TYPE_OTHER);
+
     nvs_close(h);
     return err;
 }
@@ -518,14 +918,19 @@ bool config_mgr_has_weak_password(void)
 
 bool config_mgr_is_provisioned(void)
 {
+    uint32_t locked = 0;
+    esp_err_t err;
+    if (cache_lookup_u32(CACHE_NS_FACTORY, KEY_PROVISION_LOCKED, &locked, &err)) {
+        return (err == ESP_OK && locked == 1);
+    }
+
     nvs_handle_t h;
-    esp_err_t err = nvs_open(NS_FACTORY, NVS_READONLY, &h);
+    err = nvs_open(NS_FACTORY, NVS_READONLY, &h);
     if (err != ESP_OK) {
         // Factory namespace doesn't exist = not provisioned
         return false;
     }
 
-    uint32_t locked = 0;
     err = nvs_get_u32(h, KEY_PROVISION_LOCKED, &locked);
     nvs_close(h);
 
@@ -593,6 +998,15 @@ esp_err_t config_mgr_provision_hardware(const hardware_info_t* hw_info)
 
     ret = nvs_commit(h);
     if (ret == ESP_OK) {
+        cache_store_str(CACHE_NS_FACTORY, KEY_HW_MODEL, hw_info->model);
+        cache_store_str(CACHE_NS_FACTORY, KEY_HW_REVISION, hw_info->revision);
+        cache_store_str(CACHE_NS_FACTORY, KEY_HW_SERIAL, hw_info->serial);
+        cache_store_str(CACHE_NS_FACTORY, KEY_GNSS_MANUFACTURER, hw_info->gnss_manufacturer);
+        cache_store_str(CACHE_NS_FACTORY, KEY_GNSS_MODEL, hw_info->gnss_model);
+        cache_store_str(CACHE_NS_FACTORY, KEY_GNSS_HW_VERSION, hw_info->gnss_hw_version);
+        cache_store_str(CACHE_NS_FACTORY, KEY_GNSS_FW_VERSION, hw_info->gnss_fw_version);
+        cache_store_u32(CACHE_NS_FACTORY, KEY_PROVISION_LOCKED, 1);
+
         ESP_LOGI(TAG, "Hardware provisioned: %s rev %s, S/N: %s, GNSS: %s %s (HW:%s FW:%s)",
                  hw_info->model, hw_info->revision, hw_info->serial,
                  hw_info->gnss_manufacturer, hw_info->gnss_model,
@@ -617,8 +1031,39 @@ esp_err_t config_mgr_get_hardware_info(hardware_info_t* hw_info)
     // Clear the structure first
     memset(hw_info, 0, sizeof(hardware_info_t));
 
+    // Fast path: every field served from RAM
+    const struct {
+        const char* key;
+        char* out;
+        size_t len;
+    } fields[] = {
+        { KEY_HW_MODEL, hw_info->model, sizeof(hw_info->model) },
+        { KEY_HW_REVISION, hw_info->revision, sizeof(hw_info->revision) },
+        { KEY_HW_SERIAL, hw_info->serial, sizeof(hw_info->serial) },
+        { KEY_GNSS_MANUFACTURER, hw_info->gnss_manufacturer, sizeof(hw_info->gnss_manufacturer) },
+        { KEY_GNSS_MODEL, hw_info->gnss_model, sizeof(hw_info->gnss_model) },
+        { KEY_GNSS_HW_VERSION, hw_info->gnss_hw_version, sizeof(hw_info->gnss_hw_version) },
+        { KEY_GNSS_FW_VERSION, hw_info->gnss_fw_version, sizeof(hw_info->gnss_fw_version) },
+    };
+    esp_err_t ret = ESP_OK;
+    bool all_cached = true;
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]) && ret == ESP_OK; i++) {
+        if (!cache_lookup_str(CACHE_NS_FACTORY, fields[i].key, fields[i].out, fields[i].len, &ret)) {
+            all_cached = false;
+            break;
+        }
+    }
+    if (all_cached) {
+        if (ret != ESP_OK) {
+            memset(hw_info, 0, sizeof(hardware_info_t));
+            ESP_LOGW(TAG, "Hardware info not available: %s", esp_err_to_name(ret));
+        }
+        return ret;
+    }
+    memset(hw_info, 0, sizeof(hardware_info_t));
+
     nvs_handle_t h;
-    esp_err_t ret = nvs_open(NS_FACTORY, NVS_READONLY, &h);
+    ret = nvs_open(NS_FACTORY, NVS_READONLY, &h);
     if (ret != ESP_OK) {
         ESP_LOGW(TAG, "Factory namespace not found (device not provisioned?)");
         return ret;
@@ -660,3 +1105,206 @@ cleanup:
     }
     return ret;
 }
+
+void config_mgr_cache_invalidate(const char* key)
+{
+    if (!s_cache_loaded) {
+        return;
+    }
+
+    if (!key) {
+        // Drop everything; subsequent reads go to NVS and repopulate
+        xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+        for (int i = 0; i < CACHE_MAX_ENTRIES; i++) {
+            cache_entry_clear(&s_cache[i]);
+        }
+        memset(s_cache_complete, 0, sizeof(s_cache_complete));
+        xSemaphoreGive(s_cache_mutex);
+        ESP_LOGI(TAG, "Config cache invalidated");
+        return;
+    }
+
+    for (int ns = 0; ns < CACHE_NS_COUNT; ns++) {
+        cache_store_marker((cache_ns_t)ns, key, CACHE_TYPE_STALE);
+    }
+}
+
+esp_err_t config_mgr_get_cache_stats(config_mgr_cache_stats_t* stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    if (!s_cache_loaded) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(s_cache_mutex, portMAX_DELAY);
+    stats->hits = s_cache_hits;
+    stats->misses = s_cache_misses;
+    for (int i = 0; i < CACHE_MAX_ENTRIES; i++) {
+        if (s_cache[i].type == CACHE_TYPE_U32 || s_cache[i].type == CACHE_TYPE_STR) {
+            stats->entries++;
+        }
+    }
+    stats->capacity = CACHE_MAX_ENTRIES;
+    xSemaphoreGive(s_cache_mutex);
+    return ESP_OK;
+}
+
+struct config_mgr_txn {
+    config_store_txn_t* store;
+    esp_err_t err;                  // First validation error (sticky)
+    uint8_t key_count;
+    bool keys_overflow;
+    char keys[TXN_MAX_TRACKED_KEYS][NVS_KEY_NAME_MAX_SIZE];
+};
+
+static esp_err_t txn_track(config_mgr_txn_t* txn, const char* key, esp_err_t ret)
+{
+    if (ret != ESP_OK) {
+        if (txn->err == ESP_OK) {
+            txn->err = ret;
+        }
+        return ret;
+    }
+
+    for (int i = 0; i < txn->key_count; i++) {
+        if (strcmp(txn->keys[i], key) == 0) {
+            return ESP_OK;
+        }
+    }
+    if (txn->key_count < TXN_MAX_TRACKED_KEYS) {
+        strlcpy(txn->keys[txn->key_count++], key, NVS_KEY_NAME_MAX_SIZE);
+    } else {
+        txn->keys_overflow = true;
+    }
+    return ESP_OK;
+}
+
+esp_err_t config_mgr_txn_begin(config_mgr_txn_t** out_txn)
+{
+    if (!out_txn) {
+        ESP_LOGE(TAG, "Invalid arguments to config_mgr_txn_begin");
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_txn = NULL;
+
+    config_mgr_txn_t* txn = calloc(1, sizeof(*txn));
+    if (!txn) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = config_store_txn_begin(NS, &txn->store);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to begin config transaction: %s", esp_err_to_name(err));
+        free(txn);
+        return err;
+    }
+
+    *out_txn = txn;
+    return ESP_OK;
+}
+
+esp_err_t config_mgr_txn_set_string(config_mgr_txn_t* txn, const char* key, const char* val)
+{
+    if (!txn || !key || !val) {
+        ESP_LOGE(TAG, "Invalid arguments to config_mgr_txn_set_string");
+        if (txn) {
+            txn_track(txn, key, ESP_ERR_INVALID_ARG);
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t val_len = strlen(val);
+    if (val_len > MAX_STRING_LENGTH) {
+        ESP_LOGE(TAG, "String value too long for key '%s' (max %d bytes, got %zu)",
+                 key, MAX_STRING_LENGTH, val_len);
+        return txn_track(txn, key, ESP_ERR_INVALID_SIZE);
+    }
+
+    return txn_track(txn, key, config_store_txn_set_str(txn->store, key, val));
+}
+
+esp_err_t config_mgr_txn_set_u32(config_mgr_txn_t* txn, const char* key, uint32_t val)
+{
+    if (!txn || !key) {
+        ESP_LOGE(TAG, "Invalid arguments to config_mgr_txn_set_u32");
+        if (txn) {
+            txn_track(txn, key, ESP_ERR_INVALID_ARG);
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return txn_track(txn, key, config_store_txn_set_u32(txn->store, key, val));
+}
+
+esp_err_t config_mgr_txn_set_bool(config_mgr_txn_t* txn, const char* key, bool val)
+{
+    return config_mgr_txn_set_u32(txn, key, val ? 1 : 0);
+}
+
+esp_err_t config_mgr_txn_set_blob(config_mgr_txn_t* txn, const char* key, const void* data, size_t data_len)
+{
+    if (!txn || !key || !data || data_len == 0) {
+        ESP_LOGE(TAG, "Invalid arguments to config_mgr_txn_set_blob");
+        if (txn) {
+            txn_track(txn, key, ESP_ERR_INVALID_ARG);
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (data_len > MAX_BLOB_LENGTH) {
+        ESP_LOGE(TAG, "Blob too large for key '%s' (max %d bytes, got %zu)",
+                 key, MAX_BLOB_LENGTH, data_len);
+        return txn_track(txn, key, ESP_ERR_INVALID_SIZE);
+    }
+
+    return txn_track(txn, key, config_store_txn_set_blob(txn->store, key, data, data_len));
+}
+
+esp_err_t config_mgr_txn_commit(config_mgr_txn_t* txn)
+{
+    if (!txn) {
+        ESP_LOGE(TAG, "Invalid arguments to config_mgr_txn_commit");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err;
+    if (txn->err != ESP_OK) {
+        config_store_txn_abort(txn->store);
+        err = txn->err;
+        ESP_LOGW(TAG, "Config transaction discarded: %s", esp_err_to_name(err));
+    } else {
+        err = config_store_txn_commit(txn->store);
+
+        // Even a failed commit may have written some keys, so always invalidate;
+        // the next read of each key refills the cache from NVS
+        if (txn->keys_overflow) {
+            config_mgr_cache_invalidate(NULL);
+        } else {
+            for (int i = 0; i < txn->key_count; i++) {
+                cache_store_marker(CACHE_NS_CFG, txn->keys[i], CACHE_TYPE_STALE);
+            }
+        }
+
+        if (err == ESP_OK) {
+            ESP_LOGI(TAG, "Committed %u config keys", txn->key_count);
+        } else {
+            ESP_LOGE(TAG, "Config transaction commit failed: %s", esp_err_to_name(err));
+        }
+    }
+
+    free(txn);
+    return err;
+}
+
+void config_mgr_txn_abort(config_mgr_txn_t* txn)
+{
+    if (!txn) {
+        return;
+    }
+    config_store_txn_abort(txn->store);
+    free(txn);
+}
@@ -19,6 +19,14 @@ typedef struct {
     char gnss_fw_version[32];       // GNSS firmware version (e.g., "4.14.0")
 } hardware_info_t;
 
+// RAM cache statistics (cfg + factory namespaces)
+typedef struct {
+    uint32_t hits;                  // Reads answered from RAM (including cached "not found")
+    uint32_t misses;                // Reads that fell through to NVS
+    uint32_t entries;               // Values currently held in RAM
+    uint32_t capacity;              // Maximum number of cached keys
+} config_mgr_cache_stats_t;
+
 esp_err_t config_mgr_init(void);
 esp_err_t config_mgr_load_defaults_if_needed(void);
 
@@ -46,6 +54,27 @@ bool config_mgr_is_provisioned(void);
 esp_err_t config_mgr_provision_hardware(const hardware_info_t* hw_info);
 esp_err_t config_mgr_get_hardware_info(hardware_info_t* hw_info);
 
+// Batched writes to the cfg namespace
+// set_* only stage; commit applies everything with a single NVS commit and
+// frees the transaction. Any invalid field poisons the transaction so commit
+// writes nothing and returns the first error. abort discards without writing.
+typedef struct config_mgr_txn config_mgr_txn_t;
+
+esp_err_t config_mgr_txn_begin(config_mgr_txn_t** out_txn);
+esp_err_t config_mgr_txn_set_string(config_mgr_txn_t* txn, const char* key, const char* val);
+esp_err_t config_mgr_txn_set_u32(config_mgr_txn_t* txn, const char* key, uint32_t val);
+esp_err_t config_mgr_txn_set_bool(config_mgr_txn_t* txn, const char* key, bool val);
+esp_err_t config_mgr_txn_set_blob(config_mgr_txn_t* txn, const char* key, const void* data, size_t data_len);
+esp_err_t config_mgr_txn_commit(config_mgr_txn_t* txn);
+void config_mgr_txn_abort(config_mgr_txn_t* txn);
+
+// RAM cache
+// config_mgr_init() loads the cfg and factory namespaces into RAM; getters are
+// served from there and setters write through. Call invalidate only if a key
+// was modified behind config_mgr's back (e.g. raw nvs_* writes). NULL = all.
+void config_mgr_cache_invalidate(const char* key);
+esp_err_t config_mgr_get_cache_stats(config_mgr_cache_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,7 @@
 #include "nvs.h"
 #include "esp_log.h"
 #include <string.h>
+#include <stdlib.h>
 
 static const char *TAG = "config_store";
 
@@ -17,6 +18,32 @@ static const char *TAG = "config_store";
 #define NVS_MAX_NAMESPACE_LEN 15
 #define NVS_MAX_KEY_LEN 15
 
+// Staged write for a transaction (applied in order at commit)
+typedef enum {
+    TXN_OP_STR,
+    TXN_OP_U32,
+    TXN_OP_BLOB,
+    TXN_OP_ERASE
+} txn_op_type_t;
+
+typedef struct txn_op {
+    struct txn_op* next;
+    txn_op_type_t type;
+    char key[NVS_MAX_KEY_LEN + 1];
+    uint32_t u32;
+    size_t len;                 // Payload length (string includes terminator)
+    uint8_t data[];             // String or blob payload
+} txn_op_t;
+
+struct config_store_txn {
+    nvs_handle_t handle;
+    char ns[NVS_MAX_NAMESPACE_LEN + 1];
+    txn_op_t* head;
+    txn_op_t* tail;
+    size_t op_count;
+    esp_err_t err;              // First staging error (sticky)
+};
+
 /**
  * Initialize NVS flash storage
  * Handles the no-free-pages case as per ESP-IDF examples
@@ -460,3 +487,214 @@ esp_err_t config_store_set_if_missing_u32(const char* ns, const char* key, uint3
     // Key doesn't exist, set it
     return config_store_set_u32(ns, key, val);
 }
+
+/**
+ * Begin a write transaction on namespace ns
+ * Opens the NVS handle up front so commit cannot fail on open
+ */
+esp_err_t config_store_txn_begin(const char* ns, config_store_txn_t** out_txn)
+{
+    if (!out_txn) {
+        ESP_LOGE(TAG, "Transaction output pointer is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_txn = NULL;
+
+    // Validate namespace with a placeholder key
+    esp_err_t ret = validate_ns_key(ns, "txn");
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    config_store_txn_t* txn = calloc(1, sizeof(*txn));
+    if (!txn) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    ret = nvs_open(ns, NVS_READWRITE, &txn->handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "nvs_open(%s) failed: %s", ns, esp_err_to_name(ret));
+        free(txn);
+        return ret;
+    }
+
+    strlcpy(txn->ns, ns, sizeof(txn->ns));
+    *out_txn = txn;
+    return ESP_OK;
+}
+
+/**
+ * Append a staged op to the transaction
+ * Records the first failure in txn->err so commit refuses to apply
+ */
+static esp_err_t txn_stage(config_store_txn_t* txn, txn_op_type_t type, const char* key,
+                           uint32_t u32, const void* data, size_t len)
+{
+    if (!txn) {
+        ESP_LOGE(TAG, "Transaction is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = validate_ns_key(txn->ns, key);
+    if (ret == ESP_OK && len > 0 && !data) {
+        ESP_LOGE(TAG, "Value is NULL");
+        ret = ESP_ERR_INVALID_ARG;
+    }
+
+    txn_op_t* op = NULL;
+    if (ret == ESP_OK) {
+        op = malloc(sizeof(*op) + len);
+        if (!op) {
+            ret = ESP_ERR_NO_MEM;
+        }
+    }
+
+    if (ret != ESP_OK) {
+        if (txn->err == ESP_OK) {
+            txn->err = ret;
+        }
+        return ret;
+    }
+
+    op->next = NULL;
+    op->type = type;
+    strlcpy(op->key, key, sizeof(op->key));
+    op->u32 = u32;
+    op->len = len;
+    if (len > 0) {
+        memcpy(op->data, data, len);
+    }
+
+    if (txn->tail) {
+        txn->tail->next = op;
+    } else {
+        txn->head = op;
+    }
+    txn->tail = op;
+    txn->op_count++;
+    return ESP_OK;
+}
+
+esp_err_t config_store_txn_set_str(config_store_txn_t* txn, const char* key, const char* val)
+{
+    if (!val) {
+        ESP_LOGE(TAG, "Value is NULL");
+        if (txn && txn->err == ESP_OK) {
+            txn->err = ESP_ERR_INVALID_ARG;
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
+    return txn_stage(txn, TXN_OP_STR, key, 0, val, strlen(val) + 1);
+}
+
+esp_err_t config_store_txn_set_u32(config_store_txn_t* txn, const char* key, uint32_t val)
+{
+    return txn_stage(txn, TXN_OP_U32, key, val, NULL, 0);
+}
+
+esp_err_t config_store_txn_set_blob(config_store_txn_t* txn, const char* key, const void* data, size_t data_len)
+{
+    if (!data) {
+        ESP_LOGE(TAG, "Data pointer is NULL");
+        if (txn && txn->err == ESP_OK) {
+            txn->err = ESP_ERR_INVALID_ARG;
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
+    return txn_stage(txn, TXN_OP_BLOB, key, 0, data, data_len);
+}
+
+esp_err_t config_store_txn_erase_key(config_store_txn_t* txn, const char* key)
+{
+    return txn_stage(txn, TXN_OP_ERASE, key, 0, NULL, 0);
+}
+
+static void txn_free(config_store_txn_t* txn)
+{
+    txn_op_t* op = txn->head;
+    while (op) {
+        txn_op_t* next = op->next;
+        free(op);
+        op = next;
+    }
+    nvs_close(txn->handle);
+    free(txn);
+}
+
+/**
+ * Apply all staged writes with a single nvs_commit()
+ * The transaction is freed whether or not commit succeeds
+ */
+esp_err_t config_store_txn_commit(config_store_txn_t* txn)
+{
+    if (!txn) {
+        ESP_LOGE(TAG, "Transaction is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (txn->err != ESP_OK) {
+        ESP_LOGE(TAG, "Transaction on '%s' not applied, staging failed: %s",
+                 txn->ns, esp_err_to_name(txn->err));
+        esp_err_t err = txn->err;
+        txn_free(txn);
+        return err;
+    }
+
+    esp_err_t ret = ESP_OK;
+    size_t applied = 0;
+    for (txn_op_t* op = txn->head; op && ret == ESP_OK; op = op->next) {
+        switch (op->type) {
+            case TXN_OP_STR:
+                ret = nvs_set_str(txn->handle, op->key, (const char*)op->data);
+                break;
+            case TXN_OP_U32:
+                ret = nvs_set_u32(txn->handle, op->key, op->u32);
+                break;
+            case TXN_OP_BLOB:
+                ret = nvs_set_blob(txn->handle, op->key, op->data, op->len);
+                break;
+            case TXN_OP_ERASE:
+                ret = nvs_erase_key(txn->handle, op->key);
+                if (ret == ESP_ERR_NVS_NOT_FOUND) {
+                    ret = ESP_OK;
+                }
+                break;
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Transaction write '%s/%s' failed: %s", txn->ns, op->key, esp_err_to_name(ret));
+        } else {
+            applied++;
+        }
+    }
+
+    // Commit whatever was written so NVS state matches what we report
+    esp_err_t commit_ret = nvs_commit(txn->handle);
+    if (commit_ret != ESP_OK) {
+        ESP_LOGE(TAG, "nvs_commit(%s) failed: %s", txn->ns, esp_err_to_name(commit_ret));
+        if (ret == ESP_OK) {
+            ret = commit_ret;
+        }
+    }
+
+    if (ret == ESP_OK) {
+        ESP_LOGD(TAG, "Committed %zu writes to '%s'", applied, txn->ns);
+    } else {
+        ESP_LOGW(TAG, "Transaction on '%s' partially applied (%zu/%zu writes)",
+                 txn->ns, applied, txn->op_count);
+    }
+
+    txn_free(txn);
+    return ret;
+}
+
+/**
+ * Discard a transaction without writing anything
+ */
+void config_store_txn_abort(config_store_txn_t* txn)
+{
+    if (!txn) {
+        return;
+    }
+    ESP_LOGD(TAG, "Aborted transaction on '%s' (%zu staged writes)", txn->ns, txn->op_count);
+    txn_free(txn);
+}
@@ -32,6 +32,25 @@ esp_err_t config_store_erase_key(const char* ns, const char* key);
 esp_err_t config_store_set_if_missing_str(const char* ns, const char* key, const char* val);
 esp_err_t config_store_set_if_missing_u32(const char* ns, const char* key, uint32_t val);
 
+/**
+ * Write transaction against a single namespace.
+ *
+ * txn_set_* / txn_erase_key only stage the change in RAM. txn_commit() applies
+ * every staged write through one NVS handle followed by a single nvs_commit(),
+ * then frees the transaction. txn_abort() discards staged writes without
+ * touching flash. A staging error is sticky: commit refuses to apply and
+ * returns the first error, so a rejected field never leaves a partial update.
+ */
+typedef struct config_store_txn config_store_txn_t;
+
+esp_err_t config_store_txn_begin(const char* ns, config_store_txn_t** out_txn);
+esp_err_t config_store_txn_set_str(config_store_txn_t* txn, const char* key, const char* val);
+esp_err_t config_store_txn_set_u32(config_store_txn_t* txn, const char* key, uint32_t val);
+esp_err_t config_store_txn_set_blob(config_store_txn_t* txn, const char* key, const void* data, size_t data_len);
+esp_err_t config_store_txn_erase_key(config_store_txn_t* txn, const char* key);
+esp_err_t config_store_txn_commit(config_store_txn_t* txn);
+void config_store_txn_abort(config_store_txn_t* txn);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,7 @@
 // Test namespace and keys
 #define TEST_NS "test_ns"
 #define TEST_KEY "test_key"
+#define TEST_KEY2 "test_key2"
 
 void setUp(void)
 {
@@ -19,6 +20,7 @@ void tearDown(void)
 {
     // Clean up test data after each test
     config_store_erase_key(TEST_NS, TEST_KEY);
+    config_store_erase_key(TEST_NS, TEST_KEY2);
 }
 
 TEST_CASE("config_store_init_succeeds", "[config_store]")
@@ -271,3 +273,56 @@ TEST_CASE("config_store_null_termination", "[config_store]")
     TEST_ASSERT_EQUAL_STRING(test_val, read_buf);
     TEST_ASSERT_EQUAL(0, read_buf[strlen(test_val)]);
 }
+
+TEST_CASE("config_store_txn_commit_applies_all", "[config_store]")
+{
+    config_store_txn_t* txn = NULL;
+    char read_buf[32];
+    uint32_t read_val = 0;
+
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_begin(TEST_NS, &txn));
+    TEST_ASSERT_NOT_NULL(txn);
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_set_str(txn, TEST_KEY, "batch"));
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_set_u32(txn, TEST_KEY2, 42));
+
+    // Nothing is visible before commit
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, config_store_get_str(TEST_NS, TEST_KEY, read_buf, sizeof(read_buf)));
+
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_commit(txn));
+
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_get_str(TEST_NS, TEST_KEY, read_buf, sizeof(read_buf)));
+    TEST_ASSERT_EQUAL_STRING("batch", read_buf);
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_get_u32(TEST_NS, TEST_KEY2, &read_val));
+    TEST_ASSERT_EQUAL(42, read_val);
+}
+
+TEST_CASE("config_store_txn_abort_discards", "[config_store]")
+{
+    config_store_txn_t* txn = NULL;
+    uint32_t read_val = 0;
+
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_set_u32(TEST_NS, TEST_KEY2, 1));
+
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_begin(TEST_NS, &txn));
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_set_u32(txn, TEST_KEY2, 2));
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_erase_key(txn, TEST_KEY2));
+    config_store_txn_abort(txn);
+
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_get_u32(TEST_NS, TEST_KEY2, &read_val));
+    TEST_ASSERT_EQUAL(1, read_val);
+}
+
+TEST_CASE("config_store_txn_staging_error_is_sticky", "[config_store]")
+{
+    config_store_txn_t* txn = NULL;
+    char read_buf[32];
+
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_begin(TEST_NS, &txn));
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_txn_set_str(txn, TEST_KEY, "value"));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG,
+                      config_store_txn_set_u32(txn, "this_key_is_way_too_long_for_nvs", 1));
+
+    // Commit must refuse to apply the valid write staged before the error
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, config_store_txn_commit(txn));
+    TEST_ASSERT_EQUAL(ESP_ERR_NVS_NOT_FOUND, config_store_get_str(TEST_NS, TEST_KEY, read_buf, sizeof(read_buf)));
+}
@@ -1,9 +1,20 @@
 #include "diag.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "version.h"
+#include "event_bus.h"
 
 void diag_get_fw_version(char* out, size_t len) {
     const char* v = version_get_string();
@@ -28,3 +39,743 @@ void diag_log_last_error(esp_err_t err, const char* scope) {
                  scope ? scope : "?", esp_err_to_name(err), err);
     }
 }
+
+void diag_log_event_bus_stats(void) {
+    for (int i = 0; i < EVENT_BUS_LOOP_COUNT; i++) {
+        event_bus_loop_stats_t ls;
+        if (event_bus_get_loop_stats((event_bus_loop_id_t)i, &ls) == ESP_OK) {
+            ESP_LOGI("diag", "loop %s: posted %" PRIu32 " dropped %" PRIu32,
+                     ls.name, ls.posted, ls.dropped);
+        }
+    }
+
+    for (int id = 0; id < DEVICE_EVENT_COUNT; id++) {
+        event_bus_event_stats_t st;
+        if (event_bus_get_event_stats(id, &st) != ESP_OK || (st.posted == 0 && st.dropped == 0)) {
+            continue;
+        }
+
+        uint32_t wait_avg = st.queue_wait.count ? (uint32_t)(st.queue_wait.total_us / st.queue_wait.count) : 0;
+        uint32_t hnd_avg = st.handler.count ? (uint32_t)(st.handler.total_us / st.handler.count) : 0;
+        ESP_LOGI("diag", "%-18s posted %" PRIu32 " dropped %" PRIu32
+                 " | wait us %" PRIu32 "/%" PRIu32 "/%" PRIu32
+                 " | handler us %" PRIu32 "/%" PRIu32 "/%" PRIu32 " slowest %p",
+                 event_bus_event_name(id), st.posted, st.dropped,
+                 st.queue_wait.min_us, wait_avg, st.queue_wait.max_us,
+                 st.handler.min_us, hnd_avg, st.handler.max_us,
+                 (void*)st.slowest_handler);
+    }
+}
+
+/*
+ * Log ring
+ *
+ * Slot for seq n is n % capacity. The hook formats on the caller's stack,
+ * then copies into the slot under a spinlock held only for the memcpy, so
+ * logging never allocates or waits on a mutex.
+ */
+typedef struct {
+    uint32_t seq;               // 0 = never written
+    uint8_t level;
+    uint16_t len;
+    char text[CONFIG_DIAG_LOG_LINE_MAX];
+} log_slot_t;
+
+static log_slot_t* s_log_slots = NULL;
+static uint32_t s_log_next_seq = 1;
+static uint32_t s_log_truncated = 0;
+static bool s_log_in_psram = false;
+static vprintf_like_t s_prev_vprintf = NULL;
+static portMUX_TYPE s_log_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static esp_log_level_t level_from_char(char c)
+{
+    switch (c) {
+        case 'E': return ESP_LOG_ERROR;
+        case 'W': return ESP_LOG_WARN;
+        case 'I': return ESP_LOG_INFO;
+        case 'D': return ESP_LOG_DEBUG;
+        case 'V': return ESP_LOG_VERBOSE;
+        default: return ESP_LOG_NONE;
+    }
+}
+
+static void log_ring_append(const char* line, int len)
+{
+    // Skip a leading colour escape ("\033[0;32m")
+    if (len > 0 && line[0] == '\033') {
+        const char* m = memchr(line, 'm', len);
+        if (m) {
+            len -= (int)(m + 1 - line);
+            line = m + 1;
+        }
+    }
+
+    // Drop trailing newline and colour reset
+    while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+        len--;
+    }
+    if (len >= 4 && memcmp(&line[len - 4], "\033[0m", 4) == 0) {
+        len -= 4;
+    }
+    if (len <= 0) {
+        return;
+    }
+
+    esp_log_level_t level = level_from_char(line[0]);
+
+    portENTER_CRITICAL_SAFE(&s_log_lock);
+    log_slot_t* slot = &s_log_slots[s_log_next_seq % CONFIG_DIAG_LOG_RING_LINES];
+    slot->seq = s_log_next_seq++;
+    slot->level = (uint8_t)level;
+    slot->len = (uint16_t)len;
+    memcpy(slot->text, line, len);
+    slot->text[len] = '\0';
+    portEXIT_CRITICAL_SAFE(&s_log_lock);
+}
+
+static int log_ring_vprintf(const char* fmt, va_list args)
+{
+    char line[CONFIG_DIAG_LOG_LINE_MAX];
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(line, sizeof(line), fmt, copy);
+    va_end(copy);
+
+    if (len > 0) {
+        if (len >= (int)sizeof(line)) {
+            len = sizeof(line) - 1;
+            s_log_truncated++;
+        }
+        log_ring_append(line, len);
+    }
+
+    return s_prev_vprintf ? s_prev_vprintf(fmt, args) : vprintf(fmt, args);
+}
+
+esp_err_t diag_log_ring_init(void) {
+    if (s_log_slots) {
+        return ESP_OK;
+    }
+
+    size_t bytes = (size_t)CONFIG_DIAG_LOG_RING_LINES * sizeof(log_slot_t);
+#if CONFIG_DIAG_LOG_RING_PSRAM
+    s_log_slots = diag_mem_calloc(DIAG_MEM_LOG, 1, bytes);     // PSRAM first, internal fallback
+#else
+    s_log_slots = diag_mem_calloc(DIAG_MEM_GENERAL, 1, bytes);
+#endif
+    s_log_in_psram = diag_mem_in_psram(s_log_slots);
+    if (!s_log_slots) {
+        ESP_LOGE("diag", "Failed to allocate %u byte log ring", (unsigned)bytes);
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_prev_vprintf = esp_log_set_vprintf(&log_ring_vprintf);
+    ESP_LOGI("diag", "Log ring: %d lines x %d bytes (%s)", CONFIG_DIAG_LOG_RING_LINES,
+             CONFIG_DIAG_LOG_LINE_MAX, s_log_in_psram ? "PSRAM" : "internal");
+    return ESP_OK;
+}
+
+bool diag_log_ring_read(uint32_t* cursor, esp_log_level_t max_level, diag_log_line_t* out) {
+    if (!s_log_slots || !cursor || !out) {
+        return false;
+    }
+
+    for (;;) {
+        bool found = false;
+        bool keep = false;
+
+        portENTER_CRITICAL(&s_log_lock);
+        uint32_t next = s_log_next_seq;
+        uint32_t oldest = next > CONFIG_DIAG_LOG_RING_LINES ? next - CONFIG_DIAG_LOG_RING_LINES : 1;
+        uint32_t seq = *cursor + 1;
+        if (seq < oldest) {
+            seq = oldest;
+        }
+        if (seq < next) {
+            const log_slot_t* slot = &s_log_slots[seq % CONFIG_DIAG_LOG_RING_LINES];
+            found = true;
+            keep = (esp_log_level_t)slot->level <= max_level;
+            if (keep) {
+                out->seq = slot->seq;
+                out->level = (esp_log_level_t)slot->level;
+                out->len = slot->len;
+                memcpy(out->text, slot->text, slot->len + 1);
+            }
+        }
+        portEXIT_CRITICAL(&s_log_lock);
+
+        if (!found) {
+            return false;
+        }
+        *cursor = seq;
+        if (keep) {
+            return true;
+        }
+    }
+}
+
+esp_err_t diag_log_ring_get_info(diag_log_ring_info_t* info) {
+    if (!info) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_log_slots) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    portENTER_CRITICAL(&s_log_lock);
+    uint32_t next = s_log_next_seq;
+    portEXIT_CRITICAL(&s_log_lock);
+
+    info->capacity = CONFIG_DIAG_LOG_RING_LINES;
+    info->next_seq = next;
+    info->first_seq = next == 1 ? 0 : (next > CONFIG_DIAG_LOG_RING_LINES ? next - CONFIG_DIAG_LOG_RING_LINES : 1);
+    info->truncated = s_log_truncated;
+    info->in_psram = s_log_in_psram;
+    return ESP_OK;
+}
+
+static esp_err_t profiler_write_metrics(diag_metrics_sink_t sink, void* ctx);
+
+/*
+ * Metrics registry
+ *
+ * Slots are claimed once under s_metrics_lock; after that a slot is never
+ * freed, so readers and updaters touch it without locking.
+ */
+#define METRIC_NAME_MAX 64
+
+struct diag_metric {
+    char name[METRIC_NAME_MAX];
+    const char* help;
+    diag_metric_type_t type;
+    _Atomic int32_t value;          // Counter / gauge
+    diag_metric_fn_t fn;
+    void* fn_ctx;
+    const uint32_t* bounds;
+    uint8_t bound_count;
+    _Atomic uint32_t buckets[DIAG_HISTOGRAM_MAX_BUCKETS + 1];  // Last one is +Inf
+    _Atomic uint64_t sum;
+};
+
+static diag_metric_t s_metrics[CONFIG_DIAG_METRICS_MAX];
+static _Atomic uint32_t s_metric_count = 0;
+static portMUX_TYPE s_metrics_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Renderers for families with run-time labels; published like slots
+#define METRIC_WRITERS_MAX 4
+static diag_metrics_writer_t s_metric_writers[METRIC_WRITERS_MAX];
+static _Atomic uint32_t s_metric_writer_count = 0;
+
+// Type-specific fields, set on a new slot before it is published
+typedef struct {
+    diag_metric_fn_t fn;
+    void* fn_ctx;
+    const uint32_t* bounds;
+    uint8_t bound_count;
+} metric_init_t;
+
+static diag_metric_t* metric_register(const char* name, const char* help, diag_metric_type_t type,
+                                      const metric_init_t* init)
+{
+    if (!name || strlen(name) >= METRIC_NAME_MAX) {
+        return NULL;
+    }
+
+    diag_metric_t* m = NULL;
+    bool full = false;
+    bool existing = false;
+    portENTER_CRITICAL(&s_metrics_lock);
+    uint32_t count = atomic_load(&s_metric_count);
+    for (uint32_t i = 0; i < count; i++) {
+        if (strcmp(s_metrics[i].name, name) == 0) {
+            m = &s_metrics[i];
+            existing = true;
+            break;
+        }
+    }
+    if (!m && count < CONFIG_DIAG_METRICS_MAX) {
+        m = &s_metrics[count];
+        strlcpy(m->name, name, sizeof(m->name));
+        m->help = help;
+        m->type = type;
+        m->fn = init->fn;
+        m->fn_ctx = init->fn_ctx;
+        m->bounds = init->bounds;
+        m->bound_count = init->bound_count;
+        // Publish only after the slot is filled in; the seq_cst store
+        // orders every field above before the count diag_metrics_write loads
+        atomic_store(&s_metric_count, count + 1);
+    } else if (!m) {
+        full = true;
+    }
+    portEXIT_CRITICAL(&s_metrics_lock);
+
+    if (full) {
+        ESP_LOGW("diag", "Metrics registry full, %s not registered", name);
+        return NULL;
+    }
+    if (m->type != type) {
+        ESP_LOGW("diag", "Metric %s already registered with another type", name);
+        return NULL;
+    }
+    if (existing && init->fn) {
+        // Rebind a callback metric registered again (context first, the
+        // reader only looks at fn_ctx through a non-NULL fn)
+        m->fn_ctx = init->fn_ctx;
+        m->fn = init->fn;
+    }
+    return m;
+}
+
+static const metric_init_t s_no_init = {0};
+
+esp_err_t diag_metrics_add_writer(diag_metrics_writer_t fn) {
+    if (!fn) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    portENTER_CRITICAL(&s_metrics_lock);
+    uint32_t count = atomic_load(&s_metric_writer_count);
+    bool found = false;
+    for (uint32_t i = 0; i < count; i++) {
+        found |= s_metric_writers[i] == fn;
+    }
+    if (!found) {
+        if (count < METRIC_WRITERS_MAX) {
+            s_metric_writers[count] = fn;
+            atomic_store(&s_metric_writer_count, count + 1);
+        } else {
+            ret = ESP_ERR_NO_MEM;
+        }
+    }
+    portEXIT_CRITICAL(&s_metrics_lock);
+
+    if (ret != ESP_OK) {
+        ESP_LOGW("diag", "Metrics writers full");
+    }
+    return ret;
+}
+
+diag_metric_t* diag_metric_counter(const char* name, const char* help) {
+    return metric_register(name, help, DIAG_METRIC_COUNTER, &s_no_init);
+}
+
+diag_metric_t* diag_metric_gauge(const char* name, const char* help) {
+    return metric_register(name, help, DIAG_METRIC_GAUGE, &s_no_init);
+}
+
+diag_metric_t* diag_metric_counter_fn(const char* name, const char* help, diag_metric_fn_t fn, void* ctx) {
+    metric_init_t init = { .fn = fn, .fn_ctx = ctx };
+    return metric_register(name, help, DIAG_METRIC_COUNTER, &init);
+}
+
+diag_metric_t* diag_metric_gauge_fn(const char* name, const char* help, diag_metric_fn_t fn, void* ctx) {
+    metric_init_t init = { .fn = fn, .fn_ctx = ctx };
+    return metric_register(name, help, DIAG_METRIC_GAUGE, &init);
+}
+
+diag_metric_t* diag_metric_histogram(const char* name, const char* help,
+                                     const uint32_t* bounds, size_t bound_count) {
+    if (!bounds || bound_count == 0 || bound_count > DIAG_HISTOGRAM_MAX_BUCKETS) {
+        return NULL;
+    }
+
+    // A name registered again keeps the bounds it was first given
+    metric_init_t init = { .bounds = bounds, .bound_count = (uint8_t)bound_count };
+    return metric_register(name, help, DIAG_METRIC_HISTOGRAM, &init);
+}
+
+void IRAM_ATTR diag_metric_inc(diag_metric_t* m) {
+    if (m) {
+        atomic_fetch_add_explicit(&m->value, 1, memory_order_relaxed);
+    }
+}
+
+void IRAM_ATTR diag_metric_add(diag_metric_t* m, uint32_t n) {
+    if (m) {
+        atomic_fetch_add_explicit(&m->value, (int32_t)n, memory_order_relaxed);
+    }
+}
+
+void IRAM_ATTR diag_metric_set(diag_metric_t* m, int32_t value) {
+    if (m) {
+        atomic_store_explicit(&m->value, value, memory_order_relaxed);
+    }
+}
+
+void diag_metric_observe(diag_metric_t* m, uint32_t value) {
+    if (!m || !m->bounds) {
+        return;
+    }
+
+    size_t i = 0;
+    while (i < m->bound_count && value > m->bounds[i]) {
+        i++;
+    }
+    atomic_fetch_add_explicit(&m->buckets[i], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&m->sum, value, memory_order_relaxed);
+}
+
+static size_t metric_base_len(const char* name)
+{
+    const char* brace = strchr(name, '{');
+    return brace ? (size_t)(brace - name) : strlen(name);
+}
+
+/**
+ * Emit name + suffix with an extra label merged into any existing label set
+ */
+static int format_sample(char* out, size_t cap, const char* name, const char* suffix,
+                         const char* extra_label)
+{
+    size_t base = metric_base_len(name);
+    const char* labels = name + base;   // "" or "{...}"
+    if (!extra_label) {
+        return snprintf(out, cap, "%.*s%s%s", (int)base, name, suffix, labels);
+    }
+    if (labels[0] == '{') {
+        // "{a=\"b\"}" -> "{a=\"b\",le=\"..\"}"
+        return snprintf(out, cap, "%.*s%s%.*s,%s}", (int)base, name, suffix,
+                        (int)(strlen(labels) - 1), labels, extra_label);
+    }
+    return snprintf(out, cap, "%.*s%s{%s}", (int)base, name, suffix, extra_label);
+}
+
+static esp_err_t emit_line(diag_metrics_sink_t sink, void* ctx, const char* line, int len, size_t cap)
+{
+    if (len <= 0) {
+        return ESP_OK;
+    }
+    if ((size_t)len >= cap) {
+        len = (int)cap - 1;     // snprintf truncated; keep what fits
+    }
+    return sink(line, (size_t)len, ctx);
+}
+
+esp_err_t diag_metrics_write(diag_metrics_sink_t sink, void* ctx) {
+    if (!sink) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char line[160];
+    char sample[112];
+    char le[24];
+    uint32_t count = atomic_load(&s_metric_count);
+    esp_err_t ret;
+    int len;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const diag_metric_t* m = &s_metrics[i];
+        size_t base = metric_base_len(m->name);
+
+        // HELP/TYPE once per family (consecutive metrics with the same base name)
+        bool new_family = (i == 0) || base != metric_base_len(s_metrics[i - 1].name) ||
+                          strncmp(m->name, s_metrics[i - 1].name, base) != 0;
+        if (new_family) {
+            static const char* const type_names[] = { "counter", "gauge", "histogram" };
+            if (m->help) {
+                len = snprintf(line, sizeof(line), "# HELP %.*s %s\n", (int)base, m->name, m->help);
+                if ((ret = emit_line(sink, ctx, line, len, sizeof(line))) != ESP_OK) {
+                    return ret;
+                }
+            }
+            len = snprintf(line, sizeof(line), "# TYPE %.*s %s\n", (int)base, m->name, type_names[m->type]);
+            if ((ret = emit_line(sink, ctx, line, len, sizeof(line))) != ESP_OK) {
+                return ret;
+            }
+        }
+
+        if (m->type != DIAG_METRIC_HISTOGRAM) {
+            int64_t v = m->fn ? m->fn(m->fn_ctx) : atomic_load_explicit(&m->value, memory_order_relaxed);
+            if (m->type == DIAG_METRIC_COUNTER && !m->fn) {
+                v = (uint32_t)v;    // Counters wrap as unsigned
+            }
+            format_sample(sample, sizeof(sample), m->name, "", NULL);
+            len = snprintf(line, sizeof(line), "%s %lld\n", sample, (long long)v);
+            if ((ret = emit_line(sink, ctx, line, len, sizeof(line))) != ESP_OK) {
+                return ret;
+            }
+            continue;
+        }
+
+        // Buckets are cumulative in the exposition format
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b <= m->bound_count; b++) {
+            cumulative += atomic_load_explicit(&m->buckets[b], memory_order_relaxed);
+            if (b < m->bound_count) {
+                snprintf(le, sizeof(le), "le=\"%lu\"", (unsigned long)m->bounds[b]);
+            } else {
+                strlcpy(le, "le=\"+Inf\"", sizeof(le));
+            }
+            format_sample(sample, sizeof(sample), m->name, "_bucket", le);
+            len = snprintf(line, sizeof(line), "%s %llu\n", sample, (unsigned long long)cumulative);
+            if ((ret = emit_line(sink, ctx, line, len, sizeof(line))) != ESP_OK) {
+                return ret;
+            }
+        }
+
+        format_sample(sample, sizeof(sample), m->name, "_sum", NULL);
+        len = snprintf(line, sizeof(line), "%s %llu\n", sample,
+                       (unsigned long long)atomic_load_explicit(&m->sum, memory_order_relaxed));
+        if ((ret = emit_line(sink, ctx, line, len, sizeof(line))) != ESP_OK) {
+            return ret;
+        }
+        format_sample(sample, sizeof(sample), m->name, "_count", NULL);
+        len = snprintf(line, sizeof(line), "%s %llu\n", sample, (unsigned long long)cumulative);
+        if ((ret = emit_line(sink, ctx, line, len, sizeof(line))) != ESP_OK) {
+            return ret;
+        }
+    }
+
+    if ((ret = profiler_write_metrics(sink, ctx)) != ESP_OK) {
+        return ret;
+    }
+    uint32_t writers = atomic_load(&s_metric_writer_count);
+    for (uint32_t i = 0; i < writers; i++) {
+        if ((ret = s_metric_writers[i](sink, ctx)) != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+/*
+ * Profiler
+ *
+ * Runs from an esp_timer callback: uxTaskGetSystemState and
+ * heap_caps_get_info only walk lists, so a sample is quick and never
+ * blocks. Results are published into s_profile/s_task_samples under
+ * s_profile_lock for readers.
+ */
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+#define PROFILER_TASK_STATS 1
+#else
+#define PROFILER_TASK_STATS 0
+#endif
+
+static esp_timer_handle_t s_profiler_timer = NULL;
+static diag_profile_t s_profile;
+static diag_task_sample_t s_task_samples[CONFIG_DIAG_PROFILER_MAX_TASKS];
+static portMUX_TYPE s_profile_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if PROFILER_TASK_STATS
+static TaskStatus_t s_task_status[CONFIG_DIAG_PROFILER_MAX_TASKS];
+static struct {
+    TaskHandle_t handle;
+    configRUN_TIME_COUNTER_TYPE runtime;
+} s_prev_runtime[CONFIG_DIAG_PROFILER_MAX_TASKS];
+static uint32_t s_prev_count = 0;
+static configRUN_TIME_COUNTER_TYPE s_prev_total = 0;
+#endif
+
+static void sample_heap(uint32_t caps, diag_heap_sample_t* out)
+{
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, caps);
+    out->total = (uint32_t)heap_caps_get_total_size(caps);
+    out->free = (uint32_t)info.total_free_bytes;
+    out->largest_free_block = (uint32_t)info.largest_free_block;
+    out->min_free_ever = (uint32_t)info.minimum_free_bytes;
+}
+
+#if PROFILER_TASK_STATS
+static configRUN_TIME_COUNTER_TYPE prev_runtime_for(TaskHandle_t handle)
+{
+    for (uint32_t i = 0; i < s_prev_count; i++) {
+        if (s_prev_runtime[i].handle == handle) {
+            return s_prev_runtime[i].runtime;
+        }
+    }
+    return 0;   // New task: its whole run time falls in this interval
+}
+
+/**
+ * Sample task states into samples[], returns number of tasks
+ */
+static uint32_t sample_tasks(diag_task_sample_t* samples)
+{
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t n = uxTaskGetSystemState(s_task_status, CONFIG_DIAG_PROFILER_MAX_TASKS, &total);
+    if (n == 0) {
+        return 0;   // More tasks than CONFIG_DIAG_PROFILER_MAX_TASKS
+    }
+
+    // Counters wrap; unsigned deltas stay correct across one wrap
+    configRUN_TIME_COUNTER_TYPE window = (total - s_prev_total) * portNUM_PROCESSORS;
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        const TaskStatus_t* t = &s_task_status[i];
+        diag_task_sample_t* out = &samples[i];
+        configRUN_TIME_COUNTER_TYPE delta = t->ulRunTimeCounter - prev_runtime_for(t->xHandle);
+
+        strlcpy(out->name, t->pcTaskName, sizeof(out->name));
+        out->cpu_permille = window ? (uint16_t)(((uint64_t)delta * 1000ULL) / window) : 0;
+        if (out->cpu_permille > 1000) {
+            out->cpu_permille = 1000;
+        }
+        out->stack_hwm = (uint32_t)t->usStackHighWaterMark;
+#if CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID
+        out->core = (t->xCoreID == tskNO_AFFINITY) ? -1 : (int8_t)t->xCoreID;
+#else
+        out->core = -1;
+#endif
+        out->priority = (uint8_t)t->uxCurrentPriority;
+    }
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        s_prev_runtime[i].handle = s_task_status[i].xHandle;
+        s_prev_runtime[i].runtime = s_task_status[i].ulRunTimeCounter;
+    }
+    s_prev_count = n;
+    s_prev_total = total;
+    return n;
+}
+#endif
+
+static void profiler_timer_cb(void* arg)
+{
+    (void)arg;
+    diag_profile_t p = {0};
+    static diag_task_sample_t samples[CONFIG_DIAG_PROFILER_MAX_TASKS];
+
+    sample_heap(MALLOC_CAP_INTERNAL, &p.internal);
+#if CONFIG_SPIRAM
+    sample_heap(MALLOC_CAP_SPIRAM, &p.psram);
+#endif
+#if PROFILER_TASK_STATS
+    p.task_count = sample_tasks(samples);
+#endif
+    p.sampled_at_us = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_profile_lock);
+    s_profile = p;
+    memcpy(s_task_samples, samples, p.task_count * sizeof(samples[0]));
+    portEXIT_CRITICAL(&s_profile_lock);
+}
+
+esp_err_t diag_profiler_start(uint32_t interval_ms) {
+    if (!s_profiler_timer) {
+        const esp_timer_create_args_t args = {
+            .callback = profiler_timer_cb,
+            .name = "diag_prof",
+        };
+        esp_err_t ret = esp_timer_create(&args, &s_profiler_timer);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    esp_timer_stop(s_profiler_timer);
+    if (interval_ms == 0) {
+        return ESP_OK;
+    }
+
+    // First sample now so /status has data before the first interval ends
+    profiler_timer_cb(NULL);
+    esp_err_t ret = esp_timer_start_periodic(s_profiler_timer, (uint64_t)interval_ms * 1000ULL);
+    if (ret == ESP_OK) {
+        ESP_LOGI("diag", "Profiler sampling every %lu ms%s", (unsigned long)interval_ms,
+                 PROFILER_TASK_STATS ? "" : " (heap only, FreeRTOS run time stats disabled)");
+    }
+    return ret;
+}
+
+esp_err_t diag_profiler_get(diag_profile_t* out) {
+    if (!out) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_profile_lock);
+    *out = s_profile;
+    portEXIT_CRITICAL(&s_profile_lock);
+    return out->sampled_at_us ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t diag_profiler_get_tasks(diag_task_sample_t* out, size_t max, size_t* count) {
+    if (!out || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_profile_lock);
+    size_t n = s_profile.task_count < max ? s_profile.task_count : max;
+    memcpy(out, s_task_samples, n * sizeof(out[0]));
+    portEXIT_CRITICAL(&s_profile_lock);
+
+    *count = n;
+    return ESP_OK;
+}
+
+/**
+ * Profiler results as gauges; task metrics carry a task label, so they are
+ * rendered here rather than taking one registry slot per task
+ */
+static esp_err_t profiler_write_metrics(diag_metrics_sink_t sink, void* ctx)
+{
+    diag_profile_t p;
+    if (diag_profiler_get(&p) != ESP_OK) {
+        return ESP_OK;
+    }
+
+    static const char* const families[] = {
+        "diag_heap_total_bytes", "diag_heap_free_bytes",
+        "diag_heap_largest_free_block_bytes", "diag_heap_min_free_bytes",
+    };
+    const diag_heap_sample_t* heaps[] = { &p.internal, &p.psram };
+    const char* const caps[] = { "internal", "psram" };
+    char line[128];
+    esp_err_t ret;
+    int len;
+
+    // Rows are grouped per family, as the exposition format requires
+    for (size_t f = 0; f < sizeof(families) / sizeof(families[0]); f++) {
+        len = snprintf(line, sizeof(line), "# TYPE %s gauge\n", families[f]);
+        if ((ret = emit_line(sink, ctx, line, len, sizeof(line))) != ESP_OK) {
+            return ret;
+        }
+        for (size_t c = 0; c < sizeof(heaps) / sizeof(heaps[0]); c++) {
+            const diag_heap_sample_t* h = heaps[c];
+            if (h->total == 0) {
+                continue;
+            }
+            const uint32_t values[] = { h->total, h->free, h->largest_free_block, h->min_free_ever };
+            len = snprintf(line, sizeof(line), "%s{caps=\"%s\"} %lu\n", families[f], caps[c],
+                           (unsigned long)values[f]);
+            if ((ret = emit_line(sink, ctx, line, len, sizeof(line))) != ESP_OK) {
+                return ret;
+            }
+        }
+    }
+
+    if (p.task_count == 0) {
+        return ESP_OK;
+    }
+
+    diag_task_sample_t* tasks = malloc(sizeof(diag_task_sample_t) * CONFIG_DIAG_PROFILER_MAX_TASKS);
+    if (!tasks) {
+        return ESP_ERR_NO_MEM;
+    }
+    size_t n = 0;
+    diag_profiler_get_tasks(tasks, CONFIG_DIAG_PROFILER_MAX_TASKS, &n);
+
+    ret = ESP_OK;
+    for (int family = 0; family < 2 && ret == ESP_OK; family++) {
+        const char* name = family == 0 ? "diag_task_cpu_percent" : "diag_task_stack_hwm_bytes";
+        len = snprintf(line, sizeof(line), "# TYPE %s gauge\n", name);
+        ret = emit_line(sink, ctx, line, len, sizeof(line));
+        for (size_t i = 0; i < n && ret == ESP_OK; i++) {
+            if (family == 0) {
+                len = snprintf(line, sizeof(line), "%s{task=\"%s\",core=\"%d\"} %u.%u\n", name,
+                               tasks[i].name, tasks[i].core, tasks[i].cpu_permille / 10,
+                               tasks[i].cpu_permille % 10);
+            } else {
+                len = snprintf(line, sizeof(line), "%s{task=\"%s\",core=\"%d\"} %lu\n", name,
+                               tasks[i].name, tasks[i].core, (unsigned long)tasks[i].stack_hwm);
+            }
+            ret = emit_line(sink, ctx, line, len, sizeof(line));
+        }
+    }
+    free(tasks);
+    return ret;
+}
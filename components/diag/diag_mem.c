@@ -0,0 +1,286 @@
+#include "diag.h"
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "cJSON.h"
+
+/*
+ * Memory policy (see diag.h)
+ *
+ * Every block gets a small header with its requested size, purpose and
+ * region, so diag_mem_free() can charge it back without a lookup table.
+ * The cJSON hooks are the exception (see cjson_malloc).
+ * Usage counters are updated under s_mem_lock; metrics read them with
+ * plain 32-bit loads.
+ */
+
+static const char* TAG = "diag_mem";
+
+#define MEM_MAGIC 0xD1A6
+#define PSRAM_NEVER UINT32_MAX
+
+typedef struct {
+    uint32_t size;
+    uint8_t purpose;
+    uint8_t psram;
+    uint16_t magic;
+} mem_hdr_t;    // 8 bytes: keeps the block as aligned as the heap's
+
+typedef struct {
+    const char* name;
+    uint32_t psram_min;     // Smallest block placed in PSRAM first (PSRAM_NEVER = internal only)
+} mem_policy_t;
+
+static const mem_policy_t s_policy[DIAG_MEM_PURPOSE_COUNT] = {
+    [DIAG_MEM_GENERAL] = {"general", PSRAM_NEVER},
+    [DIAG_MEM_JSON]    = {"json",    0},    // Trees of small nodes, built and dropped per request
+    [DIAG_MEM_HTTP]    = {"http",    CONFIG_DIAG_MEM_PSRAM_MIN_SIZE},
+    [DIAG_MEM_OTA]     = {"ota",     0},
+    [DIAG_MEM_LOG]     = {"log",     0},
+    [DIAG_MEM_NET]     = {"net",     CONFIG_DIAG_MEM_PSRAM_MIN_SIZE},
+};
+
+static diag_mem_usage_t s_mem_usage[DIAG_MEM_PURPOSE_COUNT];
+static portMUX_TYPE s_mem_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if CONFIG_SPIRAM
+// PSRAM may be configured but not fitted (SPIRAM_IGNORE_NOTFOUND)
+static bool psram_present(void)
+{
+    static int8_t s_present = -1;
+    if (s_present < 0) {
+        s_present = heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0;
+    }
+    return s_present;
+}
+#endif
+
+static bool psram_allowed(diag_mem_purpose_t purpose)
+{
+#if CONFIG_SPIRAM
+    return s_policy[purpose].psram_min != PSRAM_NEVER && psram_present();
+#else
+    (void)purpose;
+    return false;
+#endif
+}
+
+static bool prefer_psram(diag_mem_purpose_t purpose, size_t size)
+{
+    if (!psram_allowed(purpose)) {
+        return false;
+    }
+    if (size >= s_policy[purpose].psram_min) {
+        return true;
+    }
+    // Small blocks too once internal RAM runs short
+    return heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT) < CONFIG_DIAG_MEM_INTERNAL_RESERVE;
+}
+
+static uint32_t region_caps(bool psram)
+{
+    return psram ? (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT) : (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+}
+
+/**
+ * Allocate size + extra bytes in the region the policy picks, falling back
+ * to the other one. *psram gets the region, *fallback whether it was not
+ * the preferred one.
+ */
+static void* region_alloc(diag_mem_purpose_t purpose, size_t size, size_t extra, bool* psram, bool* fallback)
+{
+    *psram = prefer_psram(purpose, size);
+    *fallback = false;
+    void* p = heap_caps_malloc(extra + size, region_caps(*psram));
+    if (!p && psram_allowed(purpose)) {
+        *psram = !*psram;
+        *fallback = true;
+        p = heap_caps_malloc(extra + size, region_caps(*psram));
+    }
+    return p;
+}
+
+static void region_charge(diag_mem_purpose_t purpose, bool ok, size_t size, bool psram, bool fallback)
+{
+    diag_mem_usage_t* u = &s_mem_usage[purpose];
+    portENTER_CRITICAL(&s_mem_lock);
+    if (!ok) {
+        u->failures++;
+    } else {
+        if (psram) {
+            u->psram_bytes += size;
+        } else {
+            u->internal_bytes += size;
+        }
+        uint32_t total = u->internal_bytes + u->psram_bytes;
+        if (total > u->peak_bytes) {
+            u->peak_bytes = total;
+        }
+        u->allocs++;
+        if (fallback) {
+            u->fallbacks++;
+        }
+    }
+    portEXIT_CRITICAL(&s_mem_lock);
+}
+
+static void region_release(diag_mem_purpose_t purpose, size_t size, bool psram)
+{
+    diag_mem_usage_t* u = &s_mem_usage[purpose];
+    uint32_t* held = psram ? &u->psram_bytes : &u->internal_bytes;
+    portENTER_CRITICAL(&s_mem_lock);
+    // Clamped: cJSON may free a block it got before the hooks went in
+    *held = (*held > size) ? *held - (uint32_t)size : 0;
+    portEXIT_CRITICAL(&s_mem_lock);
+}
+
+void* diag_mem_alloc(diag_mem_purpose_t purpose, size_t size) {
+    if ((unsigned)purpose >= DIAG_MEM_PURPOSE_COUNT) {
+        purpose = DIAG_MEM_GENERAL;
+    }
+    if (size > UINT32_MAX - sizeof(mem_hdr_t)) {
+        return NULL;
+    }
+
+    bool psram, fallback;
+    mem_hdr_t* h = region_alloc(purpose, size, sizeof(*h), &psram, &fallback);
+    region_charge(purpose, h != NULL, size, psram, fallback);
+    if (!h) {
+        return NULL;
+    }
+    h->size = (uint32_t)size;
+    h->purpose = (uint8_t)purpose;
+    h->psram = psram;
+    h->magic = MEM_MAGIC;
+    return h + 1;
+}
+
+void* diag_mem_calloc(diag_mem_purpose_t purpose, size_t n, size_t size) {
+    if (size && n > SIZE_MAX / size) {
+        return NULL;
+    }
+    void* p = diag_mem_alloc(purpose, n * size);
+    if (p) {
+        memset(p, 0, n * size);
+    }
+    return p;
+}
+
+void diag_mem_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    mem_hdr_t* h = (mem_hdr_t*)ptr - 1;
+    assert(h->magic == MEM_MAGIC && h->purpose < DIAG_MEM_PURPOSE_COUNT);
+
+    region_release((diag_mem_purpose_t)h->purpose, h->size, h->psram);
+
+    h->magic = 0;   // Catch a double free
+    heap_caps_free(h);
+}
+
+bool diag_mem_in_psram(const void* ptr) {
+    return ptr && ((const mem_hdr_t*)ptr - 1)->psram;
+}
+
+esp_err_t diag_mem_get_usage(diag_mem_purpose_t purpose, diag_mem_usage_t* out) {
+    if ((unsigned)purpose >= DIAG_MEM_PURPOSE_COUNT || !out) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_mem_lock);
+    *out = s_mem_usage[purpose];
+    portEXIT_CRITICAL(&s_mem_lock);
+    return ESP_OK;
+}
+
+const char* diag_mem_purpose_name(diag_mem_purpose_t purpose) {
+    return (unsigned)purpose < DIAG_MEM_PURPOSE_COUNT ? s_policy[purpose].name : "unknown";
+}
+
+/*
+ * cJSON hooks are global: IDF components use them too, and some release
+ * cJSON_Print() output with plain free() (wifi_provisioning does). Hooked
+ * blocks therefore carry no header. They are ordinary heap blocks, placed
+ * by the json policy and charged by their allocated size and region, so
+ * free() and cJSON_free() are both correct on them. A block released with
+ * free() stays counted in the json figures; it is never a heap error.
+ */
+static void* cjson_malloc(size_t size)
+{
+    bool psram, fallback;
+    void* p = region_alloc(DIAG_MEM_JSON, size, 0, &psram, &fallback);
+    // Charge what the heap really handed out, as cjson_free will
+    region_charge(DIAG_MEM_JSON, p != NULL, p ? heap_caps_get_allocated_size(p) : 0, psram, fallback);
+    return p;
+}
+
+static void cjson_free(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    region_release(DIAG_MEM_JSON, heap_caps_get_allocated_size(ptr), esp_ptr_external_ram(ptr));
+    heap_caps_free(ptr);
+}
+
+static int64_t read_u32(void* ctx)
+{
+    return *(volatile uint32_t*)ctx;
+}
+
+static int64_t read_total(void* ctx)
+{
+    // ctx is the byte offset of the counter inside diag_mem_usage_t
+    size_t offset = (size_t)(uintptr_t)ctx;
+    int64_t total = 0;
+    for (int p = 0; p < DIAG_MEM_PURPOSE_COUNT; p++) {
+        total += *(volatile uint32_t*)((uint8_t*)&s_mem_usage[p] + offset);
+    }
+    return total;
+}
+
+esp_err_t diag_mem_init(void) {
+    static bool s_done = false;
+    if (s_done) {
+        return ESP_OK;
+    }
+    s_done = true;
+
+    cJSON_Hooks hooks = {
+        .malloc_fn = cjson_malloc,
+        .free_fn = cjson_free,
+    };
+    cJSON_InitHooks(&hooks);
+
+    // Same base name back to back so each renders under one TYPE line
+    char name[48];
+    for (int p = 0; p < DIAG_MEM_PURPOSE_COUNT; p++) {
+        snprintf(name, sizeof(name), "mem_internal_bytes{purpose=\"%s\"}", s_policy[p].name);
+        diag_metric_gauge_fn(name, "Internal RAM held by diag_mem allocations",
+                             read_u32, &s_mem_usage[p].internal_bytes);
+    }
+    for (int p = 0; p < DIAG_MEM_PURPOSE_COUNT; p++) {
+        snprintf(name, sizeof(name), "mem_psram_bytes{purpose=\"%s\"}", s_policy[p].name);
+        diag_metric_gauge_fn(name, "PSRAM held by diag_mem allocations",
+                             read_u32, &s_mem_usage[p].psram_bytes);
+    }
+    diag_metric_counter_fn("mem_alloc_fallbacks_total", "Allocations served from the non-preferred region",
+                           read_total, (void*)offsetof(diag_mem_usage_t, fallbacks));
+    diag_metric_counter_fn("mem_alloc_failures_total", "diag_mem allocations that failed",
+                           read_total, (void*)offsetof(diag_mem_usage_t, failures));
+
+#if CONFIG_SPIRAM
+    ESP_LOGI(TAG, "PSRAM %s, %u bytes free", psram_present() ? "in use" : "not found",
+             (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+#else
+    ESP_LOGI(TAG, "PSRAM not configured, all allocations internal");
+#endif
+    return ESP_OK;
+}
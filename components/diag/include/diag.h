@@ -1,7 +1,10 @@
 #pragma once
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "esp_err.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +15,207 @@ uint32_t diag_get_heap_free(void);
 uint64_t diag_get_uptime_s(void);
 void diag_log_last_error(esp_err_t err, const char* scope);
 
+/**
+ * Log event bus loop counters and per-event queue-wait/handler times
+ * Events that were never posted are skipped
+ */
+void diag_log_event_bus_stats(void);
+
+/*
+ * Log ring: esp_log output is mirrored into a fixed ring of line slots so
+ * it can be fetched over HTTP. Every line gets a sequence number (first
+ * line is 1); readers pass the last seq they saw to fetch only newer lines.
+ */
+typedef struct {
+    uint32_t seq;
+    esp_log_level_t level;
+    uint16_t len;
+    char text[CONFIG_DIAG_LOG_LINE_MAX];    // NUL-terminated, colour codes and newline stripped
+} diag_log_line_t;
+
+typedef struct {
+    uint32_t capacity;          // Lines the ring can hold
+    uint32_t first_seq;         // Oldest line still held (0 if empty)
+    uint32_t next_seq;          // Seq the next line will get
+    uint32_t truncated;         // Lines cut to CONFIG_DIAG_LOG_LINE_MAX
+    bool in_psram;
+} diag_log_ring_info_t;
+
+/**
+ * Allocate the ring and install the esp_log_set_vprintf hook
+ * Call once, early; output is still forwarded to the previous vprintf
+ */
+esp_err_t diag_log_ring_init(void);
+
+/**
+ * Copy the first line with seq > *cursor and level <= max_level
+ * Advances *cursor to that line's seq. Returns false when no such line is
+ * held. If the cursor fell behind the ring, reading resumes at the oldest line.
+ */
+bool diag_log_ring_read(uint32_t* cursor, esp_log_level_t max_level, diag_log_line_t* out);
+
+esp_err_t diag_log_ring_get_info(diag_log_ring_info_t* info);
+
+/*
+ * Metrics registry
+ *
+ * Components register metrics once at init and keep the returned handle;
+ * updates are lock-free atomics that never allocate. Counter and gauge
+ * updates are also safe from ISRs; histogram observations are task-only
+ * (64-bit sum). Names
+ * follow Prometheus conventions and may carry a fixed label set, e.g.
+ * "udp_dest_packets_total{dest=\"1\"}"; metrics sharing a base name
+ * should be registered back to back so they render under one TYPE line.
+ * Registering an existing name returns the existing handle.
+ */
+#define DIAG_HISTOGRAM_MAX_BUCKETS 12
+
+typedef enum {
+    DIAG_METRIC_COUNTER = 0,
+    DIAG_METRIC_GAUGE,
+    DIAG_METRIC_HISTOGRAM,
+} diag_metric_type_t;
+
+typedef struct diag_metric diag_metric_t;
+
+// Sampled on every scrape, for values another module already owns
+typedef int64_t (*diag_metric_fn_t)(void* ctx);
+
+diag_metric_t* diag_metric_counter(const char* name, const char* help);
+diag_metric_t* diag_metric_gauge(const char* name, const char* help);
+diag_metric_t* diag_metric_counter_fn(const char* name, const char* help, diag_metric_fn_t fn, void* ctx);
+diag_metric_t* diag_metric_gauge_fn(const char* name, const char* help, diag_metric_fn_t fn, void* ctx);
+
+/**
+ * bounds are inclusive upper bucket limits in ascending order and must
+ * stay valid for the metric's lifetime (use a static array); +Inf is implicit
+ */
+diag_metric_t* diag_metric_histogram(const char* name, const char* help,
+                                     const uint32_t* bounds, size_t bound_count);
+
+// NULL handles are ignored so callers need not check registration results
+void diag_metric_inc(diag_metric_t* m);
+void diag_metric_add(diag_metric_t* m, uint32_t n);
+void diag_metric_set(diag_metric_t* m, int32_t value);
+void diag_metric_observe(diag_metric_t* m, uint32_t value);
+
+typedef esp_err_t (*diag_metrics_sink_t)(const char* text, size_t len, void* ctx);
+
+/**
+ * Render every metric in Prometheus text exposition format (0.0.4)
+ * sink is called once per line; a sink error stops rendering and is returned
+ */
+esp_err_t diag_metrics_write(diag_metrics_sink_t sink, void* ctx);
+
+/**
+ * Renders families whose label values are only known at run time (one row
+ * per task, say) instead of taking a registry slot per row. Called on every
+ * scrape after the registry; each family's HELP/TYPE lines and rows must be
+ * written together, one line per sink call.
+ */
+typedef esp_err_t (*diag_metrics_writer_t)(diag_metrics_sink_t sink, void* ctx);
+
+/**
+ * Add a writer to /metrics (adding the same one again is a no-op)
+ * @return ESP_ERR_NO_MEM once every writer slot is taken
+ */
+esp_err_t diag_metrics_add_writer(diag_metrics_writer_t fn);
+
+/*
+ * Memory policy: purpose-tagged allocations
+ *
+ * Large and bursty buffers are allocated through diag_mem_* with the
+ * purpose they serve, so internal RAM stays free for Wi-Fi, lwIP and DMA.
+ * Each purpose has a rule for placing its blocks:
+ * - general: internal RAM only
+ * - json, ota, log: PSRAM first at any size
+ * - http, net: PSRAM first from DIAG_MEM_PSRAM_MIN_SIZE up
+ * Once internal free heap drops below DIAG_MEM_INTERNAL_RESERVE, smaller
+ * http and net blocks go to PSRAM as well.
+ * If the first region is full, the other one is tried. Without PSRAM
+ * (not configured, or not fitted) everything is internal.
+ *
+ * Blocks carry an 8-byte header. Only diag_mem_free() may free them, and
+ * it must never be given memory from plain malloc(). Never use these
+ * calls for DMA buffers.
+ * diag_mem_init() also places cJSON allocations by the json rule. Those
+ * are plain heap blocks without a header, because the hooks are global
+ * and IDF code frees cJSON_Print() output with free(): cJSON_free() and
+ * free() both work on them, diag_mem_free() does not.
+ */
+typedef enum {
+    DIAG_MEM_GENERAL = 0,       // Default; internal RAM
+    DIAG_MEM_JSON,              // cJSON trees and printed documents
+    DIAG_MEM_HTTP,              // Request/response scratch buffers
+    DIAG_MEM_OTA,               // Image chunks, inflate state and dictionary
+    DIAG_MEM_LOG,               // Log ring
+    DIAG_MEM_NET,               // Scan results and other network bookkeeping
+    DIAG_MEM_PURPOSE_COUNT
+} diag_mem_purpose_t;
+
+typedef struct {
+    uint32_t internal_bytes;    // Requested bytes currently held in internal RAM
+    uint32_t psram_bytes;       // ... and in PSRAM
+    uint32_t peak_bytes;        // Highest internal + PSRAM total
+    uint32_t allocs;            // Successful allocations
+    uint32_t fallbacks;         // Served from the other region (preferred one full)
+    uint32_t failures;          // Allocations that returned NULL
+} diag_mem_usage_t;
+
+/**
+ * Register the mem_* metrics and install the cJSON hooks
+ * Call once, before anything uses cJSON (app_startup does, ahead of the
+ * stage graph). Allocation itself works without it.
+ */
+esp_err_t diag_mem_init(void);
+
+void* diag_mem_alloc(diag_mem_purpose_t purpose, size_t size);
+void* diag_mem_calloc(diag_mem_purpose_t purpose, size_t n, size_t size);
+void diag_mem_free(void* ptr);      // NULL is ignored
+bool diag_mem_in_psram(const void* ptr);
+
+esp_err_t diag_mem_get_usage(diag_mem_purpose_t purpose, diag_mem_usage_t* out);
+const char* diag_mem_purpose_name(diag_mem_purpose_t purpose);
+
+/*
+ * Profiler: periodic task and heap sampler
+ * CPU share is the task's run time over the interval as a share of all
+ * cores (100% = every core busy), in tenths of a percent.
+ */
+typedef struct {
+    char name[16];
+    uint16_t cpu_permille;      // Tenths of a percent of total CPU capacity
+    uint32_t stack_hwm;         // Minimum free stack ever, bytes
+    int8_t core;                // -1 = no affinity
+    uint8_t priority;
+} diag_task_sample_t;
+
+typedef struct {
+    uint32_t total;
+    uint32_t free;
+    uint32_t largest_free_block;
+    uint32_t min_free_ever;
+} diag_heap_sample_t;
+
+typedef struct {
+    diag_heap_sample_t internal;
+    diag_heap_sample_t psram;   // All zero without PSRAM
+    uint32_t task_count;        // Tasks in the last sample (0 if task stats are unavailable)
+    int64_t sampled_at_us;      // esp_timer time of the last sample, 0 before the first
+} diag_profile_t;
+
+/**
+ * Start (or re-time) the sampler; interval_ms 0 stops it
+ */
+esp_err_t diag_profiler_start(uint32_t interval_ms);
+
+esp_err_t diag_profiler_get(diag_profile_t* out);
+
+/**
+ * Copy up to max task samples from the last interval
+ */
+esp_err_t diag_profiler_get_tasks(diag_task_sample_t* out, size_t max, size_t* count);
+
 #ifdef __cplusplus
 }
 #endif
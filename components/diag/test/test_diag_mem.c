@@ -0,0 +1,92 @@
+#include "unity.h"
+#include "diag.h"
+#include "cJSON.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t held_bytes(diag_mem_purpose_t purpose)
+{
+    diag_mem_usage_t u;
+    TEST_ASSERT_EQUAL(ESP_OK, diag_mem_get_usage(purpose, &u));
+    return u.internal_bytes + u.psram_bytes;
+}
+
+TEST_CASE("diag_mem_alloc_free_charges_purpose", "[diag_mem]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, diag_mem_init());
+    uint32_t before = held_bytes(DIAG_MEM_HTTP);
+
+    uint8_t* p = diag_mem_alloc(DIAG_MEM_HTTP, 1000);
+    TEST_ASSERT_NOT_NULL(p);
+    memset(p, 0xA5, 1000);
+    TEST_ASSERT_EQUAL_UINT32(before + 1000, held_bytes(DIAG_MEM_HTTP));
+
+    diag_mem_free(p);
+    TEST_ASSERT_EQUAL_UINT32(before, held_bytes(DIAG_MEM_HTTP));
+    diag_mem_free(NULL);
+
+    // General stays internal whatever the size
+    void* g = diag_mem_alloc(DIAG_MEM_GENERAL, 4096);
+    TEST_ASSERT_NOT_NULL(g);
+    TEST_ASSERT_FALSE(diag_mem_in_psram(g));
+    diag_mem_free(g);
+}
+
+TEST_CASE("diag_mem_calloc_zeroes_and_rejects_overflow", "[diag_mem]")
+{
+    uint8_t* p = diag_mem_calloc(DIAG_MEM_NET, 16, 32);
+    TEST_ASSERT_NOT_NULL(p);
+    for (int i = 0; i < 16 * 32; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, p[i]);
+    }
+    diag_mem_free(p);
+
+    TEST_ASSERT_NULL(diag_mem_calloc(DIAG_MEM_NET, SIZE_MAX / 2, 4));
+}
+
+TEST_CASE("diag_mem_cjson_print_freed_with_free", "[diag_mem]")
+{
+    // The hooks are global; IDF components free cJSON_Print() output with
+    // plain free(), so that has to be safe alongside cJSON_free()
+    TEST_ASSERT_EQUAL(ESP_OK, diag_mem_init());
+    diag_mem_usage_t before;
+    TEST_ASSERT_EQUAL(ESP_OK, diag_mem_get_usage(DIAG_MEM_JSON, &before));
+
+    for (int i = 0; i < 64; i++) {
+        cJSON* root = cJSON_CreateObject();
+        TEST_ASSERT_NOT_NULL(root);
+        cJSON_AddStringToObject(root, "ver", "v1.1");
+        cJSON* caps = cJSON_AddArrayToObject(root, "cap");
+        cJSON_AddItemToArray(caps, cJSON_CreateString("wifi_scan"));
+        cJSON_AddNumberToObject(root, "i", i);
+
+        char* out = (i & 1) ? cJSON_Print(root) : cJSON_PrintUnformatted(root);
+        TEST_ASSERT_NOT_NULL(out);
+        TEST_ASSERT_NOT_NULL(strstr(out, "wifi_scan"));
+
+        // Parse it back so cJSON frees nodes it allocated itself
+        cJSON* copy = cJSON_Parse(out);
+        TEST_ASSERT_NOT_NULL(copy);
+        TEST_ASSERT_EQUAL(i, cJSON_GetObjectItem(copy, "i")->valueint);
+        cJSON_Delete(copy);
+
+        if (i % 3 == 0) {
+            free(out);
+        } else {
+            cJSON_free(out);
+        }
+        cJSON_Delete(root);
+    }
+
+    TEST_ASSERT_TRUE(heap_caps_check_integrity_all(true));
+
+    diag_mem_usage_t after;
+    TEST_ASSERT_EQUAL(ESP_OK, diag_mem_get_usage(DIAG_MEM_JSON, &after));
+    TEST_ASSERT_TRUE(after.allocs > before.allocs);
+    // Only the strings released with free() stay charged
+    TEST_ASSERT_TRUE(after.internal_bytes + after.psram_bytes >=
+                     before.internal_bytes + before.psram_bytes);
+}
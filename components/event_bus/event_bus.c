@@ -1,18 +1,672 @@
 #include "event_bus.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
 #include "esp_event.h"
 #include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 ESP_EVENT_DEFINE_BASE(DEVICE_EVENT);
 
 static const char *TAG = "event_bus";
 
+// Kconfig core value -1 means "no affinity"
+#define LOOP_CORE(c) ((c) < 0 ? tskNO_AFFINITY : (c))
+
+// Payloads up to this size are wrapped on the poster's stack
+#define ENVELOPE_INLINE_MAX 64
+
+typedef struct {
+    const char* name;
+    esp_event_loop_handle_t handle;
+    uint32_t posted;
+    uint32_t dropped;
+} bus_loop_t;
+
+static bus_loop_t s_loops[EVENT_BUS_LOOP_COUNT] = {
+    [EVENT_BUS_LOOP_FAST] = { .name = "evt_fast" },
+    [EVENT_BUS_LOOP_NORMAL] = { .name = "evt_normal" },
+};
+
+/*
+ * Per-event instrumentation
+ *
+ * Queue wait: a post to a dedicated loop carries an envelope ahead of the
+ * payload holding its esp_timer time, so the wait travels with the event
+ * however full the queue gets or whichever posts fail. A probe registered
+ * for ESP_EVENT_ANY_ID on each loop (and so dispatched before any
+ * id-specific handler) reads it when the event comes off the queue.
+ * ISR posts can only carry a few bytes inline, so the ids posted from ISRs
+ * travel bare and are not timed.
+ *
+ * Handler time: handlers registered through event_bus_register() are
+ * wrapped in a trampoline that times the call and hands it the payload
+ * without the envelope.
+ */
+typedef struct {
+    int64_t posted_us;
+    uint32_t len;               // Payload bytes that follow; 0 means no payload (NULL data)
+} post_envelope_t;
+
+typedef struct bus_handler {
+    esp_event_handler_t handler;
+    void* arg;
+    int32_t id;
+    esp_event_loop_handle_t loop;
+    esp_event_handler_instance_t instance;
+    struct bus_handler* next;
+} bus_handler_t;
+
+static event_bus_event_stats_t s_event_stats[DEVICE_EVENT_COUNT];
+static bus_handler_t* s_handlers = NULL;
+
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static portMUX_TYPE s_handlers_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char* const s_event_names[DEVICE_EVENT_COUNT] = {
+    [DEVICE_EVENT_NET_READY] = "NET_READY",
+    [DEVICE_EVENT_NET_LOST] = "NET_LOST",
+    [DEVICE_EVENT_NTRIP_CONNECTED] = "NTRIP_CONNECTED",
+    [DEVICE_EVENT_NTRIP_DISCONNECTED] = "NTRIP_DISCONNECTED",
+    [DEVICE_EVENT_UDP_STARTED] = "UDP_STARTED",
+    [DEVICE_EVENT_UDP_STOPPED] = "UDP_STOPPED",
+    [DEVICE_EVENT_OTA_BEGIN] = "OTA_BEGIN",
+    [DEVICE_EVENT_OTA_SUCCESS] = "OTA_SUCCESS",
+    [DEVICE_EVENT_OTA_FAIL] = "OTA_FAIL",
+    [DEVICE_EVENT_WDT_BARK] = "WDT_BARK",
+    [DEVICE_EVENT_WDT_BITE] = "WDT_BITE",
+    [DEVICE_EVENT_GNSS_READY] = "GNSS_READY",
+    [DEVICE_EVENT_GNSS_FIX_ACQUIRED] = "GNSS_FIX_ACQUIRED",
+    [DEVICE_EVENT_GNSS_FIX_LOST] = "GNSS_FIX_LOST",
+    [DEVICE_EVENT_GNSS_FIX_UPDATE] = "GNSS_FIX_UPDATE",
+    [DEVICE_EVENT_GNSS_STOPPED] = "GNSS_STOPPED",
+    [DEVICE_EVENT_TIME_SYNCED] = "TIME_SYNCED",
+    [DEVICE_EVENT_OTA_PROGRESS] = "OTA_PROGRESS",
+};
+
+static inline bool id_tracked(int32_t id)
+{
+    return id >= 0 && id < DEVICE_EVENT_COUNT;
+}
+
+/**
+ * Routing table: which loop carries each DEVICE_EVENT id
+ * NET_READY and NET_LOST must share a loop so their order is preserved
+ */
+static IRAM_ATTR event_bus_loop_id_t loop_for_id(int32_t id)
+{
+    switch (id) {
+        case DEVICE_EVENT_NET_READY:
+        case DEVICE_EVENT_NET_LOST:
+        case DEVICE_EVENT_WDT_BARK:
+        case DEVICE_EVENT_WDT_BITE:
+        case DEVICE_EVENT_GNSS_FIX_ACQUIRED:
+        case DEVICE_EVENT_GNSS_FIX_LOST:
+        case DEVICE_EVENT_GNSS_FIX_UPDATE:
+            return EVENT_BUS_LOOP_FAST;
+        default:
+            return EVENT_BUS_LOOP_NORMAL;
+    }
+}
+
+/**
+ * Ids posted from ISRs (see event_bus_isr_post); every other id posted to
+ * a dedicated loop is wrapped in an envelope
+ */
+static IRAM_ATTR bool posted_from_isr(int32_t id)
+{
+    return id == DEVICE_EVENT_WDT_BARK || id == DEVICE_EVENT_WDT_BITE;
+}
+
+static inline bool carries_envelope(int32_t id)
+{
+    return id_tracked(id) && !posted_from_isr(id);
+}
+
+static IRAM_ATTR void timing_add(event_bus_timing_t* t, uint32_t us)
+{
+    if (t->count == 0 || us < t->min_us) {
+        t->min_us = us;
+    }
+    if (us > t->max_us) {
+        t->max_us = us;
+    }
+    t->total_us += us;
+    t->count++;
+}
+
+/**
+ * Account the outcome of a post
+ */
+static IRAM_ATTR void count_post(event_bus_loop_id_t loop, int32_t id, esp_err_t ret)
+{
+    portENTER_CRITICAL_SAFE(&s_stats_lock);
+    if (ret == ESP_OK) {
+        s_loops[loop].posted++;
+    } else {
+        s_loops[loop].dropped++;
+    }
+
+    if (id_tracked(id)) {
+        if (ret == ESP_OK) {
+            s_event_stats[id].posted++;
+        } else {
+            s_event_stats[id].dropped++;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&s_stats_lock);
+}
+
+/**
+ * Runs first on each loop for every DEVICE_EVENT: post-to-dispatch latency
+ */
+static void dispatch_probe(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+    (void)arg;
+    (void)base;
+    if (!carries_envelope(id) || !data) {
+        return;
+    }
+
+    post_envelope_t env;
+    memcpy(&env, data, sizeof(env));    // The loop's copy is only 4-byte aligned
+    int64_t wait = esp_timer_get_time() - env.posted_us;
+    if (wait < 0) {
+        wait = 0;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    timing_add(&s_event_stats[id].queue_wait, wait > UINT32_MAX ? UINT32_MAX : (uint32_t)wait);
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+/**
+ * Wraps every handler registered through event_bus_register()
+ * The record may be freed by the handler unregistering itself, so it is
+ * not touched after the call
+ */
+static void handler_trampoline(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+    bus_handler_t* h = (bus_handler_t*)arg;
+    esp_event_handler_t fn = h->handler;
+
+    if (carries_envelope(id) && data) {
+        post_envelope_t env;
+        memcpy(&env, data, sizeof(env));
+        data = env.len ? (uint8_t*)data + sizeof(env) : NULL;
+    }
+
+    int64_t start = esp_timer_get_time();
+    fn(h->arg, base, id, data);
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    if (!id_tracked(id)) {
+        return;
+    }
+    uint32_t us = elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed;
+    portENTER_CRITICAL(&s_stats_lock);
+    event_bus_event_stats_t* st = &s_event_stats[id];
+    if (st->handler.count == 0 || us > st->handler.max_us) {
+        st->slowest_handler = (uintptr_t)fn;
+    }
+    timing_add(&st->handler, us);
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+static esp_err_t create_loop(event_bus_loop_id_t id, int32_t queue_size, UBaseType_t priority,
+                             uint32_t stack_size, BaseType_t core)
+{
+    esp_event_loop_args_t args = {
+        .queue_size = queue_size,
+        .task_name = s_loops[id].name,
+        .task_priority = priority,
+        .task_stack_size = stack_size,
+        .task_core_id = core,
+    };
+
+    esp_err_t ret = esp_event_loop_create(&args, &s_loops[id].handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create %s loop: %s", s_loops[id].name, esp_err_to_name(ret));
+        return ret;
+    }
+
+    // Probe goes in before any subscriber so it sees each event first
+    ret = esp_event_handler_register_with(s_loops[id].handle, DEVICE_EVENT, ESP_EVENT_ANY_ID,
+                                          &dispatch_probe, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register %s latency probe: %s", s_loops[id].name, esp_err_to_name(ret));
+        esp_event_loop_delete(s_loops[id].handle);
+        s_loops[id].handle = NULL;
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "Loop %s: queue %ld, prio %u, stack %lu", s_loops[id].name,
+             (long)queue_size, (unsigned)priority, (unsigned long)stack_size);
+    return ESP_OK;
+}
+
 esp_err_t event_bus_init(void) {
-    ESP_LOGI(TAG, "Event bus initialized (using default loop)");
-    // Default loop is created in app_main; custom loops can be added later.
+    if (s_loops[EVENT_BUS_LOOP_FAST].handle) {
+        return ESP_OK;
+    }
+
+    esp_err_t ret = create_loop(EVENT_BUS_LOOP_FAST,
+                                CONFIG_EVENT_BUS_FAST_QUEUE_SIZE,
+                                CONFIG_EVENT_BUS_FAST_TASK_PRIORITY,
+                                CONFIG_EVENT_BUS_FAST_TASK_STACK_SIZE,
+                                LOOP_CORE(CONFIG_EVENT_BUS_FAST_TASK_CORE));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    ret = create_loop(EVENT_BUS_LOOP_NORMAL,
+                      CONFIG_EVENT_BUS_NORMAL_QUEUE_SIZE,
+                      CONFIG_EVENT_BUS_NORMAL_TASK_PRIORITY,
+                      CONFIG_EVENT_BUS_NORMAL_TASK_STACK_SIZE,
+                      LOOP_CORE(CONFIG_EVENT_BUS_NORMAL_TASK_CORE));
+    if (ret != ESP_OK) {
+        esp_event_loop_delete(s_loops[EVENT_BUS_LOOP_FAST].handle);
+        s_loops[EVENT_BUS_LOOP_FAST].handle = NULL;
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "Event bus initialized (dedicated fast/normal loops)");
     return ESP_OK;
 }
 
 esp_err_t event_bus_post(esp_event_base_t base, int32_t id, void* data, size_t len, TickType_t timeout) {
-    (void)timeout; // not used with esp_event_post
-    return esp_event_post(base, id, data, len, portMAX_DELAY);
+    if (base != DEVICE_EVENT) {
+        return esp_event_post(base, id, data, len, timeout);
+    }
+
+    event_bus_loop_id_t loop = loop_for_id(id);
+    esp_err_t ret;
+    if (s_loops[loop].handle && carries_envelope(id)) {
+        // The envelope is stamped last, so the wait covers only the queue
+        uint8_t inline_buf[sizeof(post_envelope_t) + ENVELOPE_INLINE_MAX];
+        size_t total = sizeof(post_envelope_t) + (data ? len : 0);
+        uint8_t* buf = total <= sizeof(inline_buf) ? inline_buf : malloc(total);
+        if (buf) {
+            post_envelope_t env = { .len = data ? (uint32_t)len : 0 };
+            if (env.len) {
+                memcpy(buf + sizeof(env), data, len);
+            }
+            env.posted_us = esp_timer_get_time();
+            memcpy(buf, &env, sizeof(env));
+            ret = esp_event_post_to(s_loops[loop].handle, base, id, buf, total, timeout);
+            if (buf != inline_buf) {
+                free(buf);
+            }
+        } else {
+            ret = ESP_ERR_NO_MEM;
+        }
+    } else if (s_loops[loop].handle) {
+        ret = esp_event_post_to(s_loops[loop].handle, base, id, data, len, timeout);
+    } else {
+        // Not initialized (e.g. unit test build): fall back to default loop
+        ret = esp_event_post(base, id, data, len, timeout);
+    }
+
+    count_post(loop, id, ret);
+    if (ret == ESP_ERR_TIMEOUT) {
+        ESP_LOGW(TAG, "Dropped event %s (%s loop full)", event_bus_event_name(id), s_loops[loop].name);
+    }
+    return ret;
+}
+
+esp_err_t IRAM_ATTR event_bus_isr_post(int32_t id, const void* data, size_t len, BaseType_t* task_unblocked) {
+    event_bus_loop_id_t loop = loop_for_id(id);
+    esp_err_t ret;
+    if (!posted_from_isr(id)) {
+        // Its handlers expect an envelope an ISR post cannot carry
+        ret = ESP_ERR_NOT_SUPPORTED;
+    } else if (s_loops[loop].handle) {
+        ret = esp_event_isr_post_to(s_loops[loop].handle, DEVICE_EVENT, id, data, len, task_unblocked);
+    } else {
+        ret = esp_event_isr_post(DEVICE_EVENT, id, data, len, task_unblocked);
+    }
+
+    // No logging from ISR; the drop counter records it
+    count_post(loop, id, ret);
+    return ret;
+}
+
+static esp_err_t register_wrapped(event_bus_loop_id_t loop, int32_t id, esp_event_handler_t handler, void* arg)
+{
+    bus_handler_t* h = calloc(1, sizeof(*h));
+    if (!h) {
+        return ESP_ERR_NO_MEM;
+    }
+    h->handler = handler;
+    h->arg = arg;
+    h->id = id;
+    h->loop = s_loops[loop].handle;
+
+    esp_err_t ret = esp_event_handler_instance_register_with(h->loop, DEVICE_EVENT, id,
+                                                             &handler_trampoline, h, &h->instance);
+    if (ret != ESP_OK) {
+        free(h);
+        return ret;
+    }
+
+    portENTER_CRITICAL(&s_handlers_lock);
+    h->next = s_handlers;
+    s_handlers = h;
+    portEXIT_CRITICAL(&s_handlers_lock);
+    return ESP_OK;
+}
+
+esp_err_t event_bus_register(int32_t id, esp_event_handler_t handler, void* arg) {
+    if (!handler) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < EVENT_BUS_LOOP_COUNT; i++) {
+        if (id != ESP_EVENT_ANY_ID && loop_for_id(id) != (event_bus_loop_id_t)i) {
+            continue;
+        }
+
+        esp_err_t ret;
+        if (s_loops[i].handle) {
+            ret = register_wrapped((event_bus_loop_id_t)i, id, handler, arg);
+        } else if (i == 0 || id != ESP_EVENT_ANY_ID) {
+            // Default loop fallback registers once, uninstrumented
+            ret = esp_event_handler_register(DEVICE_EVENT, id, handler, arg);
+        } else {
+            continue;
+        }
+
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to register handler for event %ld: %s", (long)id, esp_err_to_name(ret));
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t event_bus_unregister(int32_t id, esp_event_handler_t handler) {
+    if (!s_loops[EVENT_BUS_LOOP_FAST].handle) {
+        return esp_event_handler_unregister(DEVICE_EVENT, id, handler);
+    }
+
+    esp_err_t result = ESP_ERR_NOT_FOUND;
+    for (;;) {
+        // Unlink one match at a time; the loop call below must not run under the spinlock
+        bus_handler_t* found = NULL;
+        portENTER_CRITICAL(&s_handlers_lock);
+        for (bus_handler_t** pp = &s_handlers; *pp; pp = &(*pp)->next) {
+            if ((*pp)->id == id && (*pp)->handler == handler) {
+                found = *pp;
+                *pp = found->next;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&s_handlers_lock);
+
+        if (!found) {
+            break;
+        }
+
+        // Returns once the handler is not running (dispatch holds the loop mutex)
+        esp_err_t ret = esp_event_handler_instance_unregister_with(found->loop, DEVICE_EVENT, id,
+                                                                   found->instance);
+        free(found);
+        if (result == ESP_ERR_NOT_FOUND || ret != ESP_OK) {
+            result = ret;
+        }
+    }
+    return result;
+}
+
+esp_err_t event_bus_get_loop_stats(event_bus_loop_id_t loop, event_bus_loop_stats_t* stats) {
+    if (loop >= EVENT_BUS_LOOP_COUNT || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_stats_lock);
+    stats->name = s_loops[loop].name;
+    stats->posted = s_loops[loop].posted;
+    stats->dropped = s_loops[loop].dropped;
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t event_bus_get_event_stats(int32_t id, event_bus_event_stats_t* stats) {
+    if (!id_tracked(id) || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_event_stats[id];
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+void event_bus_reset_event_stats(void) {
+    portENTER_CRITICAL(&s_stats_lock);
+    memset(s_event_stats, 0, sizeof(s_event_stats));
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+const char* event_bus_event_name(int32_t id) {
+    if (!id_tracked(id) || !s_event_names[id]) {
+        return "UNKNOWN";
+    }
+    return s_event_names[id];
+}
+
+/*
+ * Channel ring
+ *
+ * head counts published entries; entry n lives in slot n & mask.
+ * reserved is head + 1 while the producer is filling a slot, so readers
+ * can tell that the slot holding entry (reserved - slot_count - 1) is
+ * being overwritten. An entry n is intact while reserved - n <= slot_count.
+ */
+struct event_bus_channel {
+    char name[EVENT_BUS_CHANNEL_NAME_MAX];
+    size_t slot_size;           // Rounded up to 4-byte alignment
+    uint32_t slot_count;
+    uint32_t mask;
+    uint8_t* slots;
+    int64_t* published_us;
+    _Atomic uint32_t head;
+    _Atomic uint32_t reserved;
+};
+
+static event_bus_channel_t* s_channels[EVENT_BUS_MAX_CHANNELS];
+static portMUX_TYPE s_channel_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static event_bus_channel_t* channel_lookup(const char* name)
+{
+    for (int i = 0; i < EVENT_BUS_MAX_CHANNELS; i++) {
+        if (s_channels[i] && strncmp(s_channels[i]->name, name, sizeof(s_channels[i]->name)) == 0) {
+            return s_channels[i];
+        }
+    }
+    return NULL;
+}
+
+static void channel_free(event_bus_channel_t* ch)
+{
+    free(ch->slots);
+    free(ch->published_us);
+    free(ch);
+}
+
+static inline uint8_t* channel_slot(event_bus_channel_t* ch, uint32_t seq)
+{
+    return ch->slots + (size_t)(seq & ch->mask) * ch->slot_size;
+}
+
+static void channel_fill_entry(event_bus_channel_t* ch, uint32_t seq, event_bus_entry_t* out)
+{
+    out->data = channel_slot(ch, seq);
+    out->seq = seq;
+    out->published_us = ch->published_us[seq & ch->mask];
+}
+
+/**
+ * Move a lapped cursor up to the oldest intact entry
+ */
+static void reader_catch_up(event_bus_channel_t* ch, event_bus_reader_t* reader)
+{
+    uint32_t reserved = atomic_load_explicit(&ch->reserved, memory_order_acquire);
+    uint32_t oldest = reserved - ch->slot_count;
+    if ((int32_t)(reader->next_seq - oldest) < 0) {
+        reader->missed += oldest - reader->next_seq;
+        reader->next_seq = oldest;
+    }
+}
+
+esp_err_t event_bus_channel_create(const char* name, size_t slot_size, size_t slot_count,
+                                   event_bus_channel_t** out) {
+    if (!name || !out || slot_size == 0 || slot_count < 2 || (slot_count & (slot_count - 1)) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t aligned = (slot_size + 3) & ~(size_t)3;
+
+    event_bus_channel_t* existing = event_bus_channel_find(name);
+    if (existing) {
+        if (existing->slot_size != aligned || existing->slot_count != slot_count) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        *out = existing;
+        return ESP_OK;
+    }
+
+    // Allocate everything up front; publishing never touches the heap
+    event_bus_channel_t* ch = calloc(1, sizeof(*ch));
+    if (!ch) {
+        return ESP_ERR_NO_MEM;
+    }
+    ch->slots = calloc(slot_count, aligned);
+    ch->published_us = calloc(slot_count, sizeof(int64_t));
+    if (!ch->slots || !ch->published_us) {
+        channel_free(ch);
+        return ESP_ERR_NO_MEM;
+    }
+    strlcpy(ch->name, name, sizeof(ch->name));
+    ch->slot_size = aligned;
+    ch->slot_count = (uint32_t)slot_count;
+    ch->mask = (uint32_t)slot_count - 1;
+    atomic_init(&ch->head, 0);
+    atomic_init(&ch->reserved, 0);
+
+    // Register, unless another task created the same channel meanwhile
+    event_bus_channel_t* winner = NULL;
+    portENTER_CRITICAL(&s_channel_lock);
+    winner = channel_lookup(name);
+    if (!winner) {
+        for (int i = 0; i < EVENT_BUS_MAX_CHANNELS; i++) {
+            if (!s_channels[i]) {
+                s_channels[i] = ch;
+                winner = ch;
+                break;
+            }
+        }
+    }
+    portEXIT_CRITICAL(&s_channel_lock);
+
+    if (winner != ch) {
+        channel_free(ch);
+        if (!winner) {
+            ESP_LOGE(TAG, "No free channel slot for %s", name);
+            return ESP_ERR_NO_MEM;
+        }
+        if (winner->slot_size != aligned || winner->slot_count != slot_count) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+    } else {
+        ESP_LOGI(TAG, "Channel %s: %lu slots x %u bytes", name,
+                 (unsigned long)slot_count, (unsigned)aligned);
+    }
+
+    *out = winner;
+    return ESP_OK;
+}
+
+event_bus_channel_t* event_bus_channel_find(const char* name) {
+    if (!name) {
+        return NULL;
+    }
+
+    portENTER_CRITICAL(&s_channel_lock);
+    event_bus_channel_t* ch = channel_lookup(name);
+    portEXIT_CRITICAL(&s_channel_lock);
+    return ch;
+}
+
+void* event_bus_channel_reserve(event_bus_channel_t* ch) {
+    uint32_t head = atomic_load_explicit(&ch->head, memory_order_relaxed);
+
+    // Announce the overwrite before touching the slot
+    atomic_store_explicit(&ch->reserved, head + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    return channel_slot(ch, head);
+}
+
+void event_bus_channel_publish(event_bus_channel_t* ch) {
+    uint32_t head = atomic_load_explicit(&ch->head, memory_order_relaxed);
+    ch->published_us[head & ch->mask] = esp_timer_get_time();
+    atomic_store_explicit(&ch->head, head + 1, memory_order_release);
+}
+
+bool event_bus_channel_latest(event_bus_channel_t* ch, event_bus_entry_t* out) {
+    uint32_t head = atomic_load_explicit(&ch->head, memory_order_acquire);
+    if (head == 0) {
+        return false;
+    }
+    channel_fill_entry(ch, head - 1, out);
+    return true;
+}
+
+void event_bus_reader_init(event_bus_channel_t* ch, event_bus_reader_t* reader) {
+    reader->next_seq = atomic_load_explicit(&ch->head, memory_order_acquire);
+    reader->missed = 0;
+}
+
+bool event_bus_channel_peek(event_bus_channel_t* ch, event_bus_reader_t* reader, event_bus_entry_t* out) {
+    uint32_t head = atomic_load_explicit(&ch->head, memory_order_acquire);
+    if (reader->next_seq == head) {
+        return false;
+    }
+
+    reader_catch_up(ch, reader);
+    if (reader->next_seq == head) {
+        return false;
+    }
+    channel_fill_entry(ch, reader->next_seq, out);
+    return true;
+}
+
+bool event_bus_channel_next(event_bus_channel_t* ch, event_bus_reader_t* reader, event_bus_entry_t* out) {
+    if (!event_bus_channel_peek(ch, reader, out)) {
+        return false;
+    }
+    reader->next_seq++;
+    return true;
+}
+
+uint32_t event_bus_channel_pending(event_bus_channel_t* ch, const event_bus_reader_t* reader) {
+    uint32_t head = atomic_load_explicit(&ch->head, memory_order_acquire);
+    uint32_t pending = head - reader->next_seq;
+    return pending > ch->slot_count ? ch->slot_count : pending;
+}
+
+uint32_t event_bus_reader_skip(event_bus_channel_t* ch, event_bus_reader_t* reader) {
+    uint32_t pending = event_bus_channel_pending(ch, reader);
+    reader->next_seq = atomic_load_explicit(&ch->head, memory_order_acquire);
+    return pending;
+}
+
+bool event_bus_channel_valid(event_bus_channel_t* ch, uint32_t seq) {
+    // Order the caller's slot reads before re-checking the producer position
+    atomic_thread_fence(memory_order_acquire);
+    uint32_t reserved = atomic_load_explicit(&ch->reserved, memory_order_relaxed);
+    return (reserved - seq) <= ch->slot_count;
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include <stdbool.h>
+#include <stdint.h>
 #include "esp_event.h"
 
 #ifdef __cplusplus
@@ -26,11 +28,162 @@ typedef enum {
     DEVICE_EVENT_GNSS_FIX_LOST,
     DEVICE_EVENT_GNSS_FIX_UPDATE,
     DEVICE_EVENT_GNSS_STOPPED,
+
+    DEVICE_EVENT_TIME_SYNCED,       // SNTP set the clock
+    DEVICE_EVENT_OTA_PROGRESS,      // ota_mgr_progress_t, about once a second while an image is written
+
+    DEVICE_EVENT_COUNT
 } device_event_id_t;
 
+// Dedicated loops owned by event_bus (sizes/priorities in menuconfig "Event Bus")
+typedef enum {
+    EVENT_BUS_LOOP_FAST = 0,    // NET_READY/NET_LOST, GNSS fixes, WDT
+    EVENT_BUS_LOOP_NORMAL,      // Everything else on DEVICE_EVENT
+    EVENT_BUS_LOOP_COUNT
+} event_bus_loop_id_t;
+
+typedef struct {
+    const char* name;           // Loop task name
+    uint32_t posted;            // Events accepted into the loop queue
+    uint32_t dropped;           // Posts rejected (queue full within timeout)
+} event_bus_loop_stats_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;          // avg = total_us / count
+} event_bus_timing_t;
+
+// Per device_event_id_t counters (since boot or last reset)
+typedef struct {
+    uint32_t posted;
+    uint32_t dropped;
+    event_bus_timing_t queue_wait;  // Post to dispatch (not for ISR-posted ids)
+    event_bus_timing_t handler;     // Each handler call registered via event_bus_register()
+    uintptr_t slowest_handler;      // Address of the handler that set handler.max_us
+} event_bus_event_stats_t;
+
 esp_err_t event_bus_init(void);
+
+/**
+ * Post an event
+ * DEVICE_EVENT ids go to their dedicated loop; other bases go to the
+ * default loop. timeout is honored (0 = non-blocking); a post that times
+ * out is counted as a drop and returns ESP_ERR_TIMEOUT.
+ */
 esp_err_t event_bus_post(esp_event_base_t base, int32_t id, void* data, size_t len, TickType_t timeout);
 
+/**
+ * ISR-safe post for DEVICE_EVENT ids (never blocks)
+ * Only DEVICE_EVENT_WDT_BARK and DEVICE_EVENT_WDT_BITE may be posted from
+ * an ISR (with the few bytes of data esp_event carries inline); any other
+ * id returns ESP_ERR_NOT_SUPPORTED. Their queue wait is not measured.
+ */
+esp_err_t event_bus_isr_post(int32_t id, const void* data, size_t len, BaseType_t* task_unblocked);
+
+/**
+ * Register/unregister a DEVICE_EVENT handler on the loop that carries id
+ * ESP_EVENT_ANY_ID registers on every loop
+ */
+esp_err_t event_bus_register(int32_t id, esp_event_handler_t handler, void* arg);
+esp_err_t event_bus_unregister(int32_t id, esp_event_handler_t handler);
+
+esp_err_t event_bus_get_loop_stats(event_bus_loop_id_t loop, event_bus_loop_stats_t* stats);
+
+/**
+ * Per-event latency and handler-time statistics
+ * Queue wait and handler times are only recorded once event_bus_init()
+ * has created the dedicated loops. slowest_handler is a code address;
+ * resolve it with addr2line against the firmware ELF.
+ */
+esp_err_t event_bus_get_event_stats(int32_t id, event_bus_event_stats_t* stats);
+void event_bus_reset_event_stats(void);
+const char* event_bus_event_name(int32_t id);
+
+/*
+ * Channels: zero-copy rings for high-frequency payloads (e.g. GNSS fixes)
+ *
+ * A channel is a fixed ring of preallocated slots with one producer and any
+ * number of readers. The producer fills a slot in place and publishes it;
+ * readers get a pointer straight into the ring. Nothing is copied or
+ * allocated per entry, and the producer never blocks: when the ring is full
+ * the oldest slot is overwritten.
+ *
+ * Readers take no lock, so an entry can be overwritten while it is being
+ * read. Use the data, then call event_bus_channel_valid(); if it returns
+ * false, discard what was read.
+ */
+#define EVENT_BUS_MAX_CHANNELS 8
+#define EVENT_BUS_CHANNEL_NAME_MAX 16
+
+typedef struct event_bus_channel event_bus_channel_t;
+
+typedef struct {
+    const void* data;           // Points into the ring slot (no copy)
+    uint32_t seq;               // Entry sequence number, for event_bus_channel_valid()
+    int64_t published_us;       // esp_timer time at publish
+} event_bus_entry_t;
+
+typedef struct {
+    uint32_t next_seq;          // Next entry this reader will return
+    uint32_t missed;            // Entries overwritten before this reader got to them
+} event_bus_reader_t;
+
+/**
+ * Create a channel, or attach to an existing one with the same name
+ * slot_count must be a power of two. Attaching fails with
+ * ESP_ERR_INVALID_SIZE if the existing channel has a different geometry.
+ */
+esp_err_t event_bus_channel_create(const char* name, size_t slot_size, size_t slot_count,
+                                   event_bus_channel_t** out);
+
+/**
+ * Look up a channel by name (NULL if not created yet)
+ */
+event_bus_channel_t* event_bus_channel_find(const char* name);
+
+/**
+ * Producer: get the next slot to fill in place
+ * The slot stays invisible to readers until event_bus_channel_publish().
+ * Only one task may produce on a channel.
+ */
+void* event_bus_channel_reserve(event_bus_channel_t* ch);
+void event_bus_channel_publish(event_bus_channel_t* ch);
+
+/**
+ * Reader: most recently published entry (false if nothing published yet)
+ */
+bool event_bus_channel_latest(event_bus_channel_t* ch, event_bus_entry_t* out);
+
+/**
+ * Reader: start a cursor after the newest entry (only new entries are returned)
+ */
+void event_bus_reader_init(event_bus_channel_t* ch, event_bus_reader_t* reader);
+
+/**
+ * Reader: oldest unread entry (peek leaves the cursor, next advances it)
+ * If the producer has lapped the reader, the cursor skips ahead and
+ * reader->missed counts the lost entries.
+ */
+bool event_bus_channel_peek(event_bus_channel_t* ch, event_bus_reader_t* reader, event_bus_entry_t* out);
+bool event_bus_channel_next(event_bus_channel_t* ch, event_bus_reader_t* reader, event_bus_entry_t* out);
+
+/**
+ * Reader: number of unread entries still held in the ring
+ */
+uint32_t event_bus_channel_pending(event_bus_channel_t* ch, const event_bus_reader_t* reader);
+
+/**
+ * Reader: skip every unread entry, returns how many were skipped
+ */
+uint32_t event_bus_reader_skip(event_bus_channel_t* ch, event_bus_reader_t* reader);
+
+/**
+ * true if entry seq has not been overwritten since it was returned
+ */
+bool event_bus_channel_valid(event_bus_channel_t* ch, uint32_t seq);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,16 +9,28 @@
 #include "udp_broadcast.h"
 #include "version.h"
 #include "diag.h"
+#include "event_bus.h"
+#include "json_writer.h"
+#include "body_parser.h"
 #include "esp_log.h"
 #include "esp_http_server.h"
 #include "esp_tls_crypto.h"
 #include "esp_system.h"
 #include "esp_timer.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "ota_mgr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
 #include "cJSON.h"
+#include "lwip/sockets.h"
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
+#include <stdatomic.h>
 
 static const char *TAG = "http_ui";
 
@@ -29,373 +41,83 @@ static time_t s_first_boot_timestamp = 0;
 #define HTTPD_401 "401 UNAUTHORIZED"
 #define MAX_AUTH_LEN 128
 #define MAX_JSON_RESPONSE 2048
-
-// Favicon data (32x32 .ico file)
-static const unsigned char s_favicon_ico[] = {
-  0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x20, 0x20, 0x00, 0x00, 0x01, 0x00,
-  0x20, 0x00, 0xa8, 0x10, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x28, 0x00,
-  0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x01, 0x00,
-  0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x23, 0x2e,
-  0x00, 0x00, 0x23, 0x2e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0xfb,
-  0xfb, 0xff, 0xe9, 0xe4, 0xde, 0xff, 0xeb, 0xe6, 0xe0, 0xff, 0xfd, 0xfc,
-  0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xf6, 0xf4, 0xf1, 0xff, 0xa9, 0x94, 0x7e, 0xff, 0x8b, 0x6e,
-  0x50, 0xff, 0x8a, 0x6e, 0x50, 0xff, 0xaf, 0x9b, 0x87, 0xff, 0xf9, 0xf7,
-  0xf6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe,
-  0xfe, 0xff, 0xfe, 0xfd, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbc, 0xab,
-  0x9a, 0xff, 0x92, 0x77, 0x5b, 0xff, 0xb6, 0xa4, 0x91, 0xff, 0xb7, 0xa5,
-  0x93, 0xff, 0x8d, 0x71, 0x55, 0xff, 0xc6, 0xb7, 0xa9, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xfd, 0xfd, 0xfd, 0xff, 0xfe, 0xfe, 0xfe, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xee, 0xea, 0xe6, 0xff, 0xa3, 0x8c, 0x75, 0xff, 0x92, 0x77,
-  0x5b, 0xff, 0xd7, 0xcd, 0xc3, 0xff, 0x9e, 0x86, 0x70, 0xff, 0xb2, 0x9f,
-  0x8c, 0xff, 0x6c, 0x48, 0x25, 0xff, 0x74, 0x52, 0x31, 0xff, 0xae, 0x99,
-  0x86, 0xff, 0xa7, 0x91, 0x7c, 0xff, 0xd3, 0xc9, 0xbe, 0xff, 0x90, 0x75,
-  0x58, 0xff, 0xa7, 0x91, 0x7b, 0xff, 0xf2, 0xee, 0xeb, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xab, 0x97,
-  0x82, 0xff, 0x52, 0x27, 0x00, 0xff, 0x50, 0x25, 0x00, 0xff, 0x7e, 0x5e,
-  0x3e, 0xff, 0xaa, 0x95, 0x80, 0xff, 0x9a, 0x80, 0x67, 0xff, 0xaf, 0x9c,
-  0x88, 0xff, 0xb2, 0x9f, 0x8c, 0xff, 0x94, 0x7a, 0x5f, 0xff, 0xb0, 0x9c,
-  0x88, 0xff, 0x77, 0x56, 0x35, 0xff, 0x50, 0x25, 0x00, 0xff, 0x53, 0x29,
-  0x01, 0xff, 0xb5, 0xa3, 0x90, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0x8e, 0x78, 0xff, 0x51, 0x26,
-  0x00, 0xff, 0x51, 0x26, 0x00, 0xff, 0x71, 0x4d, 0x2c, 0xff, 0xe3, 0xdc,
-  0xd5, 0xff, 0x9c, 0x84, 0x6b, 0xff, 0x8c, 0x70, 0x53, 0xff, 0x8b, 0x6e,
-  0x51, 0xff, 0xa2, 0x8b, 0x74, 0xff, 0xe1, 0xda, 0xd3, 0xff, 0x6a, 0x45,
-  0x22, 0xff, 0x51, 0x26, 0x00, 0xff, 0x51, 0x26, 0x00, 0xff, 0xad, 0x99,
-  0x84, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xe6, 0xe0, 0xd9, 0xff, 0x8e, 0x72, 0x56, 0xff, 0x7c, 0x5b,
-  0x3a, 0xff, 0x74, 0x52, 0x2e, 0xff, 0xc0, 0xb0, 0xa1, 0xff, 0xf9, 0xf7,
-  0xf6, 0xff, 0xe0, 0xd9, 0xd1, 0xff, 0xe2, 0xdb, 0xd4, 0xff, 0xf9, 0xf8,
-  0xf6, 0xff, 0xb8, 0xa7, 0x95, 0xff, 0x73, 0x51, 0x2d, 0xff, 0x7b, 0x5b,
-  0x3a, 0xff, 0x93, 0x78, 0x5d, 0xff, 0xea, 0xe5, 0xe0, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xfb, 0xfb, 0xfa, 0xff, 0xf9, 0xf8, 0xf6, 0xff, 0xd5, 0xca,
-  0xbf, 0xff, 0x7b, 0x5a, 0x39, 0xff, 0xbf, 0xaf, 0x9f, 0xff, 0xed, 0xe8,
-  0xe4, 0xff, 0xed, 0xe9, 0xe5, 0xff, 0xba, 0xa8, 0x97, 0xff, 0x7d, 0x5c,
-  0x3b, 0xff, 0xda, 0xd0, 0xc7, 0xff, 0xf9, 0xf8, 0xf6, 0xff, 0xfc, 0xfb,
-  0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf9, 0xf8, 0xf6, 0xff, 0xe7, 0xe1,
-  0xdb, 0xff, 0xf3, 0xf1, 0xee, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd4, 0xc9,
-  0xbf, 0xff, 0x73, 0x50, 0x2d, 0xff, 0x69, 0x44, 0x1e, 0xff, 0x69, 0x44,
-  0x1e, 0xff, 0x77, 0x55, 0x33, 0xff, 0xda, 0xd1, 0xc8, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xf4, 0xf2, 0xef, 0xff, 0xeb, 0xe6, 0xe0, 0xff, 0xfb, 0xfa,
-  0xf9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xef, 0xeb, 0xe7, 0xff, 0xaa, 0x96, 0x80, 0xff, 0x9f, 0x87,
-  0x6f, 0xff, 0xe2, 0xdb, 0xd3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf9, 0xf7,
-  0xf6, 0xff, 0x9f, 0x87, 0x6f, 0xff, 0x65, 0x3e, 0x17, 0xff, 0x81, 0x62,
-  0x42, 0xff, 0xe7, 0xe1, 0xdb, 0xff, 0xfa, 0xf9, 0xf8, 0xff, 0x7f, 0x5f,
-  0x41, 0xff, 0x51, 0x26, 0x00, 0xff, 0x51, 0x26, 0x00, 0xff, 0x87, 0x69,
-  0x4d, 0xff, 0xfd, 0xfd, 0xfc, 0xff, 0xe4, 0xdd, 0xd6, 0xff, 0x81, 0x62,
-  0x42, 0xff, 0x68, 0x43, 0x1d, 0xff, 0xab, 0x96, 0x81, 0xff, 0xfc, 0xfb,
-  0xfa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xd6, 0xcd, 0xff, 0x9d, 0x85,
-  0x6c, 0xff, 0xae, 0x9a, 0x85, 0xff, 0xf1, 0xee, 0xeb, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa6, 0x90,
-  0x79, 0xff, 0x52, 0x27, 0x00, 0xff, 0x50, 0x25, 0x00, 0xff, 0x89, 0x6c,
-  0x4f, 0xff, 0xfc, 0xfb, 0xfa, 0xff, 0xe2, 0xda, 0xd3, 0xff, 0x61, 0x39,
-  0x14, 0xff, 0x53, 0x28, 0x00, 0xff, 0x53, 0x28, 0x00, 0xff, 0xb8, 0xa6,
-  0x95, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0x84, 0x6b, 0xff, 0x53, 0x28,
-  0x00, 0xff, 0x54, 0x29, 0x00, 0xff, 0xa5, 0x8e, 0x78, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xb0, 0x9c, 0x89, 0xff, 0x52, 0x27, 0x00, 0xff, 0x52, 0x28,
-  0x00, 0xff, 0x66, 0x40, 0x1d, 0xff, 0xe8, 0xe3, 0xdd, 0xff, 0xf8, 0xf7,
-  0xf5, 0xff, 0x82, 0x63, 0x44, 0xff, 0x50, 0x25, 0x00, 0xff, 0x53, 0x29,
-  0x00, 0xff, 0xae, 0x9a, 0x85, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x97, 0x7e, 0x64, 0xff, 0x50, 0x25,
-  0x00, 0xff, 0x51, 0x26, 0x00, 0xff, 0x78, 0x56, 0x36, 0xff, 0xf7, 0xf5,
-  0xf3, 0xff, 0xee, 0xea, 0xe6, 0xff, 0x76, 0x54, 0x32, 0xff, 0x52, 0x27,
-  0x00, 0xff, 0x53, 0x28, 0x00, 0xff, 0xb2, 0xa0, 0x8d, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xef, 0xeb, 0xe7, 0xff, 0xb6, 0xa4, 0x92, 0xff, 0xb8, 0xa7,
-  0x95, 0xff, 0xf2, 0xee, 0xeb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xaa, 0x95,
-  0x80, 0xff, 0x51, 0x26, 0x00, 0xff, 0x51, 0x27, 0x00, 0xff, 0x7a, 0x59,
-  0x38, 0xff, 0xf2, 0xef, 0xeb, 0xff, 0xf2, 0xef, 0xec, 0xff, 0x71, 0x4e,
-  0x2d, 0xff, 0x51, 0x26, 0x00, 0xff, 0x50, 0x25, 0x00, 0xff, 0x9f, 0x88,
-  0x71, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xdb, 0xd3, 0xc9, 0xff, 0x82, 0x64, 0x44, 0xff, 0x74, 0x51,
-  0x2e, 0xff, 0x72, 0x50, 0x2c, 0xff, 0xcf, 0xc3, 0xb7, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xde, 0xd6, 0xce, 0xff, 0xaf, 0x9b, 0x86, 0xff, 0xa8, 0x93,
-  0x7d, 0xff, 0x7c, 0x5c, 0x3a, 0xff, 0xd0, 0xc4, 0xb8, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xcc, 0xbf, 0xb2, 0xff, 0x7c, 0x5b, 0x3a, 0xff, 0xa5, 0x8f,
-  0x78, 0xff, 0xab, 0x96, 0x81, 0xff, 0xdf, 0xd7, 0xcf, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xc9, 0xbc, 0xae, 0xff, 0x71, 0x4e, 0x2a, 0xff, 0x74, 0x51,
-  0x2e, 0xff, 0x86, 0x68, 0x49, 0xff, 0xe0, 0xd8, 0xd1, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xf6, 0xf4, 0xf2, 0xff, 0xbc, 0xac, 0x9b, 0xff, 0x9d, 0x85,
-  0x6d, 0xff, 0xa9, 0x94, 0x7e, 0xff, 0xe4, 0xdd, 0xd6, 0xff, 0xc5, 0xb7,
-  0xa8, 0xff, 0x7a, 0x59, 0x37, 0xff, 0xcf, 0xc3, 0xb7, 0xff, 0xfb, 0xfa,
-  0xf8, 0xff, 0xfd, 0xfd, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc5, 0xb6,
-  0xa7, 0xff, 0x7c, 0x5b, 0x3a, 0xff, 0xb2, 0x9f, 0x8c, 0xff, 0xa2, 0x8b,
-  0x73, 0xff, 0xa4, 0x8d, 0x76, 0xff, 0xb2, 0x9e, 0x8b, 0xff, 0x7c, 0x5b,
-  0x3a, 0xff, 0xc9, 0xbc, 0xae, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd, 0xfc,
-  0xfc, 0xff, 0xfa, 0xf9, 0xf8, 0xff, 0xca, 0xbd, 0xb0, 0xff, 0x7a, 0x59,
-  0x37, 0xff, 0xcb, 0xbe, 0xb1, 0xff, 0xe1, 0xda, 0xd2, 0xff, 0xa7, 0x91,
-  0x7b, 0xff, 0x9e, 0x86, 0x6d, 0xff, 0xc0, 0xb0, 0xa0, 0xff, 0xf8, 0xf6,
-  0xf5, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0xfd, 0xff, 0xab, 0x97,
-  0x81, 0xff, 0x91, 0x75, 0x59, 0xff, 0xb4, 0xa2, 0x8f, 0xff, 0x9c, 0x84,
-  0x6b, 0xff, 0x98, 0x7f, 0x65, 0xff, 0xf8, 0xf6, 0xf4, 0xff, 0xc5, 0xb7,
-  0xa8, 0xff, 0x73, 0x50, 0x2d, 0xff, 0x7c, 0x5c, 0x3b, 0xff, 0x96, 0x7d,
-  0x62, 0xff, 0xec, 0xe7, 0xe3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xae, 0x9a,
-  0x86, 0xff, 0x73, 0x51, 0x2f, 0xff, 0xaf, 0x9c, 0x88, 0xff, 0xae, 0x9a,
-  0x85, 0xff, 0x70, 0x4d, 0x2a, 0xff, 0xb7, 0xa5, 0x93, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xe9, 0xe3, 0xdd, 0xff, 0x93, 0x78, 0x5c, 0xff, 0x7c, 0x5b,
-  0x3a, 0xff, 0x74, 0x52, 0x2e, 0xff, 0xcb, 0xbe, 0xb1, 0xff, 0xf5, 0xf3,
-  0xf0, 0xff, 0x94, 0x79, 0x5e, 0xff, 0x9f, 0x87, 0x6f, 0xff, 0xb4, 0xa1,
-  0x8e, 0xff, 0x8e, 0x72, 0x56, 0xff, 0xb2, 0x9f, 0x8b, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xec, 0xe7, 0xe3, 0xff, 0x8b, 0x6e, 0x52, 0xff, 0xb6, 0xa4,
-  0x92, 0xff, 0x6c, 0x47, 0x22, 0xff, 0xad, 0x98, 0x84, 0xff, 0x8e, 0x72,
-  0x56, 0xff, 0xdc, 0xd4, 0xcb, 0xff, 0xee, 0xea, 0xe6, 0xff, 0x6c, 0x47,
-  0x24, 0xff, 0x51, 0x26, 0x00, 0xff, 0x52, 0x27, 0x00, 0xff, 0xb0, 0x9d,
-  0x89, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa4, 0x8d, 0x76, 0xff, 0xaf, 0x9b,
-  0x87, 0xff, 0x82, 0x63, 0x43, 0xff, 0x89, 0x6c, 0x4e, 0xff, 0xaa, 0x95,
-  0x7f, 0xff, 0xad, 0x99, 0x84, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa8, 0x92,
-  0x7c, 0xff, 0x51, 0x26, 0x00, 0xff, 0x51, 0x26, 0x00, 0xff, 0x71, 0x4e,
-  0x2c, 0xff, 0xf3, 0xf0, 0xed, 0xff, 0xd5, 0xcb, 0xc1, 0xff, 0x91, 0x76,
-  0x5b, 0xff, 0xa9, 0x93, 0x7d, 0xff, 0x6e, 0x4a, 0x25, 0xff, 0xb8, 0xa6,
-  0x94, 0xff, 0x8c, 0x6f, 0x53, 0xff, 0xf1, 0xed, 0xea, 0xff, 0xee, 0xe9,
-  0xe5, 0xff, 0x8b, 0x6e, 0x52, 0xff, 0xb8, 0xa6, 0x94, 0xff, 0x77, 0x55,
-  0x33, 0xff, 0xb1, 0x9d, 0x8a, 0xff, 0x8c, 0x6f, 0x53, 0xff, 0xde, 0xd6,
-  0xce, 0xff, 0xef, 0xeb, 0xe7, 0xff, 0x6c, 0x48, 0x25, 0xff, 0x50, 0x25,
-  0x00, 0xff, 0x53, 0x29, 0x01, 0xff, 0xb6, 0xa3, 0x91, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xa6, 0x91, 0x7a, 0xff, 0xab, 0x97, 0x82, 0xff, 0x8d, 0x71,
-  0x54, 0xff, 0x94, 0x79, 0x5e, 0xff, 0xa6, 0x90, 0x79, 0xff, 0xb0, 0x9c,
-  0x88, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x99, 0x85, 0xff, 0x52, 0x27,
-  0x00, 0xff, 0x50, 0x25, 0x00, 0xff, 0x72, 0x4f, 0x2d, 0xff, 0xf3, 0xf1,
-  0xed, 0xff, 0xd8, 0xce, 0xc4, 0xff, 0x8e, 0x72, 0x57, 0xff, 0xad, 0x99,
-  0x84, 0xff, 0x78, 0x57, 0x35, 0xff, 0xb8, 0xa6, 0x95, 0xff, 0x8c, 0x70,
-  0x54, 0xff, 0xf2, 0xef, 0xec, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb3, 0xa1,
-  0x8d, 0xff, 0x8c, 0x6f, 0x52, 0xff, 0xae, 0x9a, 0x86, 0xff, 0x95, 0x7b,
-  0x61, 0xff, 0xa0, 0x89, 0x71, 0xff, 0xf8, 0xf7, 0xf5, 0xff, 0xba, 0xa9,
-  0x97, 0xff, 0x77, 0x56, 0x34, 0xff, 0x8a, 0x6e, 0x50, 0xff, 0xa5, 0x8f,
-  0x78, 0xff, 0xf2, 0xee, 0xeb, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xa8, 0x92,
-  0x7d, 0xff, 0x6f, 0x4c, 0x28, 0xff, 0xa8, 0x93, 0x7c, 0xff, 0xa6, 0x90,
-  0x79, 0xff, 0x6c, 0x48, 0x24, 0xff, 0xb1, 0x9d, 0x8a, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xef, 0xeb, 0xe7, 0xff, 0xa2, 0x8b, 0x74, 0xff, 0x8a, 0x6d,
-  0x50, 0xff, 0x77, 0x56, 0x33, 0xff, 0xc0, 0xb0, 0xa0, 0xff, 0xf7, 0xf5,
-  0xf3, 0xff, 0x9b, 0x82, 0x69, 0xff, 0x98, 0x7e, 0x64, 0xff, 0xae, 0x99,
-  0x85, 0xff, 0x89, 0x6c, 0x4f, 0xff, 0xba, 0xa9, 0x97, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfa, 0xf8, 0xf7, 0xff, 0xc8, 0xbb,
-  0xad, 0xff, 0xa8, 0x92, 0x7d, 0xff, 0xaf, 0x9b, 0x86, 0xff, 0xe0, 0xd8,
-  0xd0, 0xff, 0xba, 0xa8, 0x97, 0xff, 0x7d, 0x5c, 0x3b, 0xff, 0xda, 0xd1,
-  0xc8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd, 0xfc,
-  0xfc, 0xff, 0xb7, 0xa6, 0x94, 0xff, 0x7e, 0x5f, 0x3e, 0xff, 0xc3, 0xb4,
-  0xa5, 0xff, 0xb0, 0x9c, 0x88, 0xff, 0xb2, 0x9f, 0x8c, 0xff, 0xc2, 0xb3,
-  0xa3, 0xff, 0x7d, 0x5d, 0x3c, 0xff, 0xbc, 0xac, 0x9b, 0xff, 0xfe, 0xfd,
-  0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd5, 0xcb,
-  0xc0, 0xff, 0x7b, 0x5a, 0x38, 0xff, 0xbf, 0xaf, 0x9f, 0xff, 0xde, 0xd5,
-  0xcd, 0xff, 0xad, 0x99, 0x84, 0xff, 0xa9, 0x93, 0x7e, 0xff, 0xcc, 0xbf,
-  0xb3, 0xff, 0xfb, 0xfa, 0xf9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd3, 0xc9,
-  0xbe, 0xff, 0x76, 0x54, 0x32, 0xff, 0x68, 0x43, 0x1d, 0xff, 0x72, 0x4f,
-  0x2c, 0xff, 0xd9, 0xcf, 0xc6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd2, 0xc7,
-  0xbc, 0xff, 0x9d, 0x84, 0x6c, 0xff, 0x97, 0x7e, 0x64, 0xff, 0x7f, 0x5f,
-  0x3f, 0xff, 0xdb, 0xd2, 0xc9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd8, 0xce,
-  0xc4, 0xff, 0x7e, 0x5e, 0x3d, 0xff, 0x94, 0x7a, 0x5f, 0xff, 0x99, 0x80,
-  0x66, 0xff, 0xd4, 0xc9, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xd3, 0xc8,
-  0xbd, 0xff, 0x6f, 0x4b, 0x27, 0xff, 0x68, 0x43, 0x1c, 0xff, 0x79, 0x58,
-  0x37, 0xff, 0xd9, 0xd0, 0xc6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xfe, 0xff, 0x94, 0x79, 0x60, 0xff, 0x50, 0x25,
-  0x00, 0xff, 0x52, 0x27, 0x00, 0xff, 0x77, 0x56, 0x35, 0xff, 0xf6, 0xf4,
-  0xf2, 0xff, 0xeb, 0xe6, 0xe1, 0xff, 0x6f, 0x4b, 0x28, 0xff, 0x51, 0x26,
-  0x00, 0xff, 0x52, 0x27, 0x00, 0xff, 0xb5, 0xa3, 0x91, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xe8, 0xe2, 0xdc, 0xff, 0xa4, 0x8e, 0x77, 0xff, 0xa7, 0x91,
-  0x7b, 0xff, 0xeb, 0xe6, 0xe1, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0x98,
-  0x85, 0xff, 0x51, 0x25, 0x00, 0xff, 0x51, 0x25, 0x00, 0xff, 0x73, 0x50,
-  0x2e, 0xff, 0xef, 0xeb, 0xe7, 0xff, 0xf2, 0xef, 0xec, 0xff, 0x71, 0x4e,
-  0x2c, 0xff, 0x52, 0x27, 0x00, 0xff, 0x50, 0x25, 0x00, 0xff, 0x9c, 0x84,
-  0x6c, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xad, 0x99, 0x84, 0xff, 0x54, 0x2a, 0x01, 0xff, 0x52, 0x27,
-  0x00, 0xff, 0x90, 0x75, 0x59, 0xff, 0xfc, 0xfc, 0xfb, 0xff, 0xe3, 0xdc,
-  0xd6, 0xff, 0x63, 0x3c, 0x17, 0xff, 0x52, 0x27, 0x00, 0xff, 0x53, 0x29,
-  0x00, 0xff, 0xbb, 0xaa, 0x99, 0xff, 0xff, 0xff, 0xff, 0xff, 0x94, 0x7a,
-  0x5f, 0xff, 0x51, 0x26, 0x00, 0xff, 0x51, 0x26, 0x00, 0xff, 0x9c, 0x84,
-  0x6b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb3, 0xa0, 0x8d, 0xff, 0x52, 0x27,
-  0x00, 0xff, 0x51, 0x27, 0x00, 0xff, 0x69, 0x44, 0x20, 0xff, 0xea, 0xe5,
-  0xe0, 0xff, 0xfa, 0xf8, 0xf7, 0xff, 0x89, 0x6c, 0x4e, 0xff, 0x51, 0x27,
-  0x00, 0xff, 0x56, 0x2c, 0x03, 0xff, 0xb5, 0xa2, 0x8f, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf4, 0xf1,
-  0xee, 0xff, 0xb9, 0xa8, 0x96, 0xff, 0xb0, 0x9d, 0x89, 0xff, 0xea, 0xe5,
-  0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xfa, 0xf9, 0xff, 0xad, 0x99,
-  0x84, 0xff, 0x70, 0x4c, 0x28, 0xff, 0x8e, 0x73, 0x56, 0xff, 0xed, 0xe8,
-  0xe3, 0xff, 0xfa, 0xf8, 0xf7, 0xff, 0x7e, 0x5e, 0x40, 0xff, 0x50, 0x25,
-  0x00, 0xff, 0x50, 0x25, 0x00, 0xff, 0x87, 0x69, 0x4d, 0xff, 0xfd, 0xfc,
-  0xfc, 0xff, 0xea, 0xe5, 0xe0, 0xff, 0x8f, 0x73, 0x57, 0xff, 0x74, 0x52,
-  0x2f, 0xff, 0xb8, 0xa6, 0x95, 0xff, 0xfd, 0xfd, 0xfd, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xe7, 0xe1, 0xdb, 0xff, 0xaf, 0x9b, 0x86, 0xff, 0xbd, 0xac,
-  0x9c, 0xff, 0xf6, 0xf4, 0xf1, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0xfc, 0xfb, 0xff, 0xf1, 0xee,
-  0xeb, 0xff, 0xfa, 0xf8, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc9, 0xbc,
-  0xae, 0xff, 0x75, 0x52, 0x2f, 0xff, 0x75, 0x53, 0x30, 0xff, 0x76, 0x54,
-  0x31, 0xff, 0x77, 0x55, 0x33, 0xff, 0xcf, 0xc4, 0xb8, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xfa, 0xf9, 0xf8, 0xff, 0xf4, 0xf1, 0xef, 0xff, 0xfe, 0xfd,
-  0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf6, 0xf3, 0xf1, 0xff, 0xf1, 0xed,
-  0xea, 0xff, 0xc8, 0xbb, 0xad, 0xff, 0x7a, 0x59, 0x38, 0xff, 0xcd, 0xc0,
-  0xb4, 0xff, 0xf7, 0xf5, 0xf3, 0xff, 0xf7, 0xf5, 0xf3, 0xff, 0xc6, 0xb8,
-  0xa9, 0xff, 0x79, 0x58, 0x36, 0xff, 0xce, 0xc2, 0xb5, 0xff, 0xf1, 0xed,
-  0xea, 0xff, 0xf7, 0xf5, 0xf3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xde, 0xd6,
-  0xcd, 0xff, 0x7f, 0x60, 0x3f, 0xff, 0x6e, 0x4a, 0x26, 0xff, 0x70, 0x4d,
-  0x29, 0xff, 0xcc, 0xbf, 0xb3, 0xff, 0xf5, 0xf2, 0xef, 0xff, 0xd2, 0xc7,
-  0xbb, 0xff, 0xd4, 0xc9, 0xbe, 0xff, 0xf6, 0xf4, 0xf2, 0xff, 0xc4, 0xb5,
-  0xa6, 0xff, 0x6e, 0x4a, 0x25, 0xff, 0x6e, 0x4a, 0x26, 0xff, 0x84, 0x66,
-  0x47, 0xff, 0xe3, 0xdd, 0xd6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa0, 0x89, 0x72, 0xff, 0x50, 0x25,
-  0x00, 0xff, 0x52, 0x27, 0x00, 0xff, 0x71, 0x4e, 0x2c, 0xff, 0xdd, 0xd4,
-  0xcc, 0xff, 0x92, 0x77, 0x5c, 0xff, 0x92, 0x78, 0x5c, 0xff, 0x90, 0x75,
-  0x59, 0xff, 0x98, 0x7e, 0x64, 0xff, 0xdd, 0xd4, 0xcc, 0xff, 0x6a, 0x46,
-  0x22, 0xff, 0x52, 0x27, 0x00, 0xff, 0x51, 0x26, 0x00, 0xff, 0xa9, 0x94,
-  0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xb2, 0x9f, 0x8c, 0xff, 0x54, 0x2a, 0x01, 0xff, 0x50, 0x25,
-  0x00, 0xff, 0x85, 0x66, 0x48, 0xff, 0xa6, 0x90, 0x7a, 0xff, 0xa0, 0x88,
-  0x71, 0xff, 0xa6, 0x91, 0x7a, 0xff, 0xaa, 0x96, 0x80, 0xff, 0x9a, 0x81,
-  0x69, 0xff, 0xac, 0x98, 0x83, 0xff, 0x7e, 0x5e, 0x3e, 0xff, 0x50, 0x25,
-  0x00, 0xff, 0x56, 0x2c, 0x04, 0xff, 0xbc, 0xab, 0x9a, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf3, 0xf1,
-  0xee, 0xff, 0xb3, 0xa1, 0x8d, 0xff, 0xa3, 0x8c, 0x75, 0xff, 0xe1, 0xda,
-  0xd2, 0xff, 0x9f, 0x87, 0x71, 0xff, 0xb2, 0x9e, 0x8b, 0xff, 0x70, 0x4c,
-  0x28, 0xff, 0x78, 0x56, 0x34, 0xff, 0xad, 0x99, 0x85, 0xff, 0xa7, 0x92,
-  0x7d, 0xff, 0xdf, 0xd7, 0xce, 0xff, 0xa1, 0x89, 0x72, 0xff, 0xb7, 0xa5,
-  0x93, 0xff, 0xf6, 0xf4, 0xf2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc3, 0xb4,
-  0xa5, 0xff, 0x8c, 0x70, 0x53, 0xff, 0xb8, 0xa6, 0x94, 0xff, 0xb8, 0xa6,
-  0x94, 0xff, 0x89, 0x6c, 0x4e, 0xff, 0xcc, 0xc0, 0xb3, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfa, 0xf8, 0xf7, 0xff, 0xb6, 0xa4,
-  0x92, 0xff, 0x8d, 0x71, 0x54, 0xff, 0x8d, 0x71, 0x55, 0xff, 0xbc, 0xac,
-  0x9b, 0xff, 0xfb, 0xfb, 0xfa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0xfe, 0xff, 0xf3, 0xf1,
-  0xee, 0xff, 0xf4, 0xf2, 0xef, 0xff, 0xfe, 0xfe, 0xfe, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00
+#define JSON_CHUNK_SIZE 512     // Stack buffer for streamed JSON responses
+
+// Web assets embedded by CMakeLists.txt (web/*, text assets gzipped at build time)
+extern const uint8_t index_html_gz_start[] asm("_binary_index_html_gz_start");
+extern const uint8_t index_html_gz_end[] asm("_binary_index_html_gz_end");
+extern const uint8_t favicon_ico_gz_start[] asm("_binary_favicon_ico_gz_start");
+extern const uint8_t favicon_ico_gz_end[] asm("_binary_favicon_ico_gz_end");
+extern const uint8_t logo_webp_start[] asm("_binary_logo_webp_start");
+extern const uint8_t logo_webp_end[] asm("_binary_logo_webp_end");
+
+typedef struct {
+    const uint8_t* start;
+    const uint8_t* end;
+    bool gzip;
+} asset_blob_t;
+
+typedef struct {
+    const char* name;           // Path inside the web pack
+    const char* type;
+    const char* cache_control;
+    asset_blob_t builtin;       // Compiled into the app image
+    asset_blob_t served;        // Web pack entry when present, else builtin
+    char etag[20];              // "\"<fnv1a-64 hex>\"", filled on first use
+} web_asset_t;
+
+// The SPA is revalidated on every load so a firmware update shows at once;
+// the images change rarely and are cached for a week
+static web_asset_t s_asset_spa = {
+    "index.html", "text/html", "private, no-cache",
+    { index_html_gz_start, index_html_gz_end, true }, { 0 }, ""
+};
+static web_asset_t s_asset_favicon = {
+    "favicon.ico", "image/x-icon", "public, max-age=604800",
+    { favicon_ico_gz_start, favicon_ico_gz_end, true }, { 0 }, ""
 };
-static const size_t s_favicon_ico_len = 4286;
+static web_asset_t s_asset_logo = {
+    "logo.webp", "image/webp", "public, max-age=604800",
+    { logo_webp_start, logo_webp_end, false }, { 0 }, ""
+};
+
+static web_asset_t* const s_assets[] = { &s_asset_spa, &s_asset_favicon, &s_asset_logo };
+#define WEB_ASSET_COUNT (sizeof(s_assets) / sizeof(s_assets[0]))
 
-// Logo data (200x62 .webp file)
-// Generated from: xxd -i Xtragen-logo-200x62.webp
-#include "xtragen_logo_data.h"
+/*
+ * Web pack: the same assets in the storage partition, built by
+ * tools/mkwebpack.py. SPIFFS files are not contiguous in flash and cannot
+ * be mapped, so the partition holds a flat image instead: header, entry
+ * table, then each asset's bytes. The image is mapped once and assets are
+ * sent straight from the mapping.
+ */
+#define WEB_PACK_MAGIC      0x314B5057  // "WPK1"
+#define WEB_PACK_VERSION    1
+#define WEB_PACK_NAME_MAX   32
+#define WEB_PACK_FLAG_GZIP  0x1
+#define WEB_PACK_CHUNK      4096        // Bytes per httpd_resp_send_chunk() from flash
+#define WEB_PACK_SECTOR     4096
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t size;              // Whole image, header included
+    uint32_t crc32;             // esp_rom_crc32_le(0, ...) over everything after the header
+} web_pack_header_t;
+
+typedef struct __attribute__((packed)) {
+    char name[WEB_PACK_NAME_MAX];
+    uint32_t offset;            // From the start of the image
+    uint32_t length;
+    uint32_t flags;
+} web_pack_entry_t;
+
+#if CONFIG_HTTP_UI_WEB_PACK
+static const esp_partition_t* s_pack_part = NULL;
+static esp_partition_mmap_handle_t s_pack_map;
+static const uint8_t* s_pack = NULL;    // Mapped image, NULL when not in use
+#endif
 
 // State
 static httpd_handle_t s_server = NULL;
@@ -457,21 +179,21 @@ static esp_err_t check_basic_auth(httpd_req_t* req)
         return ESP_ERR_INVALID_STATE;
     }
 
-    char* buf = calloc(1, buf_len);
+    char* buf = diag_mem_calloc(DIAG_MEM_HTTP, 1, buf_len);
     if (!buf) {
         ESP_LOGE(TAG, "Failed to allocate memory for auth header");
         return ESP_ERR_NO_MEM;
     }
 
     if (httpd_req_get_hdr_value_str(req, "Authorization", buf, buf_len) != ESP_OK) {
-        free(buf);
+        diag_mem_free(buf);
         return ESP_ERR_INVALID_STATE;
     }
 
     // Compare with expected digest
     bool authorized = (strcmp(s_auth_digest, buf) == 0);
 
-    free(buf);
+    diag_mem_free(buf);
     return authorized ? ESP_OK : ESP_ERR_INVALID_STATE;
 }
 
@@ -488,16 +210,408 @@ static esp_err_t send_401(httpd_req_t* req)
     return ESP_OK;
 }
 
+static esp_err_t json_chunk_flush(void* ctx, const char* data, size_t len)
+{
+    return httpd_resp_send_chunk((httpd_req_t*)ctx, data, len);
+}
+
 /**
- * GET /status - Return device status as JSON
+ * End a JSON response streamed through json_chunk_flush()
+ * Headers are already on the wire, so a failure can only drop the
+ * connection; returning ESP_FAIL makes httpd close it.
  */
-static esp_err_t status_get_handler(httpd_req_t* req)
+static esp_err_t json_resp_end(httpd_req_t* req, json_writer_t* w)
 {
-    // Check auth
-    if (check_basic_auth(req) != ESP_OK) {
-        return send_401(req);
+    esp_err_t ret = json_writer_finish(w);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "JSON response aborted after %u bytes: %s",
+                 (unsigned)w->total, esp_err_to_name(ret));
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// Bounds for ui/live_ms (live status push period)
+#define LIVE_MIN_MS 200
+#define LIVE_MAX_MS 10000
+
+#if CONFIG_HTTPD_WS_SUPPORT
+/*
+ * Live status over WebSocket (GET /ws)
+ *
+ * Basic auth is checked once, on the upgrade request. After that the
+ * device pushes: a full snapshot when a client connects, then only the
+ * fields that changed. Pushes are checked every ui/live_ms and right away
+ * on NET_READY/NET_LOST/UDP_STARTED/UDP_STOPPED/TIME_SYNCED.
+ *
+ * All client bookkeeping and sending happens on the httpd task (handshake,
+ * close_fn and httpd_queue_work), so it needs no lock. The timer and event
+ * handlers only queue the work.
+ */
+#define LIVE_MAX_CLIENTS 4
+#define LIVE_MSG_MAX 512
+#define LIVE_HEAP_STEP 1024         // heap_free moves constantly; report 1 KB steps
+
+typedef struct {
+    bool net_ready;
+    char ip[16];
+    int rssi;
+    uint32_t heap_free;
+    uint32_t udp_packets_sent;
+    uint32_t udp_bytes_sent;
+    uint32_t udp_send_errors;
+    uint32_t udp_stream_samples;
+    uint32_t udp_stream_drops;
+    sntp_status_t sntp_status;
+    int64_t sntp_last_sync;
+} live_status_t;
+
+typedef struct {
+    int fd;                     // -1 = free slot
+    bool need_full;
+} live_client_t;
+
+static live_client_t s_live_clients[LIVE_MAX_CLIENTS];
+static atomic_int s_live_count = 0;
+static atomic_bool s_live_queued = false;
+static live_status_t s_live_last;   // Values as last reported
+static esp_timer_handle_t s_live_timer = NULL;
+
+static const char* sntp_status_name(sntp_status_t status)
+{
+    switch (status) {
+        case SNTP_STATUS_SYNCING: return "syncing";
+        case SNTP_STATUS_SYNCED: return "synced";
+        case SNTP_STATUS_ERROR: return "error";
+        default: return "idle";
+    }
+}
+
+static void live_collect(live_status_t* st)
+{
+    memset(st, 0, sizeof(*st));
+    st->net_ready = net_mgr_is_ready();
+    strcpy(st->ip, "0.0.0.0");
+    net_mgr_get_ip(st->ip, sizeof(st->ip));
+    net_mgr_get_rssi(&st->rssi);
+    st->heap_free = esp_get_free_heap_size();
+
+    udp_broadcast_stats_t udp;
+    if (udp_broadcast_get_stats(&udp) == ESP_OK) {
+        st->udp_packets_sent = udp.packets_sent;
+        st->udp_bytes_sent = udp.bytes_sent;
+        st->udp_send_errors = udp.send_errors;
+        st->udp_stream_samples = udp.stream_samples_sent;
+        st->udp_stream_drops = udp.stream_drops;
+    }
+
+    st->sntp_status = SNTP_STATUS_IDLE;
+    sntp_client_get_status(&st->sntp_status);
+    time_t last_sync = 0;
+    if (sntp_client_get_last_sync_time(&last_sync) == ESP_OK) {
+        st->sntp_last_sync = (int64_t)last_sync;
+    }
+}
+
+/**
+ * Render a full snapshot (prev == NULL) or the fields that differ from prev
+ * Returns the message length, 0 if nothing changed, -1 on overflow.
+ */
+static int live_render(const live_status_t* cur, const live_status_t* prev, char* buf, size_t cap)
+{
+    bool full = (prev == NULL);
+    bool any = full;
+    json_writer_t w;
+    json_writer_init(&w, buf, cap, NULL, NULL);
+
+    json_writer_begin_object(&w, NULL);
+    json_writer_string(&w, "type", full ? "full" : "delta");
+    json_writer_uint(&w, "uptime_s", (uint32_t)(esp_timer_get_time() / 1000000ULL));
+
+    if (full) {
+        char device_id[32] = {0};
+        char mac_str[18] = "00:00:00:00:00:00";
+        config_mgr_get_string("sys/device_id", device_id, sizeof(device_id));
+        net_mgr_get_mac(mac_str, sizeof(mac_str));
+        json_writer_string(&w, "device_id", device_id);
+        json_writer_string(&w, "mac", mac_str);
+        json_writer_string(&w, "fw_version", version_get_string());
+    }
+
+#define LIVE_CHANGED(field) (full || cur->field != prev->field)
+    if (LIVE_CHANGED(net_ready)) {
+        json_writer_bool(&w, "net_ready", cur->net_ready);
+        any = true;
+    }
+    if (full || strcmp(cur->ip, prev->ip) != 0) {
+        json_writer_string(&w, "ip", cur->ip);
+        any = true;
+    }
+    if (LIVE_CHANGED(rssi)) {
+        json_writer_int(&w, "rssi", cur->rssi);
+        any = true;
+    }
+    uint32_t heap_diff = full ? 0 : (cur->heap_free > prev->heap_free ? cur->heap_free - prev->heap_free
+                                                                        : prev->heap_free - cur->heap_free);
+    if (full || heap_diff >= LIVE_HEAP_STEP) {
+        json_writer_uint(&w, "heap_free", cur->heap_free);
+        any = true;
+    }
+    if (LIVE_CHANGED(udp_packets_sent) || LIVE_CHANGED(udp_send_errors) ||
+        LIVE_CHANGED(udp_stream_samples) || LIVE_CHANGED(udp_stream_drops)) {
+        json_writer_begin_object(&w, "udp_stats");
+        json_writer_uint(&w, "packets_sent", cur->udp_packets_sent);
+        json_writer_uint(&w, "bytes_sent", cur->udp_bytes_sent);
+        json_writer_uint(&w, "send_errors", cur->udp_send_errors);
+        json_writer_uint(&w, "stream_samples_sent", cur->udp_stream_samples);
+        json_writer_uint(&w, "stream_drops", cur->udp_stream_drops);
+        json_writer_end_object(&w);
+        any = true;
+    }
+    if (LIVE_CHANGED(sntp_status)) {
+        json_writer_string(&w, "sntp_status", sntp_status_name(cur->sntp_status));
+        any = true;
+    }
+    if (LIVE_CHANGED(sntp_last_sync) && cur->sntp_last_sync != 0) {
+        json_writer_int(&w, "sntp_last_sync", cur->sntp_last_sync);
+        any = true;
+    }
+#undef LIVE_CHANGED
+
+    json_writer_end_object(&w);
+    if (json_writer_finish(&w) != ESP_OK) {
+        return -1;
+    }
+    return any ? (int)w.len : 0;
+}
+
+/**
+ * Forget a client (httpd task only)
+ */
+static void live_remove_client(int fd)
+{
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) {
+        if (s_live_clients[i].fd == fd) {
+            s_live_clients[i].fd = -1;
+            atomic_fetch_sub(&s_live_count, 1);
+            ESP_LOGI(TAG, "Live status client %d closed", fd);
+            return;
+        }
+    }
+}
+
+/**
+ * httpd work item: sample once, push full or delta to every client
+ */
+static void live_push_work(void* arg)
+{
+    atomic_store(&s_live_queued, false);
+    if (!s_server) {
+        return;
+    }
+
+    live_status_t cur;
+    live_collect(&cur);
+
+    char full_msg[LIVE_MSG_MAX];
+    char delta_msg[LIVE_MSG_MAX];
+    int full_len = -2;              // Rendered on first need
+    int delta_len = live_render(&cur, &s_live_last, delta_msg, sizeof(delta_msg));
+
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) {
+        live_client_t* c = &s_live_clients[i];
+        if (c->fd < 0) {
+            continue;
+        }
+        if (httpd_ws_get_fd_info(s_server, c->fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+            live_remove_client(c->fd);
+            continue;
+        }
+
+        const char* msg = delta_msg;
+        int len = delta_len;
+        if (c->need_full) {
+            if (full_len == -2) {
+                full_len = live_render(&cur, NULL, full_msg, sizeof(full_msg));
+            }
+            msg = full_msg;
+            len = full_len;
+        }
+        if (len <= 0) {
+            continue;
+        }
+
+        httpd_ws_frame_t frame = {
+            .final = true,
+            .type = HTTPD_WS_TYPE_TEXT,
+            .payload = (uint8_t*)msg,
+            .len = (size_t)len,
+        };
+        if (httpd_ws_send_frame_async(s_server, c->fd, &frame) != ESP_OK) {
+            int fd = c->fd;
+            live_remove_client(fd);
+            httpd_sess_trigger_close(s_server, fd);
+            continue;
+        }
+        c->need_full = false;
+    }
+
+    // Deltas are relative to what was last reported; keep the baseline when
+    // nothing changed so slow drifts (heap) still cross the threshold
+    if (delta_len > 0) {
+        s_live_last = cur;
+    }
+}
+
+/**
+ * Schedule a push on the httpd task (any context except ISR)
+ */
+static void live_kick(void)
+{
+    if (!s_server || atomic_load(&s_live_count) == 0) {
+        return;
+    }
+    if (atomic_exchange(&s_live_queued, true)) {
+        return;     // Already queued
+    }
+    if (httpd_queue_work(s_server, live_push_work, NULL) != ESP_OK) {
+        atomic_store(&s_live_queued, false);
+    }
+}
+
+static void live_timer_cb(void* arg)
+{
+    live_kick();
+}
+
+static void live_event_handler(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+    live_kick();
+}
+
+static const int32_t s_live_events[] = {
+    DEVICE_EVENT_NET_READY, DEVICE_EVENT_NET_LOST,
+    DEVICE_EVENT_UDP_STARTED, DEVICE_EVENT_UDP_STOPPED,
+    DEVICE_EVENT_TIME_SYNCED,
+};
+
+static uint32_t live_period_ms(void)
+{
+    uint32_t ms = 0;
+    if (config_mgr_get_u32("ui/live_ms", &ms) != ESP_OK || ms < LIVE_MIN_MS || ms > LIVE_MAX_MS) {
+        ms = 1000;
+    }
+    return ms;
+}
+
+static esp_err_t live_start(void)
+{
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) {
+        s_live_clients[i].fd = -1;
+    }
+    atomic_store(&s_live_count, 0);
+    atomic_store(&s_live_queued, false);
+    memset(&s_live_last, 0, sizeof(s_live_last));
+
+    const esp_timer_create_args_t args = {
+        .callback = live_timer_cb,
+        .name = "http_ui_live",
+    };
+    esp_err_t ret = esp_timer_create(&args, &s_live_timer);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = esp_timer_start_periodic(s_live_timer, (uint64_t)live_period_ms() * 1000ULL);
+    if (ret != ESP_OK) {
+        esp_timer_delete(s_live_timer);
+        s_live_timer = NULL;
+        return ret;
+    }
+
+    for (size_t i = 0; i < sizeof(s_live_events) / sizeof(s_live_events[0]); i++) {
+        event_bus_register(s_live_events[i], live_event_handler, NULL);
+    }
+    return ESP_OK;
+}
+
+static void live_stop(void)
+{
+    for (size_t i = 0; i < sizeof(s_live_events) / sizeof(s_live_events[0]); i++) {
+        event_bus_unregister(s_live_events[i], live_event_handler);
+    }
+    if (s_live_timer) {
+        esp_timer_stop(s_live_timer);
+        esp_timer_delete(s_live_timer);
+        s_live_timer = NULL;
+    }
+}
+
+/**
+ * Apply a new ui/live_ms without restarting the server
+ */
+static void live_set_period(uint32_t ms)
+{
+    if (s_live_timer) {
+        esp_timer_stop(s_live_timer);
+        esp_timer_start_periodic(s_live_timer, (uint64_t)ms * 1000ULL);
+    }
+}
+
+/**
+ * GET /ws - Live status WebSocket
+ * httpd has already answered the upgrade when this runs with HTTP_GET, so
+ * a bad login cannot get a 401; returning ESP_FAIL closes the socket and
+ * the SPA falls back to polling /status (which does prompt for login).
+ */
+static esp_err_t ws_handler(httpd_req_t* req)
+{
+    int fd = httpd_req_to_sockfd(req);
+
+    if (req->method == HTTP_GET) {
+        if (check_basic_auth(req) != ESP_OK) {
+            ESP_LOGW(TAG, "Live status: unauthorized upgrade on socket %d", fd);
+            return ESP_FAIL;
+        }
+        for (int i = 0; i < LIVE_MAX_CLIENTS; i++) {
+            if (s_live_clients[i].fd < 0) {
+                s_live_clients[i].fd = fd;
+                s_live_clients[i].need_full = true;
+                atomic_fetch_add(&s_live_count, 1);
+                ESP_LOGI(TAG, "Live status client %d connected", fd);
+                live_kick();
+                return ESP_OK;
+            }
+        }
+        ESP_LOGW(TAG, "Live status: all %d client slots in use", LIVE_MAX_CLIENTS);
+        return ESP_FAIL;
+    }
+
+    // Clients have nothing to say; read and drop small text frames
+    uint8_t buf[64];
+    httpd_ws_frame_t frame = { .payload = buf };
+    esp_err_t ret = httpd_ws_recv_frame(req, &frame, 0);
+    if (ret != ESP_OK || frame.len > sizeof(buf)) {
+        return ESP_FAIL;
     }
+    return httpd_ws_recv_frame(req, &frame, sizeof(buf));
+}
+
+/**
+ * Socket close hook: drop live status clients, then close as httpd would
+ */
+static void http_ui_close_fn(httpd_handle_t hd, int sockfd)
+{
+    live_remove_client(sockfd);
+    close(sockfd);
+}
+#endif
 
+/**
+ * Write the /status object into w
+ * Shared by the handler and the test-build benchmark hook.
+ */
+static void status_write_json(json_writer_t* w)
+{
     // Get device info
     char device_id[32] = {0};
     char ip_str[16] = "0.0.0.0";
@@ -517,26 +631,128 @@ static esp_err_t status_get_handler(httpd_req_t* req)
     int rssi = 0;
     net_mgr_get_rssi(&rssi);
 
-    // Build JSON response
-    cJSON* root = cJSON_CreateObject();
-    if (!root) {
-        httpd_resp_send_500(req);
-        return ESP_FAIL;
+    json_writer_begin_object(w, NULL);
+    json_writer_string(w, "device_id", device_id);
+    json_writer_string(w, "ip", ip_str);
+    json_writer_string(w, "mac", mac_str);
+    json_writer_string(w, "netmask", netmask_str);
+    json_writer_string(w, "gateway", gateway_str);
+    json_writer_string(w, "fw_version", fw_version);
+    json_writer_uint(w, "uptime_s", uptime_s);
+    json_writer_uint(w, "heap_free", heap_free);
+    json_writer_int(w, "rssi", rssi);
+    json_writer_string(w, "wifi_power", net_mgr_power_profile_name(net_mgr_get_power_profile()));
+
+    net_mgr_roam_stats_t roam;
+    if (net_mgr_get_roam_stats(&roam) == ESP_OK) {
+        json_writer_begin_object(w, "wifi_roam");
+        json_writer_uint(w, "roams", roam.roams);
+        json_writer_uint(w, "failed", roam.failed);
+        json_writer_uint(w, "scans", roam.scans);
+        json_writer_uint(w, "last_assoc_ms", roam.last_assoc_ms);
+        json_writer_uint(w, "last_downtime_ms", roam.last_downtime_ms);
+        json_writer_end_object(w);
+    }
+
+    // UDP stats
+    json_writer_begin_object(w, "udp_stats");
+    udp_broadcast_stats_t udp;
+    if (udp_broadcast_get_stats(&udp) == ESP_OK) {
+        json_writer_uint(w, "packets_sent", udp.packets_sent);
+        json_writer_uint(w, "bytes_sent", udp.bytes_sent);
+        json_writer_uint(w, "send_errors", udp.send_errors);
+        json_writer_uint(w, "stream_packets_sent", udp.stream_packets_sent);
+        json_writer_uint(w, "stream_samples_sent", udp.stream_samples_sent);
+        json_writer_uint(w, "stream_drops", udp.stream_drops);
+        json_writer_uint(w, "stream_overruns", udp.stream_overruns);
+        json_writer_uint(w, "tx_retries", udp.tx_retries);
+        json_writer_uint(w, "tx_pool_exhausted", udp.tx_pool_exhausted);
+        json_writer_uint(w, "tx_stale_drops", udp.tx_stale_drops);
+        json_writer_uint(w, "tx_latency_last_us", udp.tx_latency_last_us);
+        json_writer_uint(w, "tx_latency_max_us", udp.tx_latency_max_us);
+    }
+    udp_dest_stats_t dest_stats[UDP_MAX_DESTINATIONS];
+    size_t dest_count = 0;
+    if (udp_broadcast_get_dest_stats(dest_stats, UDP_MAX_DESTINATIONS, &dest_count) == ESP_OK) {
+        json_writer_begin_array(w, "destinations");
+        for (size_t i = 0; i < dest_count; i++) {
+            json_writer_begin_object(w, NULL);
+            json_writer_string(w, "addr", dest_stats[i].dest.addr);
+            json_writer_uint(w, "port", dest_stats[i].dest.port);
+            json_writer_uint(w, "packets_sent", dest_stats[i].packets_sent);
+            json_writer_uint(w, "bytes_sent", dest_stats[i].bytes_sent);
+            json_writer_uint(w, "send_errors", dest_stats[i].send_errors);
+            json_writer_int(w, "last_errno", dest_stats[i].last_errno);
+            json_writer_end_object(w);
+        }
+        json_writer_end_array(w);
+    }
+    json_writer_end_object(w);
+
+    // Config cache stats
+    config_mgr_cache_stats_t cache_stats;
+    if (config_mgr_get_cache_stats(&cache_stats) == ESP_OK) {
+        json_writer_begin_object(w, "config_cache");
+        json_writer_uint(w, "hits", cache_stats.hits);
+        json_writer_uint(w, "misses", cache_stats.misses);
+        json_writer_uint(w, "entries", cache_stats.entries);
+        json_writer_end_object(w);
     }
 
-    cJSON_AddStringToObject(root, "device_id", device_id);
-    cJSON_AddStringToObject(root, "ip", ip_str);
-    cJSON_AddStringToObject(root, "mac", mac_str);
-    cJSON_AddStringToObject(root, "netmask", netmask_str);
-    cJSON_AddStringToObject(root, "gateway", gateway_str);
-    cJSON_AddStringToObject(root, "fw_version", fw_version);
-    cJSON_AddNumberToObject(root, "uptime_s", uptime_s);
-    cJSON_AddNumberToObject(root, "heap_free", heap_free);
-    cJSON_AddNumberToObject(root, "rssi", rssi);
+    // diag_mem usage by purpose (bytes requested, by region)
+    json_writer_begin_object(w, "mem");
+    for (int p = 0; p < DIAG_MEM_PURPOSE_COUNT; p++) {
+        diag_mem_usage_t mu;
+        if (diag_mem_get_usage((diag_mem_purpose_t)p, &mu) != ESP_OK || mu.allocs == 0) {
+            continue;
+        }
+        json_writer_begin_object(w, diag_mem_purpose_name((diag_mem_purpose_t)p));
+        json_writer_uint(w, "internal", mu.internal_bytes);
+        json_writer_uint(w, "psram", mu.psram_bytes);
+        json_writer_uint(w, "peak", mu.peak_bytes);
+        json_writer_uint(w, "allocs", mu.allocs);
+        json_writer_uint(w, "fallbacks", mu.fallbacks);
+        json_writer_uint(w, "failures", mu.failures);
+        json_writer_end_object(w);
+    }
+    json_writer_end_object(w);
+
+    // Profiler: heap fragmentation and per-task CPU/stack
+    diag_profile_t profile;
+    if (diag_profiler_get(&profile) == ESP_OK) {
+        json_writer_begin_object(w, "profiler");
+        const diag_heap_sample_t* heaps[] = { &profile.internal, &profile.psram };
+        const char* const heap_names[] = { "heap_internal", "heap_psram" };
+        for (int i = 0; i < 2; i++) {
+            if (heaps[i]->total == 0) {
+                continue;
+            }
+            json_writer_begin_object(w, heap_names[i]);
+            json_writer_uint(w, "total", heaps[i]->total);
+            json_writer_uint(w, "free", heaps[i]->free);
+            json_writer_uint(w, "largest_free_block", heaps[i]->largest_free_block);
+            json_writer_uint(w, "min_free_ever", heaps[i]->min_free_ever);
+            json_writer_end_object(w);
+        }
 
-    // UDP stats (placeholder - will be implemented when UDP module supports stats query)
-    cJSON* udp_stats = cJSON_CreateObject();
-    cJSON_AddItemToObject(root, "udp_stats", udp_stats);
+        diag_task_sample_t* tasks = diag_mem_alloc(DIAG_MEM_HTTP, sizeof(diag_task_sample_t) * CONFIG_DIAG_PROFILER_MAX_TASKS);
+        size_t task_count = 0;
+        if (tasks && diag_profiler_get_tasks(tasks, CONFIG_DIAG_PROFILER_MAX_TASKS, &task_count) == ESP_OK) {
+            json_writer_begin_array(w, "tasks");
+            for (size_t i = 0; i < task_count; i++) {
+                json_writer_begin_object(w, NULL);
+                json_writer_string(w, "name", tasks[i].name);
+                json_writer_double(w, "cpu_pct", tasks[i].cpu_permille / 10.0);
+                json_writer_uint(w, "stack_hwm", tasks[i].stack_hwm);
+                json_writer_int(w, "core", tasks[i].core);
+                json_writer_uint(w, "prio", tasks[i].priority);
+                json_writer_end_object(w);
+            }
+            json_writer_end_array(w);
+        }
+        diag_mem_free(tasks);
+        json_writer_end_object(w);
+    }
 
     // SNTP status
     sntp_status_t sntp_status;
@@ -548,19 +764,74 @@ static esp_err_t status_get_handler(httpd_req_t* req)
             case SNTP_STATUS_SYNCED: sntp_status_str = "synced"; break;
             case SNTP_STATUS_ERROR: sntp_status_str = "error"; break;
         }
-        cJSON_AddStringToObject(root, "sntp_status", sntp_status_str);
+        json_writer_string(w, "sntp_status", sntp_status_str);
 
         // Add last sync time if synced
         time_t last_sync;
         if (sntp_client_get_last_sync_time(&last_sync) == ESP_OK) {
-            cJSON_AddNumberToObject(root, "sntp_last_sync", (double)last_sync);
+            json_writer_int(w, "sntp_last_sync", (int64_t)last_sync);
         }
 
         // Add timezone
         char timezone[64] = {0};
         if (sntp_client_get_timezone(timezone, sizeof(timezone)) == ESP_OK) {
-            cJSON_AddStringToObject(root, "sntp_timezone", timezone);
+            json_writer_string(w, "sntp_timezone", timezone);
+        }
+    }
+
+    // Clock model and per-server NTP results
+    sntp_client_time_stats_t ts;
+    if (sntp_client_get_time_stats(&ts) == ESP_OK) {
+        static const char* const quality_names[] = { "none", "holdover", "synced" };
+        json_writer_begin_object(w, "time");
+        json_writer_string(w, "quality", quality_names[ts.quality]);
+        if (ts.quality != SNTP_TIME_QUALITY_NONE) {
+            json_writer_uint(w, "error_us", ts.error_us);
+            json_writer_int(w, "offset_us", ts.offset_us);
+            json_writer_uint(w, "delay_us", ts.delay_us);
+            if (ts.drift_known) {
+                json_writer_int(w, "drift_ppb", ts.drift_ppb);
+            }
+            json_writer_uint(w, "poll_s", ts.poll_s);
+            json_writer_uint(w, "steps", ts.steps);
+            json_writer_uint(w, "slews", ts.slews);
+        }
+        json_writer_begin_array(w, "servers");
+        for (int i = 0; i < SNTP_CLIENT_SERVER_COUNT; i++) {
+            const sntp_client_server_stats_t* sv = &ts.servers[i];
+            json_writer_begin_object(w, NULL);
+            json_writer_string(w, "host", sv->host);
+            json_writer_bool(w, "reachable", sv->reachable);
+            if (sv->replies > 0) {
+                json_writer_uint(w, "stratum", sv->stratum);
+                json_writer_int(w, "offset_us", sv->offset_us);
+                json_writer_uint(w, "delay_us", sv->delay_us);
+            }
+            json_writer_uint(w, "replies", sv->replies);
+            json_writer_uint(w, "failures", sv->failures);
+            json_writer_end_object(w);
+        }
+        json_writer_end_array(w);
+        json_writer_end_object(w);
+    }
+
+    // OTA progress (URL download or upload), kept after it ends until the next one
+    ota_mgr_progress_t ota;
+    if (ota_mgr_get_progress(&ota) == ESP_OK && ota.source != OTA_MGR_SOURCE_NONE) {
+        json_writer_begin_object(w, "ota");
+        json_writer_bool(w, "active", ota.active);
+        json_writer_string(w, "source", ota.source == OTA_MGR_SOURCE_UPLOAD ? "upload" : "url");
+        json_writer_uint(w, "bytes_done", ota.bytes_done);
+        json_writer_uint(w, "bytes_total", ota.bytes_total);
+        if (ota.resumed_from) {
+            json_writer_uint(w, "resumed_from", ota.resumed_from);
+        }
+        if (ota.bytes_total) {
+            json_writer_uint(w, "percent", (uint64_t)ota.bytes_done * 100 / ota.bytes_total);
         }
+        json_writer_uint(w, "elapsed_ms", ota.elapsed_ms);
+        json_writer_uint(w, "rate_kbps", ota.rate_kbps);
+        json_writer_end_object(w);
     }
 
     // Security warning if weak password (IMPLEMENTATION_PLAN.md requirement)
@@ -570,9 +841,9 @@ static esp_err_t status_get_handler(httpd_req_t* req)
 
             // Handle clock reset (current time before stored timestamp)
             if (current_time < s_first_boot_timestamp) {
-                cJSON_AddStringToObject(root, "security_warning",
+                json_writer_string(w, "security_warning",
                     "Clock reset detected! Waiting for time sync. Change password now!");
-                cJSON_AddBoolToObject(root, "setup_mode", false);
+                json_writer_bool(w, "setup_mode", false);
             } else {
                 time_t elapsed_sec = current_time - s_first_boot_timestamp;
                 time_t remaining_sec = SETUP_MODE_DURATION_SEC - elapsed_sec;
@@ -582,557 +853,1392 @@ static esp_err_t status_get_handler(httpd_req_t* req)
                     snprintf(warning, sizeof(warning),
                             "SETUP MODE: Default password active. %ld min remaining. Change password now!",
                             (long)(remaining_sec / 60));
-                    cJSON_AddStringToObject(root, "security_warning", warning);
-                    cJSON_AddBoolToObject(root, "setup_mode", true);
+                    json_writer_string(w, "security_warning", warning);
+                    json_writer_bool(w, "setup_mode", true);
                 } else {
-                    cJSON_AddStringToObject(root, "security_warning",
+                    json_writer_string(w, "security_warning",
                         "CRITICAL: Setup mode expired. HTTP UI will be disabled on next restart!");
-                    cJSON_AddBoolToObject(root, "setup_mode", false);
+                    json_writer_bool(w, "setup_mode", false);
                 }
             }
         } else {
             // No timestamp stored yet - waiting for time sync
-            cJSON_AddStringToObject(root, "security_warning",
+            json_writer_string(w, "security_warning",
                 "Default password in use! Waiting for time sync. Change immediately.");
-            cJSON_AddBoolToObject(root, "setup_mode", true);
+            json_writer_bool(w, "setup_mode", true);
         }
     }
 
-    char* json_str = cJSON_PrintUnformatted(root);
-    cJSON_Delete(root);
+    json_writer_end_object(w);
+}
 
-    if (!json_str) {
-        httpd_resp_send_500(req);
-        return ESP_FAIL;
+/**
+ * GET /status - Return device status as JSON
+ */
+static esp_err_t status_get_handler(httpd_req_t* req)
+{
+    // Check auth
+    if (check_basic_auth(req) != ESP_OK) {
+        return send_401(req);
     }
 
+    // Stream the response; nothing is allocated per field
+    char chunk[JSON_CHUNK_SIZE];
+    json_writer_t w;
     httpd_resp_set_type(req, "application/json");
-    httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
+    json_writer_init(&w, chunk, sizeof(chunk), json_chunk_flush, req);
+    status_write_json(&w);
+    return json_resp_end(req, &w);
+}
 
-    free(json_str);
+#ifdef CONFIG_RUN_UNIT_TESTS
+static esp_err_t status_count_flush(void* ctx, const char* data, size_t len)
+{
+    (void)data;
+    *(size_t*)ctx += len;
     return ESP_OK;
 }
 
-/**
- * GET /ui - Single Page Application
- */
-static esp_err_t ui_spa_handler(httpd_req_t* req)
+esp_err_t http_ui_test_build_status(size_t* len_out)
 {
-    if (check_basic_auth(req) != ESP_OK) {
-        return send_401(req);
+    char chunk[JSON_CHUNK_SIZE];
+    size_t flushed = 0;
+    json_writer_t w;
+    json_writer_init(&w, chunk, sizeof(chunk), status_count_flush, &flushed);
+    status_write_json(&w);
+    esp_err_t ret = json_writer_finish(&w);
+    if (len_out) {
+        *len_out = flushed;
     }
+    return ret;
+}
+#endif
 
-    httpd_resp_set_type(req, "text/html");
-
-    // Send SPA shell
-    static const char html_head[] =
-        "<!DOCTYPE html>"
-        "<html lang=\"en\">"
-        "<head>"
-        "<meta charset=\"utf-8\"/>"
-        "<meta name=\"viewport\" content=\"width=device-width,initial-scale=1\"/>"
-        "<title>XT-ESP Control Panel</title>"
-        "<link rel=\"icon\" href=\"/favicon.ico\" type=\"image/x-icon\"/>"
-        "<style>"
-        "body{font-family:Arial,sans-serif;margin:0;padding:0;background:#f5f5f5;color:#333;display:flex;min-height:100vh;}"
-        ".sidebar{width:260px;background:#2c3e50;color:#ecf0f1;display:flex;flex-direction:column;position:fixed;height:100vh;left:0;top:0;overflow:hidden;z-index:100;}"
-        ".logo{padding:20px 15px;text-align:center;background:#ffffff;border-bottom:2px solid #1a252f;flex-shrink:0;}"
-        ".logo img{max-width:90%;height:auto;display:block;margin:0 auto;}"
-        ".menu{flex:1;overflow-y:auto;padding-top:10px;}"
-        ".menu a{display:block;padding:15px 20px;color:#ecf0f1;text-decoration:none;border-left:3px solid transparent;transition:all 0.3s;cursor:pointer;}"
-        ".menu a:hover{background:#34495e;border-left-color:#3498db;}"
-        ".menu a.active{background:#34495e;border-left-color:#3498db;font-weight:bold;}"
-        ".content{margin-left:260px;flex:1;padding:20px;width:calc(100vw - 260px);box-sizing:border-box;min-height:100vh;}"
-        ".page-header{background:#fff;padding:20px;margin-bottom:20px;border-radius:8px;box-shadow:0 2px 4px rgba(0,0,0,0.1);}"
-        ".page-header h1{margin:0;font-size:24px;color:#2c3e50;}"
-        ".card{background:#fff;border:1px solid #ddd;border-radius:8px;padding:20px;margin-bottom:20px;box-shadow:0 2px 4px rgba(0,0,0,0.1);}"
-        ".card h2{margin:0 0 15px;font-size:18px;border-bottom:2px solid:#3498db;padding-bottom:8px;color:#2c3e50;}"
-        ".card h3{margin:16px 0 8px;font-size:14px;color:#666;}"
-        ".form-group{margin-bottom:15px;}"
-        ".form-group label{display:block;margin-bottom:5px;font-weight:bold;color:#555;}"
-        ".form-group input,.form-group select{width:100%;padding:8px;border:1px solid #ddd;border-radius:4px;box-sizing:border-box;font-size:14px;}"
-        ".form-group small{display:block;margin-top:4px;color:#666;font-size:12px;}"
-        ".btn{padding:10px 20px;border:none;border-radius:4px;cursor:pointer;font-size:14px;transition:all 0.3s;margin-right:10px;}"
-        ".btn-primary{background:#3498db;color:#fff;}"
-        ".btn-primary:hover{background:#2980b9;}"
-        ".btn-primary:disabled{background:#95a5a6;cursor:not-allowed;}"
-        ".btn-danger{background:#e74c3c;color:#fff;}"
-        ".btn-danger:hover{background:#c0392b;}"
-        ".btn-success{background:#27ae60;color:#fff;}"
-        ".btn-success:hover{background:#229954;}"
-        ".alert{padding:12px;margin-bottom:20px;border-radius:4px;}"
-        ".alert-info{background:#d1ecf1;border:1px solid #bee5eb;color:#0c5460;}"
-        ".alert-warning{background:#fff3cd;border:1px solid #ffc107;color:#856404;}"
-        ".alert-error{background:#f8d7da;border:1px solid:#dc3545;color:#721c24;}"
-        ".alert-success{background:#d4edda;border:1px solid #28a745;color:#155724;}"
-        ".toast{position:fixed;top:20px;right:20px;min-width:250px;padding:15px 20px;border-radius:4px;box-shadow:0 4px 6px rgba(0,0,0,0.2);z-index:1000;animation:slideIn 0.3s;}"
-        ".toast-success{background:#27ae60;color:#fff;}"
-        ".toast-error{background:#e74c3c;color:#fff;}"
-        ".toast-info{background:#3498db;color:#fff;}"
-        "@keyframes slideIn{from{transform:translateX(400px);opacity:0;}to{transform:translateX(0);opacity:1;}}"
-        ".spinner{border:4px solid #f3f3f3;border-top:4px solid #3498db;border-radius:50%;width:40px;height:40px;animation:spin 1s linear infinite;margin:20px auto;}"
-        "@keyframes spin{0%{transform:rotate(0deg)}100%{transform:rotate(360deg)}}"
-        ".loading-overlay{position:fixed;top:0;left:260px;right:0;bottom:0;background:rgba(255,255,255,0.9);display:flex;align-items:center;justify-content:center;z-index:999;}"
-        ".hidden{display:none!important;}"
-        ".dashboard-grid{display:grid;grid-template-columns:1fr;gap:16px;}"
-        "@media(min-width:768px){.dashboard-grid{grid-template-columns:repeat(2,1fr);}}"
-        "dl{display:grid;grid-template-columns:auto 1fr;gap:8px 16px;margin:0;}"
-        "dt{font-weight:bold;color:#555;}"
-        "dd{margin:0;}"
-        ".badge{display:inline-block;padding:4px 8px;border-radius:4px;font-size:12px;font-weight:bold;color:#fff;}"
-        ".badge-good{background:#28a745;}"
-        ".badge-fair{background:#ffc107;color:#333;}"
-        ".badge-poor{background:#dc3545;}"
-        ".badge-connected{background:#28a745;}"
-        ".badge-connecting{background:#ffc107;color:#333;}"
-        ".badge-disconnected{background:#6c757d;}"
-        ".badge-error{background:#dc3545;}"
-        ".badge-muted{background:#6c757d;}"
-        "@media(max-width:768px){.sidebar{width:80px;}.logo{padding:10px 5px;}.logo img{max-width:90%;}.menu a{padding:12px 8px;text-align:center;font-size:11px;}.content{margin-left:80px;width:calc(100vw - 80px);}.loading-overlay{left:80px;}}"
-        "</style>"
-        "</head>"
-        "<body>"
-        "<div class=\"sidebar\">"
-        "<div class=\"logo\"><img src=\"/logo.webp\" alt=\"ESP-NG\"/></div>"
-        "<nav class=\"menu\">"
-        "<a href=\"#status\" id=\"menu-status\">Status</a>"
-        "<a href=\"#network\" id=\"menu-network\">Network</a>"
-        "<a href=\"#udp\" id=\"menu-udp\">UDP</a>"
-        "<a href=\"#system\" id=\"menu-system\">System</a>"
-        "</nav>"
-        "</div>"
-        "<div class=\"content\">"
-        "<div id=\"app-content\"></div>"
-        "</div>"
-        "<div id=\"loading-overlay\" class=\"loading-overlay hidden\">"
-        "<div class=\"spinner\"></div>"
-        "</div>";
-
-    httpd_resp_sendstr_chunk(req, html_head);
-
-    // JavaScript application
-    static const char html_js[] =
-        "<script>"
-        // Toast notification function
-        "function showToast(message,type){"
-        "const toast=document.createElement('div');"
-        "toast.className='toast toast-'+type;"
-        "toast.textContent=message;"
-        "document.body.appendChild(toast);"
-        "setTimeout(()=>toast.remove(),4000);"
-        "}"
-        // Show/hide loading overlay
-        "function showLoading(){document.getElementById('loading-overlay').classList.remove('hidden');}"
-        "function hideLoading(){document.getElementById('loading-overlay').classList.add('hidden');}"
-        // Update active menu item
-        "function updateMenu(page){"
-        "document.querySelectorAll('.menu a').forEach(a=>a.classList.remove('active'));"
-        "const activeLink=document.getElementById('menu-'+page);"
-        "if(activeLink)activeLink.classList.add('active');"
-        "}"
-        // Content templates
-        "const templates={"
-        "status:()=>{"
-        "return `<div class=\"page-header\"><h1>Status Dashboard</h1></div>"
-        "<div class=\"alert alert-info\">Loading status data...</div>`;"
-        "},"
-        "network:()=>{"
-        "return `<div class=\"page-header\"><h1>Network Configuration</h1></div>"
-        "<div class=\"card\"><h2>WiFi Settings</h2>"
-        "<form id=\"wifi-form\">"
-        "<div class=\"form-group\"><label>SSID:</label>"
-        "<input type=\"text\" name=\"wifi_ssid\" id=\"wifi_ssid\" maxlength=\"32\" required/></div>"
-        "<div class=\"form-group\"><label>Password:</label>"
-        "<input type=\"password\" name=\"wifi_pass\" id=\"wifi_pass\" maxlength=\"64\"/>"
-        "<small>Leave blank for open network</small></div>"
-        "<button type=\"submit\" class=\"btn btn-primary\">Test & Apply Credentials</button>"
-        "</form></div>"
-        "<div class=\"card\"><h2>Time Synchronization (SNTP)</h2>"
-        "<form id=\"sntp-form\">"
-        "<div class=\"form-group\"><label>Primary NTP Server:</label>"
-        "<input type=\"text\" name=\"sntp_server1\" id=\"sntp_server1\" maxlength=\"127\" placeholder=\"pool.ntp.org\"/>"
-        "<small>e.g., pool.ntp.org, time.nist.gov</small></div>"
-        "<div class=\"form-group\"><label>Secondary NTP Server:</label>"
-        "<input type=\"text\" name=\"sntp_server2\" id=\"sntp_server2\" maxlength=\"127\" placeholder=\"time.google.com\"/>"
-        "<small>Fallback server for redundancy</small></div>"
-        "<div class=\"form-group\"><label>Timezone:</label>"
-        "<select name=\"sntp_timezone\" id=\"sntp_timezone\">"
-        "<option value=\"UTC0\">UTC</option>"
-        "<option value=\"EST5EDT,M3.2.0/2,M11.1.0/2\">US Eastern (EST/EDT)</option>"
-        "<option value=\"CST6CDT,M3.2.0/2,M11.1.0/2\">US Central (CST/CDT)</option>"
-        "<option value=\"MST7MDT,M3.2.0/2,M11.1.0/2\">US Mountain (MST/MDT)</option>"
-        "<option value=\"PST8PDT,M3.2.0/2,M11.1.0/2\">US Pacific (PST/PDT)</option>"
-        "<option value=\"CET-1CEST,M3.5.0,M10.5.0/3\">Central European (CET/CEST)</option>"
-        "<option value=\"GMT0BST,M3.5.0/1,M10.5.0\">UK (GMT/BST)</option>"
-        "<option value=\"IST-5:30\">India (IST)</option>"
-        "<option value=\"JST-9\">Japan (JST)</option>"
-        "<option value=\"AEST-10AEDT,M10.1.0,M4.1.0/3\">Australia Eastern (AEST/AEDT)</option>"
-        "</select>"
-        "<small>Select timezone for correct local time display</small></div>"
-        "<button type=\"submit\" class=\"btn btn-primary\">Save Time Settings</button>"
-        "</form></div>`;"
-        "},"
-        "udp:()=>{"
-        "return `<div class=\"page-header\"><h1>UDP Broadcast Configuration</h1></div>"
-        "<div class=\"card\"><h2>UDP Broadcast Settings</h2>"
-        "<form id=\"udp-form\">"
-        "<div class=\"form-group\"><label>Broadcast Address:</label>"
-        "<input type=\"text\" name=\"udp_addr\" id=\"udp_addr\" placeholder=\"255.255.255.255\" maxlength=\"15\"/>"
-        "<small>IP address to broadcast to (255.255.255.255 for subnet broadcast)</small></div>"
-        "<div class=\"form-group\"><label>Broadcast Port:</label>"
-        "<input type=\"number\" name=\"udp_port\" id=\"udp_port\" min=\"1\" max=\"65535\" placeholder=\"9999\"/></div>"
-        "<div class=\"form-group\"><label>Broadcast Interval (milliseconds):</label>"
-        "<input type=\"number\" name=\"udp_interval_ms\" id=\"udp_interval_ms\" min=\"200\" max=\"5000\" step=\"100\"/>"
-        "<small>How often to broadcast (200-5000 ms, e.g., 1000 = 1 Hz)</small></div>"
-        "<button type=\"submit\" class=\"btn btn-primary\">Save Configuration</button>"
-        "</form></div>`;"
-        "},"
-        "system:()=>{"
-        "return `<div class=\"page-header\"><h1>System</h1></div>"
-        "<div class=\"card\"><h2>Firmware Update</h2>"
-        "<p>Update firmware via HTTP URL</p>"
-        "<form id=\"ota-form\">"
-        "<div class=\"form-group\"><label>Firmware URL:</label>"
-        "<input type=\"url\" name=\"fw_url\" placeholder=\"http://example.com/firmware.bin\" required/></div>"
-        "<button type=\"submit\" class=\"btn btn-success\">Start OTA Update</button>"
-        "</form></div>"
-        "<div class=\"card\"><h2>System Actions</h2>"
-        "<button id=\"reboot-btn\" class=\"btn btn-danger\">Reboot Device</button>"
-        "</div>`;"
-        "}"
-        "};"
-        // Load and populate config values
-        "async function loadConfig(){"
-        "try{"
-        "const res=await fetch('/config',{method:'GET',credentials:'include'});"
-        "if(!res.ok)return;"
-        "const config=await res.json();"
-        "return config;"
-        "}catch(err){console.error('Failed to load config:',err);return null;}"
-        "}"
-        // Router function
-        "function navigate(page){"
-        "const content=document.getElementById('app-content');"
-        "if(templates[page]){content.innerHTML=templates[page]();updateMenu(page);attachHandlers();loadPageData(page);}"
-        "else{content.innerHTML='<div class=\"alert alert-error\">Page not found</div>';}"
-        "}"
-        // Load page-specific data
-        "async function loadPageData(page){"
-        "if(page==='network'){"
-        "const config=await loadConfig();"
-        "if(config){"
-        "if(config.sntp_server1)document.getElementById('sntp_server1').value=config.sntp_server1;"
-        "if(config.sntp_server2)document.getElementById('sntp_server2').value=config.sntp_server2;"
-        "if(config.sntp_timezone)document.getElementById('sntp_timezone').value=config.sntp_timezone;"
-        "}"
-        "}"
-        "else if(page==='udp'){"
-        "const config=await loadConfig();"
-        "if(config){"
-        "if(config.udp_addr)document.getElementById('udp_addr').value=config.udp_addr;"
-        "if(config.udp_port)document.getElementById('udp_port').value=config.udp_port;"
-        "if(config.udp_freq_hz){"
-        "const interval_ms=Math.round(1000.0/config.udp_freq_hz);"
-        "document.getElementById('udp_interval_ms').value=interval_ms;"
-        "}"
-        "}"
-        "}"
-        "}"
-        // Attach form handlers
-        "function attachHandlers(){"
-        // WiFi form
-        "const wifiForm=document.getElementById('wifi-form');"
-        "if(wifiForm){"
-        "wifiForm.addEventListener('submit',async(e)=>{"
-        "e.preventDefault();"
-        "const ssid=document.getElementById('wifi_ssid').value;"
-        "const pass=document.getElementById('wifi_pass').value;"
-        "if(!ssid){showToast('SSID is required','error');return;}"
-        "showLoading();"
-        "try{"
-        "const res=await fetch('/config',{method:'POST',headers:{'Content-Type':'application/json'},"
-        "body:JSON.stringify({wifi_ssid:ssid,wifi_pass:pass})});"
-        "const data=await res.json();"
-        "hideLoading();"
-        "if(data.status==='ok'){showToast('WiFi credentials applied successfully','success');}"
-        "else{showToast('Failed: '+(data.error||'Unknown error'),'error');}"
-        "}catch(err){hideLoading();showToast('Network error','error');}"
-        "});"
-        "}"
-        // SNTP form
-        "const sntpForm=document.getElementById('sntp-form');"
-        "if(sntpForm){"
-        "sntpForm.addEventListener('submit',async(e)=>{"
-        "e.preventDefault();"
-        "const server1=document.getElementById('sntp_server1').value;"
-        "const server2=document.getElementById('sntp_server2').value;"
-        "const timezone=document.getElementById('sntp_timezone').value;"
-        "showLoading();"
-        "try{"
-        "const res=await fetch('/config',{method:'POST',headers:{'Content-Type':'application/json'},"
-        "body:JSON.stringify({sntp_server1:server1,sntp_server2:server2,sntp_timezone:timezone})});"
-        "const data=await res.json();"
-        "hideLoading();"
-        "if(data.status==='ok'){showToast('Time settings saved successfully','success');}"
-        "else{showToast('Failed to save: '+(data.error||'Unknown error'),'error');}"
-        "}catch(err){hideLoading();showToast('Network error','error');}"
-        "});"
-        "}"
-        // UDP form
-        "const udpForm=document.getElementById('udp-form');"
-        "if(udpForm){"
-        "udpForm.addEventListener('submit',async(e)=>{"
-        "e.preventDefault();"
-        "const addr=document.getElementById('udp_addr').value;"
-        "const port=parseInt(document.getElementById('udp_port').value);"
-        "const interval_ms=parseInt(document.getElementById('udp_interval_ms').value);"
-        "if(!addr||!port||!interval_ms){showToast('All fields are required','error');return;}"
-        "const freq_hz=1000.0/interval_ms;"
-        "showLoading();"
-        "try{"
-        "const res=await fetch('/config',{method:'POST',headers:{'Content-Type':'application/json'},"
-        "body:JSON.stringify({udp_addr:addr,udp_port:port,udp_freq_hz:freq_hz})});"
-        "const data=await res.json();"
-        "hideLoading();"
-        "if(data.status==='ok'){showToast('UDP configuration saved','success');}"
-        "else{showToast('Failed: '+(data.error||'Unknown'),'error');}"
-        "}catch(err){hideLoading();showToast('Request failed','error');}"
-        "});"
-        "}"
-        // OTA form
-        "const otaForm=document.getElementById('ota-form');"
-        "if(otaForm){"
-        "otaForm.addEventListener('submit',async(e)=>{"
-        "e.preventDefault();"
-        "const url=e.target.fw_url.value;"
-        "if(confirm('Start OTA update from: '+url+'?')){"
-        "showLoading();"
-        "try{"
-        "const res=await fetch('/ota',{method:'POST',headers:{'Content-Type':'application/json'},"
-        "body:JSON.stringify({url:url})});"
-        "const data=await res.json();"
-        "hideLoading();"
-        "if(data.status==='ok'){showToast('OTA update started','success');}"
-        "else{showToast('OTA failed: '+(data.error||'Unknown'),'error');}"
-        "}catch(err){hideLoading();showToast('Request failed','error');}"
-        "}"
-        "});"
-        "}"
-        // Reboot button
-        "const rebootBtn=document.getElementById('reboot-btn');"
-        "if(rebootBtn){"
-        "rebootBtn.addEventListener('click',async()=>{"
-        "if(confirm('Reboot device now?')){"
-        "showLoading();"
-        "try{"
-        "await fetch('/reboot',{method:'POST'});"
-        "showToast('Device rebooting...','info');"
-        "}catch(err){hideLoading();showToast('Reboot request failed','error');}"
-        "}"
-        "});"
-        "}"
-        "}"
-        // Hash change listener
-        "window.addEventListener('hashchange',()=>{"
-        "const page=location.hash.slice(1)||'status';"
-        "navigate(page);"
-        "});"
-        // Initial navigation
-        "window.addEventListener('DOMContentLoaded',()=>{"
-        "const page=location.hash.slice(1)||'status';"
-        "navigate(page);"
-        "});"
-        "</script>";
-
-    httpd_resp_sendstr_chunk(req, html_js);
-
-    // Close HTML
-    static const char html_close[] =
-        "</body>"
-        "</html>";
-
-    httpd_resp_sendstr_chunk(req, html_close);
-    httpd_resp_sendstr_chunk(req, NULL);
-    return ESP_OK;
+static void add_timing(cJSON* parent, const char* name, const event_bus_timing_t* t)
+{
+    cJSON* o = cJSON_CreateObject();
+    if (!o) {
+        return;
+    }
+    cJSON_AddNumberToObject(o, "count", t->count);
+    cJSON_AddNumberToObject(o, "min_us", t->min_us);
+    cJSON_AddNumberToObject(o, "avg_us", t->count ? (double)(t->total_us / t->count) : 0);
+    cJSON_AddNumberToObject(o, "max_us", t->max_us);
+    cJSON_AddItemToObject(parent, name, o);
 }
 
 /**
- * GET /config - Get current configuration (JSON)
+ * GET /diag/events - Event bus loop counters and per-event latency
+ * ?reset=1 clears the per-event counters after they are reported
  */
-static esp_err_t config_get_handler(httpd_req_t* req)
+static esp_err_t diag_events_get_handler(httpd_req_t* req)
 {
+    // Check auth
     if (check_basic_auth(req) != ESP_OK) {
         return send_401(req);
     }
 
     cJSON* root = cJSON_CreateObject();
     if (!root) {
-        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Memory allocation failed");
+        httpd_resp_send_500(req);
         return ESP_FAIL;
     }
 
-    // Get all config values
-    char device_id[32] = {0};
-    char wifi_ssid[33] = {0};
-    char udp_addr[16] = {0};
-    char sntp_server1[128] = {0};
-    char sntp_server2[128] = {0};
-    char sntp_timezone[64] = {0};
-    uint32_t udp_port = 0;
-    uint32_t udp_freq_mhz = 0;
+    cJSON* loops = cJSON_AddArrayToObject(root, "loops");
+    for (int i = 0; loops && i < EVENT_BUS_LOOP_COUNT; i++) {
+        event_bus_loop_stats_t ls;
+        if (event_bus_get_loop_stats((event_bus_loop_id_t)i, &ls) != ESP_OK) {
+            continue;
+        }
+        cJSON* l = cJSON_CreateObject();
+        cJSON_AddStringToObject(l, "name", ls.name);
+        cJSON_AddNumberToObject(l, "posted", ls.posted);
+        cJSON_AddNumberToObject(l, "dropped", ls.dropped);
+        cJSON_AddItemToArray(loops, l);
+    }
 
-    config_mgr_get_string("sys/device_id", device_id, sizeof(device_id));
-    config_mgr_get_string("wifi/ssid", wifi_ssid, sizeof(wifi_ssid));
-    config_mgr_get_string("udp/addr", udp_addr, sizeof(udp_addr));
-    config_mgr_get_u32("udp/port", &udp_port);
-    config_mgr_get_u32("udp/freq_hz", &udp_freq_mhz);
-    config_mgr_get_string("sntp/server1", sntp_server1, sizeof(sntp_server1));
-    config_mgr_get_string("sntp/server2", sntp_server2, sizeof(sntp_server2));
-    config_mgr_get_string("sntp/timezone", sntp_timezone, sizeof(sntp_timezone));
+    cJSON* events = cJSON_AddArrayToObject(root, "events");
+    for (int id = 0; events && id < DEVICE_EVENT_COUNT; id++) {
+        event_bus_event_stats_t st;
+        if (event_bus_get_event_stats(id, &st) != ESP_OK) {
+            continue;
+        }
+        char addr[12];
+        snprintf(addr, sizeof(addr), "0x%08lx", (unsigned long)st.slowest_handler);
+
+        cJSON* e = cJSON_CreateObject();
+        cJSON_AddStringToObject(e, "name", event_bus_event_name(id));
+        cJSON_AddNumberToObject(e, "posted", st.posted);
+        cJSON_AddNumberToObject(e, "dropped", st.dropped);
+        add_timing(e, "queue_wait", &st.queue_wait);
+        add_timing(e, "handler", &st.handler);
+        cJSON_AddStringToObject(e, "slowest_handler", addr);
+        cJSON_AddItemToArray(events, e);
+    }
 
-    // Add all config
-    cJSON_AddStringToObject(root, "device_id", device_id);
-    cJSON_AddStringToObject(root, "wifi_ssid", wifi_ssid);
-    cJSON_AddStringToObject(root, "udp_addr", udp_addr);
-    cJSON_AddNumberToObject(root, "udp_port", udp_port);
-    // Convert millihertz to Hz for JSON output
-    cJSON_AddNumberToObject(root, "udp_freq_hz", (double)udp_freq_mhz / 1000.0);
-    cJSON_AddStringToObject(root, "sntp_server1", sntp_server1);
-    cJSON_AddStringToObject(root, "sntp_server2", sntp_server2);
-    cJSON_AddStringToObject(root, "sntp_timezone", sntp_timezone);
+    char query[32];
+    char value[4];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "reset", value, sizeof(value)) == ESP_OK &&
+        strcmp(value, "1") == 0) {
+        event_bus_reset_event_stats();
+    }
 
     char* json_str = cJSON_PrintUnformatted(root);
     cJSON_Delete(root);
 
     if (!json_str) {
-        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "JSON serialization failed");
+        httpd_resp_send_500(req);
         return ESP_FAIL;
     }
-
-    httpd_resp_set_type(req, "application/json");
-    httpd_resp_sendstr(req, json_str);
-    cJSON_free(json_str);
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
+
+    cJSON_free(json_str);
+    return ESP_OK;
+}
+
+/**
+ * Content-hash ETag (FNV-1a 64 over the served bytes)
+ */
+static const char* asset_etag(web_asset_t* a)
+{
+    if (a->etag[0] == '\0') {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (const uint8_t* p = a->served.start; p < a->served.end; p++) {
+            h ^= *p;
+            h *= 0x100000001b3ULL;
+        }
+        snprintf(a->etag, sizeof(a->etag), "\"%016llx\"", (unsigned long long)h);
+    }
+    return a->etag;
+}
+
+/**
+ * Point every asset at its web pack entry, or at the builtin copy
+ * pack may be NULL to fall back to the builtin assets. Returns how many
+ * assets were found in the pack.
+ */
+static size_t bind_assets(const uint8_t* pack)
+{
+    size_t found = 0;
+
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        web_asset_t* a = s_assets[i];
+        a->served = a->builtin;
+        a->etag[0] = '\0';
+
+        if (!pack) {
+            continue;
+        }
+        const web_pack_header_t* hdr = (const web_pack_header_t*)pack;
+        const web_pack_entry_t* entries = (const web_pack_entry_t*)(pack + sizeof(*hdr));
+        for (uint16_t e = 0; e < hdr->count; e++) {
+            if (strncmp(entries[e].name, a->name, WEB_PACK_NAME_MAX) == 0) {
+                a->served.start = pack + entries[e].offset;
+                a->served.end = a->served.start + entries[e].length;
+                a->served.gzip = (entries[e].flags & WEB_PACK_FLAG_GZIP) != 0;
+                found++;
+                break;
+            }
+        }
+    }
+    return found;
+}
+
+#if CONFIG_HTTP_UI_WEB_PACK
+/**
+ * Check a mapped image: header, entry bounds and CRC
+ */
+static bool web_pack_valid(const uint8_t* pack, size_t size)
+{
+    const web_pack_header_t* hdr = (const web_pack_header_t*)pack;
+    size_t table_end = sizeof(*hdr) + (size_t)hdr->count * sizeof(web_pack_entry_t);
+
+    if (hdr->magic != WEB_PACK_MAGIC || hdr->version != WEB_PACK_VERSION ||
+        hdr->size != size || table_end > size) {
+        return false;
+    }
+
+    const web_pack_entry_t* entries = (const web_pack_entry_t*)(pack + sizeof(*hdr));
+    for (uint16_t e = 0; e < hdr->count; e++) {
+        if (entries[e].offset < table_end || entries[e].offset > size ||
+            entries[e].length > size - entries[e].offset ||
+            memchr(entries[e].name, '\0', WEB_PACK_NAME_MAX) == NULL) {
+            return false;
+        }
+    }
+
+    return esp_rom_crc32_le(0, pack + sizeof(*hdr), size - sizeof(*hdr)) == hdr->crc32;
+}
+
+/**
+ * Drop the current mapping; assets fall back to the builtin copies
+ */
+static void web_pack_unmap(void)
+{
+    bind_assets(NULL);
+    if (s_pack) {
+        esp_partition_munmap(s_pack_map);
+        s_pack = NULL;
+    }
+}
+
+/**
+ * Map the web pack partition and bind assets to it
+ * ESP_ERR_NOT_FOUND / ESP_ERR_INVALID_CRC leave the builtin assets in use.
+ */
+static esp_err_t web_pack_map(void)
+{
+    web_pack_unmap();
+
+    if (!s_pack_part) {
+        s_pack_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                               CONFIG_HTTP_UI_WEB_PACK_PARTITION);
+        if (!s_pack_part) {
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+
+    // Read the header first so only the image, not the whole partition, is mapped
+    web_pack_header_t hdr;
+    esp_err_t ret = esp_partition_read(s_pack_part, 0, &hdr, sizeof(hdr));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    if (hdr.magic != WEB_PACK_MAGIC) {
+        return ESP_ERR_NOT_FOUND;   // Blank or never written
+    }
+    if (hdr.size < sizeof(hdr) || hdr.size > s_pack_part->size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    const void* ptr = NULL;
+    ret = esp_partition_mmap(s_pack_part, 0, hdr.size, ESP_PARTITION_MMAP_DATA, &ptr, &s_pack_map);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    if (!web_pack_valid(ptr, hdr.size)) {
+        esp_partition_munmap(s_pack_map);
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    s_pack = ptr;
+    size_t found = bind_assets(s_pack);
+    ESP_LOGI(TAG, "Web pack: %u bytes, %u entries, serving %u/%u assets from '%s'",
+             (unsigned)hdr.size, (unsigned)hdr.count, (unsigned)found,
+             (unsigned)WEB_ASSET_COUNT, s_pack_part->label);
+    return ESP_OK;
+}
+#endif
+
+/**
+ * Send an asset, or 304 if the client already has this version
+ * The bytes go from flash (web pack mapping or app rodata) to the socket in
+ * WEB_PACK_CHUNK pieces, with no RAM copy. Handlers run one at a time on
+ * the httpd task, so a POST /assets cannot remap the pack mid-send.
+ */
+static esp_err_t send_asset(httpd_req_t* req, web_asset_t* a)
+{
+    const char* etag = asset_etag(a);
+    httpd_resp_set_hdr(req, "ETag", etag);
+    httpd_resp_set_hdr(req, "Cache-Control", a->cache_control);
+
+    char inm[64];
+    if (httpd_req_get_hdr_value_str(req, "If-None-Match", inm, sizeof(inm)) == ESP_OK &&
+        strstr(inm, etag) != NULL) {
+        httpd_resp_set_status(req, "304 Not Modified");
+        return httpd_resp_send(req, NULL, 0);
+    }
+
+    httpd_resp_set_type(req, a->type);
+    if (a->served.gzip) {
+        // Every browser we target accepts gzip; there is no identity copy to fall back to
+        httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    }
+
+    for (const uint8_t* p = a->served.start; p < a->served.end; p += WEB_PACK_CHUNK) {
+        size_t n = a->served.end - p;
+        if (n > WEB_PACK_CHUNK) {
+            n = WEB_PACK_CHUNK;
+        }
+        esp_err_t ret = httpd_resp_send_chunk(req, (const char*)p, n);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+/**
+ * GET /ui - Single Page Application (web/index.html)
+ */
+static esp_err_t ui_spa_handler(httpd_req_t* req)
+{
+    if (check_basic_auth(req) != ESP_OK) {
+        return send_401(req);
+    }
+
+    return send_asset(req, &s_asset_spa);
+}
+
+/**
+ * GET /config - Get current configuration (JSON)
+ */
+static esp_err_t config_get_handler(httpd_req_t* req)
+{
+    if (check_basic_auth(req) != ESP_OK) {
+        return send_401(req);
+    }
+
+    // Get all config values
+    char device_id[32] = {0};
+    char wifi_ssid[33] = {0};
+    char udp_addr[16] = {0};
+    char sntp_server1[128] = {0};
+    char sntp_server2[128] = {0};
+    char sntp_timezone[64] = {0};
+    uint32_t udp_port = 0;
+    uint32_t udp_freq_mhz = 0;
+    uint32_t udp_format = UDP_FORMAT_JSON;
+    uint32_t udp_stream_en = 0;
+    uint32_t udp_stream_n = 0;
+    uint32_t udp_stream_ms = 0;
+    uint32_t ui_live_ms = 0;
+    uint32_t wifi_power = NET_MGR_POWER_BALANCED;
+
+    config_mgr_get_string("sys/device_id", device_id, sizeof(device_id));
+    config_mgr_get_string("wifi/ssid", wifi_ssid, sizeof(wifi_ssid));
+    config_mgr_get_u32("wifi/power", &wifi_power);
+    config_mgr_get_string("udp/addr", udp_addr, sizeof(udp_addr));
+    config_mgr_get_u32("udp/port", &udp_port);
+    config_mgr_get_u32("udp/freq_mhz", &udp_freq_mhz);
+    config_mgr_get_u32("udp/format", &udp_format);
+    config_mgr_get_u32("udp/stream_en", &udp_stream_en);
+    config_mgr_get_u32("udp/stream_n", &udp_stream_n);
+    config_mgr_get_u32("udp/stream_ms", &udp_stream_ms);
+    config_mgr_get_u32("ui/live_ms", &ui_live_ms);
+    config_mgr_get_string("sntp/server1", sntp_server1, sizeof(sntp_server1));
+    config_mgr_get_string("sntp/server2", sntp_server2, sizeof(sntp_server2));
+    config_mgr_get_string("sntp/timezone", sntp_timezone, sizeof(sntp_timezone));
+
+    // Add all config
+    char chunk[JSON_CHUNK_SIZE];
+    json_writer_t w;
+    httpd_resp_set_type(req, "application/json");
+    json_writer_init(&w, chunk, sizeof(chunk), json_chunk_flush, req);
+
+    json_writer_begin_object(&w, NULL);
+    json_writer_string(&w, "device_id", device_id);
+    json_writer_string(&w, "wifi_ssid", wifi_ssid);
+    json_writer_string(&w, "wifi_power", net_mgr_power_profile_name((net_mgr_power_profile_t)wifi_power));
+
+    // Extra networks, SSIDs only
+    net_mgr_network_t networks[NET_MGR_MAX_NETWORKS - 1];
+    size_t network_count = 0;
+    net_mgr_get_networks(networks, NET_MGR_MAX_NETWORKS - 1, &network_count);
+    json_writer_begin_array(&w, "wifi_networks");
+    for (size_t i = 0; i < network_count; i++) {
+        json_writer_begin_object(&w, NULL);
+        json_writer_string(&w, "ssid", networks[i].ssid);
+        json_writer_end_object(&w);
+    }
+    json_writer_end_array(&w);
+    memset(networks, 0, sizeof(networks));
+    json_writer_string(&w, "udp_addr", udp_addr);
+    json_writer_uint(&w, "udp_port", udp_port);
+    // Convert millihertz to Hz for JSON output
+    json_writer_double(&w, "udp_freq_hz", (double)udp_freq_mhz / 1000.0);
+    json_writer_string(&w, "udp_format", udp_format == UDP_FORMAT_BINARY ? "binary" : "json");
+    json_writer_bool(&w, "udp_stream_enabled", udp_stream_en != 0);
+    json_writer_uint(&w, "udp_stream_batch", udp_stream_n);
+    json_writer_uint(&w, "udp_stream_ms", udp_stream_ms);
+
+    udp_dest_t extra_dests[UDP_MAX_DESTINATIONS - 1];
+    size_t extra_count = 0;
+    udp_broadcast_get_destinations(extra_dests, UDP_MAX_DESTINATIONS - 1, &extra_count);
+    json_writer_begin_array(&w, "udp_destinations");
+    for (size_t i = 0; i < extra_count; i++) {
+        json_writer_begin_object(&w, NULL);
+        json_writer_uint(&w, "mode", extra_dests[i].mode);
+        json_writer_string(&w, "addr", extra_dests[i].addr);
+        json_writer_uint(&w, "port", extra_dests[i].port);
+        json_writer_uint(&w, "ttl", extra_dests[i].ttl);
+        json_writer_uint(&w, "rate_div", extra_dests[i].rate_div);
+        json_writer_end_object(&w);
+    }
+    json_writer_end_array(&w);
+    json_writer_string(&w, "sntp_server1", sntp_server1);
+    json_writer_string(&w, "sntp_server2", sntp_server2);
+    json_writer_string(&w, "sntp_timezone", sntp_timezone);
+    json_writer_uint(&w, "ui_live_ms", ui_live_ms);
+
+    json_writer_end_object(&w);
+    return json_resp_end(req, &w);
+}
+
+/*
+ * Request bodies
+ *
+ * POST bodies are parsed as they come off the socket (body_parser) through
+ * a small stack buffer, so a request costs the same memory whatever size
+ * the client claims, and anything over CONFIG_HTTP_UI_MAX_BODY is refused
+ * with 413 before a byte is read.
+ */
+#define BODY_CHUNK_SIZE 256
+#define OTA_URL_MAX 256
+
+#define DEST_HAS_MODE 0x1           // Members an extra destination must have
+#define DEST_HAS_ADDR 0x2
+#define DEST_HAS_PORT 0x4
+#define DEST_HAS_ALL (DEST_HAS_MODE | DEST_HAS_ADDR | DEST_HAS_PORT)
+
+/**
+ * POST /config in progress
+ * Fields are staged into txn as they are parsed; the ones that only make
+ * sense once the whole body is in (WiFi pair, destination list) are
+ * collected here and checked by config_update_check().
+ */
+typedef struct {
+    config_mgr_txn_t* txn;
+    const char* error;              // First rejected field, as the JSON error code
+    bool sntp_changed;
+    bool udp_changed;
+    uint32_t live_ms;               // 0 = unchanged
+    bool power_changed;
+    net_mgr_power_profile_t power;
+    bool has_ssid;
+    bool has_pass;
+    char ssid[33];
+    char pass[65];
+    bool has_dests;
+    size_t dest_count;
+    uint8_t dest_seen[UDP_MAX_DESTINATIONS - 1];    // DEST_HAS_* per element
+    udp_dest_t dests[UDP_MAX_DESTINATIONS - 1];
+    bool has_networks;
+    size_t network_count;
+    net_mgr_network_t networks[NET_MGR_MAX_NETWORKS - 1];
+} config_update_t;
+
+/*
+ * Async operations
+ *
+ * Handlers that would hold the single httpd task for seconds (WiFi
+ * credential test, OTA trigger, image upload, reboot delay) hand the work
+ * to a small pool of worker tasks. By default the client gets 202 Accepted with an op id
+ * and polls GET /ops?id=N. With ?wait=1 the request is detached with
+ * httpd_req_async_handler_begin() and the worker sends the final response
+ * itself. Either way the httpd task goes straight back to other sockets.
+ */
+#define HTTP_OP_WORKERS 2
+#define HTTP_OP_SLOTS 8             // Ops tracked at once; finished ones are recycled oldest first
+#define HTTP_OP_BODY_MAX 128
+#define HTTP_OP_STACK_SIZE 4096
+#define HTTP_OP_PRIORITY 5
+#define HTTP_OP_REBOOT_DELAY_MS 1000
+#define HTTP_UPLOAD_MAX_TIMEOUTS 3  // Receive timeouts (recv_wait_timeout each) an upload survives
+
+typedef enum {
+    HTTP_OP_WIFI_TEST = 0,
+    HTTP_OP_OTA,
+    HTTP_OP_REBOOT,
+    HTTP_OP_UPLOAD,                 // Image in the request body; the worker always owns req
+} http_op_kind_t;
+
+typedef enum {
+    HTTP_OP_PENDING = 0,
+    HTTP_OP_RUNNING,
+    HTTP_OP_DONE,
+    HTTP_OP_FAILED,
+} http_op_state_t;
+
+typedef struct {
+    int status;                     // HTTP status of the final response
+    char body[HTTP_OP_BODY_MAX];    // JSON body of the final response
+} http_op_result_t;
+
+typedef struct {
+    uint32_t id;                    // 0 = free slot
+    http_op_kind_t kind;
+    http_op_state_t state;
+    http_op_result_t result;        // Valid once state leaves PENDING/RUNNING (OTA: once triggered)
+    bool has_result;
+    int64_t created_us;
+    int64_t finished_us;
+} http_op_t;
+
+// What the op works on, copied out of the request (kept out of http_op_t
+// so GET /ops can snapshot the table cheaply)
+typedef union {
+    config_update_t config;         // HTTP_OP_WIFI_TEST, owns config.txn
+    char url[OTA_URL_MAX];          // HTTP_OP_OTA
+    struct {
+        bool has_sha256;
+        uint8_t sha256[32];         // X-Image-SHA256 request header
+    } upload;                       // HTTP_OP_UPLOAD
+} http_op_args_t;
+
+typedef struct {
+    uint32_t id;
+    http_op_kind_t kind;
+    http_op_args_t* args;           // Slot arguments, valid until the op finishes
+    httpd_req_t* req;               // Detached request for ?wait=1, else NULL
+} http_op_job_t;
+
+static const char* const s_op_kind_names[] = { "wifi_test", "ota", "reboot", "ota_upload" };
+static const char* const s_op_state_names[] = { "pending", "running", "done", "failed" };
+
+static http_op_t s_ops[HTTP_OP_SLOTS];
+static http_op_args_t s_op_args[HTTP_OP_SLOTS];
+static portMUX_TYPE s_ops_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_op_next_id = 1;
+static uint32_t s_ota_op_id = 0;    // Op waiting for OTA_SUCCESS/OTA_FAIL
+static QueueHandle_t s_op_queue = NULL;
+
+static void config_commit(config_update_t* u, http_op_result_t* res);
+
+static void op_result_set(http_op_result_t* res, int status, const char* body)
+{
+    res->status = status;
+    strlcpy(res->body, body, sizeof(res->body));
+}
+
+static const char* http_status_line(int status)
+{
+    switch (status) {
+        case 200: return "200 OK";
+        case 202: return "202 Accepted";
+        case 400: return "400 Bad Request";
+        case 404: return "404 Not Found";
+        case 408: return "408 Request Timeout";
+        case 409: return "409 Conflict";
+        case 413: return "413 Payload Too Large";
+        case 503: return "503 Service Unavailable";
+        default: return "500 Internal Server Error";
+    }
+}
+
+static esp_err_t send_op_result(httpd_req_t* req, const http_op_result_t* res)
+{
+    httpd_resp_set_status(req, http_status_line(res->status));
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, res->body, HTTPD_RESP_USE_STRLEN);
+}
+
+/**
+ * Claim a slot: a free one, else the op that finished longest ago
+ * Returns 0 when every slot holds a pending or running op, else the op id
+ * with its slot index in *slot.
+ */
+static uint32_t op_alloc(http_op_kind_t kind, int* slot)
+{
+    uint32_t id = 0;
+    http_op_t* pick = NULL;
+
+    portENTER_CRITICAL(&s_ops_lock);
+    for (int i = 0; i < HTTP_OP_SLOTS; i++) {
+        http_op_t* op = &s_ops[i];
+        if (op->id == 0) {
+            pick = op;
+            break;
+        }
+        if ((op->state == HTTP_OP_DONE || op->state == HTTP_OP_FAILED) &&
+            (!pick || op->finished_us < pick->finished_us)) {
+            pick = op;
+        }
+    }
+    if (pick) {
+        id = s_op_next_id++;
+        if (s_op_next_id == 0) {
+            s_op_next_id = 1;
+        }
+        memset(pick, 0, sizeof(*pick));
+        pick->id = id;
+        pick->kind = kind;
+        pick->state = HTTP_OP_PENDING;
+        pick->created_us = esp_timer_get_time();
+        *slot = pick - s_ops;
+    }
+    portEXIT_CRITICAL(&s_ops_lock);
+    return id;
+}
+
+/**
+ * Move op id to state; res (may be NULL) becomes its final response
+ * A finished op stays finished: OTA_FAIL can land before the worker marks
+ * the OTA op running.
+ */
+static void op_update(uint32_t id, http_op_state_t state, const http_op_result_t* res)
+{
+    portENTER_CRITICAL(&s_ops_lock);
+    for (int i = 0; i < HTTP_OP_SLOTS; i++) {
+        if (s_ops[i].id == id) {
+            bool finished = s_ops[i].state == HTTP_OP_DONE || s_ops[i].state == HTTP_OP_FAILED;
+            if (!finished) {
+                s_ops[i].state = state;
+            }
+            if (res) {
+                s_ops[i].result = *res;
+                s_ops[i].has_result = true;
+            }
+            if (!finished && (state == HTTP_OP_DONE || state == HTTP_OP_FAILED)) {
+                s_ops[i].finished_us = esp_timer_get_time();
+            }
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_ops_lock);
+}
+
+static http_op_state_t run_wifi_test(config_update_t* u, http_op_result_t* res)
+{
+    ESP_LOGI(TAG, "Testing WiFi credentials for SSID: %s", u->ssid);
+
+    net_mgr_cred_result_t cred_result;
+    esp_err_t ret = net_mgr_test_and_commit_credentials(u->ssid, u->pass, 20000, &cred_result);  // 20 second timeout
+    if (ret != ESP_OK) {
+        // Staging failed; nothing else in the body is applied
+        config_mgr_txn_abort(u->txn);
+        const char* error_str = net_mgr_cred_result_to_string(cred_result);
+        ESP_LOGW(TAG, "WiFi credential staging failed: %s", error_str);
+        res->status = 200;
+        snprintf(res->body, sizeof(res->body), "{\"error\":\"%s\"}", error_str ? error_str : "unknown");
+        return HTTP_OP_FAILED;
+    }
+
+    // Do NOT set needs_reboot - already connected to new network
+    ESP_LOGI(TAG, "WiFi credentials tested and committed successfully");
+    config_commit(u, res);
+    return res->status == 200 ? HTTP_OP_DONE : HTTP_OP_FAILED;
+}
+
+static http_op_state_t run_ota(uint32_t id, const char* url, http_op_result_t* res)
+{
+    // ota_mgr runs the download in its own task; the op stays running
+    // until it posts OTA_SUCCESS or OTA_FAIL
+    portENTER_CRITICAL(&s_ops_lock);
+    s_ota_op_id = id;
+    portEXIT_CRITICAL(&s_ops_lock);
+
+    esp_err_t ret = ota_mgr_trigger_from_url(url);
+    if (ret == ESP_OK) {
+        op_result_set(res, 202, "{\"status\":\"ota_triggered\"}");
+        return HTTP_OP_RUNNING;
+    }
+
+    portENTER_CRITICAL(&s_ops_lock);
+    if (s_ota_op_id == id) {
+        s_ota_op_id = 0;
+    }
+    portEXIT_CRITICAL(&s_ops_lock);
+    if (ret == ESP_ERR_INVALID_STATE) {
+        op_result_set(res, 409, "{\"error\":\"ota_in_progress\"}");
+    } else {
+        res->status = 400;
+        snprintf(res->body, sizeof(res->body), "{\"error\":\"%s\"}", esp_err_to_name(ret));
+    }
+    return HTTP_OP_FAILED;
+}
+
+/**
+ * Receive the request body straight into ota_mgr's upload buffers
+ * Each buffer is filled completely before it goes to the writer, so flash
+ * writes stay CONFIG_OTA_MGR_CHUNK_SIZE long whatever the TCP segmenting.
+ */
+static http_op_state_t run_upload(httpd_req_t* req, const http_op_args_t* args, http_op_result_t* res)
+{
+    ota_mgr_upload_t* up = NULL;
+    esp_err_t ret = ota_mgr_upload_begin(req->content_len,
+                                         args->upload.has_sha256 ? args->upload.sha256 : NULL, &up);
+    if (ret != ESP_OK) {
+        if (ret == ESP_ERR_INVALID_STATE) {
+            op_result_set(res, 409, "{\"error\":\"ota_in_progress\"}");
+        } else if (ret == ESP_ERR_INVALID_SIZE) {
+            op_result_set(res, 413, "{\"error\":\"image_too_large\"}");
+        } else {
+            res->status = 500;
+            snprintf(res->body, sizeof(res->body), "{\"error\":\"%s\"}", esp_err_to_name(ret));
+        }
+        return HTTP_OP_FAILED;
+    }
+
+    size_t remaining = req->content_len;
+    int timeouts = 0;
+    while (remaining > 0 && ret == ESP_OK) {
+        uint8_t* buf;
+        size_t cap;
+        ret = ota_mgr_upload_get_buffer(up, &buf, &cap);
+        if (ret != ESP_OK) {
+            break;
+        }
+
+        size_t want = remaining < cap ? remaining : cap;
+        size_t fill = 0;
+        while (fill < want) {
+            int n = httpd_req_recv(req, (char*)buf + fill, want - fill);
+            if (n == HTTPD_SOCK_ERR_TIMEOUT && ++timeouts <= HTTP_UPLOAD_MAX_TIMEOUTS) {
+                continue;
+            }
+            if (n <= 0) {
+                ret = n == HTTPD_SOCK_ERR_TIMEOUT ? ESP_ERR_TIMEOUT : ESP_FAIL;
+                break;
+            }
+            fill += n;
+        }
+        if (ret == ESP_OK) {
+            ret = ota_mgr_upload_submit(up, fill);
+            remaining -= fill;
+        }
+    }
+
+    if (ret != ESP_OK) {
+        ota_mgr_upload_abort(up);
+        if (ret == ESP_ERR_TIMEOUT) {
+            op_result_set(res, 408, "{\"error\":\"upload_timeout\"}");
+        } else if (ret == ESP_ERR_INVALID_VERSION) {
+            op_result_set(res, 409, "{\"error\":\"delta_base_mismatch\"}");
+        } else {
+            // Decoding errors are the sender's; anything else is ours
+            res->status = (ret == ESP_ERR_INVALID_RESPONSE || ret == ESP_ERR_INVALID_SIZE ||
+                           ret == ESP_ERR_NOT_SUPPORTED) ? 400 : 500;
+            snprintf(res->body, sizeof(res->body), "{\"error\":\"%s\"}", esp_err_to_name(ret));
+        }
+        return HTTP_OP_FAILED;
+    }
+
+    uint8_t sha256[32];
+    ret = ota_mgr_upload_finish(up, sha256);
+    if (ret == ESP_ERR_INVALID_CRC) {
+        op_result_set(res, 400, "{\"error\":\"sha256_mismatch\"}");
+        return HTTP_OP_FAILED;
+    }
+    if (ret != ESP_OK) {
+        res->status = 400;
+        snprintf(res->body, sizeof(res->body), "{\"error\":\"%s\"}", esp_err_to_name(ret));
+        return HTTP_OP_FAILED;
+    }
+
+    char hex[65];
+    for (int i = 0; i < 32; i++) {
+        snprintf(&hex[i * 2], 3, "%02x", sha256[i]);
+    }
+    res->status = 200;
+    snprintf(res->body, sizeof(res->body), "{\"status\":\"rebooting\",\"sha256\":\"%s\"}", hex);
+    return HTTP_OP_DONE;
+}
+
+static void http_op_worker(void* arg)
+{
+    http_op_job_t job;
+
+    for (;;) {
+        if (xQueueReceive(s_op_queue, &job, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        op_update(job.id, HTTP_OP_RUNNING, NULL);
+
+        http_op_result_t res = { 0 };
+        http_op_state_t state = HTTP_OP_FAILED;
+        switch (job.kind) {
+            case HTTP_OP_WIFI_TEST:
+                state = run_wifi_test(&job.args->config, &res);
+                break;
+            case HTTP_OP_OTA:
+                state = run_ota(job.id, job.args->url, &res);
+                break;
+            case HTTP_OP_REBOOT:
+                op_result_set(&res, 200, "{\"status\":\"rebooting\"}");
+                state = HTTP_OP_DONE;
+                break;
+            case HTTP_OP_UPLOAD:
+                state = run_upload(job.req, job.args, &res);
+                break;
+        }
+        op_update(job.id, state, &res);
+
+        if (job.req) {
+            send_op_result(job.req, &res);
+            httpd_req_async_handler_complete(job.req);
+        }
+
+        if (job.kind == HTTP_OP_REBOOT) {
+            // Give the response (or the client's next poll) time to go out
+            vTaskDelay(pdMS_TO_TICKS(HTTP_OP_REBOOT_DELAY_MS));
+            esp_restart();
+        }
+    }
+}
+
+static void ota_result_handler(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+    portENTER_CRITICAL(&s_ops_lock);
+    uint32_t op_id = s_ota_op_id;
+    s_ota_op_id = 0;
+    portEXIT_CRITICAL(&s_ops_lock);
+
+    if (op_id) {
+        op_update(op_id, id == DEVICE_EVENT_OTA_SUCCESS ? HTTP_OP_DONE : HTTP_OP_FAILED, NULL);
+    }
+}
+
+/**
+ * Create the op queue and workers (once; they outlive http_ui_stop)
+ */
+static esp_err_t http_ops_init(void)
+{
+    if (s_op_queue) {
+        return ESP_OK;
+    }
+
+    // Every queued job holds a slot, so a queue this deep never overflows
+    s_op_queue = xQueueCreate(HTTP_OP_SLOTS, sizeof(http_op_job_t));
+    if (!s_op_queue) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (int i = 0; i < HTTP_OP_WORKERS; i++) {
+        char name[12];
+        snprintf(name, sizeof(name), "http_op%d", i);
+        if (xTaskCreate(http_op_worker, name, HTTP_OP_STACK_SIZE, NULL, HTTP_OP_PRIORITY, NULL) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create %s", name);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    event_bus_register(DEVICE_EVENT_OTA_SUCCESS, ota_result_handler, NULL);
+    event_bus_register(DEVICE_EVENT_OTA_FAIL, ota_result_handler, NULL);
+    return ESP_OK;
+}
+
+/**
+ * Drop the arguments of an op that will never run
+ */
+static void op_args_release(http_op_kind_t kind, const void* args)
+{
+    if (kind == HTTP_OP_WIFI_TEST) {
+        config_mgr_txn_abort(((const config_update_t*)args)->txn);
+    }
+}
+
+/**
+ * Queue a long-running operation for req
+ * args (args_len bytes, may be NULL) is copied into the op slot and owned
+ * by the op from here on. Responds 202 with the op id, or, for ?wait=1,
+ * detaches req so the worker can answer when the op completes.
+ */
+static esp_err_t http_op_submit(httpd_req_t* req, http_op_kind_t kind, const void* args, size_t args_len)
+{
+    char query[32];
+    char value[8];
+    bool wait = httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+                httpd_query_key_value(query, "wait", value, sizeof(value)) == ESP_OK &&
+                strcmp(value, "1") == 0;
+
+    int slot = -1;
+    uint32_t id = s_op_queue ? op_alloc(kind, &slot) : 0;
+    if (id == 0) {
+        op_args_release(kind, args);
+        http_op_result_t busy;
+        op_result_set(&busy, 503, "{\"error\":\"busy\"}");
+        return send_op_result(req, &busy);
+    }
+
+    // The slot was finished or free, so no worker is still reading its args
+    http_op_job_t job = { .id = id, .kind = kind, .args = &s_op_args[slot], .req = NULL };
+    if (args) {
+        memcpy(job.args, args, args_len);
+    }
+    if ((wait || kind == HTTP_OP_UPLOAD) && httpd_req_async_handler_begin(req, &job.req) != ESP_OK) {
+        job.req = NULL;     // Fall back to 202 + polling
+    }
+    if (kind == HTTP_OP_UPLOAD && !job.req) {
+        // The body can only be read by whoever owns the request
+        http_op_result_t busy;
+        op_result_set(&busy, 503, "{\"error\":\"busy\"}");
+        op_update(id, HTTP_OP_FAILED, &busy);
+        return send_op_result(req, &busy);
+    }
+
+    // Cannot fail: one queue entry per slot
+    xQueueSend(s_op_queue, &job, 0);
+    ESP_LOGI(TAG, "Op %lu (%s) queued%s", (unsigned long)id, s_op_kind_names[kind],
+             job.req ? ", client waiting" : "");
+
+    if (job.req) {
+        return ESP_OK;
+    }
+
+    char body[64];
+    char location[24];
+    snprintf(body, sizeof(body), "{\"op_id\":%lu,\"state\":\"pending\"}", (unsigned long)id);
+    snprintf(location, sizeof(location), "/ops?id=%lu", (unsigned long)id);
+    httpd_resp_set_status(req, "202 Accepted");
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Location", location);
+    return httpd_resp_send(req, body, HTTPD_RESP_USE_STRLEN);
+}
+
+static void write_op(json_writer_t* w, const http_op_t* op, int64_t now_us)
+{
+    json_writer_begin_object(w, NULL);
+    json_writer_uint(w, "id", op->id);
+    json_writer_string(w, "kind", s_op_kind_names[op->kind]);
+    json_writer_string(w, "state", s_op_state_names[op->state]);
+    json_writer_uint(w, "age_ms", (uint64_t)((now_us - op->created_us) / 1000));
+    if (op->has_result) {
+        json_writer_int(w, "http_status", op->result.status);
+        json_writer_raw(w, "response", op->result.body);
+    }
+    json_writer_end_object(w);
+}
+
+/**
+ * GET /ops - Async operation status (?id=N for one op, else all tracked ops)
+ */
+static esp_err_t ops_get_handler(httpd_req_t* req)
+{
+    if (check_basic_auth(req) != ESP_OK) {
+        return send_401(req);
+    }
+
+    uint32_t want = 0;
+    char query[32];
+    char value[12];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "id", value, sizeof(value)) == ESP_OK) {
+        want = (uint32_t)strtoul(value, NULL, 10);
+    }
+
+    http_op_t ops[HTTP_OP_SLOTS];
+    portENTER_CRITICAL(&s_ops_lock);
+    memcpy(ops, s_ops, sizeof(ops));
+    portEXIT_CRITICAL(&s_ops_lock);
+
+    int64_t now_us = esp_timer_get_time();
+    char chunk[JSON_CHUNK_SIZE];
+    json_writer_t w;
+    httpd_resp_set_type(req, "application/json");
+
+    if (want) {
+        for (int i = 0; i < HTTP_OP_SLOTS; i++) {
+            if (ops[i].id == want) {
+                json_writer_init(&w, chunk, sizeof(chunk), json_chunk_flush, req);
+                write_op(&w, &ops[i], now_us);
+                return json_resp_end(req, &w);
+            }
+        }
+        httpd_resp_set_status(req, "404 Not Found");
+        return httpd_resp_send(req, "{\"error\":\"unknown_op\"}", HTTPD_RESP_USE_STRLEN);
+    }
+
+    json_writer_init(&w, chunk, sizeof(chunk), json_chunk_flush, req);
+    json_writer_begin_array(&w, NULL);
+    for (int i = 0; i < HTTP_OP_SLOTS; i++) {
+        if (ops[i].id) {
+            write_op(&w, &ops[i], now_us);
+        }
+    }
+    json_writer_end_array(&w);
+    return json_resp_end(req, &w);
+}
+
+static esp_err_t send_error(httpd_req_t* req, int status, const char* code)
+{
+    http_op_result_t res;
+    res.status = status;
+    snprintf(res.body, sizeof(res.body), "{\"error\":\"%s\"}", code);
+    return send_op_result(req, &res);
+}
+
+/**
+ * Stream the request body through a body_parser calling cb for each field
+ * application/x-www-form-urlencoded bodies are parsed as forms, anything
+ * else as JSON. On failure the error response has already been sent and
+ * ESP_FAIL is returned, so the handler's ESP_FAIL makes httpd drop the
+ * connection instead of draining an oversized body.
+ */
+static esp_err_t recv_body(httpd_req_t* req, body_parser_cb_t cb, void* ctx)
+{
+    if (req->content_len > CONFIG_HTTP_UI_MAX_BODY) {
+        ESP_LOGW(TAG, "%s: %u byte body refused (max %d)", req->uri,
+                 (unsigned)req->content_len, CONFIG_HTTP_UI_MAX_BODY);
+        httpd_resp_set_hdr(req, "Connection", "close");
+        send_error(req, 413, "body_too_large");
+        return ESP_FAIL;
+    }
+
+    char type[64];
+    body_parser_format_t format = BODY_PARSER_JSON;
+    if (httpd_req_get_hdr_value_str(req, "Content-Type", type, sizeof(type)) == ESP_OK &&
+        strncasecmp(type, "application/x-www-form-urlencoded", 33) == 0) {
+        format = BODY_PARSER_FORM;
+    }
+
+    body_parser_t parser;
+    body_parser_init(&parser, format, cb, ctx);
+
+    char chunk[BODY_CHUNK_SIZE];
+    size_t remaining = req->content_len;
+    esp_err_t err = ESP_OK;
+    while (remaining > 0 && err == ESP_OK) {
+        int n = httpd_req_recv(req, chunk, remaining < sizeof(chunk) ? remaining : sizeof(chunk));
+        if (n <= 0) {
+            if (n == HTTPD_SOCK_ERR_TIMEOUT) {
+                httpd_resp_send_408(req);
+            }
+            return ESP_FAIL;
+        }
+        remaining -= n;
+        err = body_parser_feed(&parser, chunk, n);
+    }
+    if (err == ESP_OK) {
+        err = body_parser_finish(&parser);
+    }
+    if (err != ESP_OK) {
+        send_error(req, 400, err == ESP_ERR_INVALID_SIZE ? "value_too_long" : "invalid_body");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static void config_reject(config_update_t* u, const char* error)
+{
+    if (!u->error) {
+        u->error = error;
+    }
+}
+
+/**
+ * udp_destinations: array of {mode, addr, port, ttl?, rate_div?}; replaces the stored list
+ */
+static void config_dest_field(config_update_t* u, const body_field_t* f)
+{
+    if (f->index < 0) {
+        // Anything but an array is ignored
+        if (f->type == BODY_VALUE_ARRAY) {
+            u->has_dests = true;
+            u->dest_count = 0;
+            memset(u->dest_seen, 0, sizeof(u->dest_seen));
+        }
+        return;
+    }
+    if (!u->has_dests) {
+        return;
+    }
+    if (f->index >= UDP_MAX_DESTINATIONS - 1) {
+        config_reject(u, "invalid_udp_destinations");
+        return;
+    }
+
+    udp_dest_t* d = &u->dests[f->index];
+    if (!f->subkey) {
+        if (f->type != BODY_VALUE_OBJECT) {
+            config_reject(u, "invalid_udp_destinations");
+            return;
+        }
+        memset(d, 0, sizeof(*d));
+        d->ttl = 1;
+        d->rate_div = 1;
+        u->dest_count = f->index + 1;
+        return;
+    }
+
+    double num = 0;
+    bool is_num = f->type == BODY_VALUE_NUMBER && body_field_number(f, &num);
+    uint8_t* seen = &u->dest_seen[f->index];
+
+    if (strcmp(f->subkey, "mode") == 0) {
+        if (!is_num || num < 0 || num > 2) {
+            config_reject(u, "invalid_udp_destinations");
+            return;
+        }
+        d->mode = (udp_mode_t)num;
+        *seen |= DEST_HAS_MODE;
+    } else if (strcmp(f->subkey, "addr") == 0) {
+        if (f->type != BODY_VALUE_STRING) {
+            config_reject(u, "invalid_udp_destinations");
+            return;
+        }
+        strlcpy(d->addr, f->value, sizeof(d->addr));
+        *seen |= DEST_HAS_ADDR;
+    } else if (strcmp(f->subkey, "port") == 0) {
+        if (!is_num || num < 1 || num > 65535) {
+            config_reject(u, "invalid_udp_destinations");
+            return;
+        }
+        d->port = (uint16_t)num;
+        *seen |= DEST_HAS_PORT;
+    } else if (strcmp(f->subkey, "ttl") == 0) {
+        d->ttl = (is_num && num >= 1 && num <= 255) ? (uint8_t)num : 1;
+    } else if (strcmp(f->subkey, "rate_div") == 0) {
+        d->rate_div = (is_num && num >= 1 && num <= 255) ? (uint8_t)num : 1;
+    }
+}
+
+/**
+ * One element or member of "wifi_networks": [{"ssid": ..., "pass": ...}, ...]
+ * The extra networks roamed between next to wifi_ssid; replaces the list,
+ * [] clears it. Checked as a whole by net_mgr_txn_set_networks().
+ */
+static void config_network_field(config_update_t* u, const body_field_t* f)
+{
+    if (f->index < 0) {
+        if (f->type == BODY_VALUE_ARRAY) {
+            u->has_networks = true;
+            u->network_count = 0;
+        }
+        return;
+    }
+    if (!u->has_networks) {
+        return;
+    }
+    if (f->index >= NET_MGR_MAX_NETWORKS - 1) {
+        config_reject(u, "invalid_wifi_networks");
+        return;
+    }
+
+    net_mgr_network_t* n = &u->networks[f->index];
+    if (!f->subkey) {
+        if (f->type != BODY_VALUE_OBJECT) {
+            config_reject(u, "invalid_wifi_networks");
+            return;
+        }
+        memset(n, 0, sizeof(*n));
+        u->network_count = f->index + 1;
+        return;
+    }
+
+    char* dst = NULL;
+    size_t cap = 0;
+    if (strcmp(f->subkey, "ssid") == 0) {
+        dst = n->ssid;
+        cap = sizeof(n->ssid);
+    } else if (strcmp(f->subkey, "pass") == 0) {
+        dst = n->pass;
+        cap = sizeof(n->pass);
+    } else {
+        return;
+    }
+    if (f->type != BODY_VALUE_STRING || f->len >= cap) {
+        config_reject(u, "invalid_wifi_networks");
+        return;
+    }
+    strlcpy(dst, f->value, cap);
+}
+
+/**
+ * body_parser callback for POST /config: stage each known field as it arrives
+ * Out-of-range values are logged and skipped, as they always were; only
+ * fields that make the whole request meaningless set u->error.
+ */
+static esp_err_t config_field(void* ctx, const body_field_t* f)
+{
+    config_update_t* u = ctx;
+    config_mgr_txn_t* txn = u->txn;
+    bool is_str = f->type == BODY_VALUE_STRING;
+    double num = 0;
+    bool flag = false;
+
+    if (strcmp(f->key, "udp_destinations") == 0) {
+        config_dest_field(u, f);
+        return ESP_OK;
+    }
+    if (strcmp(f->key, "wifi_networks") == 0) {
+        config_network_field(u, f);
+        return ESP_OK;
+    }
+
+    // WiFi credential staging (test before commit, no reboot required)
+    if (body_field_is(f, "wifi_ssid") && is_str) {
+        if (f->len >= sizeof(u->ssid)) {
+            config_reject(u, "wifi_invalid_input");
+        } else {
+            strlcpy(u->ssid, f->value, sizeof(u->ssid));
+            u->has_ssid = true;
+        }
+    } else if (body_field_is(f, "wifi_pass") && is_str) {
+        if (f->len >= sizeof(u->pass)) {
+            config_reject(u, "wifi_invalid_input");
+        } else {
+            strlcpy(u->pass, f->value, sizeof(u->pass));
+            u->has_pass = true;
+        }
+    } else if (body_field_is(f, "wifi_power") && is_str) {
+        // "low_latency", "balanced" or "power_save"; applied without reconnecting
+        net_mgr_power_profile_t power;
+        if (net_mgr_power_profile_from_name(f->value, &power) == ESP_OK) {
+            config_mgr_txn_set_u32(txn, "wifi/power", (uint32_t)power);
+            u->power = power;
+            u->power_changed = true;
+        } else {
+            ESP_LOGW(TAG, "Wi-Fi power profile invalid: %s", f->value);
+        }
+
+    // SNTP config (can be applied at runtime)
+    } else if (body_field_is(f, "sntp_server1") && is_str) {
+        config_mgr_txn_set_string(txn, "sntp/server1", f->value);
+        u->sntp_changed = true;
+    } else if (body_field_is(f, "sntp_server2") && is_str) {
+        config_mgr_txn_set_string(txn, "sntp/server2", f->value);
+        u->sntp_changed = true;
+    } else if (body_field_is(f, "sntp_timezone") && is_str) {
+        config_mgr_txn_set_string(txn, "sntp/timezone", f->value);
+        u->sntp_changed = true;
+
+    // UDP config (can be applied at runtime)
+    } else if (body_field_is(f, "udp_enabled") && body_field_bool(f, &flag)) {
+        config_mgr_txn_set_bool(txn, "udp/enabled", flag);
+        u->udp_changed = true;
+    } else if (body_field_is(f, "udp_addr") && is_str) {
+        config_mgr_txn_set_string(txn, "udp/addr", f->value);
+        u->udp_changed = true;
+    } else if (body_field_is(f, "udp_port") && body_field_number(f, &num)) {
+        config_mgr_txn_set_u32(txn, "udp/port", (uint32_t)num);
+        u->udp_changed = true;
+    } else if (body_field_is(f, "udp_freq_hz") && body_field_number(f, &num)) {
+        // Accept frequency as float in Hz (e.g., 1.5)
+        float freq_hz = (float)num;
+        // Validate frequency range: 0.2 Hz to 5 Hz (per CLAUDE_TASKS.md)
+        if (freq_hz >= 0.2f && freq_hz <= 5.0f) {
+            // Convert to millihertz for NVS storage (1 Hz = 1000 mHz)
+            // Use rounding to avoid truncation (e.g., 0.2*1000=199.999... → 200, not 199)
+            uint32_t freq_mhz = (uint32_t)lroundf(freq_hz * 1000.0f);
+            config_mgr_txn_set_u32(txn, "udp/freq_mhz", freq_mhz);
+            u->udp_changed = true;
+            ESP_LOGI(TAG, "UDP frequency set to %.2f Hz (%lu mHz)", freq_hz, freq_mhz);
+        } else {
+            ESP_LOGW(TAG, "UDP frequency out of range (0.2-5.0 Hz): %.2f", freq_hz);
+        }
+    } else if (body_field_is(f, "udp_ttl") && body_field_number(f, &num)) {
+        uint32_t ttl = (uint32_t)num;
+        if (ttl >= 1 && ttl <= 255) {
+            config_mgr_txn_set_u32(txn, "udp/ttl", ttl);
+            u->udp_changed = true;
+        } else {
+            ESP_LOGW(TAG, "UDP TTL out of range (1-255): %lu", ttl);
+        }
+    } else if (body_field_is(f, "udp_mode") && body_field_number(f, &num)) {
+        uint32_t mode = (uint32_t)num;
+        // Validate mode: 0=broadcast, 1=multicast, 2=unicast
+        if (mode <= 2) {
+            config_mgr_txn_set_u32(txn, "udp/mode", mode);
+            u->udp_changed = true;
+        } else {
+            ESP_LOGW(TAG, "UDP mode invalid: %lu", mode);
+        }
+    } else if (body_field_is(f, "udp_format")) {
+        // Accept "json"/"binary" or the numeric udp_format_t value
+        int format = -1;
+        if (is_str && strcmp(f->value, "json") == 0) {
+            format = UDP_FORMAT_JSON;
+        } else if (is_str && strcmp(f->value, "binary") == 0) {
+            format = UDP_FORMAT_BINARY;
+        } else if (body_field_number(f, &num)) {
+            format = (int)num;
+        }
+        if (format == UDP_FORMAT_JSON || format == UDP_FORMAT_BINARY) {
+            config_mgr_txn_set_u32(txn, "udp/format", (uint32_t)format);
+            u->udp_changed = true;
+        } else {
+            ESP_LOGW(TAG, "UDP format invalid");
+        }
+    } else if (body_field_is(f, "udp_stream_enabled") && body_field_bool(f, &flag)) {
+        config_mgr_txn_set_bool(txn, "udp/stream_en", flag);
+        u->udp_changed = true;
+    } else if (body_field_is(f, "udp_stream_batch") && body_field_number(f, &num)) {
+        uint32_t batch = (uint32_t)num;
+        if (batch >= 1 && batch <= 32) {
+            config_mgr_txn_set_u32(txn, "udp/stream_n", batch);
+            u->udp_changed = true;
+        } else {
+            ESP_LOGW(TAG, "UDP stream batch out of range (1-32): %lu", batch);
+        }
+    } else if (body_field_is(f, "udp_stream_ms") && body_field_number(f, &num)) {
+        uint32_t ms = (uint32_t)num;
+        if (ms >= 10 && ms <= 1000) {
+            config_mgr_txn_set_u32(txn, "udp/stream_ms", ms);
+            u->udp_changed = true;
+        } else {
+            ESP_LOGW(TAG, "UDP stream max age out of range (10-1000 ms): %lu", ms);
+        }
+    } else if (body_field_is(f, "ui_live_ms") && body_field_number(f, &num)) {
+        uint32_t ms = (uint32_t)num;
+        if (ms >= LIVE_MIN_MS && ms <= LIVE_MAX_MS) {
+            config_mgr_txn_set_u32(txn, "ui/live_ms", ms);
+            u->live_ms = ms;
+        } else {
+            ESP_LOGW(TAG, "Live status period out of range (200-10000 ms): %lu", ms);
+        }
+    }
     return ESP_OK;
 }
 
 /**
- * POST /config - Update configuration
+ * Whole-body checks once parsing is done; sets u->error on failure
  */
-static esp_err_t config_post_handler(httpd_req_t* req)
+static void config_update_check(config_update_t* u)
 {
-    // Check auth
-    if (check_basic_auth(req) != ESP_OK) {
-        return send_401(req);
+    // Both SSID and password must be provided together
+    if (u->has_ssid != u->has_pass) {
+        config_reject(u, "wifi_incomplete");
     }
 
-    // Read request body
-    char* buf = malloc(req->content_len + 1);
-    if (!buf) {
-        httpd_resp_send_500(req);
-        return ESP_FAIL;
+    if (!u->error && u->has_networks &&
+        net_mgr_txn_set_networks(u->txn, u->networks, u->network_count) != ESP_OK) {
+        config_reject(u, "invalid_wifi_networks");
     }
+    memset(u->networks, 0, sizeof(u->networks));   // Passwords are in txn now
 
-    int ret = httpd_req_recv(req, buf, req->content_len);
-    if (ret <= 0) {
-        free(buf);
-        if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
-            httpd_resp_send_408(req);
+    if (!u->error && u->has_dests) {
+        for (size_t i = 0; i < u->dest_count; i++) {
+            if (u->dest_seen[i] != DEST_HAS_ALL) {
+                config_reject(u, "invalid_udp_destinations");
+                return;
+            }
         }
-        return ESP_FAIL;
-    }
-    buf[ret] = '\0';
-
-    // Parse JSON
-    cJSON* root = cJSON_Parse(buf);
-    free(buf);
-
-    if (!root) {
-        httpd_resp_set_status(req, "400 Bad Request");
-        httpd_resp_set_type(req, "application/json");
-        httpd_resp_send(req, "{\"error\":\"Invalid JSON\"}", HTTPD_RESP_USE_STRLEN);
-        return ESP_OK;
+        if (udp_broadcast_txn_set_destinations(u->txn, u->dests, u->dest_count) != ESP_OK) {
+            config_reject(u, "invalid_udp_destinations");
+            return;
+        }
+        u->udp_changed = true;
     }
+}
 
+/**
+ * Commit everything staged for a POST /config and apply it at runtime
+ * Runs on the httpd task or on an op worker, so the response goes into res
+ * rather than onto a request.
+ */
+static void config_commit(config_update_t* u, http_op_result_t* res)
+{
     bool needs_reboot = false;
-    bool udp_config_changed = false;
-
-    // Process configuration updates
-    // WiFi credential staging (test before commit, no reboot required)
-    cJSON* wifi_ssid = cJSON_GetObjectItem(root, "wifi_ssid");
-    cJSON* wifi_pass = cJSON_GetObjectItem(root, "wifi_pass");
-
-    if ((wifi_ssid && cJSON_IsString(wifi_ssid)) ||
-        (wifi_pass && cJSON_IsString(wifi_pass))) {
-
-        // Both SSID and password must be provided together
-        if (!wifi_ssid || !cJSON_IsString(wifi_ssid) ||
-            !wifi_pass || !cJSON_IsString(wifi_pass)) {
-            cJSON_Delete(root);
-            httpd_resp_set_status(req, "400 Bad Request");
-            httpd_resp_set_type(req, "application/json");
-            httpd_resp_send(req, "{\"error\":\"wifi_incomplete\"}", HTTPD_RESP_USE_STRLEN);
-            return ESP_OK;
-        }
-
-        ESP_LOGI(TAG, "Testing WiFi credentials for SSID: %s", wifi_ssid->valuestring);
-
-        net_mgr_cred_result_t cred_result;
-        esp_err_t test_ret = net_mgr_test_and_commit_credentials(
-            wifi_ssid->valuestring,
-            wifi_pass->valuestring,
-            20000,  // 20 second timeout
-            &cred_result
-        );
-
-        if (test_ret != ESP_OK) {
-            // Staging failed, return error
-            const char* error_str = net_mgr_cred_result_to_string(cred_result);
-            ESP_LOGW(TAG, "WiFi credential staging failed: %s", error_str);
-
-            cJSON* error_response = cJSON_CreateObject();
-            cJSON_AddStringToObject(error_response, "error", error_str);
-
-            char* error_json = cJSON_PrintUnformatted(error_response);
-            cJSON_Delete(error_response);
-            cJSON_Delete(root);
-
-            if (error_json) {
-                httpd_resp_set_type(req, "application/json");
-                httpd_resp_send(req, error_json, HTTPD_RESP_USE_STRLEN);
-                free(error_json);
-            } else {
-                httpd_resp_send_500(req);
-            }
-            return ESP_OK;
-        }
 
-        ESP_LOGI(TAG, "WiFi credentials tested and committed successfully");
-        // Do NOT set needs_reboot - already connected to new network
+    // Single commit for everything staged while parsing
+    esp_err_t txn_ret = config_mgr_txn_commit(u->txn);
+    u->txn = NULL;
+    if (txn_ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save configuration: %s", esp_err_to_name(txn_ret));
+        op_result_set(res, 500, "{\"error\":\"save_failed\"}");
+        return;
     }
 
-    // SNTP config (can be applied at runtime)
-    bool sntp_config_changed = false;
-
-    cJSON* sntp_server1 = cJSON_GetObjectItem(root, "sntp_server1");
-    if (sntp_server1 && cJSON_IsString(sntp_server1)) {
-        config_mgr_set_string("sntp/server1", sntp_server1->valuestring);
-        sntp_config_changed = true;
+#if CONFIG_HTTPD_WS_SUPPORT
+    if (u->live_ms) {
+        live_set_period(u->live_ms);
     }
+#endif
 
-    cJSON* sntp_server2 = cJSON_GetObjectItem(root, "sntp_server2");
-    if (sntp_server2 && cJSON_IsString(sntp_server2)) {
-        config_mgr_set_string("sntp/server2", sntp_server2->valuestring);
-        sntp_config_changed = true;
+    if (u->power_changed) {
+        net_mgr_set_power_profile(u->power);
     }
 
-    cJSON* sntp_timezone = cJSON_GetObjectItem(root, "sntp_timezone");
-    if (sntp_timezone && cJSON_IsString(sntp_timezone)) {
-        config_mgr_set_string("sntp/timezone", sntp_timezone->valuestring);
-        sntp_config_changed = true;
+    if (u->has_networks) {
+        net_mgr_reload_networks();
     }
 
     // Apply SNTP configuration changes at runtime
-    if (sntp_config_changed) {
+    if (u->sntp_changed) {
         ESP_LOGI(TAG, "SNTP configuration changed, reloading");
         esp_err_t sntp_ret = sntp_client_reload_config();
         if (sntp_ret != ESP_OK) {
@@ -1142,67 +2248,8 @@ static esp_err_t config_post_handler(httpd_req_t* req)
         }
     }
 
-    // UDP config (can be applied at runtime)
-    cJSON* udp_enabled = cJSON_GetObjectItem(root, "udp_enabled");
-    if (udp_enabled && cJSON_IsBool(udp_enabled)) {
-        config_mgr_set_bool("udp/enabled", cJSON_IsTrue(udp_enabled));
-        udp_config_changed = true;
-    }
-
-    cJSON* udp_addr = cJSON_GetObjectItem(root, "udp_addr");
-    if (udp_addr && cJSON_IsString(udp_addr)) {
-        config_mgr_set_string("udp/addr", udp_addr->valuestring);
-        udp_config_changed = true;
-    }
-
-    cJSON* udp_port = cJSON_GetObjectItem(root, "udp_port");
-    if (udp_port && cJSON_IsNumber(udp_port)) {
-        config_mgr_set_u32("udp/port", (uint32_t)udp_port->valuedouble);
-        udp_config_changed = true;
-    }
-
-    cJSON* udp_freq_hz = cJSON_GetObjectItem(root, "udp_freq_hz");
-    if (udp_freq_hz && cJSON_IsNumber(udp_freq_hz)) {
-        // Accept frequency as float in Hz (e.g., 1.5)
-        float freq_hz = (float)udp_freq_hz->valuedouble;
-        // Validate frequency range: 0.2 Hz to 5 Hz (per CLAUDE_TASKS.md)
-        if (freq_hz >= 0.2f && freq_hz <= 5.0f) {
-            // Convert to millihertz for NVS storage (1 Hz = 1000 mHz)
-            // Use rounding to avoid truncation (e.g., 0.2*1000=199.999... → 200, not 199)
-            uint32_t freq_mhz = (uint32_t)lroundf(freq_hz * 1000.0f);
-            config_mgr_set_u32("udp/freq_hz", freq_mhz);
-            udp_config_changed = true;
-            ESP_LOGI(TAG, "UDP frequency set to %.2f Hz (%lu mHz)", freq_hz, freq_mhz);
-        } else {
-            ESP_LOGW(TAG, "UDP frequency out of range (0.2-5.0 Hz): %.2f", freq_hz);
-        }
-    }
-
-    cJSON* udp_ttl = cJSON_GetObjectItem(root, "udp_ttl");
-    if (udp_ttl && cJSON_IsNumber(udp_ttl)) {
-        uint32_t ttl = (uint32_t)udp_ttl->valuedouble;
-        if (ttl >= 1 && ttl <= 255) {
-            config_mgr_set_u32("udp/ttl", ttl);
-            udp_config_changed = true;
-        } else {
-            ESP_LOGW(TAG, "UDP TTL out of range (1-255): %lu", ttl);
-        }
-    }
-
-    cJSON* udp_mode = cJSON_GetObjectItem(root, "udp_mode");
-    if (udp_mode && cJSON_IsNumber(udp_mode)) {
-        uint32_t mode = (uint32_t)udp_mode->valuedouble;
-        // Validate mode: 0=broadcast, 1=multicast, 2=unicast
-        if (mode <= 2) {
-            config_mgr_set_u32("udp/mode", mode);
-            udp_config_changed = true;
-        } else {
-            ESP_LOGW(TAG, "UDP mode invalid: %lu", mode);
-        }
-    }
-
     // Apply UDP configuration changes at runtime (per requirements)
-    if (udp_config_changed) {
+    if (u->udp_changed) {
         ESP_LOGI(TAG, "UDP configuration changed, applying at runtime");
 
         // Load complete UDP configuration from NVS
@@ -1213,7 +2260,7 @@ static esp_err_t config_post_handler(httpd_req_t* req)
         if (config_mgr_get_u32("udp/port", &temp_u32) == ESP_OK) {
             udp_cfg.port = (uint16_t)temp_u32;
         }
-        if (config_mgr_get_u32("udp/freq_hz", &temp_u32) == ESP_OK) {
+        if (config_mgr_get_u32("udp/freq_mhz", &temp_u32) == ESP_OK) {
             // NVS stores frequency in millihertz; pass it directly without conversion
             // This preserves fractional precision (e.g., 1.5 Hz = 1500 mHz)
             udp_cfg.freq_mhz = (uint16_t)temp_u32;
@@ -1224,6 +2271,9 @@ static esp_err_t config_post_handler(httpd_req_t* req)
         if (config_mgr_get_u32("udp/mode", &temp_u32) == ESP_OK) {
             udp_cfg.mode = (udp_mode_t)temp_u32;
         }
+        if (config_mgr_get_u32("udp/format", &temp_u32) == ESP_OK) {
+            udp_cfg.format = (udp_format_t)temp_u32;
+        }
 
         // Apply configuration to running UDP broadcast module
         esp_err_t apply_ret = udp_broadcast_apply_config(&udp_cfg);
@@ -1236,28 +2286,104 @@ static esp_err_t config_post_handler(httpd_req_t* req)
     }
 
     // Build response
-    cJSON* response = cJSON_CreateObject();
-    cJSON_AddStringToObject(response, "status", "ok");
-    cJSON_AddBoolToObject(response, "needs_reboot", needs_reboot);
+    res->status = 200;
+    snprintf(res->body, sizeof(res->body), "{\"status\":\"ok\",\"needs_reboot\":%s}",
+             needs_reboot ? "true" : "false");
+}
 
-    char* json_str = cJSON_PrintUnformatted(response);
-    cJSON_Delete(response);
-    cJSON_Delete(root);
+/**
+ * POST /config - Update configuration (JSON or form-encoded body)
+ * Bodies with wifi_ssid/wifi_pass run as an async operation (see http_op_submit)
+ */
+static esp_err_t config_post_handler(httpd_req_t* req)
+{
+    // Check auth
+    if (check_basic_auth(req) != ESP_OK) {
+        return send_401(req);
+    }
 
-    if (!json_str) {
-        httpd_resp_send_500(req);
+    // SNTP and UDP fields are staged and committed together so a save is
+    // one flash commit and never leaves the config half-applied
+    config_update_t u = { 0 };
+    if (config_mgr_txn_begin(&u.txn) != ESP_OK) {
+        return send_error(req, 500, "save_failed");
+    }
+
+    if (recv_body(req, config_field, &u) != ESP_OK) {
+        config_mgr_txn_abort(u.txn);
         return ESP_FAIL;
     }
 
-    httpd_resp_set_type(req, "application/json");
-    httpd_resp_send(req, json_str, HTTPD_RESP_USE_STRLEN);
+    config_update_check(&u);
+    if (u.error) {
+        config_mgr_txn_abort(u.txn);
+        return send_error(req, 400, u.error);
+    }
+
+    if (u.has_ssid) {
+        // The credential test blocks for up to 20 s; a worker runs it and
+        // then commits the rest of the body, so a failed test saves nothing
+        return http_op_submit(req, HTTP_OP_WIFI_TEST, &u, sizeof(u));
+    }
+
+    http_op_result_t res;
+    config_commit(&u, &res);
+    return send_op_result(req, &res);
+}
+
+static esp_err_t ota_field(void* ctx, const body_field_t* f)
+{
+    char* url = ctx;
 
-    free(json_str);
+    if (body_field_is(f, "url") && f->type == BODY_VALUE_STRING) {
+        strlcpy(url, f->value, OTA_URL_MAX);
+    }
     return ESP_OK;
 }
 
+static bool parse_sha256_hex(const char* hex, uint8_t out[32])
+{
+    if (strlen(hex) != 64) {
+        return false;
+    }
+    for (int i = 0; i < 32; i++) {
+        char byte[3] = { hex[i * 2], hex[i * 2 + 1], '\0' };
+        char* end = NULL;
+        out[i] = (uint8_t)strtoul(byte, &end, 16);
+        if (end != byte + 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * POST /ota with an application/octet-stream body: the body is the image
+ * Always detached to a worker (progress in /status and /ops); the response
+ * comes when the image is verified, and the device reboots 2 s later.
+ */
+static esp_err_t ota_upload_handler(httpd_req_t* req)
+{
+    if (req->content_len == 0) {
+        return send_error(req, 400, "empty_image");
+    }
+
+    http_op_args_t args = { 0 };
+    char hex[72];
+    if (httpd_req_get_hdr_value_str(req, "X-Image-SHA256", hex, sizeof(hex)) == ESP_OK) {
+        if (!parse_sha256_hex(hex, args.upload.sha256)) {
+            return send_error(req, 400, "invalid_sha256");
+        }
+        args.upload.has_sha256 = true;
+    }
+
+    ESP_LOGI(TAG, "OTA upload of %u bytes requested", (unsigned)req->content_len);
+    return http_op_submit(req, HTTP_OP_UPLOAD, &args.upload, sizeof(args.upload));
+}
+
 /**
- * POST /ota - Trigger OTA update
+ * POST /ota - Trigger OTA update (async operation, state tracked until OTA_SUCCESS/OTA_FAIL)
+ * JSON {"url": ...} pulls the image; an application/octet-stream body is the image itself.
  */
 static esp_err_t ota_post_handler(httpd_req_t* req)
 {
@@ -1266,96 +2392,200 @@ static esp_err_t ota_post_handler(httpd_req_t* req)
         return send_401(req);
     }
 
-    // Read request body
-    char* buf = malloc(req->content_len + 1);
-    if (!buf) {
-        httpd_resp_send_500(req);
-        return ESP_FAIL;
+    char type[64];
+    if (httpd_req_get_hdr_value_str(req, "Content-Type", type, sizeof(type)) == ESP_OK &&
+        strncasecmp(type, "application/octet-stream", 24) == 0) {
+        return ota_upload_handler(req);
     }
 
-    int ret = httpd_req_recv(req, buf, req->content_len);
-    if (ret <= 0) {
-        free(buf);
-        if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
-            httpd_resp_send_408(req);
-        }
+    char url[OTA_URL_MAX] = "";
+    if (recv_body(req, ota_field, url) != ESP_OK) {
         return ESP_FAIL;
     }
-    buf[ret] = '\0';
-
-    // Parse JSON
-    cJSON* root = cJSON_Parse(buf);
-    free(buf);
 
-    if (!root) {
-        httpd_resp_set_status(req, "400 Bad Request");
-        httpd_resp_set_type(req, "application/json");
-        httpd_resp_send(req, "{\"error\":\"Invalid JSON\"}", HTTPD_RESP_USE_STRLEN);
-        return ESP_OK;
+    if (!url[0]) {
+        return send_error(req, 400, "missing_url");
     }
 
-    cJSON* url = cJSON_GetObjectItem(root, "url");
-    if (!url || !cJSON_IsString(url)) {
-        cJSON_Delete(root);
-        httpd_resp_set_status(req, "400 Bad Request");
-        httpd_resp_set_type(req, "application/json");
-        httpd_resp_send(req, "{\"error\":\"Missing 'url' field\"}", HTTPD_RESP_USE_STRLEN);
-        return ESP_OK;
-    }
+    ESP_LOGI(TAG, "OTA requested from URL: %s", url);
+    return http_op_submit(req, HTTP_OP_OTA, url, sizeof(url));
+}
 
-    // TODO: Call ota_mgr_trigger_from_url() when Task 7 is implemented
-    ESP_LOGI(TAG, "OTA requested from URL: %s (not yet implemented)", url->valuestring);
+/**
+ * POST /reboot - Reboot device after 1s delay (async operation)
+ */
+static esp_err_t reboot_post_handler(httpd_req_t* req)
+{
+    // Check auth
+    if (check_basic_auth(req) != ESP_OK) {
+        return send_401(req);
+    }
 
-    cJSON_Delete(root);
+    ESP_LOGW(TAG, "Reboot requested via HTTP");
 
-    // Send response
-    httpd_resp_set_type(req, "application/json");
-    httpd_resp_send(req, "{\"status\":\"ota_triggered\"}", HTTPD_RESP_USE_STRLEN);
+    // A worker waits out the delay so the response (and other sockets)
+    // are not held up behind it
+    return http_op_submit(req, HTTP_OP_REBOOT, NULL, 0);
+}
 
-    return ESP_OK;
+/**
+ * Parse ?level= for /logs: letter (E/W/I/D/V), name, or number
+ */
+static esp_log_level_t parse_log_level(const char* v)
+{
+    switch (v[0]) {
+        case 'e': case 'E': return ESP_LOG_ERROR;
+        case 'w': case 'W': return ESP_LOG_WARN;
+        case 'i': case 'I': return ESP_LOG_INFO;
+        case 'd': case 'D': return ESP_LOG_DEBUG;
+        case 'v': case 'V': return ESP_LOG_VERBOSE;
+        default: break;
+    }
+    int n = atoi(v);
+    if (n < ESP_LOG_ERROR) n = ESP_LOG_ERROR;
+    if (n > ESP_LOG_VERBOSE) n = ESP_LOG_VERBOSE;
+    return (esp_log_level_t)n;
 }
 
 /**
- * POST /reboot - Reboot device after 1s delay
+ * GET /logs - Stream the diag log ring as text/plain
+ * ?since=<seq> returns only lines newer than seq; X-Log-Next-Seq gives the
+ * value to pass next time. ?level=<E|W|I|D|V> keeps lines at or above
+ * that severity. Lines are sent in chunks, so the ring is never copied
+ * whole.
  */
-static esp_err_t reboot_post_handler(httpd_req_t* req)
+static esp_err_t logs_get_handler(httpd_req_t* req)
 {
     // Check auth
     if (check_basic_auth(req) != ESP_OK) {
         return send_401(req);
     }
 
-    ESP_LOGW(TAG, "Reboot requested via HTTP");
+    diag_log_ring_info_t info;
+    if (diag_log_ring_get_info(&info) != ESP_OK) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "text/plain");
+        httpd_resp_send(req, "Log ring not available\n", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
 
-    // Send response first
-    httpd_resp_set_type(req, "application/json");
-    httpd_resp_send(req, "{\"status\":\"rebooting\"}", HTTPD_RESP_USE_STRLEN);
+    uint32_t cursor = 0;
+    esp_log_level_t max_level = ESP_LOG_VERBOSE;
+    char query[64];
+    char value[16];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (httpd_query_key_value(query, "since", value, sizeof(value)) == ESP_OK) {
+            cursor = (uint32_t)strtoul(value, NULL, 10);
+        }
+        if (httpd_query_key_value(query, "level", value, sizeof(value)) == ESP_OK && value[0]) {
+            max_level = parse_log_level(value);
+        }
+    }
+
+    // Stop at the lines present now so X-Log-Next-Seq is exact
+    uint32_t last_seq = info.next_seq - 1;
+    char next_hdr[12];
+    snprintf(next_hdr, sizeof(next_hdr), "%lu", (unsigned long)last_seq);
+
+    httpd_resp_set_type(req, "text/plain");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+    httpd_resp_set_hdr(req, "X-Log-Next-Seq", next_hdr);
+
+    const size_t chunk_cap = 1024;
+    char* chunk = malloc(chunk_cap);
+    diag_log_line_t* line = malloc(sizeof(*line));
+    if (!chunk || !line) {
+        free(chunk);
+        free(line);
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+
+    esp_err_t ret = ESP_OK;
+    size_t used = 0;
+    while (cursor < last_seq && diag_log_ring_read(&cursor, max_level, line)) {
+        if (line->seq > last_seq) {
+            break;
+        }
+        if (used + line->len + 1 > chunk_cap) {
+            ret = httpd_resp_send_chunk(req, chunk, used);
+            used = 0;
+            if (ret != ESP_OK) {
+                break;
+            }
+        }
+        memcpy(chunk + used, line->text, line->len);
+        used += line->len;
+        chunk[used++] = '\n';
+    }
+
+    if (ret == ESP_OK && used > 0) {
+        ret = httpd_resp_send_chunk(req, chunk, used);
+    }
+    free(chunk);
+    free(line);
+
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Log stream aborted: %s", esp_err_to_name(ret));
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
 
-    // Schedule reboot after 1s (allow response to be sent)
-    // Note: In a real implementation, use esp_timer for clean shutdown
-    vTaskDelay(pdMS_TO_TICKS(1000));
-    esp_restart();
+// Batches metric lines into HTTP chunks
+typedef struct {
+    httpd_req_t* req;
+    char buf[1024];
+    size_t used;
+} metrics_chunk_t;
 
+static esp_err_t metrics_sink(const char* text, size_t len, void* ctx)
+{
+    metrics_chunk_t* c = (metrics_chunk_t*)ctx;
+    if (c->used + len > sizeof(c->buf)) {
+        esp_err_t ret = httpd_resp_send_chunk(c->req, c->buf, c->used);
+        c->used = 0;
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    memcpy(c->buf + c->used, text, len);
+    c->used += len;
     return ESP_OK;
 }
 
 /**
- * GET /logs - Return log ring buffer (placeholder)
+ * GET /metrics - diag metrics registry in Prometheus text format
  */
-static esp_err_t logs_get_handler(httpd_req_t* req)
+static esp_err_t metrics_get_handler(httpd_req_t* req)
 {
     // Check auth
     if (check_basic_auth(req) != ESP_OK) {
         return send_401(req);
     }
 
-    // TODO: Implement log ring buffer in Task 10 (diag module)
-    // For now, return placeholder
+    metrics_chunk_t* c = malloc(sizeof(*c));
+    if (!c) {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    c->req = req;
+    c->used = 0;
+
+    httpd_resp_set_type(req, "text/plain; version=0.0.4");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
 
-    httpd_resp_set_type(req, "text/plain");
-    httpd_resp_send(req, "Log ring buffer not yet implemented\n", HTTPD_RESP_USE_STRLEN);
+    esp_err_t ret = diag_metrics_write(metrics_sink, c);
+    if (ret == ESP_OK && c->used > 0) {
+        ret = httpd_resp_send_chunk(req, c->buf, c->used);
+    }
+    free(c);
 
-    return ESP_OK;
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Metrics scrape aborted: %s", esp_err_to_name(ret));
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
 }
 
 /**
@@ -1379,10 +2609,7 @@ static esp_err_t root_redirect_get_handler(httpd_req_t* req)
  */
 static esp_err_t favicon_get_handler(httpd_req_t* req)
 {
-    httpd_resp_set_type(req, "image/x-icon");
-    httpd_resp_set_hdr(req, "Cache-Control", "public, max-age=86400");  // Cache for 1 day
-    httpd_resp_send(req, (const char*)s_favicon_ico, s_favicon_ico_len);
-    return ESP_OK;
+    return send_asset(req, &s_asset_favicon);
 }
 
 /**
@@ -1390,11 +2617,100 @@ static esp_err_t favicon_get_handler(httpd_req_t* req)
  */
 static esp_err_t logo_get_handler(httpd_req_t* req)
 {
-    httpd_resp_set_type(req, "image/webp");
-    httpd_resp_set_hdr(req, "Cache-Control", "public, max-age=86400");  // Cache for 1 day
-    httpd_resp_send(req, (const char*)Xtragen_logo_200x62_webp, Xtragen_logo_200x62_webp_len);
+    return send_asset(req, &s_asset_logo);
+}
+
+#if CONFIG_HTTP_UI_WEB_PACK
+/**
+ * POST /assets - Replace the web pack (body: image from tools/mkwebpack.py)
+ * Each flash sector is erased just before it is written, header first, so
+ * an interrupted upload leaves no valid pack and the builtin assets serve
+ * until a good one arrives.
+ */
+static esp_err_t assets_post_handler(httpd_req_t* req)
+{
+    if (check_basic_auth(req) != ESP_OK) {
+        return send_401(req);
+    }
+
+    httpd_resp_set_type(req, "application/json");
+
+    if (!s_pack_part) {
+        httpd_resp_set_status(req, "404 Not Found");
+        httpd_resp_send(req, "{\"error\":\"No web pack partition\"}", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+    if (req->content_len < sizeof(web_pack_header_t) || req->content_len > s_pack_part->size) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "{\"error\":\"Invalid web pack size\"}", HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+
+    uint8_t* buf = malloc(WEB_PACK_SECTOR);
+    if (!buf) {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "Web pack upload: %u bytes", (unsigned)req->content_len);
+    web_pack_unmap();
+
+    size_t written = 0;
+    esp_err_t ret = ESP_OK;
+    while (written < req->content_len && ret == ESP_OK) {
+        size_t want = req->content_len - written;
+        if (want > WEB_PACK_SECTOR) {
+            want = WEB_PACK_SECTOR;
+        }
+
+        size_t fill = 0;
+        while (fill < want) {
+            int n = httpd_req_recv(req, (char*)buf + fill, want - fill);
+            if (n <= 0) {
+                free(buf);
+                if (n == HTTPD_SOCK_ERR_TIMEOUT) {
+                    httpd_resp_send_408(req);
+                }
+                ESP_LOGW(TAG, "Web pack upload aborted at %u bytes", (unsigned)(written + fill));
+                return ESP_FAIL;
+            }
+            fill += n;
+        }
+
+        ret = esp_partition_erase_range(s_pack_part, written, WEB_PACK_SECTOR);
+        if (ret == ESP_OK) {
+            ret = esp_partition_write(s_pack_part, written, buf, fill);
+        }
+        written += fill;
+    }
+    free(buf);
+
+    if (ret == ESP_OK) {
+        ret = web_pack_map();
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Web pack upload rejected: %s", esp_err_to_name(ret));
+        char msg[80];
+        snprintf(msg, sizeof(msg), "{\"error\":\"Web pack rejected: %s\"}", esp_err_to_name(ret));
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, msg, HTTPD_RESP_USE_STRLEN);
+        return ESP_OK;
+    }
+
+    size_t from_pack = 0;
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        if (s_assets[i]->served.start != s_assets[i]->builtin.start) {
+            from_pack++;
+        }
+    }
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "{\"status\":\"ok\",\"bytes\":%u,\"assets\":%u}",
+             (unsigned)written, (unsigned)from_pack);
+    httpd_resp_send(req, msg, HTTPD_RESP_USE_STRLEN);
     return ESP_OK;
 }
+#endif
 
 // URI handler structures
 static const httpd_uri_t status_get = {
@@ -1432,6 +2748,13 @@ static const httpd_uri_t ota_post = {
     .user_ctx = NULL
 };
 
+static const httpd_uri_t ops_get = {
+    .uri = "/ops",
+    .method = HTTP_GET,
+    .handler = ops_get_handler,
+    .user_ctx = NULL
+};
+
 static const httpd_uri_t reboot_post = {
     .uri = "/reboot",
     .method = HTTP_POST,
@@ -1439,6 +2762,20 @@ static const httpd_uri_t reboot_post = {
     .user_ctx = NULL
 };
 
+static const httpd_uri_t diag_events_get = {
+    .uri = "/diag/events",
+    .method = HTTP_GET,
+    .handler = diag_events_get_handler,
+    .user_ctx = NULL
+};
+
+static const httpd_uri_t metrics_get = {
+    .uri = "/metrics",
+    .method = HTTP_GET,
+    .handler = metrics_get_handler,
+    .user_ctx = NULL
+};
+
 static const httpd_uri_t logs_get = {
     .uri = "/logs",
     .method = HTTP_GET,
@@ -1467,6 +2804,25 @@ static const httpd_uri_t logo_get = {
     .user_ctx = NULL
 };
 
+#if CONFIG_HTTPD_WS_SUPPORT
+static const httpd_uri_t ws_get = {
+    .uri = "/ws",
+    .method = HTTP_GET,
+    .handler = ws_handler,
+    .user_ctx = NULL,
+    .is_websocket = true
+};
+#endif
+
+#if CONFIG_HTTP_UI_WEB_PACK
+static const httpd_uri_t assets_post = {
+    .uri = "/assets",
+    .method = HTTP_POST,
+    .handler = assets_post_handler,
+    .user_ctx = NULL
+};
+#endif
+
 esp_err_t http_ui_start(void)
 {
     ESP_LOGI(TAG, "Starting HTTP server");
@@ -1577,10 +2933,28 @@ skip_setup_check:
         return ret;
     }
 
+    // Serve the web pack from the storage partition when one is flashed
+    bind_assets(NULL);
+#if CONFIG_HTTP_UI_WEB_PACK
+    ret = web_pack_map();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "No usable web pack (%s), serving builtin assets", esp_err_to_name(ret));
+    }
+#endif
+
+    ret = http_ops_init();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Async op workers unavailable: %s", esp_err_to_name(ret));
+    }
+
     // Start HTTP server
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     config.lru_purge_enable = true;
-    config.max_uri_handlers = 12;  // Increased from default 8 to accommodate all handlers
+    config.max_uri_handlers = 20;  // Increased from default 8 to accommodate all handlers
+    config.stack_size = 6144;      // POST bodies are parsed on the stack (body_parser)
+#if CONFIG_HTTPD_WS_SUPPORT
+    config.close_fn = http_ui_close_fn;
+#endif
 
     ret = httpd_start(&s_server, &config);
     if (ret != ESP_OK) {
@@ -1598,7 +2972,19 @@ skip_setup_check:
     httpd_register_uri_handler(s_server, &config_post);   // JSON API
     httpd_register_uri_handler(s_server, &ota_post);
     httpd_register_uri_handler(s_server, &reboot_post);
+    httpd_register_uri_handler(s_server, &ops_get);
     httpd_register_uri_handler(s_server, &logs_get);
+    httpd_register_uri_handler(s_server, &diag_events_get);
+    httpd_register_uri_handler(s_server, &metrics_get);
+#if CONFIG_HTTP_UI_WEB_PACK
+    httpd_register_uri_handler(s_server, &assets_post);
+#endif
+#if CONFIG_HTTPD_WS_SUPPORT
+    httpd_register_uri_handler(s_server, &ws_get);
+    if (live_start() != ESP_OK) {
+        ESP_LOGW(TAG, "Live status timer not started; /ws pushes on events only");
+    }
+#endif
 
     ESP_LOGI(TAG, "HTTP server started on port %d", config.server_port);
 
@@ -1612,6 +2998,9 @@ esp_err_t http_ui_stop(void)
     }
 
     ESP_LOGI(TAG, "Stopping HTTP server");
+#if CONFIG_HTTPD_WS_SUPPORT
+    live_stop();
+#endif
 
     esp_err_t ret = httpd_stop(s_server);
     if (ret == ESP_OK) {
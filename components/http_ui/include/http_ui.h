@@ -1,4 +1,6 @@
 #pragma once
+#include <stddef.h>
+#include "sdkconfig.h"
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -9,6 +11,14 @@ esp_err_t http_ui_start(void);
 esp_err_t http_ui_stop(void);
 esp_err_t http_ui_update_auth(const char* user, const char* pass);
 
+#ifdef CONFIG_RUN_UNIT_TESTS
+/**
+ * Benchmark hook: build the GET /status body through the same streaming
+ * writer the handler uses, discarding the output. len_out gets its size.
+ */
+esp_err_t http_ui_test_build_status(size_t* len_out);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
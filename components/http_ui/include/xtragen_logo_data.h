@@ -1,423 +0,0 @@
-unsigned char Xtragen_logo_200x62_webp[] = {
-  0x52, 0x49, 0x46, 0x46, 0xa4, 0x13, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50,
-  0x56, 0x50, 0x38, 0x58, 0x0a, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
-  0xc7, 0x00, 0x00, 0x3d, 0x00, 0x00, 0x41, 0x4c, 0x50, 0x48, 0x2e, 0x0c,
-  0x00, 0x00, 0x01, 0xff, 0x43, 0x90, 0x6d, 0xb3, 0xfd, 0xfe, 0xe4, 0x13,
-  0x88, 0x98, 0xff, 0xe4, 0xd4, 0x37, 0x35, 0xfc, 0x6f, 0xdb, 0xf6, 0x38,
-  0xc9, 0xb6, 0x7f, 0xfb, 0x39, 0xc9, 0xa4, 0x12, 0x20, 0x10, 0x7a, 0x51,
-  0x10, 0xb1, 0x87, 0x48, 0x55, 0xb1, 0x53, 0xbd, 0xa4, 0x6a, 0x6c, 0x60,
-  0x8b, 0xd2, 0x14, 0x08, 0xa6, 0x10, 0x32, 0x99, 0x99, 0xf3, 0xf8, 0xd7,
-  0xcf, 0xe3, 0x9c, 0x09, 0xb9, 0x9f, 0xc5, 0xc7, 0xfc, 0x1c, 0xd1, 0xff,
-  0xc4, 0xff, 0xc5, 0xe8, 0x7f, 0x9e, 0xdd, 0x98, 0x69, 0x45, 0xd3, 0x37,
-  0x9f, 0x94, 0x64, 0x55, 0x39, 0xc7, 0x63, 0x02, 0x4d, 0x7e, 0xa6, 0x56,
-  0x7c, 0x78, 0x75, 0x64, 0xc1, 0xca, 0xf7, 0xa2, 0xb9, 0x47, 0xca, 0x7f,
-  0x06, 0x5a, 0x27, 0x6f, 0x84, 0x1e, 0x38, 0xdb, 0x68, 0xd6, 0x22, 0x16,
-  0x17, 0x50, 0xb7, 0xe4, 0x52, 0xfc, 0xc8, 0x75, 0xd6, 0x82, 0x27, 0xf9,
-  0x38, 0x54, 0x20, 0x11, 0x44, 0xd3, 0x4d, 0xae, 0xff, 0xfa, 0xfd, 0xa6,
-  0x5b, 0xcc, 0x52, 0x66, 0x80, 0xb8, 0x88, 0x9d, 0x72, 0xaf, 0x71, 0xf3,
-  0xcb, 0xc9, 0xde, 0x6c, 0x18, 0xcd, 0x35, 0xfc, 0x8d, 0xf4, 0x61, 0xe7,
-  0x3d, 0xf9, 0xb8, 0xbd, 0x4c, 0xf2, 0x93, 0xf1, 0xbb, 0xd8, 0x71, 0xa3,
-  0x42, 0xec, 0x2c, 0xa1, 0xb9, 0x4e, 0x90, 0xef, 0x79, 0xc2, 0x3e, 0x6a,
-  0x1b, 0xde, 0x5c, 0x6a, 0xbb, 0x55, 0xfb, 0x66, 0xec, 0x93, 0x57, 0x4d,
-  0xa0, 0xa9, 0xae, 0x92, 0xef, 0x03, 0x9e, 0xdb, 0x5f, 0x87, 0x3b, 0x53,
-  0x99, 0xf2, 0xf9, 0xa8, 0xe1, 0x90, 0x67, 0x8f, 0xa2, 0xa9, 0x3e, 0x27,
-  0xdf, 0x26, 0x22, 0x5b, 0xd5, 0xf3, 0xe3, 0x53, 0xa7, 0x3c, 0x1d, 0x10,
-  0x65, 0xf2, 0x6a, 0xfd, 0x68, 0xaa, 0xbd, 0x35, 0xf2, 0x5e, 0x40, 0x05,
-  0x6f, 0x7d, 0x29, 0x9c, 0x6c, 0x0f, 0x08, 0xa8, 0x7d, 0xf2, 0x0e, 0x0d,
-  0x34, 0x55, 0x71, 0xaf, 0x40, 0xaa, 0x26, 0x2f, 0xee, 0x81, 0x05, 0x83,
-  0x43, 0x2b, 0xe4, 0x2a, 0x92, 0xdf, 0x7b, 0xd0, 0x64, 0x45, 0x72, 0xfc,
-  0x66, 0xd7, 0xb2, 0x7d, 0x71, 0xc3, 0x80, 0x2f, 0xbc, 0xec, 0x94, 0xd3,
-  0x83, 0xf7, 0xae, 0xc6, 0xd0, 0x94, 0x43, 0xcb, 0x6e, 0xe9, 0x86, 0x80,
-  0x0e, 0x2c, 0xda, 0xd6, 0x6d, 0x03, 0xcd, 0xdb, 0x5c, 0xa4, 0xf2, 0xed,
-  0xc1, 0x99, 0x4c, 0xea, 0xa5, 0x73, 0x71, 0x0f, 0x4d, 0xdd, 0x58, 0xb6,
-  0x55, 0xcd, 0x55, 0x96, 0x5b, 0xba, 0x2d, 0xd0, 0x94, 0x8d, 0xae, 0xf4,
-  0x9d, 0x94, 0x00, 0x87, 0x76, 0xc9, 0xf7, 0xc0, 0x00, 0x07, 0xba, 0xc6,
-  0x86, 0x62, 0x68, 0x82, 0xc1, 0x1b, 0x8f, 0x67, 0xda, 0xe0, 0x19, 0x93,
-  0x65, 0x52, 0xa5, 0xc9, 0x00, 0x78, 0x97, 0x7c, 0xb3, 0xe0, 0xf0, 0x8b,
-  0x32, 0x39, 0xdf, 0xba, 0xe0, 0x89, 0xee, 0xf9, 0xa7, 0x57, 0x0d, 0x34,
-  0xa7, 0xb6, 0x5d, 0xe2, 0xca, 0xa8, 0x00, 0x8f, 0x54, 0x49, 0x3b, 0x57,
-  0xc1, 0x3f, 0xc9, 0x37, 0x09, 0x9e, 0x97, 0xa4, 0xf7, 0x42, 0xe0, 0xc0,
-  0x63, 0x87, 0x94, 0xbb, 0x16, 0x40, 0x33, 0x12, 0x6b, 0x92, 0xf4, 0x71,
-  0x02, 0xfc, 0x8a, 0x7c, 0x4b, 0xe0, 0x15, 0xf2, 0xdc, 0x21, 0xa8, 0xc0,
-  0x3e, 0x79, 0x72, 0x18, 0x3c, 0x7a, 0x41, 0xda, 0xbd, 0x8d, 0x46, 0xbd,
-  0xcf, 0x5f, 0xf0, 0xb3, 0x28, 0xea, 0x3a, 0x9f, 0xbf, 0xe0, 0xc7, 0x61,
-  0xfc, 0x63, 0x2d, 0xc7, 0xe4, 0x1b, 0x01, 0x6f, 0x93, 0x6f, 0x03, 0xdc,
-  0x73, 0x44, 0x2c, 0xdf, 0x85, 0xa1, 0xcc, 0x3c, 0xf9, 0xee, 0x82, 0x17,
-  0xc9, 0xb7, 0x26, 0xd0, 0xa0, 0xfd, 0x88, 0xf4, 0x13, 0x03, 0x3e, 0x73,
-  0x9b, 0x58, 0x6e, 0x04, 0xe0, 0x09, 0xc6, 0x3f, 0xd2, 0x96, 0x27, 0xdf,
-  0x38, 0xf8, 0x21, 0xf9, 0x1e, 0x41, 0x77, 0xad, 0x1d, 0x1f, 0x2d, 0x44,
-  0xc1, 0xe2, 0x07, 0x79, 0xb2, 0x0f, 0xbc, 0x4a, 0xbe, 0xb7, 0x06, 0x1a,
-  0xdd, 0x24, 0x5d, 0xea, 0x81, 0xef, 0x46, 0x95, 0xb8, 0xd0, 0x06, 0xef,
-  0xea, 0x6b, 0xf5, 0x30, 0x80, 0x7f, 0xc3, 0xd8, 0x21, 0xcf, 0xea, 0x00,
-  0xb7, 0xe6, 0xc8, 0xdb, 0x8a, 0x40, 0x0b, 0x43, 0xc1, 0x6b, 0x3f, 0x26,
-  0x2d, 0xb7, 0x82, 0xe0, 0xb4, 0x24, 0x6f, 0x16, 0x0d, 0xc5, 0xb6, 0x24,
-  0x7e, 0x6f, 0x42, 0x47, 0x0e, 0x88, 0x6b, 0x19, 0x78, 0xc1, 0x1d, 0x52,
-  0x39, 0x13, 0xff, 0xc8, 0x95, 0x3c, 0x69, 0xf7, 0x61, 0x10, 0xdc, 0xfe,
-  0xfa, 0xe0, 0xf0, 0x43, 0xc9, 0x59, 0x8f, 0xe0, 0x92, 0xd6, 0x1f, 0xee,
-  0xe9, 0x8f, 0x93, 0xa3, 0xa5, 0x28, 0x38, 0x9a, 0x25, 0x2d, 0x73, 0x71,
-  0x34, 0x4e, 0x9d, 0x12, 0x5b, 0x77, 0xc1, 0xe2, 0x91, 0x43, 0xfc, 0x3e,
-  0x0c, 0xaf, 0xbf, 0x48, 0x2a, 0x67, 0xe2, 0x1f, 0x11, 0x03, 0xdb, 0x87,
-  0xbb, 0xeb, 0x4e, 0x75, 0xce, 0x80, 0x8e, 0xc6, 0xc4, 0x78, 0xc9, 0xd9,
-  0x30, 0x51, 0x97, 0xfc, 0x4a, 0x7b, 0xbd, 0x66, 0xb2, 0x45, 0x80, 0x43,
-  0x6f, 0xdc, 0xe2, 0x7f, 0xbb, 0x9f, 0xe7, 0xdb, 0xf0, 0xbf, 0xcc, 0x38,
-  0xc4, 0x47, 0x11, 0xa8, 0x44, 0x89, 0xb8, 0xd4, 0x0f, 0x4f, 0x3c, 0x96,
-  0xa4, 0x7e, 0xc6, 0x4c, 0x0e, 0x82, 0x0d, 0x93, 0x0d, 0x70, 0x20, 0x12,
-  0x8f, 0x05, 0xe0, 0x0b, 0x86, 0xa3, 0xf1, 0x58, 0xd8, 0x14, 0xb8, 0x2c,
-  0x10, 0x8e, 0xc6, 0x63, 0x91, 0x90, 0xe9, 0x05, 0x05, 0x7c, 0x81, 0x70,
-  0x34, 0x1e, 0x0d, 0x0b, 0xd4, 0x05, 0x4c, 0x16, 0x50, 0x22, 0x14, 0x8b,
-  0x47, 0x42, 0x02, 0xbe, 0xd0, 0xc8, 0xdd, 0xb1, 0x08, 0xf8, 0x41, 0x4d,
-  0x3d, 0x10, 0xf0, 0x5f, 0x2f, 0xd2, 0x7a, 0xd8, 0xe8, 0xbb, 0x7d, 0xad,
-  0x15, 0x9d, 0x3f, 0x69, 0xbf, 0x03, 0xfe, 0xc8, 0x16, 0xfd, 0x19, 0x01,
-  0xb7, 0x8c, 0x5f, 0xef, 0x0b, 0xa0, 0x61, 0xf8, 0x03, 0xb1, 0xfb, 0x54,
-  0x04, 0xfe, 0x23, 0xfd, 0x48, 0x40, 0x1b, 0x13, 0x05, 0xe2, 0x8b, 0x6f,
-  0x5f, 0x79, 0x1d, 0x3c, 0xfa, 0x55, 0x7d, 0xb9, 0x0d, 0xd5, 0xb3, 0x59,
-  0x94, 0xb5, 0xab, 0xd0, 0x3d, 0x0f, 0x3f, 0x1c, 0x57, 0xa5, 0x75, 0xf2,
-  0xed, 0x65, 0x02, 0x75, 0x81, 0xf1, 0xad, 0xe3, 0x0b, 0xe9, 0x14, 0x7e,
-  0x7c, 0xf1, 0x36, 0x13, 0xd0, 0xc1, 0xdb, 0x6f, 0x8e, 0x2f, 0xdc, 0xf2,
-  0xe1, 0xd2, 0xa0, 0x80, 0xef, 0xe9, 0x57, 0xb5, 0xd3, 0x83, 0xb6, 0x97,
-  0xfb, 0x96, 0x5b, 0xf8, 0xf1, 0x34, 0x06, 0x0e, 0x66, 0x4e, 0x6a, 0x8e,
-  0x5d, 0x9c, 0x0f, 0xc3, 0x98, 0xad, 0x3a, 0x73, 0x41, 0xf8, 0xc4, 0xc8,
-  0x1f, 0xb9, 0xfb, 0xcd, 0x72, 0xec, 0xf3, 0xd7, 0xbf, 0xe5, 0x5e, 0x02,
-  0xfe, 0xe8, 0xb6, 0xcc, 0x0f, 0x0b, 0xb4, 0x6f, 0x9e, 0xdb, 0xca, 0xfa,
-  0x39, 0x28, 0xd0, 0xa8, 0xa7, 0x4c, 0x5c, 0xe9, 0x1e, 0xa9, 0x12, 0xef,
-  0x99, 0xd0, 0xa9, 0x1d, 0x87, 0xea, 0x7f, 0x81, 0xd3, 0xc4, 0x6f, 0x8c,
-  0x74, 0x91, 0xd8, 0xe9, 0x03, 0xaf, 0x5f, 0x48, 0xf2, 0xcb, 0xe2, 0xc3,
-  0x20, 0xbc, 0xd6, 0xac, 0x4d, 0x97, 0x9e, 0x24, 0xc1, 0x5d, 0xbb, 0x36,
-  0xf9, 0xe4, 0xc5, 0x62, 0x04, 0x5e, 0x96, 0xf8, 0xd1, 0xd0, 0x1f, 0x49,
-  0x9e, 0x3c, 0x1e, 0x86, 0x78, 0x68, 0x9d, 0x6f, 0xcf, 0xaf, 0x9e, 0xd9,
-  0xab, 0x41, 0x04, 0xe7, 0xac, 0xea, 0xfa, 0x9b, 0x0f, 0x73, 0x09, 0xb0,
-  0xb8, 0x5a, 0x21, 0x6b, 0xf7, 0xe9, 0xe2, 0x81, 0xa4, 0x5c, 0x07, 0x74,
-  0xef, 0x8b, 0xf7, 0xaf, 0x3f, 0x39, 0x85, 0x61, 0x81, 0x68, 0xce, 0x3e,
-  0x5a, 0x7c, 0xb6, 0x5b, 0x3d, 0x1b, 0x44, 0x23, 0x63, 0x5e, 0x12, 0xbf,
-  0xff, 0x46, 0x5c, 0xb9, 0x06, 0x6f, 0x9a, 0x2e, 0xfb, 0x05, 0x4e, 0x13,
-  0x9f, 0x8e, 0x17, 0x48, 0x3b, 0xed, 0xe0, 0xe7, 0x2e, 0x5d, 0x62, 0x65,
-  0xa0, 0x03, 0x59, 0x97, 0x94, 0x2c, 0x9f, 0x14, 0x5c, 0xd2, 0x6e, 0xe9,
-  0x53, 0x02, 0xaa, 0x6b, 0x8f, 0x2e, 0x71, 0x56, 0x02, 0xd0, 0x59, 0xe2,
-  0xdf, 0x8a, 0xea, 0xbf, 0x47, 0x7b, 0x8b, 0xa5, 0x91, 0x60, 0x2c, 0x98,
-  0x3a, 0xba, 0x18, 0x85, 0x0a, 0xcc, 0x4a, 0xd2, 0x9f, 0xe3, 0x60, 0xf1,
-  0xdb, 0x9a, 0x0b, 0x46, 0x43, 0xf1, 0xac, 0x5c, 0x84, 0x1e, 0x28, 0x90,
-  0x2e, 0x8e, 0x42, 0x19, 0xcf, 0xe5, 0xdb, 0x84, 0x19, 0x33, 0xa7, 0xe5,
-  0x4e, 0x04, 0x8d, 0x42, 0xfb, 0xc4, 0x92, 0xf4, 0x6b, 0x01, 0xef, 0x7e,
-  0xe9, 0x5c, 0x12, 0x3b, 0xe5, 0x12, 0x7f, 0x07, 0xa7, 0x89, 0xe5, 0x19,
-  0x79, 0x76, 0x08, 0x9c, 0x3c, 0x93, 0xce, 0xe1, 0xd6, 0xca, 0xdb, 0x0a,
-  0xe9, 0xa3, 0x20, 0xf8, 0x6a, 0x8d, 0xf8, 0xfb, 0x60, 0xb4, 0x6b, 0x93,
-  0xd8, 0xfd, 0xaf, 0xcf, 0x84, 0x0a, 0xbc, 0x25, 0x5d, 0x58, 0x9c, 0x7d,
-  0x55, 0x26, 0x76, 0xc6, 0xa0, 0xb3, 0xe4, 0x73, 0x2b, 0x45, 0x97, 0xb4,
-  0x33, 0xf5, 0xdc, 0x9d, 0x49, 0x7c, 0x73, 0x4f, 0x7a, 0xae, 0x5b, 0xaf,
-  0xc1, 0xfd, 0x2e, 0x69, 0x67, 0x1a, 0x3c, 0x28, 0xdf, 0x87, 0x96, 0x9c,
-  0xd2, 0x9d, 0xc4, 0xf9, 0x49, 0x08, 0x2a, 0xf4, 0x95, 0xbc, 0x93, 0x16,
-  0xa8, 0xf8, 0xf1, 0x69, 0x7b, 0xc6, 0xb2, 0x97, 0x83, 0x1f, 0x6a, 0x57,
-  0xd0, 0xf0, 0xca, 0x39, 0xf9, 0x0e, 0xdb, 0x50, 0x97, 0xaa, 0x10, 0xe7,
-  0x4c, 0xf8, 0xd3, 0xe4, 0xb3, 0xbf, 0xac, 0x3c, 0x7b, 0x09, 0x6f, 0xf2,
-  0x69, 0x07, 0x74, 0xcf, 0x29, 0x71, 0x75, 0x08, 0x4a, 0x2c, 0x11, 0xbb,
-  0x83, 0xe0, 0xe4, 0x09, 0xf1, 0x07, 0xe8, 0xeb, 0x16, 0xf1, 0x8f, 0x04,
-  0x38, 0x75, 0x4e, 0xfc, 0xc1, 0x04, 0x67, 0xc9, 0xfb, 0xde, 0x67, 0x60,
-  0xf8, 0x98, 0xf4, 0xfa, 0xbb, 0x72, 0xff, 0x03, 0x49, 0x6a, 0xa1, 0xe3,
-  0x64, 0x0f, 0x3c, 0x2d, 0xc9, 0xfb, 0x0c, 0x9e, 0xa4, 0x99, 0x4e, 0x9b,
-  0xd4, 0x21, 0xf6, 0x8b, 0x29, 0xa8, 0x44, 0x8d, 0xbc, 0x8b, 0x11, 0xa8,
-  0x76, 0xfb, 0x7d, 0xdb, 0x4f, 0x52, 0xa5, 0xbe, 0x39, 0x79, 0x1f, 0x0d,
-  0x8d, 0x57, 0xe4, 0x39, 0xb7, 0x51, 0x9f, 0xaa, 0x10, 0xe7, 0x4c, 0xf8,
-  0xd3, 0xe4, 0x1d, 0x8e, 0x86, 0x05, 0xfc, 0x86, 0x80, 0x27, 0x36, 0x89,
-  0xed, 0xdb, 0x50, 0x81, 0x37, 0xc4, 0xc5, 0x04, 0x38, 0xf4, 0x85, 0xb8,
-  0x08, 0xfd, 0x9a, 0xd8, 0x1d, 0x87, 0xb7, 0x20, 0x49, 0x95, 0x3b, 0xc1,
-  0x59, 0xd2, 0x95, 0x56, 0xe8, 0x49, 0x49, 0xfc, 0xfd, 0xed, 0xf9, 0xe0,
-  0x94, 0x24, 0xf9, 0xa2, 0xf3, 0xf4, 0x1b, 0x78, 0x5a, 0x92, 0x97, 0x05,
-  0xdf, 0xa7, 0xe9, 0x94, 0x43, 0xea, 0x97, 0xc8, 0x15, 0x3b, 0xa1, 0x12,
-  0x55, 0xf2, 0x2a, 0x57, 0xa0, 0xda, 0x6b, 0x3b, 0xed, 0xdf, 0x49, 0x15,
-  0x7a, 0x67, 0xdd, 0x34, 0x1a, 0x9a, 0x59, 0xf2, 0xec, 0x21, 0xd4, 0xa7,
-  0x2a, 0xc4, 0x39, 0x13, 0xfe, 0x34, 0xe9, 0x8b, 0x51, 0x5c, 0x2a, 0x82,
-  0x91, 0x78, 0x4b, 0x62, 0x95, 0xd8, 0x99, 0x80, 0x0a, 0xbc, 0x21, 0x2e,
-  0x24, 0xc0, 0xa1, 0x2f, 0xc4, 0x65, 0xe8, 0x3c, 0x71, 0x69, 0x30, 0xee,
-  0x4d, 0xda, 0xa4, 0xe4, 0x00, 0x38, 0x4b, 0xfa, 0xad, 0x80, 0xee, 0xb1,
-  0x88, 0xf3, 0xf3, 0xee, 0xa3, 0xc8, 0x27, 0x3b, 0xd7, 0x76, 0xc7, 0xde,
-  0x00, 0x77, 0x39, 0xa4, 0xe5, 0x3c, 0xb8, 0x5f, 0xbe, 0x0f, 0xbf, 0xb4,
-  0xf3, 0x37, 0xba, 0x2f, 0x7e, 0x9b, 0x50, 0xa1, 0x1d, 0xf2, 0x7e, 0x47,
-  0xa1, 0x62, 0x87, 0xc5, 0xae, 0xf1, 0xb3, 0x8b, 0x67, 0xe6, 0xa7, 0xea,
-  0x30, 0x1a, 0x4e, 0xd4, 0xc8, 0xf7, 0x39, 0x8a, 0xba, 0x54, 0x85, 0x38,
-  0x67, 0xc2, 0x9f, 0x26, 0xfd, 0x29, 0x84, 0x4b, 0x42, 0xb7, 0x57, 0xde,
-  0xe5, 0x8e, 0xcf, 0x8a, 0x35, 0x62, 0x27, 0x03, 0x25, 0x16, 0x88, 0x9d,
-  0x01, 0x70, 0xfb, 0x31, 0xf1, 0x3e, 0x58, 0x38, 0xc4, 0x4e, 0xfe, 0xd8,
-  0x2b, 0x48, 0xe2, 0x1b, 0xe0, 0x2c, 0xb1, 0x9c, 0x85, 0xd7, 0x51, 0x20,
-  0x2e, 0x74, 0x9c, 0x55, 0x32, 0x66, 0x30, 0x30, 0xfc, 0xa7, 0x72, 0x15,
-  0x2a, 0xf8, 0x54, 0x12, 0xdb, 0xeb, 0x31, 0xe8, 0x03, 0xfb, 0x79, 0x28,
-  0xa0, 0xba, 0x7e, 0xd0, 0x4b, 0xe8, 0xae, 0x13, 0xd2, 0xe7, 0x37, 0xa1,
-  0xc4, 0x43, 0xf9, 0xbd, 0x33, 0xa0, 0x22, 0x4f, 0xe5, 0x87, 0x30, 0x1a,
-  0x25, 0x8a, 0xe4, 0x97, 0xcf, 0x51, 0x97, 0xaa, 0x10, 0xe7, 0x4c, 0xf8,
-  0xd3, 0xa4, 0x57, 0x51, 0x6f, 0x3e, 0x3b, 0x93, 0x74, 0x89, 0x93, 0x01,
-  0x0f, 0x5a, 0xc4, 0x5f, 0xfb, 0xcc, 0xe4, 0x6b, 0x62, 0xf7, 0x31, 0x38,
-  0x2e, 0xa9, 0x51, 0x1a, 0x9c, 0x25, 0xb6, 0xef, 0xc1, 0x4b, 0xe6, 0x89,
-  0x0b, 0xe2, 0xfe, 0x79, 0xed, 0xdb, 0xf6, 0xc7, 0xb2, 0xf5, 0xd4, 0x80,
-  0xf9, 0xb4, 0x56, 0x59, 0x7a, 0xf9, 0xec, 0x66, 0x08, 0x6c, 0x8c, 0x5d,
-  0x90, 0x9d, 0xdb, 0xde, 0x3d, 0x23, 0xb5, 0xd7, 0x0d, 0xdd, 0x31, 0xb1,
-  0xf0, 0x7c, 0xcb, 0x2e, 0x8f, 0x1b, 0x08, 0x7d, 0x72, 0xce, 0xde, 0x6f,
-  0x1d, 0xda, 0xc7, 0xbd, 0x68, 0x14, 0x5c, 0x93, 0xa4, 0xe4, 0xfa, 0x19,
-  0x71, 0x69, 0x18, 0xfe, 0x54, 0x85, 0x38, 0x67, 0xc2, 0x9f, 0x26, 0xbd,
-  0x80, 0x3a, 0x73, 0xd5, 0x25, 0x7d, 0x71, 0xf6, 0xeb, 0xa0, 0x48, 0xec,
-  0x64, 0xc0, 0xc6, 0x9a, 0x4b, 0x4a, 0x96, 0x7e, 0x9f, 0xb9, 0xc4, 0x7b,
-  0x6d, 0xe0, 0x56, 0x49, 0x5a, 0x5e, 0x96, 0x06, 0x67, 0x89, 0xad, 0xeb,
-  0xf0, 0x92, 0x79, 0xe2, 0x02, 0x8c, 0xf1, 0xfd, 0x6a, 0xcd, 0x3a, 0x9e,
-  0x30, 0x11, 0x78, 0x56, 0xb3, 0xd3, 0x06, 0x7c, 0xe2, 0x46, 0xc9, 0x7d,
-  0xff, 0xf1, 0xc2, 0x52, 0xa7, 0x0b, 0xfb, 0xf2, 0x28, 0x09, 0x7f, 0xf8,
-  0x95, 0x5b, 0xba, 0x2e, 0x10, 0x7f, 0x59, 0xa8, 0xd9, 0x17, 0x9f, 0xba,
-  0x05, 0x1a, 0x5d, 0xaf, 0x11, 0xef, 0xc5, 0xe6, 0x25, 0x71, 0xce, 0x84,
-  0x2f, 0x55, 0x21, 0xce, 0x99, 0xf0, 0xa7, 0x49, 0x2f, 0xa0, 0x6e, 0xb0,
-  0x46, 0x2c, 0xb7, 0xaf, 0xa5, 0xe2, 0xe1, 0x05, 0x62, 0x27, 0x03, 0x1d,
-  0x7f, 0xe5, 0x90, 0xdf, 0xfe, 0xd6, 0x0f, 0x1d, 0x74, 0x89, 0x4f, 0x27,
-  0xef, 0x5c, 0xd2, 0x0e, 0xce, 0x12, 0x5b, 0x63, 0xf0, 0x92, 0x79, 0xe2,
-  0x02, 0x58, 0x74, 0x8d, 0xf6, 0x07, 0xa0, 0xc4, 0x82, 0x53, 0xbd, 0x2f,
-  0xe0, 0xbf, 0x73, 0x4e, 0xab, 0x21, 0x11, 0xef, 0xed, 0x0f, 0xa2, 0xfd,
-  0x2b, 0xfd, 0xea, 0x81, 0x3f, 0xb4, 0x4c, 0xe5, 0x9b, 0xe0, 0xc8, 0xf0,
-  0x68, 0x3b, 0x1a, 0xb7, 0x1e, 0x10, 0xd7, 0x46, 0x11, 0xfb, 0x4e, 0xfa,
-  0xb1, 0x01, 0x2f, 0x55, 0x21, 0xce, 0x99, 0xf0, 0xa7, 0x49, 0x2f, 0xa0,
-  0xee, 0x19, 0xe9, 0xcf, 0x41, 0xe8, 0x15, 0x62, 0x27, 0x03, 0x6d, 0x4c,
-  0x94, 0x49, 0x5b, 0x27, 0x9f, 0x6e, 0x19, 0xf0, 0x95, 0x89, 0x0b, 0x1d,
-  0x68, 0x90, 0x25, 0xb6, 0xc6, 0xe0, 0x25, 0xf3, 0xc4, 0x05, 0x78, 0xc6,
-  0xf0, 0xfb, 0xfc, 0xde, 0x47, 0xb7, 0x92, 0x11, 0x60, 0xa3, 0x4d, 0x05,
-  0xee, 0x9e, 0x3b, 0x2b, 0x41, 0xd4, 0xb5, 0x7e, 0xa4, 0x5f, 0x43, 0xb1,
-  0xae, 0x56, 0x01, 0x0e, 0xbe, 0x72, 0xce, 0xdf, 0x1e, 0xa8, 0xb5, 0x0e,
-  0xfc, 0x0f, 0x62, 0x45, 0x92, 0x92, 0xeb, 0x02, 0xea, 0x8a, 0x4d, 0x7c,
-  0x7e, 0x05, 0x5e, 0xc7, 0x39, 0xf1, 0x5e, 0x18, 0xfe, 0x34, 0xe9, 0x05,
-  0xd4, 0xad, 0x11, 0xcb, 0x79, 0x68, 0xf3, 0x2b, 0xb1, 0x93, 0x81, 0x9e,
-  0xb5, 0xc8, 0x4d, 0xb7, 0x76, 0xc4, 0xc2, 0x41, 0xd4, 0xbd, 0x23, 0x96,
-  0x33, 0x68, 0x90, 0x25, 0xb6, 0xc6, 0xe0, 0x25, 0xf3, 0xc4, 0x05, 0x78,
-  0xc3, 0x45, 0xd2, 0xee, 0x64, 0x00, 0xdc, 0xb9, 0x7d, 0xac, 0xbe, 0x56,
-  0xec, 0xd5, 0x10, 0x2e, 0x69, 0xf9, 0xe2, 0xfe, 0x39, 0x3c, 0xfb, 0xbd,
-  0xd6, 0x02, 0x0e, 0x6f, 0x92, 0x96, 0x07, 0x09, 0x34, 0x1e, 0x3d, 0x27,
-  0x3e, 0xee, 0x02, 0x1b, 0x1b, 0x92, 0xf8, 0x4b, 0x1c, 0x3a, 0x56, 0x22,
-  0x2e, 0x8d, 0x1a, 0x22, 0xd4, 0x2a, 0xa0, 0xd2, 0xa4, 0x17, 0x50, 0xb7,
-  0x4c, 0x7a, 0xd5, 0x80, 0x0a, 0x4e, 0x59, 0xc4, 0x4e, 0x06, 0x2c, 0x8e,
-  0x49, 0x59, 0x83, 0xa6, 0xd0, 0xa8, 0xbb, 0x53, 0x23, 0xce, 0x8f, 0x05,
-  0xa0, 0xcd, 0xe4, 0xc4, 0x10, 0x74, 0x96, 0xd8, 0x1a, 0x83, 0x97, 0xcc,
-  0x13, 0x17, 0xa0, 0xc5, 0x16, 0x79, 0x76, 0x0a, 0xdc, 0x9a, 0x23, 0xef,
-  0x75, 0x08, 0x5a, 0x18, 0x4a, 0x40, 0x27, 0x0e, 0x48, 0xcb, 0xb7, 0x41,
-  0xf0, 0x04, 0xf9, 0x9e, 0xa2, 0x61, 0x60, 0x8f, 0x58, 0xce, 0xc0, 0x4b,
-  0xfe, 0x21, 0x76, 0x9f, 0x40, 0x1b, 0x27, 0xa4, 0xff, 0x6c, 0x6f, 0x7c,
-  0x3a, 0x8c, 0x42, 0xa5, 0x49, 0x2f, 0xa0, 0x6e, 0x9a, 0x74, 0xf5, 0xc5,
-  0x8d, 0x89, 0x2d, 0x8b, 0xb4, 0x93, 0x01, 0x1b, 0x05, 0xe2, 0xfc, 0xfb,
-  0xcd, 0x0d, 0x5e, 0x9c, 0xea, 0x17, 0xd0, 0x91, 0x1c, 0xe9, 0xea, 0xe6,
-  0xdc, 0x9d, 0xfb, 0x2f, 0x3f, 0x9c, 0xd1, 0x3d, 0xe8, 0x2c, 0xb1, 0x35,
-  0x06, 0x2f, 0x99, 0x27, 0x2e, 0x40, 0xc7, 0x8f, 0xc9, 0x37, 0x0a, 0x9e,
-  0x21, 0xdf, 0x63, 0xe8, 0x9e, 0x0f, 0xc5, 0x93, 0x57, 0x2d, 0x60, 0xb1,
-  0x4f, 0x9e, 0x1c, 0x04, 0x2f, 0x91, 0xef, 0xbd, 0x81, 0x06, 0xc6, 0x13,
-  0xd2, 0x9f, 0x22, 0xf0, 0x4d, 0xda, 0xc4, 0xd5, 0x21, 0xe8, 0x05, 0xaa,
-  0xab, 0x46, 0xa1, 0xd2, 0xa4, 0x17, 0x50, 0xd7, 0x5e, 0xa2, 0xfa, 0x7c,
-  0x99, 0x94, 0x93, 0x81, 0x7e, 0xee, 0xd0, 0x25, 0xee, 0x97, 0x6e, 0xe8,
-  0xee, 0x13, 0xba, 0xf4, 0x1e, 0x74, 0x96, 0xd8, 0x1a, 0x83, 0x97, 0xcc,
-  0x13, 0x17, 0xa0, 0x03, 0xfb, 0xe4, 0xb9, 0x83, 0xe0, 0xff, 0xc8, 0xb7,
-  0x0a, 0xee, 0xfe, 0x45, 0x2c, 0xb3, 0x26, 0x54, 0x38, 0x4f, 0xbe, 0x09,
-  0xf0, 0x3c, 0xf9, 0xd6, 0x05, 0x1a, 0x0c, 0x94, 0x89, 0xad, 0x7e, 0xf8,
-  0x23, 0x9f, 0x48, 0xe7, 0xa2, 0xe0, 0xce, 0x3d, 0xf2, 0x57, 0xa3, 0x50,
-  0x69, 0xd2, 0x0b, 0xa8, 0x33, 0xa6, 0x6d, 0xf2, 0xff, 0x1c, 0xd8, 0x20,
-  0xe5, 0x64, 0xa0, 0x13, 0xef, 0xe8, 0xd2, 0x9f, 0x09, 0xb0, 0xe8, 0xfb,
-  0xe2, 0x52, 0xbd, 0xbc, 0x0d, 0x9d, 0x25, 0xb6, 0xc6, 0xe0, 0x25, 0xf3,
-  0xc4, 0x05, 0x78, 0x2f, 0x5c, 0xd2, 0x7b, 0x31, 0xf0, 0x02, 0xf9, 0xee,
-  0x81, 0x97, 0xc9, 0x73, 0x46, 0xa1, 0x8c, 0x7d, 0xf2, 0xdc, 0x61, 0xf0,
-  0xf0, 0x39, 0x69, 0xe7, 0x06, 0x1a, 0x04, 0xd7, 0x4a, 0x5c, 0x5c, 0x12,
-  0xa8, 0x1b, 0x3a, 0x2b, 0x71, 0xf1, 0xbe, 0x00, 0xf7, 0xbe, 0x2f, 0x5b,
-  0x76, 0xed, 0xa2, 0xf0, 0xde, 0x84, 0xba, 0x55, 0xd2, 0x4f, 0x50, 0x1f,
-  0x98, 0x3c, 0xba, 0xa8, 0xd9, 0xd5, 0xe2, 0x5a, 0x07, 0x46, 0x4a, 0xea,
-  0xcf, 0x1d, 0x28, 0x31, 0xb8, 0x53, 0x26, 0xe5, 0xda, 0xec, 0x48, 0xf2,
-  0xa6, 0xe1, 0x45, 0xa7, 0xbf, 0x94, 0xab, 0x35, 0xbb, 0x76, 0x51, 0xfa,
-  0x3e, 0x1b, 0x83, 0x5e, 0x2b, 0xf1, 0xe9, 0x55, 0x78, 0x6d, 0x7b, 0x25,
-  0x3e, 0x80, 0x17, 0xdb, 0x94, 0xa4, 0xce, 0x86, 0xa0, 0x87, 0x2b, 0xa4,
-  0x6b, 0x1d, 0xe0, 0x03, 0xf2, 0xcd, 0x80, 0xa7, 0x6c, 0xd2, 0xdf, 0x42,
-  0x60, 0x63, 0xd6, 0x22, 0xe5, 0xbc, 0x0c, 0xa0, 0x81, 0x11, 0x6b, 0xe1,
-  0x78, 0x10, 0xf5, 0x22, 0xda, 0xa2, 0xa3, 0x02, 0x5e, 0xc7, 0xd8, 0x9d,
-  0x5b, 0x43, 0x2d, 0xd0, 0xc1, 0x16, 0x1d, 0xc2, 0x65, 0xe6, 0xe0, 0x2d,
-  0x35, 0x92, 0x00, 0x8b, 0x16, 0x0e, 0x42, 0x0d, 0x9d, 0x93, 0x92, 0x1f,
-  0x67, 0xee, 0x72, 0x7a, 0xee, 0x83, 0x4b, 0xbc, 0x05, 0xbf, 0x68, 0x1f,
-  0xbe, 0x79, 0xe7, 0xc6, 0x70, 0xab, 0x80, 0x2f, 0xd2, 0xc2, 0xf1, 0x00,
-  0x3c, 0x23, 0xd6, 0xc2, 0x71, 0xf8, 0x8c, 0xfe, 0x89, 0x1b, 0x61, 0x78,
-  0xc6, 0xdd, 0x33, 0x92, 0xf9, 0x09, 0x03, 0xbc, 0x4b, 0xbe, 0x29, 0x70,
-  0x70, 0xee, 0x8c, 0x6a, 0x3b, 0x6d, 0xf0, 0x44, 0x72, 0x52, 0xa5, 0x04,
-  0xfe, 0x9f, 0x86, 0x77, 0x49, 0xb9, 0x4b, 0x06, 0x7c, 0xc6, 0x47, 0xe2,
-  0xdd, 0x00, 0xfe, 0x96, 0x48, 0x8e, 0xaa, 0x76, 0x01, 0x8e, 0x7c, 0x26,
-  0xdf, 0xb3, 0x00, 0x58, 0x24, 0xaf, 0xf6, 0x46, 0xf0, 0x0f, 0x24, 0x4f,
-  0x49, 0x55, 0xc7, 0xe0, 0x17, 0x1f, 0x88, 0xb7, 0xf0, 0xd7, 0x03, 0xeb,
-  0x8e, 0x55, 0x75, 0x54, 0xc5, 0xa9, 0x64, 0x04, 0xfe, 0x9d, 0xb6, 0xdf,
-  0xa4, 0xdc, 0x97, 0x01, 0x68, 0x11, 0xca, 0x54, 0x49, 0xc9, 0x34, 0xfe,
-  0x76, 0x68, 0x9d, 0x8a, 0x63, 0x1d, 0x77, 0xc6, 0x5b, 0x1f, 0xda, 0xd6,
-  0x34, 0xfe, 0x9d, 0xe0, 0x07, 0x62, 0xf9, 0xf1, 0x61, 0x5a, 0xcd, 0xae,
-  0xec, 0x4b, 0xe2, 0x5c, 0x04, 0x7f, 0x39, 0xb2, 0xe6, 0xfe, 0xb9, 0x26,
-  0xa0, 0x8d, 0x79, 0xcb, 0xbe, 0x1f, 0xc0, 0x3f, 0x33, 0x54, 0x24, 0x2d,
-  0x1d, 0x25, 0x49, 0xcb, 0x9f, 0x9d, 0xf8, 0x8b, 0xa2, 0x2b, 0x33, 0x35,
-  0xb4, 0xee, 0x94, 0x47, 0x05, 0x7c, 0xe6, 0x13, 0xfb, 0x62, 0xe6, 0xda,
-  0x83, 0xdb, 0xad, 0x02, 0xff, 0x82, 0xb8, 0xbe, 0x5f, 0xa5, 0x3a, 0x6b,
-  0xef, 0x61, 0x2b, 0xfe, 0xa2, 0xb8, 0x5e, 0x22, 0x25, 0xe9, 0xfc, 0x06,
-  0x58, 0x68, 0xa8, 0xe0, 0x33, 0xf2, 0x0e, 0x87, 0xf1, 0x6f, 0x84, 0xc7,
-  0x57, 0x3f, 0xee, 0xe5, 0x0f, 0x77, 0x36, 0x5e, 0x5c, 0x37, 0xf1, 0x57,
-  0x53, 0x35, 0xf2, 0x9e, 0x41, 0x45, 0xe7, 0xf6, 0x6a, 0x95, 0x8f, 0x63,
-  0x06, 0xd4, 0x0f, 0xf2, 0x4e, 0xc3, 0x68, 0xaa, 0x33, 0xe4, 0x7b, 0x8b,
-  0xd6, 0x1d, 0xa7, 0xf8, 0xf3, 0xa8, 0xaa, 0x9e, 0x99, 0xe2, 0x8c, 0x3c,
-  0xfb, 0x1a, 0x9a, 0xea, 0x2b, 0xf2, 0xed, 0x60, 0xc3, 0xd9, 0xe9, 0x6b,
-  0x69, 0xbf, 0x75, 0x6a, 0xdd, 0x11, 0x16, 0x79, 0xce, 0x0d, 0x34, 0xd5,
-  0x0c, 0xf9, 0x9e, 0xb5, 0x39, 0xfb, 0xad, 0x23, 0xef, 0x5e, 0x77, 0x0c,
-  0x55, 0xbf, 0x89, 0xcf, 0xe4, 0x55, 0xda, 0xd1, 0x54, 0xc3, 0x3b, 0x92,
-  0xf8, 0x47, 0x7b, 0x5a, 0xce, 0xb5, 0x96, 0x49, 0x7d, 0x16, 0x07, 0x85,
-  0xe4, 0xb5, 0x22, 0xb1, 0xfd, 0x0c, 0x4d, 0xb6, 0x65, 0x79, 0x6f, 0x7f,
-  0xb1, 0x03, 0xb3, 0x74, 0xaf, 0x57, 0x92, 0x3a, 0xc3, 0x6e, 0x31, 0x25,
-  0xae, 0x64, 0x7f, 0x7d, 0x9f, 0x0c, 0xa1, 0xe9, 0x1a, 0x41, 0xf0, 0x0d,
-  0xb9, 0x1c, 0xfd, 0xe9, 0xda, 0x4b, 0xc1, 0xfc, 0x59, 0x0b, 0x94, 0x88,
-  0x06, 0xd0, 0xac, 0xc3, 0xe5, 0xe2, 0x95, 0x78, 0x66, 0xdc, 0x7c, 0xec,
-  0xbc, 0x41, 0x93, 0x9f, 0xb4, 0x8a, 0xf3, 0x23, 0x37, 0xb7, 0xec, 0xe3,
-  0x1e, 0x34, 0xf9, 0xe0, 0x83, 0x3f, 0x6e, 0xd5, 0x51, 0x07, 0x57, 0x04,
-  0x9a, 0xbd, 0x48, 0x4d, 0xae, 0x2e, 0xa4, 0xa3, 0x68, 0x92, 0x00, 0x00,
-  0x56, 0x50, 0x38, 0x20, 0x50, 0x07, 0x00, 0x00, 0xf0, 0x22, 0x00, 0x9d,
-  0x01, 0x2a, 0xc8, 0x00, 0x3e, 0x00, 0x3e, 0x49, 0x1e, 0x8c, 0x43, 0xa4,
-  0x22, 0xa1, 0x98, 0x4b, 0xdd, 0x1c, 0x40, 0x04, 0x84, 0xb1, 0x80, 0x6a,
-  0xbc, 0xd7, 0x6e, 0x1f, 0x40, 0xb3, 0x4b, 0xec, 0xaa, 0xcc, 0xb8, 0x23,
-  0xc9, 0xc9, 0xf2, 0xbf, 0xdc, 0xfa, 0xb2, 0xdb, 0xa5, 0xe6, 0x1f, 0xcd,
-  0x6b, 0xd2, 0xff, 0xf9, 0x6d, 0xf6, 0xef, 0x40, 0x0e, 0x98, 0xab, 0xf4,
-  0xfe, 0xd4, 0xff, 0xce, 0xe3, 0xd0, 0xed, 0x9f, 0xec, 0xfd, 0x7e, 0x76,
-  0x2f, 0xb5, 0xce, 0xf0, 0x1e, 0x8b, 0xbc, 0xd5, 0xa8, 0xd4, 0x96, 0xbf,
-  0xd7, 0xf8, 0x42, 0x79, 0xe7, 0x41, 0xfe, 0x73, 0x48, 0xc5, 0xf6, 0x13,
-  0xfb, 0x80, 0x8c, 0x42, 0x33, 0x68, 0x2f, 0x2b, 0x6f, 0x39, 0xc0, 0xbb,
-  0x30, 0xfe, 0xbd, 0x92, 0x47, 0x87, 0x0b, 0xf5, 0x49, 0x33, 0xcf, 0xb6,
-  0xed, 0x9d, 0x19, 0x3f, 0x1c, 0x46, 0x9d, 0xe2, 0x88, 0xb3, 0x0f, 0x16,
-  0xb7, 0xa4, 0xbe, 0x12, 0x8e, 0x1b, 0xc1, 0xc9, 0x52, 0xf1, 0x0e, 0xc0,
-  0x66, 0x4c, 0x65, 0x72, 0x36, 0xaf, 0x32, 0xea, 0x9c, 0x42, 0x7c, 0x14,
-  0x09, 0xd2, 0x5b, 0xb7, 0x83, 0xc2, 0x91, 0xd8, 0x90, 0x76, 0x29, 0x1e,
-  0xbe, 0xf8, 0x25, 0xd9, 0xb2, 0x7e, 0x7c, 0x29, 0x61, 0xf4, 0x3d, 0xd2,
-  0x1d, 0xe9, 0xf3, 0xd8, 0x38, 0xb4, 0x85, 0x14, 0x60, 0x9b, 0xa2, 0x06,
-  0xaa, 0x86, 0xc4, 0xe7, 0xe7, 0xa5, 0x5e, 0x20, 0x48, 0x21, 0x71, 0xd9,
-  0x94, 0x6c, 0x14, 0x36, 0xe5, 0xcd, 0xe5, 0x55, 0x26, 0xab, 0x58, 0xe5,
-  0xcc, 0x77, 0x79, 0xfd, 0x4c, 0x98, 0xac, 0xbc, 0xb7, 0x8b, 0x50, 0xe5,
-  0x3f, 0x6d, 0xcc, 0xee, 0x0a, 0xb7, 0x89, 0xaa, 0x46, 0x8c, 0xd5, 0xf2,
-  0x85, 0xf0, 0xe5, 0xa7, 0x30, 0x4e, 0x29, 0xda, 0x22, 0x10, 0x99, 0x6f,
-  0xa3, 0xbf, 0x8f, 0xea, 0x58, 0x34, 0x2b, 0x5c, 0x08, 0xd2, 0x5b, 0x3d,
-  0xf8, 0xb1, 0x3e, 0x85, 0x2e, 0xa3, 0x73, 0x36, 0x67, 0xa0, 0xf0, 0x27,
-  0xd7, 0x38, 0x8a, 0xe6, 0x85, 0xd9, 0x98, 0x68, 0x00, 0xfe, 0xfe, 0x7c,
-  0xb6, 0x2f, 0xf1, 0x97, 0x1a, 0x3a, 0x7a, 0x2d, 0xfa, 0x13, 0xc9, 0xf4,
-  0x16, 0x53, 0x96, 0x62, 0xd8, 0xfc, 0xba, 0x17, 0xb7, 0x86, 0x01, 0xa0,
-  0xaa, 0x0f, 0x37, 0xab, 0xe2, 0xf9, 0xb8, 0x05, 0x8a, 0x40, 0x3c, 0xd9,
-  0x40, 0x94, 0x2d, 0x50, 0xe1, 0x9f, 0x93, 0x1b, 0x3e, 0x69, 0xf2, 0x6b,
-  0x49, 0x5f, 0xff, 0xfe, 0xb1, 0x55, 0xfd, 0x1e, 0x63, 0x88, 0xe5, 0x89,
-  0x78, 0xae, 0xf7, 0x0d, 0xab, 0x47, 0x07, 0x4a, 0x9e, 0xdd, 0x7d, 0x8f,
-  0xb7, 0x98, 0x71, 0x2b, 0x21, 0x2f, 0xba, 0x80, 0x44, 0xc8, 0x0c, 0x1c,
-  0xb5, 0x62, 0x4a, 0x4f, 0x75, 0x9f, 0x77, 0xd1, 0x93, 0xf4, 0x52, 0x42,
-  0x26, 0x28, 0xc9, 0xaf, 0x25, 0x7d, 0x06, 0xe8, 0xea, 0xd5, 0x91, 0x4b,
-  0xb2, 0x61, 0x0e, 0x7c, 0xba, 0xf6, 0x01, 0xd5, 0x0c, 0x38, 0x69, 0x61,
-  0x5c, 0x06, 0x58, 0x11, 0x69, 0x09, 0x91, 0xac, 0xc1, 0x5e, 0x20, 0x96,
-  0xc5, 0xca, 0xc4, 0x00, 0x06, 0xe9, 0x19, 0x56, 0xa3, 0x04, 0x37, 0x84,
-  0x54, 0xbe, 0x9b, 0x6d, 0x55, 0xee, 0xc4, 0xbe, 0xb3, 0xb2, 0x86, 0xd0,
-  0xbe, 0xa7, 0x4c, 0x2b, 0xac, 0x5d, 0x7c, 0x79, 0xe5, 0x2a, 0x30, 0xbb,
-  0x36, 0xb4, 0x83, 0xc5, 0x63, 0x84, 0x92, 0xdf, 0xa0, 0x96, 0x98, 0xf4,
-  0xa4, 0x6d, 0x51, 0x5b, 0xaa, 0x18, 0xc1, 0x8f, 0xc0, 0x1c, 0x4a, 0x3e,
-  0x8f, 0xe1, 0x26, 0x2f, 0x17, 0x37, 0xf6, 0x22, 0xc6, 0x5a, 0x86, 0xf4,
-  0x5d, 0xf6, 0x69, 0x34, 0xa8, 0xb1, 0x48, 0x35, 0xdf, 0x7b, 0x9e, 0xa1,
-  0xf0, 0x6d, 0xf2, 0x0c, 0xa5, 0xcf, 0x81, 0xf0, 0x4a, 0x61, 0x22, 0x5e,
-  0x60, 0x62, 0xbb, 0x82, 0xf9, 0x58, 0x7a, 0x79, 0x44, 0xd8, 0x3d, 0x23,
-  0x68, 0x26, 0xac, 0x5f, 0x6f, 0xc0, 0x4e, 0x2f, 0xd1, 0x0e, 0x4a, 0x33,
-  0xd1, 0x9e, 0xb7, 0x3f, 0x34, 0x7e, 0xfd, 0x1c, 0x6d, 0x12, 0xae, 0xd2,
-  0xf8, 0xcd, 0x3c, 0x1d, 0xac, 0xa9, 0xb0, 0xea, 0x2c, 0x84, 0x92, 0x57,
-  0x90, 0x8a, 0xe6, 0x69, 0xac, 0xeb, 0x76, 0xfb, 0x3d, 0x4b, 0x2c, 0x97,
-  0xce, 0x28, 0xfc, 0x07, 0x94, 0x76, 0xe4, 0x79, 0xc9, 0x9d, 0x17, 0x80,
-  0x78, 0x5a, 0xac, 0xc3, 0xe7, 0x61, 0x78, 0x59, 0x58, 0xed, 0x93, 0xfc,
-  0xa2, 0x70, 0xfb, 0x7a, 0x18, 0xe3, 0x30, 0x70, 0xe7, 0xb8, 0x38, 0x46,
-  0x21, 0xb4, 0x04, 0x95, 0xf3, 0xb7, 0xc6, 0x04, 0xfa, 0xc6, 0x1f, 0x35,
-  0xe5, 0x85, 0x53, 0xa0, 0xc0, 0xbd, 0xdc, 0x67, 0x26, 0x5d, 0x9a, 0x8b,
-  0xe4, 0xc9, 0xe5, 0x34, 0xb7, 0xc7, 0xdd, 0x6d, 0x51, 0x91, 0x9e, 0x28,
-  0x7f, 0xdc, 0xaa, 0x00, 0x10, 0x54, 0xf7, 0x7e, 0x1a, 0xe0, 0x79, 0xfc,
-  0x3b, 0xa8, 0x6b, 0x94, 0x0b, 0x4e, 0x69, 0xb4, 0x8b, 0x09, 0x32, 0x60,
-  0x1d, 0xec, 0xa4, 0x81, 0xd0, 0xa9, 0x8e, 0x04, 0x82, 0xc1, 0xf6, 0x24,
-  0xad, 0x66, 0x4f, 0x3d, 0x0b, 0xe4, 0xb2, 0x86, 0x20, 0xd8, 0xdc, 0xdb,
-  0xe2, 0xaf, 0x2e, 0xda, 0xcb, 0xad, 0x92, 0xc6, 0x31, 0x45, 0x5e, 0xb6,
-  0x1d, 0xc3, 0x1d, 0x07, 0x9e, 0x4a, 0xdb, 0xb6, 0x24, 0x9e, 0x2e, 0x80,
-  0x7b, 0x24, 0x78, 0xfe, 0xa8, 0xb5, 0x40, 0x32, 0xf4, 0x6f, 0xf7, 0xd4,
-  0x57, 0x16, 0x06, 0x47, 0x55, 0x68, 0x34, 0xfa, 0x13, 0xf7, 0xf1, 0x3a,
-  0xa9, 0xb3, 0xf5, 0x2f, 0x81, 0x76, 0xf0, 0x50, 0x75, 0xda, 0x8d, 0x23,
-  0xf8, 0xf6, 0xda, 0x5f, 0xaf, 0x90, 0xe0, 0xe2, 0x07, 0xb0, 0x3e, 0x6b,
-  0x66, 0x70, 0x62, 0xea, 0xce, 0x05, 0x7d, 0x7f, 0x2b, 0xb8, 0x16, 0x6a,
-  0x65, 0x4a, 0x4f, 0x7a, 0x55, 0xc8, 0x23, 0x83, 0x64, 0xb9, 0x9c, 0x39,
-  0x45, 0x12, 0xdf, 0x3e, 0x0c, 0xdd, 0x91, 0xdb, 0xe9, 0x93, 0x69, 0x7c,
-  0xca, 0xda, 0x5c, 0x02, 0xbc, 0xc3, 0x0c, 0x05, 0xa7, 0xd0, 0x9a, 0x50,
-  0x6a, 0x36, 0x9d, 0x5d, 0x93, 0x49, 0x15, 0xf3, 0x23, 0x2e, 0x98, 0x87,
-  0x6d, 0x65, 0xb2, 0x2b, 0xdb, 0x8c, 0x16, 0xef, 0xaa, 0x54, 0x57, 0x3c,
-  0x77, 0xe0, 0x2c, 0x50, 0x70, 0xd0, 0x25, 0x11, 0x6b, 0xce, 0x59, 0xc9,
-  0x9d, 0x20, 0x8f, 0x54, 0x1a, 0x68, 0x06, 0x50, 0xa5, 0x00, 0x16, 0x6d,
-  0x79, 0xb2, 0xd2, 0xbc, 0x5a, 0xb5, 0x29, 0xfe, 0x20, 0x61, 0x45, 0x6e,
-  0x5f, 0x31, 0x3a, 0x75, 0xa3, 0xe2, 0x95, 0xb0, 0xcb, 0xb2, 0x01, 0xa0,
-  0x70, 0xb2, 0x1d, 0x00, 0x4c, 0x36, 0x0c, 0xf4, 0xd2, 0x1c, 0xef, 0x56,
-  0x62, 0x09, 0xb1, 0x8d, 0x8d, 0x5c, 0x4b, 0x7b, 0x79, 0x93, 0x77, 0x89,
-  0xae, 0x6d, 0xbc, 0x8a, 0x17, 0xe5, 0x35, 0x76, 0xac, 0xc5, 0xd1, 0xa4,
-  0x67, 0xef, 0x25, 0xbe, 0x26, 0xbd, 0xb8, 0x54, 0xa3, 0x96, 0xb8, 0xab,
-  0x00, 0xdb, 0xbe, 0xd2, 0x41, 0x93, 0x5a, 0xe5, 0xd9, 0xf2, 0xd3, 0x93,
-  0xe7, 0xcf, 0xdc, 0x5b, 0x4b, 0xa8, 0xf7, 0xf9, 0x7a, 0x2a, 0xef, 0x81,
-  0x5d, 0xfb, 0xd2, 0x9d, 0x55, 0xa2, 0x65, 0xf5, 0x72, 0x71, 0x3f, 0xb1,
-  0x65, 0xa6, 0xc5, 0x0d, 0x9c, 0xc5, 0xf7, 0xac, 0x3f, 0x97, 0x0a, 0x7c,
-  0x27, 0x72, 0xfe, 0x60, 0x67, 0x38, 0xaf, 0x25, 0x39, 0x6a, 0x07, 0xdc,
-  0xf4, 0x7c, 0x7c, 0x1d, 0xd1, 0x34, 0xe0, 0xe5, 0x4b, 0xf0, 0xb0, 0x87,
-  0x87, 0xfa, 0xca, 0xde, 0x9b, 0x3d, 0x40, 0xe9, 0x75, 0x04, 0x71, 0xc3,
-  0x2f, 0x28, 0x4f, 0xfc, 0x62, 0x81, 0xca, 0xc7, 0x30, 0xc9, 0x79, 0xa3,
-  0x4f, 0xef, 0xa5, 0x4a, 0x4e, 0xe4, 0xa9, 0xe1, 0x49, 0xbc, 0x13, 0x47,
-  0x6f, 0x07, 0x1c, 0x64, 0x02, 0xcd, 0x25, 0xfc, 0x44, 0x65, 0xcb, 0xc0,
-  0x1c, 0x24, 0x3d, 0x38, 0x9e, 0xda, 0x1e, 0x07, 0x13, 0x88, 0x91, 0xed,
-  0xd4, 0x21, 0x0b, 0xbd, 0xba, 0x84, 0xa2, 0x4d, 0x4f, 0xf3, 0x86, 0x7f,
-  0xe9, 0xc8, 0x51, 0xf8, 0x4d, 0x8f, 0xe8, 0x73, 0x97, 0x3e, 0x4b, 0x9a,
-  0x36, 0x08, 0xf8, 0x7d, 0x1e, 0x46, 0xa2, 0x6c, 0xbd, 0x8e, 0xc4, 0xc6,
-  0xa5, 0x5b, 0xf5, 0x5f, 0x98, 0xe0, 0x65, 0x7f, 0x8d, 0xad, 0xf0, 0x87,
-  0x91, 0xbb, 0x9c, 0xf4, 0x7a, 0x8b, 0x5f, 0xd3, 0x6d, 0x27, 0xcb, 0xa0,
-  0x9f, 0x5b, 0x48, 0x9f, 0xde, 0x1e, 0xaf, 0x32, 0x17, 0xb0, 0x97, 0xd1,
-  0x17, 0x60, 0x38, 0x60, 0xa4, 0x0a, 0xcb, 0x36, 0xd1, 0xcd, 0xa0, 0x94,
-  0x1c, 0x66, 0x67, 0x3f, 0xc7, 0x34, 0xd5, 0x88, 0x92, 0xee, 0x88, 0x28,
-  0x65, 0xf4, 0x26, 0x0e, 0x50, 0xdb, 0xe9, 0x97, 0xaa, 0x4d, 0x32, 0x25,
-  0x3f, 0x62, 0x2d, 0x02, 0xbb, 0xc7, 0x38, 0xa2, 0x24, 0x00, 0x5d, 0xb3,
-  0x92, 0xa3, 0x28, 0x4b, 0x4d, 0x55, 0x84, 0x04, 0xed, 0x6e, 0xb3, 0x1d,
-  0x4e, 0x67, 0xd5, 0x45, 0x0d, 0x47, 0x85, 0x25, 0xf8, 0x39, 0x4d, 0xc1,
-  0xc1, 0x86, 0x66, 0x2c, 0xa0, 0x26, 0xda, 0xcf, 0x2d, 0x38, 0x62, 0xab,
-  0x9b, 0x69, 0x3e, 0xd8, 0x24, 0x2a, 0xeb, 0xa5, 0xb4, 0xfd, 0x63, 0xa1,
-  0xbb, 0x0b, 0xfc, 0x9a, 0x90, 0x2d, 0xc5, 0x29, 0xa3, 0x40, 0x0f, 0x95,
-  0xf3, 0xce, 0x48, 0xaa, 0xb9, 0x06, 0x30, 0xc4, 0x78, 0xd6, 0x58, 0x0a,
-  0xa5, 0x5d, 0x74, 0x09, 0xab, 0x92, 0x7a, 0xdc, 0x40, 0x0c, 0x88, 0x2f,
-  0x14, 0xec, 0x61, 0xbb, 0xf0, 0x22, 0xb9, 0xb8, 0x2d, 0x35, 0xf4, 0xd2,
-  0x9b, 0x6a, 0x13, 0xfc, 0x29, 0x4a, 0xce, 0x05, 0xd8, 0xe8, 0x3f, 0x1f,
-  0xf5, 0xfd, 0xa7, 0xcd, 0xe8, 0x20, 0xcc, 0x00, 0xc9, 0xb7, 0x8b, 0x63,
-  0xe2, 0x2c, 0x45, 0x68, 0xbf, 0x3a, 0xe1, 0x4c, 0xb4, 0xb9, 0x28, 0xc2,
-  0xbc, 0xc4, 0x4e, 0xc9, 0x7a, 0x34, 0xe3, 0x59, 0xea, 0x1c, 0x7d, 0x9a,
-  0x6e, 0xb6, 0x73, 0x20, 0xdc, 0xcc, 0x31, 0x07, 0x53, 0x16, 0xcf, 0x60,
-  0x10, 0xbd, 0x0f, 0x8e, 0x41, 0x24, 0x77, 0xd2, 0xf0, 0x96, 0x47, 0xf5,
-  0x81, 0x82, 0x34, 0xc7, 0x24, 0x96, 0x03, 0xf2, 0xeb, 0xa5, 0x63, 0x21,
-  0xc0, 0x49, 0xc7, 0x19, 0x2e, 0x49, 0xb3, 0xd1, 0x0c, 0xac, 0x62, 0x6c,
-  0xa5, 0x45, 0x69, 0xb0, 0xf5, 0x27, 0x18, 0xe1, 0x3a, 0x65, 0x41, 0xc0,
-  0x64, 0xf6, 0x74, 0xae, 0x70, 0x5b, 0xed, 0x34, 0x34, 0xe1, 0xcd, 0xda,
-  0x3a, 0x77, 0xc9, 0xa1, 0x45, 0x97, 0xd8, 0x50, 0x7a, 0x02, 0xca, 0xfc,
-  0x51, 0x7e, 0x9c, 0xf1, 0x8e, 0xa8, 0x88, 0x0f, 0x95, 0xfc, 0x40, 0x3b,
-  0xcc, 0xa0, 0x17, 0xa9, 0x0d, 0x4e, 0x61, 0x4d, 0x67, 0xd5, 0x25, 0x26,
-  0x2c, 0x3b, 0xc7, 0x85, 0xdd, 0xa6, 0x39, 0xce, 0xd6, 0x19, 0x19, 0xfd,
-  0xa7, 0x3a, 0xc0, 0xcf, 0x46, 0x9d, 0x68, 0x7e, 0x17, 0xd9, 0x52, 0x78,
-  0xab, 0x5e, 0x71, 0xdc, 0x45, 0xc3, 0x81, 0x83, 0xa4, 0x0e, 0xd2, 0x7a,
-  0x30, 0x69, 0x3d, 0x63, 0x29, 0xd5, 0x33, 0xea, 0x27, 0xc0, 0x25, 0xae,
-  0x6e, 0x83, 0xb4, 0xc3, 0x44, 0x43, 0x81, 0xbb, 0x7f, 0x49, 0x47, 0xf6,
-  0xd5, 0xaa, 0x2e, 0x79, 0x9e, 0x0a, 0xf6, 0xdc, 0xa8, 0x1b, 0x4a, 0x11,
-  0xc5, 0xc2, 0x65, 0x0a, 0x7b, 0x7e, 0x21, 0xeb, 0xc8, 0x19, 0x5f, 0x79,
-  0x31, 0xdd, 0xff, 0xce, 0x33, 0xf8, 0x09, 0x09, 0x76, 0x27, 0x74, 0x33,
-  0x72, 0xa3, 0x49, 0x06, 0xd6, 0x91, 0x65, 0x81, 0x1a, 0xcb, 0x59, 0xe5,
-  0xe7, 0xcb, 0xe0, 0x1e, 0x9a, 0x29, 0xb4, 0xe3, 0xaa, 0xc5, 0x2c, 0x6c,
-  0x02, 0xa1, 0xd5, 0x8b, 0x0a, 0xa7, 0xb2, 0x10, 0xdd, 0x32, 0xe8, 0xe1,
-  0x1b, 0x02, 0xaf, 0x73, 0x35, 0x83, 0x3e, 0x32, 0x1f, 0x3d, 0x52, 0xc0,
-  0xc3, 0x01, 0x76, 0x5c, 0xed, 0x5c, 0xea, 0x4b, 0xa3, 0xcc, 0xe0, 0xa6,
-  0x7f, 0xa9, 0x1c, 0xa5, 0x0e, 0xd9, 0x78, 0x61, 0xa3, 0xe3, 0x13, 0x3b,
-  0x47, 0x62, 0xe8, 0x53, 0xba, 0x85, 0x5c, 0x97, 0xad, 0x11, 0x29, 0x39,
-  0x10, 0xd1, 0xb3, 0xb6, 0x20, 0x75, 0x64, 0x95, 0x19, 0xbf, 0x59, 0x6d,
-  0xc5, 0x93, 0x2b, 0x72, 0xc2, 0x46, 0x55, 0x55, 0x78, 0xfb, 0xdc, 0x6b,
-  0xd2, 0xba, 0x76, 0xee, 0xaa, 0x1e, 0x50, 0x9a, 0xbf, 0xf2, 0xdd, 0xc2,
-  0x42, 0x06, 0x05, 0xa6, 0xd1, 0x0c, 0x0c, 0xbf, 0x3b, 0xc7, 0x7e, 0xcb,
-  0xc2, 0x2a, 0xb2, 0x0e, 0x52, 0xef, 0x92, 0x02, 0xca, 0x29, 0x51, 0x32,
-  0x33, 0x73, 0x65, 0xb5, 0xf4, 0x97, 0x81, 0x89, 0x4d, 0x60, 0xea, 0xb7,
-  0xf3, 0xf1, 0xc4, 0xe6, 0x31, 0x58, 0x6b, 0x2c, 0xb1, 0x8e, 0xe2, 0x59,
-  0x13, 0xdf, 0xc7, 0x7a, 0x38, 0x7c, 0x4a, 0x32, 0xe6, 0x2b, 0x51, 0x1b,
-  0x20, 0xbf, 0x21, 0xba, 0x89, 0xa9, 0xf0, 0x49, 0x55, 0x69, 0xba, 0x77,
-  0xa3, 0x7c, 0x05, 0x22, 0x63, 0x3f, 0xbb, 0x66, 0x74, 0xb8, 0x6b, 0xe8,
-  0xfd, 0xe0, 0xbb, 0xfc, 0xaf, 0x35, 0x05, 0x45, 0xcc, 0x4a, 0x62, 0xb0,
-  0x1e, 0x68, 0x24, 0xce, 0xf3, 0xb7, 0xe7, 0x2d, 0x87, 0xad, 0x26, 0x48,
-  0x3a, 0x47, 0x7a, 0x46, 0xee, 0x50, 0x0a, 0x64, 0xe7, 0x6e, 0xb8, 0x1d,
-  0x97, 0x3b, 0xb6, 0x8c, 0xcf, 0xf4, 0x30, 0x71, 0x42, 0x1a, 0xd6, 0xbb,
-  0x41, 0x39, 0xc1, 0x17, 0x57, 0xcb, 0x63, 0x54, 0x12, 0xe5, 0xaa, 0x0b,
-  0x3b, 0x1c, 0xd6, 0x45, 0xc7, 0xde, 0x35, 0x6a, 0x81, 0x0d, 0x1d, 0x40,
-  0xb2, 0x34, 0x3e, 0x20, 0x00, 0x00, 0x00, 0xb2, 0x29, 0x21, 0x90, 0x3d,
-  0x35, 0xc6, 0xc5, 0xc4, 0x36, 0xf4, 0x95, 0x0f, 0xb9, 0xfb, 0xf2, 0xf4,
-  0x35, 0xb2, 0x24, 0x78, 0x63, 0x54, 0x90, 0x02, 0x40, 0xb2, 0xdc, 0x32,
-  0xfa, 0xfb, 0xe1, 0x33, 0x0b, 0x26, 0xc0, 0xde, 0x30, 0x28, 0x91, 0xb8,
-  0x58, 0x00, 0xd2, 0x8f, 0x80, 0x00, 0x00, 0x00
-};
-unsigned int Xtragen_logo_200x62_webp_len = 5036;
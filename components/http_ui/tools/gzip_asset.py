@@ -0,0 +1,13 @@
+#!/usr/bin/env python3
+"""Gzip one web asset for embedding (deterministic: no name, mtime 0)."""
+import gzip
+import sys
+
+if len(sys.argv) != 3:
+    sys.exit("usage: gzip_asset.py <input> <output.gz>")
+
+with open(sys.argv[1], "rb") as f:
+    data = f.read()
+
+with open(sys.argv[2], "wb") as f:
+    f.write(gzip.compress(data, compresslevel=9, mtime=0))
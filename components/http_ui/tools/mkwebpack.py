@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""Build a web pack image for the storage partition.
+
+Layout (little-endian, matches web_pack_* in http_ui.c):
+  header  magic "WPK1", u16 version, u16 count, u32 size, u32 crc32
+  entries count x { char name[32], u32 offset, u32 length, u32 flags }
+  data    each asset, 4-byte aligned; offsets are from the start of the image
+
+crc32 (zlib) covers everything after the header. Text assets are gzipped
+deterministically (mtime 0) and flagged so they are served with
+Content-Encoding: gzip.
+"""
+import gzip
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"WPK1"
+VERSION = 1
+NAME_MAX = 32
+FLAG_GZIP = 0x1
+GZIP_EXT = {".html", ".js", ".css", ".ico", ".svg", ".json", ".txt"}
+
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<%dsIII" % NAME_MAX)
+
+
+def collect(web_dir):
+    assets = []
+    for root, _, files in os.walk(web_dir):
+        for fn in sorted(files):
+            path = os.path.join(root, fn)
+            name = os.path.relpath(path, web_dir).replace(os.sep, "/")
+            if len(name) >= NAME_MAX:
+                sys.exit("mkwebpack: name too long: %s" % name)
+            with open(path, "rb") as f:
+                data = f.read()
+            flags = 0
+            if os.path.splitext(fn)[1].lower() in GZIP_EXT:
+                data = gzip.compress(data, compresslevel=9, mtime=0)
+                flags |= FLAG_GZIP
+            assets.append((name, data, flags))
+    return sorted(assets)
+
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        sys.exit("usage: mkwebpack.py <web_dir> <output.bin> [max_size]")
+    assets = collect(sys.argv[1])
+
+    offset = HEADER.size + ENTRY.size * len(assets)
+    entries = b""
+    data = b""
+    for name, blob, flags in assets:
+        pad = (-offset) % 4
+        data += b"\0" * pad
+        offset += pad
+        entries += ENTRY.pack(name.encode(), offset, len(blob), flags)
+        data += blob
+        offset += len(blob)
+
+    body = entries + data
+    image = HEADER.pack(MAGIC, VERSION, len(assets), HEADER.size + len(body),
+                        zlib.crc32(body)) + body
+
+    if len(sys.argv) == 4 and len(image) > int(sys.argv[3], 0):
+        sys.exit("mkwebpack: image is %d bytes, partition holds %s" % (len(image), sys.argv[3]))
+    with open(sys.argv[2], "wb") as f:
+        f.write(image)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,83 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Streaming JSON writer
+ *
+ * Writes compact JSON into a caller-owned buffer (stack or static) without
+ * any heap allocation. With a flush callback the buffer is handed off
+ * whenever it fills, so output of any size streams through a few hundred
+ * bytes (e.g. httpd_resp_send_chunk). Without one the buffer must hold the
+ * whole document.
+ *
+ * Calls never fail individually: the first error is latched and every
+ * later call is a no-op, so a document is emitted straight through and
+ * checked once with json_writer_finish().
+ *
+ * key is the member name inside an object, NULL for array elements and
+ * the top-level value.
+ */
+#define JSON_WRITER_MAX_DEPTH 16
+
+typedef esp_err_t (*json_writer_flush_t)(void* ctx, const char* data, size_t len);
+
+typedef struct {
+    char* buf;
+    size_t cap;
+    size_t len;                 // Bytes pending in buf
+    size_t total;               // Bytes emitted so far, flushed or not
+    json_writer_flush_t flush;  // NULL: fixed buffer
+    void* ctx;
+    uint32_t has_items;         // Bit n: container at depth n already has a member
+    uint8_t depth;
+    esp_err_t err;              // First error, ESP_OK while healthy
+} json_writer_t;
+
+/**
+ * Start a document in buf
+ * A plain struct copy of the writer snapshots its state, so a fixed-buffer
+ * document can be rendered up to some point once and continued from the
+ * copy many times.
+ */
+void json_writer_init(json_writer_t* w, char* buf, size_t cap, json_writer_flush_t flush, void* ctx);
+
+void json_writer_begin_object(json_writer_t* w, const char* key);
+void json_writer_end_object(json_writer_t* w);
+void json_writer_begin_array(json_writer_t* w, const char* key);
+void json_writer_end_array(json_writer_t* w);
+
+/**
+ * Values (strings are escaped; NULL is written as null)
+ */
+void json_writer_string(json_writer_t* w, const char* key, const char* value);
+void json_writer_int(json_writer_t* w, const char* key, int64_t value);
+void json_writer_uint(json_writer_t* w, const char* key, uint64_t value);
+void json_writer_double(json_writer_t* w, const char* key, double value);
+void json_writer_bool(json_writer_t* w, const char* key, bool value);
+void json_writer_null(json_writer_t* w, const char* key);
+
+/**
+ * Pre-rendered JSON value, copied verbatim (the caller vouches for it)
+ */
+void json_writer_raw(json_writer_t* w, const char* key, const char* json);
+
+/**
+ * Finish the document
+ * With a flush callback, hands over whatever is still buffered. Without
+ * one, NUL-terminates buf (the terminator needs one byte of cap and is not
+ * counted in w->len). Returns the latched error: ESP_ERR_NO_MEM if a fixed
+ * buffer overflowed, ESP_ERR_INVALID_STATE on unbalanced or too deep
+ * nesting, or whatever the flush callback returned.
+ */
+esp_err_t json_writer_finish(json_writer_t* w);
+
+#ifdef __cplusplus
+}
+#endif
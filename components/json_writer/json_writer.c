@@ -0,0 +1,217 @@
+/* Streaming JSON writer - see json_writer.h */
+
+#include "json_writer.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+void json_writer_init(json_writer_t* w, char* buf, size_t cap, json_writer_flush_t flush, void* ctx)
+{
+    memset(w, 0, sizeof(*w));
+    w->buf = buf;
+    w->cap = cap;
+    w->flush = flush;
+    w->ctx = ctx;
+    w->err = (buf && cap > 0) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+static void put(json_writer_t* w, const char* s, size_t n)
+{
+    // A fixed buffer keeps one byte back for the terminator
+    size_t usable = w->flush ? w->cap : w->cap - 1;
+
+    while (n > 0 && w->err == ESP_OK) {
+        if (w->len == usable) {
+            if (!w->flush) {
+                w->err = ESP_ERR_NO_MEM;
+                return;
+            }
+            w->err = w->flush(w->ctx, w->buf, w->len);
+            w->len = 0;
+            continue;
+        }
+        size_t room = usable - w->len;
+        size_t take = n < room ? n : room;
+        memcpy(w->buf + w->len, s, take);
+        w->len += take;
+        w->total += take;
+        s += take;
+        n -= take;
+    }
+}
+
+static void put_escaped(json_writer_t* w, const char* s)
+{
+    put(w, "\"", 1);
+
+    const char* run = s;
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        put(w, run, s - run);
+        run = s + 1;
+
+        char esc[8];
+        switch (c) {
+            case '"':  put(w, "\\\"", 2); break;
+            case '\\': put(w, "\\\\", 2); break;
+            case '\n': put(w, "\\n", 2); break;
+            case '\r': put(w, "\\r", 2); break;
+            case '\t': put(w, "\\t", 2); break;
+            default:
+                snprintf(esc, sizeof(esc), "\\u%04x", c);
+                put(w, esc, 6);
+                break;
+        }
+    }
+    put(w, run, s - run);
+
+    put(w, "\"", 1);
+}
+
+/**
+ * Separator and member name ahead of any value
+ */
+static void put_prefix(json_writer_t* w, const char* key)
+{
+    uint32_t bit = 1u << w->depth;
+    if (w->has_items & bit) {
+        put(w, ",", 1);
+    }
+    w->has_items |= bit;
+
+    if (key) {
+        put_escaped(w, key);
+        put(w, ":", 1);
+    }
+}
+
+static void begin(json_writer_t* w, const char* key, char open)
+{
+    put_prefix(w, key);
+    if (w->depth + 1 >= JSON_WRITER_MAX_DEPTH) {
+        if (w->err == ESP_OK) {
+            w->err = ESP_ERR_INVALID_STATE;
+        }
+        return;
+    }
+    put(w, &open, 1);
+    w->depth++;
+    w->has_items &= ~(1u << w->depth);
+}
+
+static void end(json_writer_t* w, char close)
+{
+    if (w->depth == 0) {
+        if (w->err == ESP_OK) {
+            w->err = ESP_ERR_INVALID_STATE;
+        }
+        return;
+    }
+    put(w, &close, 1);
+    w->depth--;
+}
+
+void json_writer_begin_object(json_writer_t* w, const char* key)
+{
+    begin(w, key, '{');
+}
+
+void json_writer_end_object(json_writer_t* w)
+{
+    end(w, '}');
+}
+
+void json_writer_begin_array(json_writer_t* w, const char* key)
+{
+    begin(w, key, '[');
+}
+
+void json_writer_end_array(json_writer_t* w)
+{
+    end(w, ']');
+}
+
+void json_writer_string(json_writer_t* w, const char* key, const char* value)
+{
+    if (!value) {
+        json_writer_null(w, key);
+        return;
+    }
+    put_prefix(w, key);
+    put_escaped(w, value);
+}
+
+void json_writer_int(json_writer_t* w, const char* key, int64_t value)
+{
+    char num[24];
+    int n = snprintf(num, sizeof(num), "%" PRId64, value);
+    put_prefix(w, key);
+    put(w, num, n);
+}
+
+void json_writer_uint(json_writer_t* w, const char* key, uint64_t value)
+{
+    char num[24];
+    int n = snprintf(num, sizeof(num), "%" PRIu64, value);
+    put_prefix(w, key);
+    put(w, num, n);
+}
+
+void json_writer_double(json_writer_t* w, const char* key, double value)
+{
+    // JSON has no NaN/Infinity
+    if (!isfinite(value)) {
+        json_writer_null(w, key);
+        return;
+    }
+    char num[32];
+    int n = snprintf(num, sizeof(num), "%.10g", value);
+    put_prefix(w, key);
+    put(w, num, n);
+}
+
+void json_writer_bool(json_writer_t* w, const char* key, bool value)
+{
+    put_prefix(w, key);
+    put(w, value ? "true" : "false", value ? 4 : 5);
+}
+
+void json_writer_null(json_writer_t* w, const char* key)
+{
+    put_prefix(w, key);
+    put(w, "null", 4);
+}
+
+void json_writer_raw(json_writer_t* w, const char* key, const char* json)
+{
+    if (!json || !json[0]) {
+        json_writer_null(w, key);
+        return;
+    }
+    put_prefix(w, key);
+    put(w, json, strlen(json));
+}
+
+esp_err_t json_writer_finish(json_writer_t* w)
+{
+    if (w->err == ESP_OK && w->depth != 0) {
+        w->err = ESP_ERR_INVALID_STATE;
+    }
+    if (w->err != ESP_OK) {
+        return w->err;
+    }
+
+    if (w->flush) {
+        if (w->len > 0) {
+            w->err = w->flush(w->ctx, w->buf, w->len);
+            w->len = 0;
+        }
+    } else {
+        w->buf[w->len] = '\0';
+    }
+    return w->err;
+}
@@ -0,0 +1,267 @@
+#include "unity.h"
+#include "json_writer.h"
+#include "esp_err.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Flush sink: collects the streamed document and the size of every chunk
+ */
+typedef struct {
+    char out[512];
+    size_t len;
+    size_t chunks[256];
+    int chunk_count;
+    int fail_at;                // Chunk that fails with ESP_FAIL, -1: never
+} sink_t;
+
+static esp_err_t sink_flush(void* ctx, const char* data, size_t len)
+{
+    sink_t* s = ctx;
+
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_TRUE(s->len + len < sizeof(s->out));
+    TEST_ASSERT_TRUE(s->chunk_count < (int)(sizeof(s->chunks) / sizeof(s->chunks[0])));
+    if (s->chunk_count == s->fail_at) {
+        return ESP_FAIL;
+    }
+    memcpy(s->out + s->len, data, len);
+    s->len += len;
+    s->out[s->len] = '\0';
+    s->chunks[s->chunk_count++] = len;
+    return ESP_OK;
+}
+
+static void sink_init(sink_t* s)
+{
+    memset(s, 0, sizeof(*s));
+    s->fail_at = -1;
+}
+
+/**
+ * One document exercising every value type and nesting shape
+ */
+static void write_sample(json_writer_t* w)
+{
+    json_writer_begin_object(w, NULL);
+    json_writer_string(w, "ver", "v1.1");
+    json_writer_int(w, "min", INT64_MIN);
+    json_writer_uint(w, "max", UINT64_MAX);
+    json_writer_double(w, "d", 1.5);
+    json_writer_bool(w, "on", true);
+    json_writer_null(w, "none");
+    json_writer_begin_array(w, "list");
+    json_writer_int(w, NULL, 1);
+    json_writer_begin_object(w, NULL);
+    json_writer_string(w, "k", "a\"b");
+    json_writer_begin_array(w, "e");
+    json_writer_end_array(w);
+    json_writer_end_object(w);
+    json_writer_begin_array(w, NULL);
+    json_writer_bool(w, NULL, false);
+    json_writer_end_array(w);
+    json_writer_raw(w, NULL, "{\"r\":[1,2]}");
+    json_writer_end_array(w);
+    json_writer_begin_object(w, "o");
+    json_writer_end_object(w);
+    json_writer_string(w, "last", "\xc3\xa9");
+    json_writer_end_object(w);
+}
+
+static const char SAMPLE[] =
+    "{\"ver\":\"v1.1\",\"min\":-9223372036854775808,\"max\":18446744073709551615,"
+    "\"d\":1.5,\"on\":true,\"none\":null,"
+    "\"list\":[1,{\"k\":\"a\\\"b\",\"e\":[]},[false],{\"r\":[1,2]}],"
+    "\"o\":{},\"last\":\"\xc3\xa9\"}";
+
+TEST_CASE("json_writer_fixed_buffer_document", "[json_writer]")
+{
+    char buf[sizeof(SAMPLE)];
+    json_writer_t w;
+
+    // Exactly the document plus its terminator fits
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    write_sample(&w);
+    TEST_ASSERT_EQUAL(ESP_OK, json_writer_finish(&w));
+    TEST_ASSERT_EQUAL_STRING(SAMPLE, buf);
+    TEST_ASSERT_EQUAL(strlen(SAMPLE), w.len);
+    TEST_ASSERT_EQUAL(strlen(SAMPLE), w.total);
+}
+
+TEST_CASE("json_writer_escapes_strings", "[json_writer]")
+{
+    char buf[160];
+    json_writer_t w;
+
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    json_writer_begin_object(&w, NULL);
+    json_writer_string(&w, "q\"k", "\"\\/");
+    json_writer_string(&w, "ws", "\n\r\t\b\f");
+    json_writer_string(&w, "ctl", "\x01\x1f\x7f");
+    json_writer_string(&w, "utf8", "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80");
+    json_writer_string(&w, "empty", "");
+    json_writer_string(&w, "nul", NULL);
+    json_writer_raw(&w, "raw", "");
+    json_writer_double(&w, "nan", NAN);
+    json_writer_double(&w, "inf", -INFINITY);
+    json_writer_end_object(&w);
+    TEST_ASSERT_EQUAL(ESP_OK, json_writer_finish(&w));
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"q\\\"k\":\"\\\"\\\\/\","
+        "\"ws\":\"\\n\\r\\t\\u0008\\u000c\","
+        "\"ctl\":\"\\u0001\\u001f\x7f\","
+        "\"utf8\":\"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\","
+        "\"empty\":\"\",\"nul\":null,\"raw\":null,\"nan\":null,\"inf\":null}", buf);
+}
+
+TEST_CASE("json_writer_comma_placement", "[json_writer]")
+{
+    char buf[128];
+    json_writer_t w;
+
+    // Each container starts without a separator, whatever its parent had
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    json_writer_begin_array(&w, NULL);
+    json_writer_begin_array(&w, NULL);
+    json_writer_begin_object(&w, NULL);
+    json_writer_int(&w, "a", 1);
+    json_writer_begin_object(&w, "b");
+    json_writer_end_object(&w);
+    json_writer_int(&w, "c", 2);
+    json_writer_end_object(&w);
+    json_writer_begin_object(&w, NULL);
+    json_writer_end_object(&w);
+    json_writer_end_array(&w);
+    json_writer_begin_array(&w, NULL);
+    json_writer_int(&w, NULL, 3);
+    json_writer_end_array(&w);
+    json_writer_int(&w, NULL, 4);
+    json_writer_end_array(&w);
+    TEST_ASSERT_EQUAL(ESP_OK, json_writer_finish(&w));
+    TEST_ASSERT_EQUAL_STRING("[[{\"a\":1,\"b\":{},\"c\":2},{}],[3],4]", buf);
+}
+
+TEST_CASE("json_writer_reports_overflow_and_nesting", "[json_writer]")
+{
+    char buf[sizeof(SAMPLE)];
+    json_writer_t w;
+
+    // One byte short: the terminator no longer fits
+    json_writer_init(&w, buf, sizeof(buf) - 1, NULL, NULL);
+    write_sample(&w);
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, json_writer_finish(&w));
+    TEST_ASSERT_EQUAL(sizeof(buf) - 2, w.len);
+    // Latched: later calls change nothing
+    json_writer_int(&w, "x", 1);
+    TEST_ASSERT_EQUAL(sizeof(buf) - 2, w.len);
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, json_writer_finish(&w));
+
+    for (size_t cap = 1; cap < sizeof(buf); cap++) {
+        json_writer_init(&w, buf, cap, NULL, NULL);
+        write_sample(&w);
+        TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, json_writer_finish(&w));
+        TEST_ASSERT_TRUE(w.len < cap);
+    }
+
+    json_writer_init(&w, NULL, 16, NULL, NULL);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, json_writer_finish(&w));
+
+    // Unbalanced
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    json_writer_begin_object(&w, NULL);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, json_writer_finish(&w));
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    json_writer_end_array(&w);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, json_writer_finish(&w));
+
+    // JSON_WRITER_MAX_DEPTH - 1 containers may be open at once
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    for (int d = 0; d < JSON_WRITER_MAX_DEPTH - 1; d++) {
+        json_writer_begin_array(&w, NULL);
+    }
+    for (int d = 0; d < JSON_WRITER_MAX_DEPTH - 1; d++) {
+        json_writer_end_array(&w);
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, json_writer_finish(&w));
+    json_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    for (int d = 0; d < JSON_WRITER_MAX_DEPTH; d++) {
+        json_writer_begin_array(&w, NULL);
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, json_writer_finish(&w));
+}
+
+TEST_CASE("json_writer_flushes_at_chunk_boundaries", "[json_writer]")
+{
+    char buf[64];
+    json_writer_t w;
+    sink_t s;
+
+    // Every buffer size, down to one byte, streams the same document
+    for (size_t cap = 1; cap <= sizeof(buf); cap++) {
+        sink_init(&s);
+        json_writer_init(&w, buf, cap, sink_flush, &s);
+        write_sample(&w);
+        TEST_ASSERT_EQUAL(ESP_OK, json_writer_finish(&w));
+        TEST_ASSERT_EQUAL_STRING(SAMPLE, s.out);
+        TEST_ASSERT_EQUAL(strlen(SAMPLE), w.total);
+        TEST_ASSERT_EQUAL(0, w.len);
+
+        // Full chunks only, bar the last; a flushing buffer has no terminator byte
+        TEST_ASSERT_EQUAL((strlen(SAMPLE) + cap - 1) / cap, s.chunk_count);
+        for (int i = 0; i < s.chunk_count - 1; i++) {
+            TEST_ASSERT_EQUAL(cap, s.chunks[i]);
+        }
+    }
+
+    // A document that exactly fills the buffer goes out in one chunk at finish
+    sink_init(&s);
+    json_writer_init(&w, buf, 2, sink_flush, &s);
+    json_writer_begin_array(&w, NULL);
+    json_writer_end_array(&w);
+    TEST_ASSERT_EQUAL(0, s.chunk_count);
+    TEST_ASSERT_EQUAL(ESP_OK, json_writer_finish(&w));
+    TEST_ASSERT_EQUAL(1, s.chunk_count);
+    TEST_ASSERT_EQUAL_STRING("[]", s.out);
+}
+
+TEST_CASE("json_writer_latches_flush_error", "[json_writer]")
+{
+    char buf[16];
+    json_writer_t w;
+    sink_t s;
+
+    sink_init(&s);
+    s.fail_at = 2;
+    json_writer_init(&w, buf, sizeof(buf), sink_flush, &s);
+    write_sample(&w);
+    TEST_ASSERT_EQUAL(ESP_FAIL, json_writer_finish(&w));
+    TEST_ASSERT_EQUAL(2, s.chunk_count);
+    TEST_ASSERT_EQUAL(2 * sizeof(buf), s.len);
+    TEST_ASSERT_EQUAL(3 * sizeof(buf), w.total);
+}
+
+TEST_CASE("json_writer_copy_snapshots_state", "[json_writer]")
+{
+    char buf[64];
+    json_writer_t base;
+    json_writer_t w;
+
+    json_writer_init(&base, buf, sizeof(buf), NULL, NULL);
+    json_writer_begin_object(&base, NULL);
+    json_writer_string(&base, "id", "dev");
+
+    // Continue the same prefix twice; the second copy overwrites the tail
+    w = base;
+    json_writer_int(&w, "n", 1);
+    json_writer_end_object(&w);
+    TEST_ASSERT_EQUAL(ESP_OK, json_writer_finish(&w));
+    TEST_ASSERT_EQUAL_STRING("{\"id\":\"dev\",\"n\":1}", buf);
+
+    w = base;
+    json_writer_begin_array(&w, "a");
+    json_writer_end_array(&w);
+    json_writer_end_object(&w);
+    TEST_ASSERT_EQUAL(ESP_OK, json_writer_finish(&w));
+    TEST_ASSERT_EQUAL_STRING("{\"id\":\"dev\",\"a\":[]}", buf);
+}
@@ -1,7 +1,9 @@
 #pragma once
 #include "esp_err.h"
+#include "config_mgr.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,6 +32,87 @@ esp_err_t net_mgr_get_netmask(char* netmask_str, size_t netmask_str_len);
 esp_err_t net_mgr_get_gateway(char* gw_str, size_t gw_str_len);
 int net_mgr_get_rssi(int* rssi_out);
 
+/**
+ * Known networks: the primary one (wifi/ssid, wifi/pass) plus up to
+ * NET_MGR_MAX_NETWORKS - 1 more (wifi/ssidN, wifi/passN). Connects and
+ * roaming pick the strongest AP that carries any of them.
+ */
+#define NET_MGR_MAX_NETWORKS 4
+
+typedef struct {
+    char ssid[33];
+    char pass[65];
+} net_mgr_network_t;
+
+/**
+ * Extra networks only (the primary one is not included)
+ */
+esp_err_t net_mgr_get_networks(net_mgr_network_t* out, size_t max, size_t* count);
+
+/**
+ * Stage the extra network list in txn (replaces it; count 0 clears it)
+ * Call net_mgr_reload_networks() once txn is committed.
+ */
+esp_err_t net_mgr_txn_set_networks(config_mgr_txn_t* txn, const net_mgr_network_t* nets, size_t count);
+
+/**
+ * Re-read the known networks; used from the next connect or roam on
+ */
+esp_err_t net_mgr_reload_networks(void);
+
+/**
+ * Roaming between APs of the known networks (CONFIG_NET_MGR_ROAM)
+ */
+typedef struct {
+    uint32_t roams;                 // Completed, started by us or by the AP (802.11v)
+    uint32_t failed;                // Target AP not joined; fell back to a reconnect
+    uint32_t scans;                 // Background scans on low RSSI
+    uint32_t last_assoc_ms;         // Last roam: link down to associated with the new AP
+    uint32_t last_downtime_ms;      // Last roam: link down to IP address back (DHCP included)
+} net_mgr_roam_stats_t;
+
+esp_err_t net_mgr_get_roam_stats(net_mgr_roam_stats_t* out);
+
+/**
+ * Wi-Fi power profiles: modem sleep, listen interval and TX power together
+ * The configured profile ("wifi/power", loaded at start) is the base one;
+ * while any holder of net_mgr_request_low_latency() remains, the radio is
+ * kept in NET_MGR_POWER_LOW_LATENCY instead.
+ */
+typedef enum {
+    NET_MGR_POWER_LOW_LATENCY = 0,  // No modem sleep, full TX power
+    NET_MGR_POWER_BALANCED,         // Modem sleep on DTIM (IDF default)
+    NET_MGR_POWER_SAVE,             // Wake every listen interval, reduced TX power
+} net_mgr_power_profile_t;
+
+/**
+ * Switch the base profile at runtime (not persisted; store "wifi/power" for that)
+ * The listen interval only changes with the next association.
+ */
+esp_err_t net_mgr_set_power_profile(net_mgr_power_profile_t profile);
+
+/**
+ * Profile in effect: the base one, or LOW_LATENCY while it is requested
+ */
+net_mgr_power_profile_t net_mgr_get_power_profile(void);
+
+/**
+ * Hold the radio awake for latency-sensitive traffic (counted; pair each call
+ * with net_mgr_release_low_latency())
+ */
+void net_mgr_request_low_latency(void);
+void net_mgr_release_low_latency(void);
+
+/**
+ * "low_latency", "balanced" or "power_save"
+ */
+const char* net_mgr_power_profile_name(net_mgr_power_profile_t profile);
+
+/**
+ * Parse a profile name as above; ESP_ERR_INVALID_ARG if unknown
+ */
+esp_err_t net_mgr_power_profile_from_name(const char* name, net_mgr_power_profile_t* out);
+
 /**
  * Test WiFi credentials and commit to NVS only on success
  *
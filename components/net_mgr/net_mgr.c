@@ -5,8 +5,10 @@
 #include "net_mgr.h"
 #include "config_mgr.h"
 #include "event_bus.h"
+#include "diag.h"
 #include "esp_log.h"
 #include "esp_wifi.h"
+#include "esp_mac.h"
 #include "esp_event.h"
 #include "esp_netif.h"
 #include "esp_timer.h"
@@ -16,6 +18,7 @@
 #include "freertos/event_groups.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include <stdlib.h>
 #include <string.h>
 
 static const char *TAG = "net_mgr";
@@ -32,6 +35,9 @@ static esp_netif_t* s_netif = NULL;
 static EventGroupHandle_t s_wifi_event_group = NULL;
 static esp_timer_handle_t s_reconnect_timer = NULL;
 static int s_retry_num = 0;
+static diag_metric_t* s_m_disconnects = NULL;
+static diag_metric_t* s_m_reconnects = NULL;
+static diag_metric_t* s_m_restarts = NULL;
 static bool s_is_connected = false;
 
 // WiFi restart worker task (to avoid blocking timer callback)
@@ -49,6 +55,299 @@ static SemaphoreHandle_t s_cred_staging_mutex = NULL;
 static volatile bool s_cred_staging_active = false;
 static volatile wifi_err_reason_t s_cred_staging_fail_reason = WIFI_REASON_UNSPECIFIED;
 
+/*
+ * Power profiles
+ *
+ * Modem sleep saves most of the radio's power but holds frames for the STA
+ * until its next wake-up, which shows up as 100-300 ms latency spikes on
+ * streaming and the web UI. Each profile sets the sleep mode, how often the
+ * STA wakes for beacons in MAX_MODEM sleep (listen interval, in beacons) and
+ * the TX power cap (0.25 dBm units).
+ *
+ * With BLE enabled the coexistence scheduler requires modem sleep, so
+ * LOW_LATENCY falls back to MIN_MODEM sleep there.
+ */
+typedef struct {
+    wifi_ps_type_t ps;
+    uint16_t listen_interval;
+    int8_t max_tx_power;
+} power_settings_t;
+
+static const power_settings_t s_power_settings[] = {
+    [NET_MGR_POWER_LOW_LATENCY] = { WIFI_PS_NONE,      3,  80 },  // 20 dBm
+    [NET_MGR_POWER_BALANCED]    = { WIFI_PS_MIN_MODEM, 3,  80 },
+    [NET_MGR_POWER_SAVE]        = { WIFI_PS_MAX_MODEM, 10, 60 },  // 15 dBm
+};
+
+static const char* const s_power_names[] = {
+    [NET_MGR_POWER_LOW_LATENCY] = "low_latency",
+    [NET_MGR_POWER_BALANCED]    = "balanced",
+    [NET_MGR_POWER_SAVE]        = "power_save",
+};
+
+#define POWER_PROFILE_COUNT (sizeof(s_power_settings) / sizeof(s_power_settings[0]))
+
+static SemaphoreHandle_t s_power_mutex = NULL;
+static net_mgr_power_profile_t s_power_base = NET_MGR_POWER_BALANCED;
+static net_mgr_power_profile_t s_power_applied = NET_MGR_POWER_BALANCED;
+static bool s_power_applied_valid = false;
+static uint32_t s_low_latency_refs = 0;
+
+static net_mgr_power_profile_t power_effective(void)
+{
+    return s_low_latency_refs > 0 ? NET_MGR_POWER_LOW_LATENCY : s_power_base;
+}
+
+/**
+ * Push the effective profile to the driver if it changed
+ * force: the driver lost its settings (Wi-Fi (re)started). Caller holds s_power_mutex.
+ */
+static void power_apply_locked(bool force)
+{
+    net_mgr_power_profile_t profile = power_effective();
+    if (!force && s_power_applied_valid && profile == s_power_applied) {
+        return;
+    }
+    const power_settings_t* set = &s_power_settings[profile];
+
+    esp_err_t ret = esp_wifi_set_ps(set->ps);
+    if (ret != ESP_OK && set->ps == WIFI_PS_NONE) {
+        ESP_LOGW(TAG, "Modem sleep cannot be disabled (%s), using min modem sleep", esp_err_to_name(ret));
+        ret = esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "esp_wifi_set_ps failed: %s", esp_err_to_name(ret));
+    }
+
+    // Only accepted once the driver is started; STA_START applies it again
+    ret = esp_wifi_set_max_tx_power(set->max_tx_power);
+    if (ret != ESP_OK && ret != ESP_ERR_WIFI_NOT_STARTED) {
+        ESP_LOGW(TAG, "esp_wifi_set_max_tx_power failed: %s", esp_err_to_name(ret));
+    }
+
+    if (!s_power_applied_valid || profile != s_power_applied) {
+        ESP_LOGI(TAG, "Power profile: %s", s_power_names[profile]);
+    }
+    s_power_applied = profile;
+    s_power_applied_valid = true;
+}
+
+static void power_apply(bool force)
+{
+    if (!s_power_mutex) {
+        return;     // Not started yet; net_mgr_start() applies it
+    }
+    xSemaphoreTake(s_power_mutex, portMAX_DELAY);
+    power_apply_locked(force);
+    xSemaphoreGive(s_power_mutex);
+}
+
+// Listen interval for the next association
+static uint16_t power_listen_interval(void)
+{
+    return s_power_settings[power_effective()].listen_interval;
+}
+
+static void power_load(void)
+{
+    uint32_t value = NET_MGR_POWER_BALANCED;
+    if (config_mgr_get_u32("wifi/power", &value) == ESP_OK && value < POWER_PROFILE_COUNT) {
+        s_power_base = (net_mgr_power_profile_t)value;
+    } else {
+        s_power_base = NET_MGR_POWER_BALANCED;
+    }
+}
+
+/*
+ * Known networks
+ *
+ * Slot 0 is the primary network (wifi/ssid, wifi/pass), slots 1.. the extra
+ * ones (wifi/ssid1, wifi/pass1, ...). Only the SSIDs are kept here; the
+ * password is read from config when a network is joined.
+ */
+typedef struct {
+    char ssid[33];
+    uint8_t slot;
+} known_network_t;
+
+static known_network_t s_networks[NET_MGR_MAX_NETWORKS];
+static size_t s_network_count = 0;      // 0 while no primary SSID is configured (provisioning)
+
+static void network_keys(size_t slot, char ssid_key[16], char pass_key[16])
+{
+    if (slot == 0) {
+        strlcpy(ssid_key, "wifi/ssid", 16);
+        strlcpy(pass_key, "wifi/pass", 16);
+    } else {
+        snprintf(ssid_key, 16, "wifi/ssid%u", (unsigned)slot);
+        snprintf(pass_key, 16, "wifi/pass%u", (unsigned)slot);
+    }
+}
+
+static void networks_load(void)
+{
+    size_t count = 0;
+    for (size_t slot = 0; slot < NET_MGR_MAX_NETWORKS; slot++) {
+        char ssid_key[16];
+        char pass_key[16];
+        char ssid[33] = {0};
+        network_keys(slot, ssid_key, pass_key);
+        if (config_mgr_get_string(ssid_key, ssid, sizeof(ssid)) != ESP_OK || ssid[0] == '\0') {
+            if (slot == 0) {
+                break;      // Extra networks only count next to a primary one
+            }
+            continue;
+        }
+        strlcpy(s_networks[count].ssid, ssid, sizeof(s_networks[count].ssid));
+        s_networks[count].slot = (uint8_t)slot;
+        count++;
+    }
+    s_network_count = count;
+}
+
+static const known_network_t* network_find(const char* ssid)
+{
+    for (size_t i = 0; i < s_network_count; i++) {
+        if (strcmp(ssid, s_networks[i].ssid) == 0) {
+            return &s_networks[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * STA config for joining net (SSID, password from config, security and power settings)
+ * The caller clears cfg once it is handed to the driver.
+ */
+static void sta_config_load(const known_network_t* net, wifi_config_t* cfg)
+{
+    char ssid_key[16];
+    char pass_key[16];
+    char pass[65] = {0};
+    network_keys(net->slot, ssid_key, pass_key);
+    if (config_mgr_get_string(pass_key, pass, sizeof(pass)) != ESP_OK) {
+        ESP_LOGW(TAG, "No Wi-Fi password found for %s, using empty password", net->ssid);
+        pass[0] = '\0';
+    }
+
+    memset(cfg, 0, sizeof(*cfg));
+    // A 32-byte SSID or a 64-digit hex key fills the field without a terminator
+    memcpy(cfg->sta.ssid, net->ssid, strnlen(net->ssid, sizeof(cfg->sta.ssid)));
+    memcpy(cfg->sta.password, pass, strnlen(pass, sizeof(cfg->sta.password)));
+    memset(pass, 0, sizeof(pass));
+
+    // Use WPA2 as minimum auth mode (from example)
+    cfg->sta.threshold.authmode = WIFI_AUTH_WPA2_PSK;
+    cfg->sta.pmf_cfg.capable = true;
+    cfg->sta.pmf_cfg.required = false;
+    cfg->sta.listen_interval = power_listen_interval();
+#ifdef CONFIG_NET_MGR_ROAM
+    // Neighbor reports, BSS transition and fast transition where the AP offers them
+    cfg->sta.rm_enabled = 1;
+    cfg->sta.btm_enabled = 1;
+    cfg->sta.ft_enabled = 1;
+#endif
+}
+
+/*
+ * Connect sequence
+ *
+ * The AP of the last successful connection (BSSID and channel, saved as
+ * "wifi/ap_cache") is joined directly, without a scan. If that attempt
+ * fails, or nothing is cached, one active scan picks the strongest AP of
+ * any known network, which is then joined by BSSID. The IP lease is
+ * asked for again on the next boot by lwIP (CONFIG_LWIP_DHCP_RESTORE_LAST_IP):
+ * the server confirms it, or a normal DHCP exchange follows.
+ *
+ * Each phase is timed for the wifi_connect_*_ms metrics. The driver does
+ * authentication, association and the key handshake in one step, so they
+ * are reported together as "assoc".
+ */
+#define AP_CACHE_VERSION 1
+#define SCAN_MAX_RECORDS 20
+
+typedef struct {
+    uint8_t version;
+    uint8_t channel;
+    uint8_t bssid[6];
+    char ssid[33];
+} ap_cache_t;
+
+typedef enum {
+    CONNECT_IDLE = 0,
+    CONNECT_SCANNING,
+    CONNECT_ASSOC,          // esp_wifi_connect() until STA_CONNECTED
+    CONNECT_DHCP,           // STA_CONNECTED until GOT_IP
+} connect_phase_t;
+
+static ap_cache_t s_ap_cache;
+static bool s_ap_cache_valid = false;
+static bool s_fast_failed = false;      // The cached AP failed since the last connection
+static bool s_fast_attempt = false;     // The attempt in progress skipped the scan
+static connect_phase_t s_phase = CONNECT_IDLE;
+static int64_t s_connect_start_us = 0;
+static int64_t s_phase_start_us = 0;
+static uint32_t s_scan_ms = 0;
+static uint32_t s_assoc_ms = 0;
+static diag_metric_t* s_m_fast_hits = NULL;
+static diag_metric_t* s_m_fast_misses = NULL;
+static diag_metric_t* s_m_scan_ms = NULL;
+static diag_metric_t* s_m_assoc_ms = NULL;
+static diag_metric_t* s_m_dhcp_ms = NULL;
+static diag_metric_t* s_m_connect_ms = NULL;
+
+/*
+ * Roaming
+ *
+ * While connected the RSSI is sampled every ROAM_CHECK_MS. Below
+ * CONFIG_NET_MGR_ROAM_RSSI, and at most once per
+ * CONFIG_NET_MGR_ROAM_SCAN_INTERVAL_S, a background scan looks for the
+ * known networks. It returns to the home channel between channels, so no
+ * gap in traffic is longer than one channel's dwell time. An AP at least
+ * CONFIG_NET_MGR_ROAM_DELTA dB stronger is joined by BSSID right away.
+ *
+ * A roam does not go through NET_LOST/NET_READY, so listeners keep their
+ * sockets and timers. The address does not survive it, though: on
+ * STA_DISCONNECTED IDF takes the netif down, and sends fail until DHCP
+ * (normally a quick renewal of the same lease) brings GOT_IP. The roam
+ * is therefore timed in two phases, link down to associated with the new
+ * AP (802.11r fast transition where the AP supports it) and link down to
+ * the address being back; the latter is the downtime reported.
+ * NET_READY follows only if DHCP hands out a different address. Moves the
+ * AP requests (802.11v BSS transition) are made by the supplicant itself
+ * and are timed the same way.
+ */
+#define ROAM_CHECK_MS       2000    // RSSI sampling period
+#define ROAM_SCAN_DWELL_MS  30      // Per channel, off the home channel
+#define ROAM_HOME_DWELL_MS  60      // Back on the home channel between channels
+
+typedef enum {
+    ROAM_IDLE = 0,
+    ROAM_SCANNING,          // Background scan, still connected
+    ROAM_LEAVING,           // esp_wifi_disconnect() from the current AP
+    ROAM_JOINING,           // Until STA_CONNECTED to the new AP
+} roam_state_t;
+
+static roam_state_t s_roam_state = ROAM_IDLE;
+static bool s_roamed = false;                   // Link is back through a roam; NET_LOST was not posted
+#ifdef CONFIG_NET_MGR_ROAM
+static esp_timer_handle_t s_roam_timer = NULL;
+static int64_t s_roam_scan_us = 0;              // Last background scan
+#endif
+static int64_t s_roam_start_us = 0;             // Link to the old AP given up
+static uint32_t s_roam_assoc_ms = 0;            // Link down to associated, current roam
+static const known_network_t* s_roam_net = NULL;
+static uint8_t s_roam_bssid[6];
+static uint8_t s_roam_channel = 0;
+static net_mgr_roam_stats_t s_roam_stats;
+static diag_metric_t* s_m_roams = NULL;
+static diag_metric_t* s_m_roam_fails = NULL;
+static diag_metric_t* s_m_roam_scans = NULL;
+static diag_metric_t* s_m_roam_downtime = NULL;
+static const uint32_t s_roam_downtime_bounds[] = { 25, 50, 100, 200, 500, 1000, 5000 };
+
+static void schedule_reconnect(void);
+
 /**
  * WiFi restart worker task
  * Handles blocking WiFi stop/restart operations outside of timer context
@@ -65,6 +364,8 @@ static void wifi_restart_task(void* arg)
         if (xQueueReceive(s_restart_queue, &trigger, portMAX_DELAY) == pdTRUE) {
             ESP_LOGW(TAG, "Executing WiFi restart in worker task");
 
+            diag_metric_inc(s_m_restarts);
+
             // Stop WiFi - log but continue if it fails (may already be stopped)
             esp_err_t ret = esp_wifi_stop();
             if (ret != ESP_OK && ret != ESP_ERR_WIFI_NOT_STARTED) {
@@ -109,6 +410,360 @@ static void wifi_restart_task(void* arg)
     }
 }
 
+// Milliseconds in the current phase; starts the next one
+static uint32_t phase_end(connect_phase_t next)
+{
+    int64_t now = esp_timer_get_time();
+    uint32_t ms = (uint32_t)((now - s_phase_start_us) / 1000);
+    s_phase_start_us = now;
+    s_phase = next;
+    return ms;
+}
+
+// Join one AP of net by BSSID on its channel (no scan)
+static void connect_to(const known_network_t* net, const uint8_t bssid[6], uint8_t channel)
+{
+    wifi_config_t cfg;
+    sta_config_load(net, &cfg);
+    memcpy(cfg.sta.bssid, bssid, sizeof(cfg.sta.bssid));
+    cfg.sta.bssid_set = true;
+    cfg.sta.channel = channel;
+    esp_err_t ret = esp_wifi_set_config(WIFI_IF_STA, &cfg);
+    memset(&cfg, 0, sizeof(cfg));  // Clear password
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to pin BSSID: %s", esp_err_to_name(ret));
+    }
+
+    phase_end(CONNECT_ASSOC);
+    ret = esp_wifi_connect();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "esp_wifi_connect failed: %s", esp_err_to_name(ret));
+    }
+}
+
+/**
+ * Start a connection: cached AP first, otherwise scan (see "Connect sequence")
+ * Non-blocking; safe from the event and timer tasks
+ */
+static void connect_start(void)
+{
+    if (s_cred_staging_active || s_network_count == 0) {
+        // Credential staging drives its own config; no SSID means provisioning
+        esp_wifi_connect();
+        return;
+    }
+
+    s_connect_start_us = esp_timer_get_time();
+    s_phase_start_us = s_connect_start_us;
+    s_scan_ms = 0;
+    s_fast_attempt = false;
+
+#ifdef CONFIG_NET_MGR_FAST_CONNECT
+    const known_network_t* cached = s_ap_cache_valid ? network_find(s_ap_cache.ssid) : NULL;
+    if (cached && !s_fast_failed) {
+        ESP_LOGI(TAG, "Connecting to cached AP " MACSTR " on channel %u",
+                 MAC2STR(s_ap_cache.bssid), s_ap_cache.channel);
+        s_fast_attempt = true;
+        connect_to(cached, s_ap_cache.bssid, s_ap_cache.channel);
+        return;
+    }
+#endif
+
+    // With a single network only its APs need to answer
+    wifi_scan_config_t scan = {
+        .ssid = s_network_count == 1 ? (uint8_t*)s_networks[0].ssid : NULL,
+        .show_hidden = true,
+        .scan_type = WIFI_SCAN_TYPE_ACTIVE,
+    };
+    s_phase = CONNECT_SCANNING;
+    esp_err_t ret = esp_wifi_scan_start(&scan, false);
+    if (ret != ESP_OK) {
+        // Fall back to the driver's own scan for the primary network
+        ESP_LOGW(TAG, "Scan failed to start: %s", esp_err_to_name(ret));
+        wifi_config_t cfg;
+        sta_config_load(&s_networks[0], &cfg);
+        esp_wifi_set_config(WIFI_IF_STA, &cfg);
+        memset(&cfg, 0, sizeof(cfg));  // Clear password
+        s_phase = CONNECT_ASSOC;
+        esp_wifi_connect();
+    }
+}
+
+/**
+ * Strongest AP of a known network in the scan results (releases them)
+ * exclude (may be NULL) is skipped: the current AP when roaming.
+ */
+static const known_network_t* scan_pick(const uint8_t* exclude, wifi_ap_record_t* best, uint16_t* seen)
+{
+    uint16_t count = 0;
+    esp_wifi_scan_get_ap_num(&count);
+    if (count > SCAN_MAX_RECORDS) {
+        count = SCAN_MAX_RECORDS;
+    }
+    *seen = 0;
+
+    wifi_ap_record_t* aps = count ? diag_mem_calloc(DIAG_MEM_NET, count, sizeof(*aps)) : NULL;
+    if (aps == NULL) {
+        esp_wifi_clear_ap_list();
+        return NULL;
+    }
+
+    const known_network_t* net = NULL;
+    if (esp_wifi_scan_get_ap_records(&count, aps) == ESP_OK) {
+        *seen = count;
+        for (int i = 0; i < count; i++) {
+            if (exclude && memcmp(aps[i].bssid, exclude, sizeof(aps[i].bssid)) == 0) {
+                continue;
+            }
+            const known_network_t* n = network_find((const char*)aps[i].ssid);
+            if (n && (!net || aps[i].rssi > best->rssi)) {
+                net = n;
+                *best = aps[i];
+            }
+        }
+    }
+    diag_mem_free(aps);
+    return net;
+}
+
+/**
+ * Scan finished: join the strongest AP that carries the SSID
+ */
+static void connect_scan_done(void)
+{
+    if (s_phase != CONNECT_SCANNING) {
+        return;     // Not our scan
+    }
+    s_scan_ms = phase_end(CONNECT_SCANNING);
+
+    wifi_ap_record_t ap;
+    uint16_t seen = 0;
+    const known_network_t* net = scan_pick(NULL, &ap, &seen);
+    if (net == NULL) {
+        ESP_LOGW(TAG, "No configured SSID found (%u AP(s), scan took %lu ms)", seen, s_scan_ms);
+        s_phase = CONNECT_IDLE;
+        schedule_reconnect();
+        return;
+    }
+
+    ESP_LOGI(TAG, "Scan found %u AP(s) in %lu ms, joining %s " MACSTR " (channel %u, %d dBm)",
+             seen, s_scan_ms, net->ssid, MAC2STR(ap.bssid), ap.primary, ap.rssi);
+    connect_to(net, ap.bssid, ap.primary);
+}
+
+// GOT_IP: record the timings and remember the AP for the next boot
+static void connect_done(void)
+{
+    if (s_phase != CONNECT_DHCP) {
+        s_phase = CONNECT_IDLE;
+        return;     // Not started by connect_start() (e.g. credential staging)
+    }
+    uint32_t dhcp_ms = phase_end(CONNECT_IDLE);
+    uint32_t total_ms = (uint32_t)((esp_timer_get_time() - s_connect_start_us) / 1000);
+
+    ESP_LOGI(TAG, "Connected in %lu ms (%s, scan %lu, assoc %lu, dhcp %lu)", total_ms,
+             s_fast_attempt ? "cached AP" : "scanned", s_scan_ms, s_assoc_ms, dhcp_ms);
+    diag_metric_set(s_m_scan_ms, (int32_t)s_scan_ms);
+    diag_metric_set(s_m_assoc_ms, (int32_t)s_assoc_ms);
+    diag_metric_set(s_m_dhcp_ms, (int32_t)dhcp_ms);
+    diag_metric_set(s_m_connect_ms, (int32_t)total_ms);
+    if (s_fast_attempt) {
+        diag_metric_inc(s_m_fast_hits);
+    }
+    s_fast_failed = false;
+
+    wifi_ap_record_t ap;
+    wifi_config_t cfg;
+    if (esp_wifi_sta_get_ap_info(&ap) != ESP_OK || esp_wifi_get_config(WIFI_IF_STA, &cfg) != ESP_OK) {
+        return;
+    }
+    ap_cache_t cache = {
+        .version = AP_CACHE_VERSION,
+        .channel = ap.primary,
+    };
+    memcpy(cache.bssid, ap.bssid, sizeof(cache.bssid));
+    memcpy(cache.ssid, cfg.sta.ssid, sizeof(cfg.sta.ssid));
+    memset(&cfg, 0, sizeof(cfg));  // Clear password
+
+    // Only write flash when the AP changed
+    if (!s_ap_cache_valid || memcmp(&cache, &s_ap_cache, sizeof(cache)) != 0) {
+        if (config_mgr_set_blob("wifi/ap_cache", &cache, sizeof(cache)) == ESP_OK) {
+            s_ap_cache = cache;
+            s_ap_cache_valid = true;
+        }
+    }
+}
+
+static void ap_cache_load(void)
+{
+    size_t len = sizeof(s_ap_cache);
+    s_ap_cache_valid = config_mgr_get_blob("wifi/ap_cache", &s_ap_cache, &len) == ESP_OK &&
+                       len == sizeof(s_ap_cache) && s_ap_cache.version == AP_CACHE_VERSION &&
+                       s_ap_cache.channel != 0;
+    s_ap_cache.ssid[sizeof(s_ap_cache.ssid) - 1] = '\0';
+}
+
+#ifdef CONFIG_NET_MGR_ROAM
+/**
+ * Roam check: start a background scan while the signal is weak
+ * Runs in timer task context - must not block!
+ */
+static void roam_timer_callback(void* arg)
+{
+    (void)arg;
+    int rssi = 0;
+    if (!s_is_connected || s_cred_staging_active || s_phase != CONNECT_IDLE || s_roam_state != ROAM_IDLE ||
+        net_mgr_get_rssi(&rssi) != 0 || rssi >= CONFIG_NET_MGR_ROAM_RSSI) {
+        return;
+    }
+    int64_t now = esp_timer_get_time();
+    if (s_roam_scan_us != 0 && now - s_roam_scan_us < (int64_t)CONFIG_NET_MGR_ROAM_SCAN_INTERVAL_S * 1000000) {
+        return;
+    }
+    s_roam_scan_us = now;
+
+    wifi_scan_config_t scan = {
+        .ssid = s_network_count == 1 ? (uint8_t*)s_networks[0].ssid : NULL,
+        .scan_type = WIFI_SCAN_TYPE_ACTIVE,
+        .scan_time.active = { .min = ROAM_SCAN_DWELL_MS / 2, .max = ROAM_SCAN_DWELL_MS },
+        .home_chan_dwell_time = ROAM_HOME_DWELL_MS,
+    };
+    s_roam_state = ROAM_SCANNING;
+    esp_err_t ret = esp_wifi_scan_start(&scan, false);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Roam scan failed to start: %s", esp_err_to_name(ret));
+        s_roam_state = ROAM_IDLE;
+        return;
+    }
+    ESP_LOGI(TAG, "RSSI %d dBm, scanning for a stronger AP", rssi);
+    s_roam_stats.scans++;
+    diag_metric_inc(s_m_roam_scans);
+}
+
+/**
+ * Background scan finished: move to a clearly stronger AP if there is one
+ */
+static void roam_scan_done(void)
+{
+    s_roam_state = ROAM_IDLE;
+
+    wifi_ap_record_t cur;
+    if (!s_is_connected || esp_wifi_sta_get_ap_info(&cur) != ESP_OK) {
+        esp_wifi_clear_ap_list();
+        return;
+    }
+
+    wifi_ap_record_t ap;
+    uint16_t seen = 0;
+    const known_network_t* net = scan_pick(cur.bssid, &ap, &seen);
+    if (net == NULL || ap.rssi < cur.rssi + CONFIG_NET_MGR_ROAM_DELTA) {
+        ESP_LOGI(TAG, "No AP %d dB stronger than the current one (%d dBm, %u AP(s) seen)",
+                 CONFIG_NET_MGR_ROAM_DELTA, cur.rssi, seen);
+        return;
+    }
+
+    ESP_LOGI(TAG, "Roaming from " MACSTR " (%d dBm) to %s " MACSTR " (channel %u, %d dBm)",
+             MAC2STR(cur.bssid), cur.rssi, net->ssid, MAC2STR(ap.bssid), ap.primary, ap.rssi);
+    s_roam_net = net;
+    memcpy(s_roam_bssid, ap.bssid, sizeof(s_roam_bssid));
+    s_roam_channel = ap.primary;
+    s_roam_start_us = esp_timer_get_time();
+
+    // The target is joined from the DISCONNECTED event
+    s_roam_state = ROAM_LEAVING;
+    if (esp_wifi_disconnect() != ESP_OK) {
+        s_roam_state = ROAM_IDLE;
+    }
+}
+#endif
+
+// STA_CONNECTED after a roam: associated, the address is not back yet
+static void roam_linked(void)
+{
+    s_roam_assoc_ms = (uint32_t)((esp_timer_get_time() - s_roam_start_us) / 1000);
+}
+
+// GOT_IP after a roam: traffic flows again
+static void roam_done(void)
+{
+    uint32_t ms = (uint32_t)((esp_timer_get_time() - s_roam_start_us) / 1000);
+    s_roam_state = ROAM_IDLE;
+    s_roamed = true;
+    s_roam_stats.roams++;
+    s_roam_stats.last_assoc_ms = s_roam_assoc_ms;
+    s_roam_stats.last_downtime_ms = ms;
+    diag_metric_inc(s_m_roams);
+    diag_metric_observe(s_m_roam_downtime, (int32_t)ms);
+    ESP_LOGI(TAG, "Roamed, associated after %lu ms, address back after %lu ms", s_roam_assoc_ms, ms);
+}
+
+/*
+ * NET_READY/NET_LOST delivery
+ *
+ * The Wi-Fi handler waits at most NET_EDGE_POST_MS for room on the event
+ * bus. A post that still fails becomes the pending edge and is re-posted
+ * from a timer until it goes through; a newer edge replaces it, since
+ * listeners only need the latest state. s_edge_mutex keeps a retry from
+ * landing after the edge that replaced it.
+ */
+#define NET_EDGE_POST_MS  100
+#define NET_EDGE_RETRY_MS 250
+
+static esp_timer_handle_t s_edge_timer = NULL;
+static SemaphoreHandle_t s_edge_mutex = NULL;
+static int32_t s_pending_edge = -1;             // Undelivered DEVICE_EVENT id, -1: none
+static diag_metric_t* s_m_edge_retries = NULL;
+
+static void edge_retry_arm(void)
+{
+    if (s_edge_timer && !esp_timer_is_active(s_edge_timer)) {
+        esp_timer_start_once(s_edge_timer, NET_EDGE_RETRY_MS * 1000ULL);
+    }
+}
+
+/**
+ * Post a link edge from the Wi-Fi handler; keeps it for the retry timer
+ * if the bus stays full
+ */
+static void post_edge(int32_t id)
+{
+    xSemaphoreTake(s_edge_mutex, portMAX_DELAY);
+    s_pending_edge = -1;
+    if (event_bus_post(DEVICE_EVENT, id, NULL, 0, pdMS_TO_TICKS(NET_EDGE_POST_MS)) != ESP_OK) {
+        ESP_LOGW(TAG, "%s not delivered (event bus full), retrying",
+                 id == DEVICE_EVENT_NET_READY ? "NET_READY" : "NET_LOST");
+        s_pending_edge = id;
+        edge_retry_arm();
+    }
+    xSemaphoreGive(s_edge_mutex);
+}
+
+/**
+ * Timer callback re-posting the pending edge
+ * Runs in timer task context - must not block!
+ */
+static void edge_timer_callback(void* arg)
+{
+    (void)arg;
+
+    // The Wi-Fi handler is posting a newer edge; check again later
+    if (xSemaphoreTake(s_edge_mutex, 0) != pdTRUE) {
+        edge_retry_arm();
+        return;
+    }
+    if (s_pending_edge >= 0) {
+        diag_metric_inc(s_m_edge_retries);
+        if (event_bus_post(DEVICE_EVENT, s_pending_edge, NULL, 0, 0) == ESP_OK) {
+            ESP_LOGI(TAG, "%s delivered on retry",
+                     s_pending_edge == DEVICE_EVENT_NET_READY ? "NET_READY" : "NET_LOST");
+            s_pending_edge = -1;
+        } else {
+            edge_retry_arm();
+        }
+    }
+    xSemaphoreGive(s_edge_mutex);
+}
+
 /**
  * Timer callback for reconnection attempts
  * Runs in timer task context - must not block!
@@ -133,10 +788,8 @@ static void reconnect_timer_callback(void* arg)
     }
 
     ESP_LOGI(TAG, "Attempting reconnection (retry %d/%d)", s_retry_num + 1, MAX_RETRY_BEFORE_RESTART);
-    esp_err_t ret = esp_wifi_connect();
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "esp_wifi_connect failed: %s", esp_err_to_name(ret));
-    }
+    diag_metric_inc(s_m_reconnects);
+    connect_start();
 
     // Increment retry counter for next backoff calculation
     s_retry_num++;
@@ -186,18 +839,88 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
 {
     if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
         ESP_LOGI(TAG, "Wi-Fi STA started, connecting...");
-        esp_wifi_connect();
+        power_apply(true);
+        connect_start();
+
+    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_SCAN_DONE) {
+#ifdef CONFIG_NET_MGR_ROAM
+        if (s_roam_state == ROAM_SCANNING) {
+            roam_scan_done();
+            return;
+        }
+#endif
+        connect_scan_done();
+
+    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_CONNECTED) {
+        if (s_phase == CONNECT_ASSOC) {
+            s_assoc_ms = phase_end(CONNECT_DHCP);
+        }
+        if (s_roam_state == ROAM_JOINING) {
+            roam_linked();
+        }
 
     } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
+        wifi_event_sta_disconnected_t* event = (wifi_event_sta_disconnected_t*) event_data;
         s_is_connected = false;
+        s_roamed = false;
+
+        // Roaming (see "Roaming"): no NET_LOST unless the new AP fails
+        if (s_roam_state == ROAM_LEAVING) {
+            s_roam_state = ROAM_JOINING;
+            s_connect_start_us = s_roam_start_us;
+            s_phase_start_us = esp_timer_get_time();
+            s_scan_ms = 0;
+            s_fast_attempt = false;
+            connect_to(s_roam_net, s_roam_bssid, s_roam_channel);
+            return;
+        }
+        if (s_roam_state == ROAM_SCANNING) {
+            s_roam_state = ROAM_IDLE;
+            esp_wifi_scan_stop();
+        }
+        if (event->reason == WIFI_REASON_ROAMING && !s_cred_staging_active) {
+            // The supplicant moves to the AP named in a BSS transition request
+            ESP_LOGI(TAG, "AP requested a move, roaming");
+            s_roam_state = ROAM_JOINING;
+            s_roam_start_us = esp_timer_get_time();
+            s_phase = CONNECT_IDLE;
+            return;
+        }
+        if (s_roam_state == ROAM_JOINING) {
+            ESP_LOGW(TAG, "Roam failed (reason %d), reconnecting", event->reason);
+            s_roam_state = ROAM_IDLE;
+            s_roam_stats.failed++;
+            diag_metric_inc(s_m_roam_fails);
+        }
 
-        // Post NET_LOST event with timeout to avoid blocking Wi-Fi task
-        // If queue is full, event is dropped (non-critical for reconnection logic)
-        event_bus_post(DEVICE_EVENT, DEVICE_EVENT_NET_LOST, NULL, 0, pdMS_TO_TICKS(100));
+        // The cached AP did not work out (moved, gone or changed channel):
+        // scan right away instead of backing off
+        bool fast_failed = s_fast_attempt && (s_phase == CONNECT_ASSOC || s_phase == CONNECT_DHCP);
+        bool scanning = s_phase == CONNECT_SCANNING;
+        if (!scanning) {
+            s_phase = CONNECT_IDLE;
+            s_fast_attempt = false;
+        }
+        if (fast_failed && !s_cred_staging_active) {
+            ESP_LOGI(TAG, "Cached AP not reachable, scanning");
+            s_fast_failed = true;
+            diag_metric_inc(s_m_fast_misses);
+            connect_start();
+            return;
+        }
+
+        diag_metric_inc(s_m_disconnects);
+
+        // Post NET_LOST with a bounded wait to avoid blocking the Wi-Fi task
+        // (retried from a timer if the bus stays full)
+        post_edge(DEVICE_EVENT_NET_LOST);
 
         // Schedule reconnection with exponential backoff (non-blocking)
-        // Continues indefinitely with backoff capped at 60s
-        schedule_reconnect();
+        // Continues indefinitely with backoff capped at 60s. A scan in
+        // flight (net_mgr_reconnect) connects or reschedules by itself.
+        if (!scanning) {
+            schedule_reconnect();
+        }
 
     } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
         ip_event_got_ip_t* event = (ip_event_got_ip_t*) event_data;
@@ -208,13 +931,25 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
             esp_timer_stop(s_reconnect_timer);
         }
 
+        connect_done();
+        if (s_roam_state == ROAM_JOINING) {
+            roam_done();
+        }
+
         // Reset retry counter on successful connection
         s_retry_num = 0;
         s_is_connected = true;
         xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
 
-        // Post NET_READY event with timeout to avoid blocking Wi-Fi task
-        event_bus_post(DEVICE_EVENT, DEVICE_EVENT_NET_READY, NULL, 0, pdMS_TO_TICKS(100));
+        // After a roam, listeners only need to hear about a new address
+        bool roamed = s_roamed;
+        s_roamed = false;
+        if (roamed && !event->ip_changed) {
+            return;
+        }
+
+        // Post NET_READY with a bounded wait to avoid blocking the Wi-Fi task
+        post_edge(DEVICE_EVENT_NET_READY);
     }
 }
 
@@ -254,10 +989,55 @@ static void cred_staging_event_handler(void* arg, esp_event_base_t event_base,
     }
 }
 
+static int64_t read_retry_num(void* ctx)
+{
+    (void)ctx;
+    return s_retry_num;
+}
+
+static int64_t read_connected(void* ctx)
+{
+    (void)ctx;
+    return s_is_connected ? 1 : 0;
+}
+
+static int64_t read_power_profile(void* ctx)
+{
+    (void)ctx;
+    return power_effective();
+}
+
 esp_err_t net_mgr_start(void)
 {
     esp_err_t ret;
 
+    if (!s_m_disconnects) {
+        s_m_disconnects = diag_metric_counter("wifi_disconnects_total", "STA disconnect events");
+        s_m_reconnects = diag_metric_counter("wifi_reconnect_attempts_total", "Backoff reconnect attempts");
+        s_m_restarts = diag_metric_counter("wifi_restarts_total", "Full Wi-Fi stop/start cycles after max retries");
+        diag_metric_gauge_fn("wifi_retry_count", "Current consecutive reconnect attempts", read_retry_num, NULL);
+        diag_metric_gauge_fn("wifi_connected", "1 while the STA has an IP", read_connected, NULL);
+        diag_metric_gauge_fn("wifi_power_profile", "Power profile in effect (0 low latency, 1 balanced, 2 power save)",
+                             read_power_profile, NULL);
+        s_m_fast_hits = diag_metric_counter("wifi_fast_connect_total{result=\"hit\"}",
+                                            "Connections made to the cached AP without a scan");
+        s_m_fast_misses = diag_metric_counter("wifi_fast_connect_total{result=\"miss\"}",
+                                              "Cached AP attempts that fell back to a scan");
+        s_m_scan_ms = diag_metric_gauge("wifi_connect_scan_ms", "Last connection: SSID scan (0 if the cached AP was used)");
+        s_m_assoc_ms = diag_metric_gauge("wifi_connect_assoc_ms", "Last connection: authentication, association and key handshake");
+        s_m_dhcp_ms = diag_metric_gauge("wifi_connect_dhcp_ms", "Last connection: link up to IP address");
+        s_m_connect_ms = diag_metric_gauge("wifi_connect_ms", "Last connection: connect started to IP address");
+        s_m_roams = diag_metric_counter("wifi_roams_total{result=\"ok\"}", "Moves to another AP without NET_LOST");
+        s_m_roam_fails = diag_metric_counter("wifi_roams_total{result=\"failed\"}",
+                                             "Roam targets not joined (fell back to a reconnect)");
+        s_m_roam_scans = diag_metric_counter("wifi_roam_scans_total", "Background scans on low RSSI");
+        s_m_edge_retries = diag_metric_counter("wifi_event_post_retries_total",
+                                               "NET_READY/NET_LOST re-posts after the event bus was full");
+        s_m_roam_downtime = diag_metric_histogram("wifi_roam_downtime_ms", "Link down to IP address back, per roam",
+                                                  s_roam_downtime_bounds,
+                                                  sizeof(s_roam_downtime_bounds) / sizeof(s_roam_downtime_bounds[0]));
+    }
+
     // Create event group
     if (!s_wifi_event_group) {
         s_wifi_event_group = xEventGroupCreate();
@@ -305,6 +1085,52 @@ esp_err_t net_mgr_start(void)
         }
     }
 
+    // Link edge retry (see "NET_READY/NET_LOST delivery")
+    if (!s_edge_mutex) {
+        s_edge_mutex = xSemaphoreCreateMutex();
+        if (!s_edge_mutex) {
+            ESP_LOGE(TAG, "Failed to create event post mutex");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if (!s_edge_timer) {
+        esp_timer_create_args_t timer_args = {
+            .callback = &edge_timer_callback,
+            .name = "net_edge"
+        };
+        ret = esp_timer_create(&timer_args, &s_edge_timer);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create event retry timer: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+
+    if (!s_power_mutex) {
+        s_power_mutex = xSemaphoreCreateMutex();
+        if (!s_power_mutex) {
+            ESP_LOGE(TAG, "Failed to create power profile mutex");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+#ifdef CONFIG_NET_MGR_ROAM
+    // Roam check timer (runs while connected, see "Roaming")
+    if (!s_roam_timer) {
+        esp_timer_create_args_t timer_args = {
+            .callback = &roam_timer_callback,
+            .name = "net_roam"
+        };
+        ret = esp_timer_create(&timer_args, &s_roam_timer);
+        if (ret == ESP_OK) {
+            ret = esp_timer_start_periodic(s_roam_timer, ROAM_CHECK_MS * 1000ULL);
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to start roam timer: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+#endif
+
     // Create staging mutex
     if (!s_cred_staging_mutex) {
         s_cred_staging_mutex = xSemaphoreCreateMutex();
@@ -331,6 +1157,9 @@ esp_err_t net_mgr_start(void)
         return ret;
     }
 
+    power_load();
+    power_apply(true);
+
     // Register event handlers (adapted from example)
     ret = esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_event_handler, NULL);
     if (ret != ESP_OK) {
@@ -345,11 +1174,8 @@ esp_err_t net_mgr_start(void)
     }
 
     // Load Wi-Fi credentials from config_mgr (CLAUDE_TASKS.md requirement)
-    char ssid[32] = {0};
-    char password[64] = {0};
-
-    ret = config_mgr_get_string("wifi/ssid", ssid, sizeof(ssid));
-    if (ret != ESP_OK || strlen(ssid) == 0) {
+    networks_load();
+    if (s_network_count == 0) {
         ESP_LOGW(TAG, "No Wi-Fi SSID configured, skipping connection");
         ESP_LOGI(TAG, "Set Wi-Fi mode to STA for provisioning readiness");
 
@@ -361,29 +1187,22 @@ esp_err_t net_mgr_start(void)
         return ret;
     }
 
-    ret = config_mgr_get_string("wifi/pass", password, sizeof(password));
-    if (ret != ESP_OK) {
-        ESP_LOGW(TAG, "No Wi-Fi password found, using empty password");
-        password[0] = '\0';
-    }
+    ap_cache_load();
 
     // Configure Wi-Fi (adapted from example wifi_config_t setup)
-    wifi_config_t wifi_config = {0};
-    strlcpy((char*)wifi_config.sta.ssid, ssid, sizeof(wifi_config.sta.ssid));
-    strlcpy((char*)wifi_config.sta.password, password, sizeof(wifi_config.sta.password));
-
-    // Use WPA2 as minimum auth mode (from example)
-    wifi_config.sta.threshold.authmode = WIFI_AUTH_WPA2_PSK;
-    wifi_config.sta.pmf_cfg.capable = true;
-    wifi_config.sta.pmf_cfg.required = false;
+    wifi_config_t wifi_config;
+    sta_config_load(&s_networks[0], &wifi_config);
 
     ret = esp_wifi_set_mode(WIFI_MODE_STA);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "esp_wifi_set_mode failed: %s", esp_err_to_name(ret));
+        memset(&wifi_config, 0, sizeof(wifi_config));
         return ret;
     }
 
     ret = esp_wifi_set_config(WIFI_IF_STA, &wifi_config);
+    // Clear password from stack memory (security best practice)
+    memset(&wifi_config, 0, sizeof(wifi_config));
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "esp_wifi_set_config failed: %s", esp_err_to_name(ret));
         return ret;
@@ -395,10 +1214,8 @@ esp_err_t net_mgr_start(void)
         return ret;
     }
 
-    ESP_LOGI(TAG, "Network manager started, connecting to SSID: %s", ssid);
-
-    // Clear password from stack memory (security best practice)
-    memset(password, 0, sizeof(password));
+    ESP_LOGI(TAG, "Network manager started, connecting to SSID: %s (%u known network(s))",
+             s_networks[0].ssid, (unsigned)s_network_count);
 
     return ESP_OK;
 }
@@ -408,63 +1225,189 @@ esp_err_t net_mgr_reconnect(void)
     ESP_LOGI(TAG, "Reconnecting with new credentials");
 
     // Load new credentials from config_mgr
-    char ssid[32] = {0};
-    char password[64] = {0};
-
-    esp_err_t ret = config_mgr_get_string("wifi/ssid", ssid, sizeof(ssid));
-    if (ret != ESP_OK || strlen(ssid) == 0) {
+    networks_load();
+    if (s_network_count == 0) {
         ESP_LOGE(TAG, "No Wi-Fi SSID configured for reconnect");
         return ESP_ERR_INVALID_STATE;
     }
 
-    ret = config_mgr_get_string("wifi/pass", password, sizeof(password));
-    if (ret != ESP_OK) {
-        ESP_LOGW(TAG, "No Wi-Fi password found, using empty password");
-        password[0] = '\0';
-    }
-
-    // Disconnect from current network
+    // Disconnect from current network (a roam in progress is dropped)
     ESP_LOGI(TAG, "Disconnecting from current network");
-    ret = esp_wifi_disconnect();
+    s_roam_state = ROAM_IDLE;
+    esp_err_t ret = esp_wifi_disconnect();
     if (ret != ESP_OK && ret != ESP_ERR_WIFI_NOT_STARTED && ret != ESP_ERR_WIFI_NOT_CONNECT) {
         ESP_LOGW(TAG, "esp_wifi_disconnect warning: %s", esp_err_to_name(ret));
         // Continue anyway - might not be connected
     }
 
     // Configure new Wi-Fi credentials
-    wifi_config_t wifi_config = {0};
-    strlcpy((char*)wifi_config.sta.ssid, ssid, sizeof(wifi_config.sta.ssid));
-    strlcpy((char*)wifi_config.sta.password, password, sizeof(wifi_config.sta.password));
-
-    // Use WPA2 as minimum auth mode
-    wifi_config.sta.threshold.authmode = WIFI_AUTH_WPA2_PSK;
-    wifi_config.sta.pmf_cfg.capable = true;
-    wifi_config.sta.pmf_cfg.required = false;
-
+    wifi_config_t wifi_config;
+    sta_config_load(&s_networks[0], &wifi_config);
     ret = esp_wifi_set_config(WIFI_IF_STA, &wifi_config);
+
+    // Clear password from stack memory
+    memset(&wifi_config, 0, sizeof(wifi_config));
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "esp_wifi_set_config failed: %s", esp_err_to_name(ret));
-        memset(password, 0, sizeof(password));
         return ret;
     }
 
-    // Clear password from stack memory
-    memset(password, 0, sizeof(password));
-
     // Reset retry counter for new connection attempt
     s_retry_num = 0;
 
-    // Reconnect with new credentials
-    ESP_LOGI(TAG, "Connecting to new SSID: %s", ssid);
-    ret = esp_wifi_connect();
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "esp_wifi_connect failed: %s", esp_err_to_name(ret));
-        return ret;
+    // Reconnect with new credentials (the cached AP only applies to its own SSID)
+    ESP_LOGI(TAG, "Connecting to new SSID: %s", s_networks[0].ssid);
+    s_fast_failed = false;
+    connect_start();
+
+    return ESP_OK;
+}
+
+esp_err_t net_mgr_get_networks(net_mgr_network_t* out, size_t max, size_t* count)
+{
+    if (!out || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *count = 0;
+    for (size_t slot = 1; slot < NET_MGR_MAX_NETWORKS && *count < max; slot++) {
+        char ssid_key[16];
+        char pass_key[16];
+        net_mgr_network_t* n = &out[*count];
+        network_keys(slot, ssid_key, pass_key);
+        memset(n, 0, sizeof(*n));
+        if (config_mgr_get_string(ssid_key, n->ssid, sizeof(n->ssid)) != ESP_OK || n->ssid[0] == '\0') {
+            continue;
+        }
+        config_mgr_get_string(pass_key, n->pass, sizeof(n->pass));
+        (*count)++;
+    }
+    return ESP_OK;
+}
+
+esp_err_t net_mgr_txn_set_networks(config_mgr_txn_t* txn, const net_mgr_network_t* nets, size_t count)
+{
+    if (!txn || (count > 0 && !nets) || count > NET_MGR_MAX_NETWORKS - 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t slot = 1; slot < NET_MGR_MAX_NETWORKS; slot++) {
+        char ssid_key[16];
+        char pass_key[16];
+        const char* ssid = "";
+        const char* pass = "";
+        network_keys(slot, ssid_key, pass_key);
+
+        if (slot <= count) {
+            const net_mgr_network_t* n = &nets[slot - 1];
+            size_t ssid_len = strnlen(n->ssid, sizeof(n->ssid));
+            size_t pass_len = strnlen(n->pass, sizeof(n->pass));
+            if (ssid_len == 0 || ssid_len >= sizeof(n->ssid) || pass_len >= sizeof(n->pass) ||
+                (pass_len > 0 && pass_len < 8)) {
+                ESP_LOGE(TAG, "Invalid network %u", (unsigned)slot);
+                return ESP_ERR_INVALID_ARG;
+            }
+            ssid = n->ssid;
+            pass = n->pass;
+        }
+
+        // Empty strings clear the slot
+        esp_err_t ret = config_mgr_txn_set_string(txn, ssid_key, ssid);
+        if (ret == ESP_OK) {
+            ret = config_mgr_txn_set_string(txn, pass_key, pass);
+        }
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t net_mgr_reload_networks(void)
+{
+    networks_load();
+    ESP_LOGI(TAG, "%u known network(s)", (unsigned)s_network_count);
+    return ESP_OK;
+}
+
+esp_err_t net_mgr_get_roam_stats(net_mgr_roam_stats_t* out)
+{
+    if (!out) {
+        return ESP_ERR_INVALID_ARG;
     }
+    *out = s_roam_stats;
+    return ESP_OK;
+}
 
+esp_err_t net_mgr_set_power_profile(net_mgr_power_profile_t profile)
+{
+    if ((unsigned)profile >= POWER_PROFILE_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_power_mutex) {
+        s_power_base = profile;
+        return ESP_OK;
+    }
+    xSemaphoreTake(s_power_mutex, portMAX_DELAY);
+    s_power_base = profile;
+    power_apply_locked(false);
+    xSemaphoreGive(s_power_mutex);
     return ESP_OK;
 }
 
+net_mgr_power_profile_t net_mgr_get_power_profile(void)
+{
+    return power_effective();
+}
+
+void net_mgr_request_low_latency(void)
+{
+    if (!s_power_mutex) {
+        return;
+    }
+    xSemaphoreTake(s_power_mutex, portMAX_DELAY);
+    s_low_latency_refs++;
+    power_apply_locked(false);
+    xSemaphoreGive(s_power_mutex);
+}
+
+void net_mgr_release_low_latency(void)
+{
+    if (!s_power_mutex) {
+        return;
+    }
+    xSemaphoreTake(s_power_mutex, portMAX_DELAY);
+    if (s_low_latency_refs > 0) {
+        s_low_latency_refs--;
+    } else {
+        ESP_LOGW(TAG, "Low latency released more often than requested");
+    }
+    power_apply_locked(false);
+    xSemaphoreGive(s_power_mutex);
+}
+
+const char* net_mgr_power_profile_name(net_mgr_power_profile_t profile)
+{
+    if ((unsigned)profile >= POWER_PROFILE_COUNT) {
+        return "unknown";
+    }
+    return s_power_names[profile];
+}
+
+esp_err_t net_mgr_power_profile_from_name(const char* name, net_mgr_power_profile_t* out)
+{
+    if (!name || !out) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < POWER_PROFILE_COUNT; i++) {
+        if (strcmp(name, s_power_names[i]) == 0) {
+            *out = (net_mgr_power_profile_t)i;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
 bool net_mgr_is_ready(void)
 {
     if (!s_netif) {
@@ -808,6 +1751,7 @@ esp_err_t net_mgr_test_and_commit_credentials(const char* ssid, const char* pass
 
         config_mgr_set_string("wifi/ssid", ssid);
         config_mgr_set_string("wifi/pass", pass);
+        networks_load();
 
         result = NET_MGR_CRED_OK;
         ret = ESP_OK;
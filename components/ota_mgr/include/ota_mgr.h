@@ -1,4 +1,7 @@
 #pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -6,8 +9,83 @@ extern "C" {
 #endif
 
 esp_err_t ota_mgr_init(void);
+
+/**
+ * Download and install the image at url in the background
+ * With CONFIG_OTA_MGR_RESUME an interrupted download of the same image
+ * continues where it stopped (and is retried by itself on NET_READY).
+ */
 esp_err_t ota_mgr_trigger_from_url(const char* url);
 
+typedef enum {
+    OTA_MGR_SOURCE_NONE = 0,
+    OTA_MGR_SOURCE_URL,         // Pulled with ota_mgr_trigger_from_url()
+    OTA_MGR_SOURCE_UPLOAD,      // Pushed through ota_mgr_upload_*()
+} ota_mgr_source_t;
+
+/**
+ * Progress of the image being written (also the DEVICE_EVENT_OTA_PROGRESS payload)
+ */
+typedef struct {
+    bool active;
+    ota_mgr_source_t source;
+    uint32_t bytes_done;        // Received (URL) or written to flash (upload)
+    uint32_t bytes_total;       // 0 if the size is not known
+    uint32_t resumed_from;      // Bytes kept from an interrupted download (included in bytes_done)
+    uint32_t elapsed_ms;
+    uint32_t rate_kbps;         // KB/s averaged since the start, over this attempt's bytes
+} ota_mgr_progress_t;
+
+esp_err_t ota_mgr_get_progress(ota_mgr_progress_t* out);
+
+/*
+ * Push OTA: the caller streams an image in (e.g. an HTTP request body)
+ *
+ * Two CONFIG_OTA_MGR_CHUNK_SIZE buffers alternate between the caller and a
+ * writer task: while one is being filled from the network the other is
+ * hashed (SHA-256) and written with esp_ota_write(), so receive and flash
+ * time overlap. Loop over get_buffer()/submit() until the image is in,
+ * then finish() or abort(); both free the session.
+ *
+ * Like a download, the image may be a plain app image, gzipped, or a delta
+ * against the running firmware (tools/mkdelta.py, optionally gzipped); it is
+ * decoded on the way to flash. Sizes and hashes are of the bytes sent.
+ *
+ * Shares the one-OTA-at-a-time guard with ota_mgr_trigger_from_url().
+ */
+typedef struct ota_mgr_upload ota_mgr_upload_t;
+
+/**
+ * Start writing an image of image_size bytes to the next OTA partition
+ * sha256 (may be NULL) is checked against the received image in finish().
+ * ESP_ERR_INVALID_STATE if an OTA is already running, ESP_ERR_INVALID_SIZE
+ * if the image cannot fit.
+ */
+esp_err_t ota_mgr_upload_begin(size_t image_size, const uint8_t sha256[32], ota_mgr_upload_t** out);
+
+/**
+ * Next buffer to fill (waits for the writer to hand one back)
+ * Returns the writer's error once a write has failed.
+ */
+esp_err_t ota_mgr_upload_get_buffer(ota_mgr_upload_t* up, uint8_t** buf, size_t* cap);
+
+/**
+ * Hand the buffer from get_buffer() to the writer with len bytes in it
+ */
+esp_err_t ota_mgr_upload_submit(ota_mgr_upload_t* up, size_t len);
+
+/**
+ * Wait for the writer, verify and activate the image, then reboot in 2 s
+ * sha256_out (may be NULL) receives the hash of what was received.
+ * ESP_ERR_INVALID_CRC if it does not match the expected hash,
+ * ESP_ERR_OTA_VALIDATE_FAILED if the image is not a valid app,
+ * ESP_ERR_INVALID_RESPONSE if it could not be decoded,
+ * ESP_ERR_INVALID_VERSION for a delta built against other firmware.
+ */
+esp_err_t ota_mgr_upload_finish(ota_mgr_upload_t* up, uint8_t sha256_out[32]);
+
+void ota_mgr_upload_abort(ota_mgr_upload_t* up);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,6 +3,7 @@
 #include "event_bus.h"
 #include "net_mgr.h"
 #include "version.h"
+#include "diag.h"
 
 #include "esp_log.h"
 #include "esp_ota_ops.h"
@@ -10,25 +11,57 @@
 #include "esp_https_ota.h"
 #include "esp_app_format.h"
 #include "esp_crt_bundle.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp_rom_crc.h"
+#include "rom/miniz.h"
+#include "mbedtls/sha256.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 #include "freertos/semphr.h"
 
+#include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 
 static const char *TAG = "ota_mgr";
 
 #define OTA_TASK_STACK_SIZE (8192)
 #define OTA_TASK_PRIORITY (5)
 #define HASH_LEN (32)
+#define OTA_UPLOAD_BUFFERS (2)
+#define OTA_WRITER_STACK_SIZE (4096)
+#define OTA_BUFFER_WAIT_MS (30000)
+#define OTA_PROGRESS_INTERVAL_MS (1000)
+#define OTA_REBOOT_DELAY_MS (2000)
+#define OTA_VALIDATOR_MAX (64)
+#define OTA_SECTOR_SIZE (4096)
 
 // OTA synchronization - prevent multiple simultaneous OTA operations
-static SemaphoreHandle_t s_ota_mutex = NULL;
+// A binary semaphore, not a mutex: for a pull OTA the caller takes it and
+// ota_task gives it back, and a mutex may only be given by its holder
+static SemaphoreHandle_t s_ota_guard = NULL;
 static volatile bool s_ota_in_progress = false;
 
+// Progress of the image being written, for /status and OTA_PROGRESS
+static portMUX_TYPE s_progress_lock = portMUX_INITIALIZER_UNLOCKED;
+static ota_mgr_progress_t s_progress;
+static int64_t s_progress_start_us = 0;
+static int64_t s_progress_posted_us = 0;
+
+// NET_READY arrived while an OTA was running (see ota_resume_kick)
+static volatile bool s_net_ready_pending = false;
+
 // OTA task parameters
 typedef struct {
     char url[256];
+    // From the response headers, see ota_http_event_handler
+    int status;
+    char validator[OTA_VALIDATOR_MAX];  // ETag, else Last-Modified
+    bool has_etag;
+    uint32_t total;                     // Whole image: Content-Length of a 200, Content-Range total of a 206
+    bool resumable;                     // Progress is being recorded in NVS
 } ota_task_params_t;
 
 // Static function to print SHA256 hash
@@ -73,6 +106,729 @@ static void log_partition_info(void)
     }
 }
 
+// Caller holds s_progress_lock
+static void progress_refresh(int64_t now_us)
+{
+    if (!s_progress.active) {
+        return;
+    }
+    s_progress.elapsed_ms = (uint32_t)((now_us - s_progress_start_us) / 1000);
+    s_progress.rate_kbps = s_progress.elapsed_ms ?
+        (uint32_t)((uint64_t)(s_progress.bytes_done - s_progress.resumed_from) * 1000 / 1024 /
+                   s_progress.elapsed_ms) : 0;
+}
+
+static void progress_start(ota_mgr_source_t source, uint32_t total, uint32_t resumed_from)
+{
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_progress_lock);
+    memset(&s_progress, 0, sizeof(s_progress));
+    s_progress.active = true;
+    s_progress.source = source;
+    s_progress.bytes_total = total;
+    s_progress.bytes_done = resumed_from;
+    s_progress.resumed_from = resumed_from;
+    s_progress_start_us = now;
+    s_progress_posted_us = now;
+    portEXIT_CRITICAL(&s_progress_lock);
+}
+
+/**
+ * Record bytes done; posts OTA_PROGRESS at most once per interval (and at 100%)
+ */
+static void progress_update(uint32_t done)
+{
+    int64_t now = esp_timer_get_time();
+    ota_mgr_progress_t snap;
+    bool post = false;
+
+    portENTER_CRITICAL(&s_progress_lock);
+    s_progress.bytes_done = done;
+    progress_refresh(now);
+    if (now - s_progress_posted_us >= OTA_PROGRESS_INTERVAL_MS * 1000LL ||
+        (s_progress.bytes_total && done >= s_progress.bytes_total)) {
+        s_progress_posted_us = now;
+        post = true;
+    }
+    snap = s_progress;
+    portEXIT_CRITICAL(&s_progress_lock);
+
+    if (post) {
+        // Never hold up the download for the event loop
+        event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_PROGRESS, &snap, sizeof(snap), 0);
+    }
+}
+
+static void progress_stop(void)
+{
+    portENTER_CRITICAL(&s_progress_lock);
+    progress_refresh(esp_timer_get_time());
+    s_progress.active = false;
+    portEXIT_CRITICAL(&s_progress_lock);
+}
+
+esp_err_t ota_mgr_get_progress(ota_mgr_progress_t* out)
+{
+    if (out == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_progress_lock);
+    progress_refresh(esp_timer_get_time());
+    *out = s_progress;
+    portEXIT_CRITICAL(&s_progress_lock);
+    return ESP_OK;
+}
+
+/*
+ * Image decoding
+ *
+ * Every image, uploaded or downloaded without esp_https_ota, goes through
+ * one streaming decoder on its way to esp_ota_write():
+ *   gzip   1f 8b ...   inflated with the ROM inflater (tinfl, 32 KB window)
+ *   delta  "ODL1" ...  rebuilt from the running app (tools/mkdelta.py)
+ *   image  e9 ...      written as is
+ * A delta may itself be gzipped. Decoded writes are staged into whole
+ * OTA_OUT_BUF_SIZE flash writes. Only the decoded image is validated by
+ * esp_ota_end(), so corrupt input or a delta built against another
+ * firmware can never boot.
+ */
+#define OTA_OUT_BUF_SIZE (4096)
+
+#define GZIP_FHCRC (0x02)
+#define GZIP_FEXTRA (0x04)
+#define GZIP_FNAME (0x08)
+#define GZIP_FCOMMENT (0x10)
+
+// Delta: header, then ops until target_size bytes are produced (little-endian)
+#define OTA_DELTA_MAGIC "ODL1"
+#define OTA_DELTA_VERSION (1)
+#define OTA_DELTA_HEADER_SIZE (44)  // magic, u16 version, u16 reserved, u32 target_size, base app_elf_sha256[32]
+#define OTA_DELTA_OP_COPY (1)       // u32 src, u32 len: bytes from the running app partition
+#define OTA_DELTA_OP_DATA (2)       // u32 len, then len literal bytes
+
+enum {
+    GZ_HEADER = 0,
+    GZ_EXTRA_LEN,
+    GZ_SKIP,                    // FEXTRA payload, FHCRC
+    GZ_STRING,                  // FNAME / FCOMMENT up to the NUL
+    GZ_DATA,
+    GZ_TRAILER,
+    GZ_END,
+};
+
+enum {
+    IMG_DETECT = 0,
+    IMG_RAW,
+    IMG_DELTA_HEADER,
+    IMG_DELTA_OP,
+    IMG_DELTA_DATA,
+    IMG_DELTA_END,
+};
+
+typedef struct {
+    const esp_partition_t* partition;   // Being written
+    const esp_partition_t* base;        // Running app, source of delta copies
+    esp_ota_handle_t handle;
+    esp_err_t err;                      // First error, sticky
+
+    // Outer layer: gzip or not, decided by the first byte
+    bool detected;
+    bool gzip;
+    uint8_t gz_state;
+    uint8_t gz_flags;
+    uint8_t gz_buf[10];
+    size_t gz_len;
+    size_t gz_skip;
+    uint32_t gz_crc;                    // Of the inflated data
+    uint32_t gz_size;
+    tinfl_decompressor* inflator;
+    uint8_t* dict;
+    size_t dict_ofs;
+
+    // Inner layer: delta or plain image
+    uint8_t img_state;
+    uint8_t hdr[OTA_DELTA_HEADER_SIZE]; // Delta header or op being gathered
+    size_t hdr_len;
+    uint32_t target_size;
+    uint32_t op_left;
+    size_t produced;                    // Decoded image bytes so far
+
+    uint8_t* out;
+    size_t out_len;
+    size_t written;                     // Passed to esp_ota_write()
+    esp_app_desc_t desc;
+    bool has_desc;
+} ota_decoder_t;
+
+static void dec_fail(ota_decoder_t* d, esp_err_t err)
+{
+    if (d->err == ESP_OK) {
+        d->err = err;
+    }
+}
+
+static uint32_t get_le32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Gather bytes into buf until it holds need; returns bytes taken from data
+static size_t gather(uint8_t* buf, size_t* have, size_t need, const uint8_t* data, size_t len)
+{
+    size_t n = need > *have ? need - *have : 0;
+    if (n > len) {
+        n = len;
+    }
+    memcpy(buf + *have, data, n);
+    *have += n;
+    return n;
+}
+
+static void out_flush(ota_decoder_t* d)
+{
+    if (d->out_len == 0 || d->err != ESP_OK) {
+        return;
+    }
+
+    // Log the new image's app description from its first flash write
+    const size_t desc_ofs = sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t);
+    if (d->written == 0 && d->out_len >= desc_ofs + sizeof(esp_app_desc_t)) {
+        memcpy(&d->desc, d->out + desc_ofs, sizeof(d->desc));
+        d->has_desc = d->desc.magic_word == ESP_APP_DESC_MAGIC_WORD;
+        if (d->has_desc) {
+            ESP_LOGI(TAG, "New firmware version: %s", d->desc.version);
+            ESP_LOGI(TAG, "New firmware project: %s", d->desc.project_name);
+        }
+    }
+
+    esp_err_t ret = esp_ota_write(d->handle, d->out, d->out_len);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "esp_ota_write failed at %u: %s", (unsigned)d->written, esp_err_to_name(ret));
+        dec_fail(d, ret);
+        return;
+    }
+    d->written += d->out_len;
+    d->out_len = 0;
+}
+
+static void out_put(ota_decoder_t* d, const uint8_t* data, size_t len)
+{
+    d->produced += len;
+    while (len > 0 && d->err == ESP_OK) {
+        size_t n = OTA_OUT_BUF_SIZE - d->out_len;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(d->out + d->out_len, data, n);
+        d->out_len += n;
+        data += n;
+        len -= n;
+        if (d->out_len == OTA_OUT_BUF_SIZE) {
+            out_flush(d);
+        }
+    }
+}
+
+// COPY op: read straight from the running app into the output buffer
+static void out_copy(ota_decoder_t* d, uint32_t src, uint32_t len)
+{
+    if (src > d->base->size || len > d->base->size - src) {
+        ESP_LOGE(TAG, "Delta copy 0x%lx+%lu is outside the running app", src, len);
+        dec_fail(d, ESP_ERR_INVALID_RESPONSE);
+        return;
+    }
+    d->produced += len;
+    while (len > 0 && d->err == ESP_OK) {
+        size_t n = OTA_OUT_BUF_SIZE - d->out_len;
+        if (n > len) {
+            n = len;
+        }
+        esp_err_t ret = esp_partition_read(d->base, src, d->out + d->out_len, n);
+        if (ret != ESP_OK) {
+            dec_fail(d, ret);
+            return;
+        }
+        d->out_len += n;
+        src += n;
+        len -= n;
+        if (d->out_len == OTA_OUT_BUF_SIZE) {
+            out_flush(d);
+        }
+    }
+}
+
+static void delta_next_op(ota_decoder_t* d)
+{
+    d->hdr_len = 0;
+    d->img_state = d->produced == d->target_size ? IMG_DELTA_END : IMG_DELTA_OP;
+}
+
+static void delta_begin(ota_decoder_t* d)
+{
+    uint16_t version = (uint16_t)(d->hdr[4] | (d->hdr[5] << 8));
+    if (version != OTA_DELTA_VERSION) {
+        ESP_LOGE(TAG, "Unsupported delta version %u", version);
+        dec_fail(d, ESP_ERR_NOT_SUPPORTED);
+        return;
+    }
+
+    // A delta only makes sense against the exact firmware it was built from
+    const esp_app_desc_t* running = esp_app_get_description();
+    if (memcmp(d->hdr + 12, running->app_elf_sha256, sizeof(running->app_elf_sha256)) != 0) {
+        ESP_LOGE(TAG, "Delta was built against another firmware than the running %s", running->version);
+        dec_fail(d, ESP_ERR_INVALID_VERSION);
+        return;
+    }
+
+    d->target_size = get_le32(d->hdr + 8);
+    if (d->target_size == 0 || d->target_size > d->partition->size) {
+        dec_fail(d, ESP_ERR_INVALID_SIZE);
+        return;
+    }
+    ESP_LOGI(TAG, "Applying delta against %s, %lu byte image", running->version, d->target_size);
+    delta_next_op(d);
+}
+
+static void delta_op(ota_decoder_t* d)
+{
+    uint8_t op = d->hdr[0];
+    uint32_t len = get_le32(d->hdr + (op == OTA_DELTA_OP_COPY ? 5 : 1));
+
+    if (len == 0 || len > d->target_size - d->produced) {
+        dec_fail(d, ESP_ERR_INVALID_RESPONSE);
+        return;
+    }
+    if (op == OTA_DELTA_OP_COPY) {
+        out_copy(d, get_le32(d->hdr + 1), len);
+        delta_next_op(d);
+    } else {
+        d->op_left = len;
+        d->img_state = IMG_DELTA_DATA;
+    }
+}
+
+// Decoded (inflated) bytes: a delta to apply or the image itself
+static void image_feed(ota_decoder_t* d, const uint8_t* data, size_t len)
+{
+    while (len > 0 && d->err == ESP_OK) {
+        size_t n = 0;
+        switch (d->img_state) {
+            case IMG_DETECT:
+                n = gather(d->hdr, &d->hdr_len, 4, data, len);
+                if (d->hdr_len == 4) {
+                    if (memcmp(d->hdr, OTA_DELTA_MAGIC, 4) == 0) {
+                        d->img_state = IMG_DELTA_HEADER;
+                    } else {
+                        d->img_state = IMG_RAW;
+                        out_put(d, d->hdr, 4);
+                    }
+                }
+                break;
+            case IMG_RAW:
+                out_put(d, data, len);
+                n = len;
+                break;
+            case IMG_DELTA_HEADER:
+                n = gather(d->hdr, &d->hdr_len, OTA_DELTA_HEADER_SIZE, data, len);
+                if (d->hdr_len == OTA_DELTA_HEADER_SIZE) {
+                    delta_begin(d);
+                }
+                break;
+            case IMG_DELTA_OP:
+                // Opcode first: it decides how many argument bytes follow
+                if (d->hdr_len == 0) {
+                    n = gather(d->hdr, &d->hdr_len, 1, data, len);
+                    if (d->hdr[0] != OTA_DELTA_OP_COPY && d->hdr[0] != OTA_DELTA_OP_DATA) {
+                        dec_fail(d, ESP_ERR_INVALID_RESPONSE);
+                    }
+                    break;
+                }
+                n = gather(d->hdr, &d->hdr_len, d->hdr[0] == OTA_DELTA_OP_COPY ? 9 : 5, data, len);
+                if (d->hdr_len == (d->hdr[0] == OTA_DELTA_OP_COPY ? 9u : 5u)) {
+                    delta_op(d);
+                }
+                break;
+            case IMG_DELTA_DATA:
+                n = len < d->op_left ? len : d->op_left;
+                out_put(d, data, n);
+                d->op_left -= n;
+                if (d->op_left == 0) {
+                    delta_next_op(d);
+                }
+                break;
+            default:
+                // Bytes past the end of the delta
+                dec_fail(d, ESP_ERR_INVALID_SIZE);
+                break;
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+static void gz_next(ota_decoder_t* d)
+{
+    d->gz_len = 0;
+    if (d->gz_flags & GZIP_FEXTRA) {
+        d->gz_flags &= ~GZIP_FEXTRA;
+        d->gz_state = GZ_EXTRA_LEN;
+    } else if (d->gz_flags & GZIP_FNAME) {
+        d->gz_flags &= ~GZIP_FNAME;
+        d->gz_state = GZ_STRING;
+    } else if (d->gz_flags & GZIP_FCOMMENT) {
+        d->gz_flags &= ~GZIP_FCOMMENT;
+        d->gz_state = GZ_STRING;
+    } else if (d->gz_flags & GZIP_FHCRC) {
+        d->gz_flags &= ~GZIP_FHCRC;
+        d->gz_skip = 2;
+        d->gz_state = GZ_SKIP;
+    } else {
+        tinfl_init(d->inflator);
+        d->gz_state = GZ_DATA;
+    }
+}
+
+// Inflate as much of data as possible; returns bytes consumed
+static size_t gz_inflate(ota_decoder_t* d, const uint8_t* data, size_t len)
+{
+    size_t used = 0;
+
+    while (d->err == ESP_OK) {
+        size_t in_bytes = len - used;
+        size_t out_bytes = TINFL_LZ_DICT_SIZE - d->dict_ofs;
+        uint8_t* out = d->dict + d->dict_ofs;
+        tinfl_status status = tinfl_decompress(d->inflator, data + used, &in_bytes, d->dict, out,
+                                               &out_bytes, TINFL_FLAG_HAS_MORE_INPUT);
+        used += in_bytes;
+
+        if (out_bytes > 0) {
+            d->gz_crc = esp_rom_crc32_le(d->gz_crc, out, out_bytes);
+            d->gz_size += out_bytes;
+            d->dict_ofs = (d->dict_ofs + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+            image_feed(d, out, out_bytes);
+        }
+
+        if (status < TINFL_STATUS_DONE) {
+            ESP_LOGE(TAG, "Inflate failed (%d)", (int)status);
+            dec_fail(d, ESP_ERR_INVALID_RESPONSE);
+        } else if (status == TINFL_STATUS_DONE) {
+            d->gz_len = 0;
+            d->gz_state = GZ_TRAILER;
+            break;
+        } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && used == len) {
+            break;
+        }
+    }
+    return used;
+}
+
+static void gz_feed(ota_decoder_t* d, const uint8_t* data, size_t len)
+{
+    while (len > 0 && d->err == ESP_OK) {
+        size_t n = 0;
+        const uint8_t* nul;
+        switch (d->gz_state) {
+            case GZ_HEADER:
+                n = gather(d->gz_buf, &d->gz_len, 10, data, len);
+                if (d->gz_len == 10) {
+                    if (d->gz_buf[0] != 0x1f || d->gz_buf[1] != 0x8b || d->gz_buf[2] != 8) {
+                        dec_fail(d, ESP_ERR_INVALID_RESPONSE);
+                        break;
+                    }
+                    d->gz_flags = d->gz_buf[3];
+                    gz_next(d);
+                }
+                break;
+            case GZ_EXTRA_LEN:
+                n = gather(d->gz_buf, &d->gz_len, 2, data, len);
+                if (d->gz_len == 2) {
+                    d->gz_skip = d->gz_buf[0] | (d->gz_buf[1] << 8);
+                    d->gz_state = GZ_SKIP;
+                }
+                break;
+            case GZ_SKIP:
+                n = len < d->gz_skip ? len : d->gz_skip;
+                d->gz_skip -= n;
+                if (d->gz_skip == 0) {
+                    gz_next(d);
+                }
+                break;
+            case GZ_STRING:
+                nul = memchr(data, 0, len);
+                n = nul ? (size_t)(nul - data) + 1 : len;
+                if (nul) {
+                    gz_next(d);
+                }
+                break;
+            case GZ_DATA:
+                n = gz_inflate(d, data, len);
+                break;
+            case GZ_TRAILER:
+                n = gather(d->gz_buf, &d->gz_len, 8, data, len);
+                if (d->gz_len == 8) {
+                    if (get_le32(d->gz_buf) != d->gz_crc || get_le32(d->gz_buf + 4) != d->gz_size) {
+                        ESP_LOGE(TAG, "gzip CRC/size mismatch");
+                        dec_fail(d, ESP_ERR_INVALID_RESPONSE);
+                        break;
+                    }
+                    d->gz_state = GZ_END;
+                }
+                break;
+            default:
+                // Concatenated gzip members are not supported
+                dec_fail(d, ESP_ERR_INVALID_SIZE);
+                break;
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+/**
+ * Open the next OTA partition for writing through the decoder
+ */
+static esp_err_t ota_decoder_begin(ota_decoder_t* d)
+{
+    memset(d, 0, sizeof(*d));
+    d->partition = esp_ota_get_next_update_partition(NULL);
+    d->base = esp_ota_get_running_partition();
+    if (d->partition == NULL || d->base == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    d->out = diag_mem_alloc(DIAG_MEM_OTA, OTA_OUT_BUF_SIZE);
+    if (d->out == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Sequential writes erase sector by sector as the image arrives,
+    // instead of the whole partition up front while the sender waits
+    esp_err_t ret = esp_ota_begin(d->partition, OTA_WITH_SEQUENTIAL_WRITES, &d->handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "esp_ota_begin failed: %s", esp_err_to_name(ret));
+        diag_mem_free(d->out);
+        d->out = NULL;
+    }
+    return ret;
+}
+
+static void ota_decoder_free(ota_decoder_t* d)
+{
+    diag_mem_free(d->inflator);
+    diag_mem_free(d->dict);
+    diag_mem_free(d->out);
+    d->inflator = NULL;
+    d->dict = NULL;
+    d->out = NULL;
+}
+
+static esp_err_t ota_decoder_feed(ota_decoder_t* d, const uint8_t* data, size_t len)
+{
+    if (d->err != ESP_OK || len == 0) {
+        return d->err;
+    }
+
+    if (!d->detected) {
+        d->detected = true;
+        d->gzip = data[0] == 0x1f;
+        if (d->gzip) {
+            // Only paid for compressed images
+            d->inflator = diag_mem_alloc(DIAG_MEM_OTA, sizeof(tinfl_decompressor));
+            d->dict = diag_mem_alloc(DIAG_MEM_OTA, TINFL_LZ_DICT_SIZE);
+            if (d->inflator == NULL || d->dict == NULL) {
+                dec_fail(d, ESP_ERR_NO_MEM);
+                return d->err;
+            }
+            ESP_LOGI(TAG, "Image is gzip compressed");
+        }
+    }
+
+    if (d->gzip) {
+        gz_feed(d, data, len);
+    } else {
+        image_feed(d, data, len);
+    }
+    return d->err;
+}
+
+/**
+ * All input is in: check the streams ended cleanly, flush, validate and
+ * make the new image the boot partition. Frees the decoder either way.
+ */
+static esp_err_t ota_decoder_end(ota_decoder_t* d)
+{
+    if (d->err == ESP_OK) {
+        if (!d->detected || (d->gzip && d->gz_state != GZ_END)) {
+            dec_fail(d, ESP_ERR_INVALID_SIZE);
+        } else if (d->img_state != IMG_RAW && d->img_state != IMG_DELTA_END) {
+            dec_fail(d, ESP_ERR_INVALID_SIZE);
+        }
+    }
+    out_flush(d);
+
+    esp_err_t ret = d->err;
+    if (ret == ESP_OK) {
+        if (d->gzip || d->img_state == IMG_DELTA_END) {
+            ESP_LOGI(TAG, "Decoded %u byte image", (unsigned)d->written);
+        }
+        // Validates the image (and its own appended hash) before it can boot
+        ret = esp_ota_end(d->handle);
+        if (ret == ESP_OK) {
+            ret = esp_ota_set_boot_partition(d->partition);
+        }
+    } else {
+        esp_ota_abort(d->handle);
+    }
+    ota_decoder_free(d);
+    return ret;
+}
+
+static void ota_decoder_abort(ota_decoder_t* d)
+{
+    esp_ota_abort(d->handle);
+    ota_decoder_free(d);
+}
+
+/*
+ * Download resumption
+ *
+ * A plain image download records how far it got in NVS, with the URL and
+ * the server's validator (ETag, else Last-Modified) and size as the image
+ * identity. The next attempt at the same URL, by hand or on NET_READY,
+ * asks for the rest with a Range request (esp_https_ota's ota_resumption)
+ * and keeps what is already in the inactive partition. A changed validator
+ * or size, or a server that ignores Range, starts over from byte zero.
+ * Offsets are saved at sector boundaries: the sector being written when
+ * the link dropped is erased and fetched again on resume.
+ *
+ * ota/res_len is the offset, 0 when there is nothing to resume.
+ */
+typedef struct {
+    char url[256];
+    char validator[OTA_VALIDATOR_MAX];
+    uint32_t size;
+    uint32_t offset;
+} ota_resume_t;
+
+static bool resume_load(ota_resume_t* r)
+{
+    if (config_mgr_get_u32("ota/res_len", &r->offset) != ESP_OK || r->offset == 0) {
+        return false;
+    }
+    return config_mgr_get_string("ota/res_url", r->url, sizeof(r->url)) == ESP_OK &&
+           config_mgr_get_string("ota/res_tag", r->validator, sizeof(r->validator)) == ESP_OK &&
+           config_mgr_get_u32("ota/res_size", &r->size) == ESP_OK;
+}
+
+// The inactive partition is about to be rewritten: nothing left to resume
+static void resume_clear(void)
+{
+    uint32_t offset = 0;
+    if (config_mgr_get_u32("ota/res_len", &offset) == ESP_OK && offset != 0) {
+        config_mgr_set_u32("ota/res_len", 0);
+    }
+}
+
+/**
+ * Start recording a fresh download; false if it cannot be resumed
+ */
+static bool resume_record(const ota_task_params_t* p)
+{
+#ifdef CONFIG_OTA_MGR_RESUME
+    if (!p->validator[0] || p->total == 0) {
+        ESP_LOGW(TAG, "Server sent no ETag/Last-Modified or length, download cannot be resumed");
+        return false;
+    }
+
+    config_mgr_txn_t* txn = NULL;
+    if (config_mgr_txn_begin(&txn) != ESP_OK) {
+        return false;
+    }
+    config_mgr_txn_set_string(txn, "ota/res_url", p->url);
+    config_mgr_txn_set_string(txn, "ota/res_tag", p->validator);
+    config_mgr_txn_set_u32(txn, "ota/res_size", p->total);
+    config_mgr_txn_set_u32(txn, "ota/res_len", 0);
+    return config_mgr_txn_commit(txn) == ESP_OK;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Save a resume point every CONFIG_OTA_MGR_RESUME_SAVE_INTERVAL bytes,
+ * or whenever there is a new whole sector if force is set
+ */
+static void resume_progress(const ota_task_params_t* p, uint32_t done, uint32_t* saved, bool force)
+{
+#ifdef CONFIG_OTA_MGR_RESUME
+    uint32_t offset = done - done % OTA_SECTOR_SIZE;
+    if (!p->resumable || offset <= *saved ||
+        (!force && done - *saved < CONFIG_OTA_MGR_RESUME_SAVE_INTERVAL)) {
+        return;
+    }
+    if (config_mgr_set_u32("ota/res_len", offset) == ESP_OK) {
+        *saved = offset;
+    }
+#endif
+}
+
+/**
+ * Restart an interrupted download, if there is one
+ */
+static void ota_resume_kick(void)
+{
+    ota_resume_t r;
+    if (!resume_load(&r)) {
+        return;
+    }
+    if (s_ota_in_progress) {
+        // The running download is likely about to fail on the dropped link
+        s_net_ready_pending = true;
+        return;
+    }
+    ESP_LOGI(TAG, "Resuming interrupted OTA download at %lu of %lu bytes", r.offset, r.size);
+    ota_mgr_trigger_from_url(r.url);
+}
+
+/**
+ * NET_READY, and OTA_FAIL for a NET_READY that arrived mid-download
+ * ota_task posts OTA_FAIL after releasing the guard, so the retry starts
+ * here on the event loop rather than from the task that is exiting.
+ */
+static void ota_resume_event_handler(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+    if (id == DEVICE_EVENT_OTA_FAIL) {
+        if (!s_net_ready_pending) {
+            return;
+        }
+        s_net_ready_pending = false;
+    }
+    ota_resume_kick();
+}
+
+// Record the response status and the headers that identify the image
+static void ota_http_on_header(esp_http_client_event_t *evt)
+{
+    ota_task_params_t* p = evt->user_data;
+    if (p == NULL) {
+        return;
+    }
+    p->status = esp_http_client_get_status_code(evt->client);
+
+    if (strcasecmp(evt->header_key, "ETag") == 0) {
+        strlcpy(p->validator, evt->header_value, sizeof(p->validator));
+        p->has_etag = true;
+    } else if (strcasecmp(evt->header_key, "Last-Modified") == 0 && !p->has_etag) {
+        strlcpy(p->validator, evt->header_value, sizeof(p->validator));
+    } else if (strcasecmp(evt->header_key, "Content-Length") == 0 && p->status == 200) {
+        p->total = strtoul(evt->header_value, NULL, 10);
+    } else if (strcasecmp(evt->header_key, "Content-Range") == 0) {
+        // bytes <first>-<last>/<total>
+        const char* slash = strchr(evt->header_value, '/');
+        p->total = slash ? strtoul(slash + 1, NULL, 10) : 0;
+    }
+}
+
 // HTTP event handler for OTA
 static esp_err_t ota_http_event_handler(esp_http_client_event_t *evt)
 {
@@ -88,6 +844,7 @@ static esp_err_t ota_http_event_handler(esp_http_client_event_t *evt)
         break;
     case HTTP_EVENT_ON_HEADER:
         ESP_LOGD(TAG, "HTTP_EVENT_ON_HEADER, key=%s, value=%s", evt->header_key, evt->header_value);
+        ota_http_on_header(evt);
         break;
     case HTTP_EVENT_ON_DATA:
         ESP_LOGD(TAG, "HTTP_EVENT_ON_DATA, len=%d", evt->data_len);
@@ -105,13 +862,98 @@ static esp_err_t ota_http_event_handler(esp_http_client_event_t *evt)
     return ESP_OK;
 }
 
+/**
+ * Download a compressed or delta image and write it through the decoder
+ * (esp_https_ota only takes plain app images)
+ */
+static esp_err_t ota_pull_decoded(const esp_http_client_config_t* http_config, esp_app_desc_t* desc)
+{
+    ota_decoder_t dec;
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    bool dec_open = false;
+
+    uint8_t* buf = diag_mem_alloc(DIAG_MEM_OTA, CONFIG_OTA_MGR_CHUNK_SIZE);
+    esp_http_client_handle_t client = esp_http_client_init(http_config);
+    if (buf == NULL || client == NULL) {
+        goto done;
+    }
+
+    ret = esp_http_client_open(client, 0);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open %s: %s", http_config->url, esp_err_to_name(ret));
+        goto done;
+    }
+    int64_t length = esp_http_client_fetch_headers(client);
+    int status = esp_http_client_get_status_code(client);
+    if (status != 200) {
+        ESP_LOGE(TAG, "Image download failed, HTTP status %d", status);
+        ret = ESP_FAIL;
+        goto done;
+    }
+
+    ret = ota_decoder_begin(&dec);
+    if (ret != ESP_OK) {
+        goto done;
+    }
+    dec_open = true;
+    progress_start(OTA_MGR_SOURCE_URL, length > 0 ? (uint32_t)length : 0, 0);
+
+    uint32_t received = 0;
+    for (;;) {
+        int n = esp_http_client_read(client, (char*)buf, CONFIG_OTA_MGR_CHUNK_SIZE);
+        if (n < 0) {
+            ESP_LOGE(TAG, "Image read failed at %lu", received);
+            ret = ESP_FAIL;
+            goto done;
+        }
+        if (n == 0) {
+            break;
+        }
+        ret = ota_decoder_feed(&dec, buf, (size_t)n);
+        if (ret != ESP_OK) {
+            goto done;
+        }
+        received += (uint32_t)n;
+        progress_update(received);
+    }
+    progress_stop();
+
+    if (!esp_http_client_is_complete_data_received(client)) {
+        ESP_LOGE(TAG, "Complete data was not received");
+        ret = ESP_FAIL;
+        goto done;
+    }
+
+    dec_open = false;
+    ret = ota_decoder_end(&dec);
+    if (ret == ESP_ERR_OTA_VALIDATE_FAILED) {
+        ESP_LOGE(TAG, "Image validation failed, image is corrupted");
+    }
+    if (dec.has_desc) {
+        *desc = dec.desc;
+    } else {
+        memset(desc, 0, sizeof(*desc));
+    }
+
+done:
+    progress_stop();
+    if (dec_open) {
+        ota_decoder_abort(&dec);
+    }
+    if (client) {
+        esp_http_client_cleanup(client);
+    }
+    diag_mem_free(buf);
+    return ret;
+}
+
 // OTA task - runs in separate task to avoid blocking
 static void ota_task(void *pvParameter)
 {
     if (pvParameter == NULL) {
         ESP_LOGE(TAG, "OTA task parameter is NULL");
         s_ota_in_progress = false;
-        xSemaphoreGive(s_ota_mutex);
+        xSemaphoreGive(s_ota_guard);
         vTaskDelete(NULL);
         return;
     }
@@ -121,8 +963,12 @@ static void ota_task(void *pvParameter)
     esp_err_t ota_result = ESP_OK;
     esp_https_ota_handle_t https_ota_handle = NULL;
     bool ota_started = false;
+    ota_resume_t resume = { 0 };
+    bool resuming = false;
+    uint32_t saved = 0;
 
     ESP_LOGI(TAG, "Starting OTA update from URL: %s", params->url);
+    s_net_ready_pending = false;
 
     // Post OTA_BEGIN event
     event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_BEGIN, NULL, 0, pdMS_TO_TICKS(100));
@@ -137,12 +983,26 @@ static void ota_task(void *pvParameter)
     }
     ESP_LOGI(TAG, "Network ready (IP: %s), proceeding with OTA download", ip_check);
 
+#ifdef CONFIG_OTA_MGR_RESUME
+    if (resume_load(&resume)) {
+        if (strcmp(resume.url, params->url) == 0) {
+            resuming = true;
+            saved = resume.offset;
+        } else {
+            // Another image: what is in the partition is of no use
+            resume_clear();
+        }
+    }
+#endif
+
     // Configure HTTP client
     esp_http_client_config_t http_config = {
         .url = params->url,
         .event_handler = ota_http_event_handler,
+        .user_data = params,
         .keep_alive_enable = true,
         .timeout_ms = 5000,
+        .buffer_size = CONFIG_OTA_MGR_CHUNK_SIZE,   // Bytes per esp_https_ota_perform() read/write
 #ifdef CONFIG_MBEDTLS_CERTIFICATE_BUNDLE
         .crt_bundle_attach = esp_crt_bundle_attach,
 #endif
@@ -153,7 +1013,19 @@ static void ota_task(void *pvParameter)
         .http_config = &http_config,
     };
 
+retry:
+    // Resuming sends Range: bytes=<offset>- and continues the partition from there
+    ota_config.ota_resumption = resuming;
+    ota_config.ota_image_bytes_written = resuming ? resume.offset : 0;
+    params->status = 0;
+    params->validator[0] = '\0';
+    params->has_etag = false;
+    params->total = 0;
+
     ESP_LOGI(TAG, "Attempting to download update from %s", http_config.url);
+    if (resuming) {
+        ESP_LOGI(TAG, "Resuming at %lu of %lu bytes", resume.offset, resume.size);
+    }
 
     // Begin OTA operation
     ret = esp_https_ota_begin(&ota_config, &https_ota_handle);
@@ -163,16 +1035,53 @@ static void ota_task(void *pvParameter)
     }
     ota_started = true;
 
-    // Get image descriptor from new firmware
-    esp_app_desc_t new_app_info;
-    ret = esp_https_ota_get_img_desc(https_ota_handle, &new_app_info);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to get image descriptor: %s", esp_err_to_name(ret));
-        goto ota_fail;
+    esp_app_desc_t new_app_info = { 0 };
+    if (resuming) {
+        // Only append to the same image; nothing has been written yet
+        if (params->status != 206 || params->total != resume.size ||
+            strcmp(params->validator, resume.validator) != 0) {
+            ESP_LOGW(TAG, "Image on the server changed or Range is not supported (status %d), starting over",
+                     params->status);
+            esp_https_ota_abort(https_ota_handle);
+            https_ota_handle = NULL;
+            ota_started = false;
+            resume_clear();
+            resuming = false;
+            saved = 0;
+            goto retry;
+        }
+        params->resumable = true;
+    } else {
+        // Get image descriptor from new firmware
+        ret = esp_https_ota_get_img_desc(https_ota_handle, &new_app_info);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to get image descriptor: %s", esp_err_to_name(ret));
+            goto ota_fail;
+        }
+
+        if (new_app_info.magic_word != ESP_APP_DESC_MAGIC_WORD) {
+            // Not a plain app image: fetch it again through the decoder (gzip or delta).
+            // The inflater cannot pick up mid-stream, so these always start over.
+            ESP_LOGI(TAG, "Image is not a plain app, downloading it through the decoder");
+            esp_https_ota_abort(https_ota_handle);
+            https_ota_handle = NULL;
+            ota_started = false;
+            resume_clear();
+            ret = ota_pull_decoded(&http_config, &new_app_info);
+            if (ret != ESP_OK) {
+                goto ota_fail;
+            }
+            goto ota_done;
+        }
+
+        ESP_LOGI(TAG, "New firmware version: %s", new_app_info.version);
+        ESP_LOGI(TAG, "New firmware project: %s", new_app_info.project_name);
+        params->resumable = resume_record(params);
     }
 
-    ESP_LOGI(TAG, "New firmware version: %s", new_app_info.version);
-    ESP_LOGI(TAG, "New firmware project: %s", new_app_info.project_name);
+    int image_size = esp_https_ota_get_image_size(https_ota_handle);
+    uint32_t total = params->total ? params->total : (image_size > 0 ? (uint32_t)image_size : 0);
+    progress_start(OTA_MGR_SOURCE_URL, total, resuming ? resume.offset : 0);
 
     // Optionally validate version (commented out for flexibility)
     // const esp_partition_t *running = esp_ota_get_running_partition();
@@ -194,7 +1103,10 @@ static void ota_task(void *pvParameter)
         // Monitor progress
         const size_t bytes_read = esp_https_ota_get_image_len_read(https_ota_handle);
         ESP_LOGD(TAG, "Image bytes read: %zu", bytes_read);
+        progress_update((uint32_t)bytes_read);
+        resume_progress(params, (uint32_t)bytes_read, &saved, false);
     }
+    progress_stop();
 
     // Check if complete data received
     if (esp_https_ota_is_complete_data_received(https_ota_handle) != true) {
@@ -207,25 +1119,11 @@ static void ota_task(void *pvParameter)
     ret = esp_https_ota_finish(https_ota_handle);
     https_ota_handle = NULL;  // Handle is freed by finish
 
-    if (ret == ESP_OK) {
-        ESP_LOGI(TAG, "OTA succeeded, preparing to reboot");
-
-        // Record success in config_mgr with NEW firmware version
-        config_mgr_set_u32("ota/last_result", (uint32_t)ESP_OK);
-        config_mgr_set_string("ota/last_version", new_app_info.version);
-
-        // Post OTA_SUCCESS event
-        event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_SUCCESS, NULL, 0, pdMS_TO_TICKS(100));
+    // Whatever the outcome the partition holds a whole image now
+    params->resumable = false;
+    resume_clear();
 
-        // Clean up
-        free(params);
-        s_ota_in_progress = false;
-        xSemaphoreGive(s_ota_mutex);
-
-        ESP_LOGI(TAG, "Rebooting in 2 seconds...");
-        vTaskDelay(pdMS_TO_TICKS(2000));
-        esp_restart();
-    } else {
+    if (ret != ESP_OK) {
         if (ret == ESP_ERR_OTA_VALIDATE_FAILED) {
             ESP_LOGE(TAG, "Image validation failed, image is corrupted");
         }
@@ -233,15 +1131,47 @@ static void ota_task(void *pvParameter)
         goto ota_fail;
     }
 
+ota_done:
+    ESP_LOGI(TAG, "OTA succeeded, preparing to reboot");
+
+    // A resumed image's description was never downloaded; read it from flash
+    if (new_app_info.magic_word != ESP_APP_DESC_MAGIC_WORD) {
+        esp_ota_get_partition_description(esp_ota_get_next_update_partition(NULL), &new_app_info);
+    }
+
+    // Record success in config_mgr with NEW firmware version
+    config_mgr_set_u32("ota/last_result", (uint32_t)ESP_OK);
+    if (new_app_info.magic_word == ESP_APP_DESC_MAGIC_WORD) {
+        config_mgr_set_string("ota/last_version", new_app_info.version);
+    }
+
+    // Post OTA_SUCCESS event
+    event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_SUCCESS, NULL, 0, pdMS_TO_TICKS(100));
+
+    // Clean up
+    free(params);
+    s_ota_in_progress = false;
+    xSemaphoreGive(s_ota_guard);
+
+    ESP_LOGI(TAG, "Rebooting in 2 seconds...");
+    vTaskDelay(pdMS_TO_TICKS(2000));
+    esp_restart();
+
     // Should never reach here due to restart
     vTaskDelete(NULL);
     return;
 
 ota_fail:
     // Cleanup on failure
+    progress_stop();
     if (ota_started && https_ota_handle != NULL) {
+        // Keep everything written so far for the next attempt
+        resume_progress(params, (uint32_t)esp_https_ota_get_image_len_read(https_ota_handle), &saved, true);
         esp_https_ota_abort(https_ota_handle);
     }
+    if (params->resumable && saved > 0) {
+        ESP_LOGI(TAG, "Download will resume at %lu bytes", saved);
+    }
 
     ota_result = ret;
     ESP_LOGE(TAG, "OTA failed: %s (0x%x)", esp_err_to_name(ret), ret);
@@ -249,13 +1179,14 @@ ota_fail:
     // Record failure in config_mgr
     config_mgr_set_u32("ota/last_result", (uint32_t)ret);
 
-    // Post OTA_FAIL event
-    event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_FAIL, &ota_result, sizeof(ota_result), pdMS_TO_TICKS(100));
-
     // Clean up
     free(params);
     s_ota_in_progress = false;
-    xSemaphoreGive(s_ota_mutex);
+    xSemaphoreGive(s_ota_guard);
+
+    // Post OTA_FAIL event once the guard is free, so a resume pending on it
+    // can start (see ota_resume_event_handler)
+    event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_FAIL, &ota_result, sizeof(ota_result), pdMS_TO_TICKS(100));
 
     // Task cleanup
     vTaskDelete(NULL);
@@ -265,13 +1196,14 @@ esp_err_t ota_mgr_init(void)
 {
     ESP_LOGI(TAG, "Initializing OTA manager");
 
-    // Create OTA mutex for synchronization
-    if (s_ota_mutex == NULL) {
-        s_ota_mutex = xSemaphoreCreateMutex();
-        if (s_ota_mutex == NULL) {
-            ESP_LOGE(TAG, "Failed to create OTA mutex");
+    // Create the one-OTA-at-a-time guard
+    if (s_ota_guard == NULL) {
+        s_ota_guard = xSemaphoreCreateBinary();
+        if (s_ota_guard == NULL) {
+            ESP_LOGE(TAG, "Failed to create OTA guard");
             return ESP_ERR_NO_MEM;
         }
+        xSemaphoreGive(s_ota_guard);
     }
 
     // Validate OTA partitions exist
@@ -313,6 +1245,21 @@ esp_err_t ota_mgr_init(void)
         }
     }
 
+#ifdef CONFIG_OTA_MGR_RESUME
+    // Pick up a download cut short by a link drop or a reboot once the network is back
+    esp_err_t reg = event_bus_register(DEVICE_EVENT_NET_READY, &ota_resume_event_handler, NULL);
+    if (reg == ESP_OK) {
+        reg = event_bus_register(DEVICE_EVENT_OTA_FAIL, &ota_resume_event_handler, NULL);
+    }
+    if (reg != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to register resume handlers: %s", esp_err_to_name(reg));
+    }
+    char ip[16] = "0.0.0.0";
+    if (net_mgr_get_ip(ip, sizeof(ip)) == ESP_OK && strcmp(ip, "0.0.0.0") != 0) {
+        ota_resume_kick();
+    }
+#endif
+
     ESP_LOGI(TAG, "OTA manager initialized successfully");
     return ESP_OK;
 }
@@ -329,14 +1276,14 @@ esp_err_t ota_mgr_trigger_from_url(const char* url)
         return ESP_ERR_INVALID_SIZE;
     }
 
-    // Check if OTA mutex was initialized
-    if (s_ota_mutex == NULL) {
-        ESP_LOGE(TAG, "OTA manager not initialized (mutex is NULL)");
+    // Check if OTA guard was initialized
+    if (s_ota_guard == NULL) {
+        ESP_LOGE(TAG, "OTA manager not initialized (guard is NULL)");
         return ESP_ERR_INVALID_STATE;
     }
 
-    // Try to acquire OTA mutex (non-blocking)
-    if (xSemaphoreTake(s_ota_mutex, 0) != pdTRUE) {
+    // Try to acquire OTA guard (non-blocking)
+    if (xSemaphoreTake(s_ota_guard, 0) != pdTRUE) {
         ESP_LOGW(TAG, "OTA operation already in progress, rejecting new request");
         return ESP_ERR_INVALID_STATE;
     }
@@ -344,7 +1291,7 @@ esp_err_t ota_mgr_trigger_from_url(const char* url)
     // Double-check flag (belt and suspenders)
     if (s_ota_in_progress) {
         ESP_LOGW(TAG, "OTA already in progress (flag set), rejecting");
-        xSemaphoreGive(s_ota_mutex);
+        xSemaphoreGive(s_ota_guard);
         return ESP_ERR_INVALID_STATE;
     }
 
@@ -354,11 +1301,11 @@ esp_err_t ota_mgr_trigger_from_url(const char* url)
     ESP_LOGI(TAG, "Triggering OTA update from URL: %s", url);
 
     // Allocate parameters for OTA task
-    ota_task_params_t *params = malloc(sizeof(ota_task_params_t));
+    ota_task_params_t *params = calloc(1, sizeof(ota_task_params_t));
     if (params == NULL) {
         ESP_LOGE(TAG, "Failed to allocate memory for OTA task parameters");
         s_ota_in_progress = false;
-        xSemaphoreGive(s_ota_mutex);
+        xSemaphoreGive(s_ota_guard);
         return ESP_ERR_NO_MEM;
     }
 
@@ -380,11 +1327,314 @@ esp_err_t ota_mgr_trigger_from_url(const char* url)
         ESP_LOGE(TAG, "Failed to create OTA task");
         free(params);
         s_ota_in_progress = false;
-        xSemaphoreGive(s_ota_mutex);
+        xSemaphoreGive(s_ota_guard);
         return ESP_FAIL;
     }
 
     ESP_LOGI(TAG, "OTA task created successfully");
-    // Note: mutex will be released by ota_task on completion/failure
+    // Note: the guard is released by ota_task on completion/failure
+    return ESP_OK;
+}
+
+/*
+ * Push OTA
+ */
+
+// Push OTA session
+typedef struct {
+    uint8_t* data;
+    size_t len;                 // 0 marks the end of the image
+} ota_chunk_t;
+
+struct ota_mgr_upload {
+    uint8_t* bufs[OTA_UPLOAD_BUFFERS];
+    uint8_t* filling;           // Buffer held by the caller, NULL if none
+    QueueHandle_t free_q;       // uint8_t*: buffers ready to fill
+    QueueHandle_t full_q;       // ota_chunk_t: buffers waiting for the writer
+    SemaphoreHandle_t done;     // Given when the writer has seen the end marker
+    TaskHandle_t writer;
+    mbedtls_sha256_context sha;
+    volatile esp_err_t err;     // First write error (set by the writer only)
+    size_t size;
+    size_t written;
+    uint8_t expected[HASH_LEN];
+    bool has_expected;
+    ota_decoder_t dec;
+    bool dec_open;              // dec holds an OTA handle
+};
+
+static void ota_restart_cb(void* arg)
+{
+    esp_restart();
+}
+
+// Hashes, decodes and flashes filled buffers until the end marker
+static void ota_writer_task(void* arg)
+{
+    ota_mgr_upload_t* up = arg;
+    ota_chunk_t chunk;
+
+    for (;;) {
+        if (xQueueReceive(up->full_q, &chunk, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (chunk.len == 0) {
+            break;
+        }
+
+        // After a failure keep draining so the caller never blocks
+        if (up->err == ESP_OK) {
+            mbedtls_sha256_update(&up->sha, chunk.data, chunk.len);
+            esp_err_t ret = ota_decoder_feed(&up->dec, chunk.data, chunk.len);
+            if (ret != ESP_OK) {
+                up->err = ret;
+            } else {
+                up->written += chunk.len;
+                progress_update((uint32_t)up->written);
+            }
+        }
+        xQueueSend(up->free_q, &chunk.data, portMAX_DELAY);
+    }
+
+    xSemaphoreGive(up->done);
+    vTaskDelete(NULL);
+}
+
+// Free everything; the writer must already be gone
+static void upload_free(ota_mgr_upload_t* up)
+{
+    mbedtls_sha256_free(&up->sha);
+    for (int i = 0; i < OTA_UPLOAD_BUFFERS; i++) {
+        diag_mem_free(up->bufs[i]);
+    }
+    if (up->free_q) {
+        vQueueDelete(up->free_q);
+    }
+    if (up->full_q) {
+        vQueueDelete(up->full_q);
+    }
+    if (up->done) {
+        vSemaphoreDelete(up->done);
+    }
+    free(up);
+}
+
+// Stop the writer and wait until it has flashed everything queued
+static void upload_drain(ota_mgr_upload_t* up)
+{
+    ota_chunk_t end = { .data = NULL, .len = 0 };
+    xQueueSend(up->full_q, &end, portMAX_DELAY);
+    xSemaphoreTake(up->done, portMAX_DELAY);
+    up->writer = NULL;
+}
+
+// End of a session that failed (err) or was abandoned
+static void upload_fail(ota_mgr_upload_t* up, esp_err_t err)
+{
+    if (up->dec_open) {
+        ota_decoder_abort(&up->dec);
+    }
+    upload_free(up);
+    progress_stop();
+
+    ESP_LOGE(TAG, "OTA upload failed: %s (0x%x)", esp_err_to_name(err), err);
+    config_mgr_set_u32("ota/last_result", (uint32_t)err);
+    event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_FAIL, &err, sizeof(err), pdMS_TO_TICKS(100));
+
+    s_ota_in_progress = false;
+    xSemaphoreGive(s_ota_guard);
+}
+
+esp_err_t ota_mgr_upload_begin(size_t image_size, const uint8_t sha256[32], ota_mgr_upload_t** out)
+{
+    if (out == NULL || image_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_ota_guard == NULL) {
+        ESP_LOGE(TAG, "OTA manager not initialized (guard is NULL)");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Compressed and delta images are smaller than what they decode to;
+    // the decoded size is checked again as the image is written
+    const esp_partition_t* partition = esp_ota_get_next_update_partition(NULL);
+    if (partition == NULL) {
+        ESP_LOGE(TAG, "No OTA partition to write");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (image_size > partition->size) {
+        ESP_LOGE(TAG, "Image of %u bytes does not fit %s (%lu bytes)",
+                 (unsigned)image_size, partition->label, partition->size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // Same one-at-a-time guard as the pull path
+    if (xSemaphoreTake(s_ota_guard, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "OTA operation already in progress, rejecting upload");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (s_ota_in_progress) {
+        xSemaphoreGive(s_ota_guard);
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_ota_in_progress = true;
+    resume_clear();
+
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    ota_mgr_upload_t* up = calloc(1, sizeof(*up));
+    if (up == NULL) {
+        goto fail;
+    }
+    mbedtls_sha256_init(&up->sha);
+    up->size = image_size;
+    if (sha256) {
+        memcpy(up->expected, sha256, HASH_LEN);
+        up->has_expected = true;
+    }
+
+    up->free_q = xQueueCreate(OTA_UPLOAD_BUFFERS, sizeof(uint8_t*));
+    up->full_q = xQueueCreate(OTA_UPLOAD_BUFFERS + 1, sizeof(ota_chunk_t));    // + end marker
+    up->done = xSemaphoreCreateBinary();
+    if (!up->free_q || !up->full_q || !up->done) {
+        goto fail_free;
+    }
+    for (int i = 0; i < OTA_UPLOAD_BUFFERS; i++) {
+        up->bufs[i] = diag_mem_alloc(DIAG_MEM_OTA, CONFIG_OTA_MGR_CHUNK_SIZE);
+        if (up->bufs[i] == NULL) {
+            goto fail_free;
+        }
+        xQueueSend(up->free_q, &up->bufs[i], 0);
+    }
+
+    ret = ota_decoder_begin(&up->dec);
+    if (ret != ESP_OK) {
+        goto fail_free;
+    }
+    up->dec_open = true;
+    mbedtls_sha256_starts(&up->sha, 0);
+
+    event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_BEGIN, NULL, 0, pdMS_TO_TICKS(100));
+    progress_start(OTA_MGR_SOURCE_UPLOAD, (uint32_t)image_size, 0);
+
+    if (xTaskCreate(ota_writer_task, "ota_writer", OTA_WRITER_STACK_SIZE, up,
+                    OTA_TASK_PRIORITY, &up->writer) != pdPASS) {
+        progress_stop();
+        ota_decoder_abort(&up->dec);
+        ret = ESP_ERR_NO_MEM;
+        goto fail_free;
+    }
+
+    ESP_LOGI(TAG, "Receiving %u byte image into %s", (unsigned)image_size, partition->label);
+    *out = up;
+    return ESP_OK;
+
+fail_free:
+    upload_free(up);
+fail:
+    s_ota_in_progress = false;
+    xSemaphoreGive(s_ota_guard);
+    return ret;
+}
+
+esp_err_t ota_mgr_upload_get_buffer(ota_mgr_upload_t* up, uint8_t** buf, size_t* cap)
+{
+    if (up == NULL || buf == NULL || cap == NULL || up->filling != NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (up->err != ESP_OK) {
+        return up->err;
+    }
+    if (xQueueReceive(up->free_q, &up->filling, pdMS_TO_TICKS(OTA_BUFFER_WAIT_MS)) != pdTRUE) {
+        up->filling = NULL;
+        return ESP_ERR_TIMEOUT;
+    }
+    *buf = up->filling;
+    *cap = CONFIG_OTA_MGR_CHUNK_SIZE;
     return ESP_OK;
 }
+
+esp_err_t ota_mgr_upload_submit(ota_mgr_upload_t* up, size_t len)
+{
+    if (up == NULL || up->filling == NULL || len == 0 || len > CONFIG_OTA_MGR_CHUNK_SIZE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ota_chunk_t chunk = { .data = up->filling, .len = len };
+    up->filling = NULL;
+    // Never blocks: at most OTA_UPLOAD_BUFFERS chunks are outstanding
+    xQueueSend(up->full_q, &chunk, portMAX_DELAY);
+    return up->err;
+}
+
+esp_err_t ota_mgr_upload_finish(ota_mgr_upload_t* up, uint8_t sha256_out[32])
+{
+    if (up == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    upload_drain(up);
+
+    esp_err_t ret = up->err;
+    if (ret == ESP_OK && up->written != up->size) {
+        ESP_LOGE(TAG, "Image incomplete: %u of %u bytes", (unsigned)up->written, (unsigned)up->size);
+        ret = ESP_ERR_INVALID_SIZE;
+    }
+    if (ret != ESP_OK) {
+        upload_fail(up, ret);
+        return ret;
+    }
+
+    uint8_t digest[HASH_LEN];
+    mbedtls_sha256_finish(&up->sha, digest);
+    print_sha256(digest, "SHA-256 of received image");
+    if (sha256_out) {
+        memcpy(sha256_out, digest, HASH_LEN);
+    }
+    if (up->has_expected && memcmp(digest, up->expected, HASH_LEN) != 0) {
+        print_sha256(up->expected, "Expected SHA-256");
+        upload_fail(up, ESP_ERR_INVALID_CRC);
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    up->dec_open = false;
+    ret = ota_decoder_end(&up->dec);
+    if (ret != ESP_OK) {
+        if (ret == ESP_ERR_OTA_VALIDATE_FAILED) {
+            ESP_LOGE(TAG, "Image validation failed, image is corrupted");
+        }
+        upload_fail(up, ret);
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "OTA upload succeeded, rebooting in %d ms", OTA_REBOOT_DELAY_MS);
+    config_mgr_set_u32("ota/last_result", (uint32_t)ESP_OK);
+    if (up->dec.has_desc) {
+        config_mgr_set_string("ota/last_version", up->dec.desc.version);
+    }
+    upload_free(up);
+    progress_stop();
+    event_bus_post(DEVICE_EVENT, DEVICE_EVENT_OTA_SUCCESS, NULL, 0, pdMS_TO_TICKS(100));
+
+    s_ota_in_progress = false;
+    xSemaphoreGive(s_ota_guard);
+
+    // The caller still has a response to send
+    const esp_timer_create_args_t timer_args = {
+        .callback = ota_restart_cb,
+        .name = "ota_reboot",
+    };
+    esp_timer_handle_t timer = NULL;
+    if (esp_timer_create(&timer_args, &timer) != ESP_OK ||
+        esp_timer_start_once(timer, OTA_REBOOT_DELAY_MS * 1000ULL) != ESP_OK) {
+        ESP_LOGW(TAG, "Reboot timer unavailable, restarting now");
+        esp_restart();
+    }
+    return ESP_OK;
+}
+
+void ota_mgr_upload_abort(ota_mgr_upload_t* up)
+{
+    if (up == NULL) {
+        return;
+    }
+    upload_drain(up);
+    upload_fail(up, up->err != ESP_OK ? up->err : ESP_FAIL);
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""Build a delta OTA image that ota_mgr rebuilds from the running firmware.
+
+Layout (little-endian, matches "Image decoding" in ota_mgr.c):
+  header  magic "ODL1", u16 version, u16 reserved, u32 target_size,
+          app_elf_sha256[32] of the base firmware
+  ops     until target_size bytes are produced
+          u8 1 (COPY), u32 src, u32 len   bytes from the running app partition
+          u8 2 (DATA), u32 len, bytes     literal bytes
+
+The device refuses a delta whose base hash is not its running app, so
+base.bin must be the exact image it runs (build/<project>.bin). With
+--gzip the delta is gzipped as well, which ota_mgr also inflates.
+"""
+import gzip
+import struct
+import sys
+
+MAGIC = b"ODL1"
+VERSION = 1
+OP_COPY = 1
+OP_DATA = 2
+BLOCK = 32                  # Shortest copy worth an op
+ALIGN = 4                   # Base offsets indexed (code and data move in words)
+ELF_SHA_OFFSET = 24 + 8 + 144   # Image header, first segment header, esp_app_desc_t.app_elf_sha256
+
+HEADER = struct.Struct("<4sHHI32s")
+
+
+def index_base(base):
+    blocks = {}
+    for ofs in range(0, len(base) - BLOCK + 1, ALIGN):
+        blocks.setdefault(base[ofs:ofs + BLOCK], ofs)
+    return blocks
+
+
+def match_len(base, src, new, dst):
+    n = 0
+    limit = min(len(base) - src, len(new) - dst)
+    while n < limit and base[src + n] == new[dst + n]:
+        n += 1
+    return n
+
+
+def diff(base, new):
+    blocks = index_base(base)
+    ops = []
+    literal = bytearray()
+    pos = 0
+    next_src = 0            # Where the last copy ended: insertions keep the rest in place
+
+    while pos < len(new):
+        src = None
+        if next_src + BLOCK <= len(base) and base[next_src:next_src + BLOCK] == new[pos:pos + BLOCK]:
+            src = next_src
+        else:
+            src = blocks.get(new[pos:pos + BLOCK])
+        if src is None:
+            literal.append(new[pos])
+            pos += 1
+            continue
+
+        n = match_len(base, src, new, pos)
+        if literal:
+            ops.append((OP_DATA, bytes(literal)))
+            literal = bytearray()
+        ops.append((OP_COPY, src, n))
+        pos += n
+        next_src = src + n
+
+    if literal:
+        ops.append((OP_DATA, bytes(literal)))
+    return ops
+
+
+def main():
+    args = [a for a in sys.argv[1:] if a != "--gzip"]
+    if len(args) != 3:
+        sys.exit("usage: mkdelta.py <base.bin> <new.bin> <output.bin> [--gzip]")
+    with open(args[0], "rb") as f:
+        base = f.read()
+    with open(args[1], "rb") as f:
+        new = f.read()
+    if len(base) < ELF_SHA_OFFSET + 32 or base[0] != 0xE9:
+        sys.exit("mkdelta: %s is not an app image" % args[0])
+
+    out = bytearray(HEADER.pack(MAGIC, VERSION, 0, len(new), base[ELF_SHA_OFFSET:ELF_SHA_OFFSET + 32]))
+    copied = 0
+    for op in diff(base, new):
+        if op[0] == OP_COPY:
+            out += struct.pack("<BII", OP_COPY, op[1], op[2])
+            copied += op[2]
+        else:
+            out += struct.pack("<BI", OP_DATA, len(op[1])) + op[1]
+    if "--gzip" in sys.argv[1:]:
+        out = gzip.compress(bytes(out), compresslevel=9, mtime=0)
+
+    with open(args[2], "wb") as f:
+        f.write(out)
+    print("mkdelta: %d byte image, %d bytes copied from base, %d byte delta" % (len(new), copied, len(out)))
+
+
+if __name__ == "__main__":
+    main()
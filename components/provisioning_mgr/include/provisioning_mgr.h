@@ -1,5 +1,6 @@
 #pragma once
 #include "esp_err.h"
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -8,6 +9,14 @@ extern "C" {
 esp_err_t provisioning_mgr_start_if_needed(void);
 esp_err_t provisioning_mgr_stop(void);
 
+/**
+ * Internal RAM returned to the heap by releasing the BT stack (bytes)
+ * Set once BLE provisioning has ended, or at startup when provisioning is
+ * skipped or uses SoftAP (PROVISIONING_MGR_RELEASE_BT). 0 until then, and
+ * always 0 in builds without BT. Also exported as prov_bt_reclaimed_bytes.
+ */
+uint32_t provisioning_mgr_get_bt_reclaimed(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,4 +1,4 @@
-/* Provisioning Manager - BLE Wi-Fi Provisioning - Adapted from ESP-IDF wifi_prov_mgr example
+/* Provisioning Manager - BLE or SoftAP Wi-Fi Provisioning - Adapted from ESP-IDF wifi_prov_mgr example
  * Reference: D:\esp\esp-idf\examples\provisioning\wifi_prov_mgr\
  */
 
@@ -6,18 +6,38 @@
 #include "config_mgr.h"
 #include "event_bus.h"
 #include "net_mgr.h"
+#include "diag.h"
+#include "sdkconfig.h"
 #include "esp_log.h"
 #include "esp_wifi.h"
 #include "esp_event.h"
+#include "esp_heap_caps.h"
 #include "wifi_provisioning/manager.h"
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE
 #include "wifi_provisioning/scheme_ble.h"
+#else
+#include "esp_netif.h"
+#include "wifi_provisioning/scheme_softap.h"
+#endif
+#if CONFIG_BT_ENABLED
+#include "esp_bt.h"
+#endif
 #include <string.h>
 
 static const char *TAG = "prov_mgr";
 
+// BT memory can be released in this build, explicitly or by the BLE scheme
+#define PROV_BT_RECLAIM (CONFIG_PROVISIONING_MGR_RELEASE_BT || \
+                         (CONFIG_PROVISIONING_MGR_TRANSPORT_BLE && !CONFIG_WIFI_PROV_KEEP_BLE_ON_AFTER_PROV))
+
 // State
 static bool s_is_provisioning = false;
 static char s_pop[33] = {0};  // PoP derived from device_id (used directly as Security 1 param)
+static bool s_bt_released = false;  // BT memory handed back to the heap (until reboot)
+static uint32_t s_bt_reclaimed = 0; // Internal RAM gained by releasing it (bytes)
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_SOFTAP
+static esp_netif_t* s_ap_netif = NULL;
+#endif
 
 // Forward declarations
 static void prov_event_handler(void* arg, esp_event_base_t event_base,
@@ -30,12 +50,96 @@ static void prov_event_handler(void* arg, esp_event_base_t event_base,
 static void unregister_event_handlers(void)
 {
     esp_event_handler_unregister(WIFI_PROV_EVENT, ESP_EVENT_ANY_ID, &prov_event_handler);
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE
     esp_event_handler_unregister(PROTOCOMM_TRANSPORT_BLE_EVENT, ESP_EVENT_ANY_ID,
                                   &prov_event_handler);
+#endif
     esp_event_handler_unregister(PROTOCOMM_SECURITY_SESSION_EVENT, ESP_EVENT_ANY_ID,
                                   &prov_event_handler);
 }
 
+#if PROV_BT_RECLAIM
+static uint32_t internal_free(void)
+{
+    return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+}
+
+/**
+ * Record the internal RAM gained since before was sampled
+ * Logged and exported as prov_bt_reclaimed_bytes.
+ */
+static void record_bt_released(uint32_t before, const char* why)
+{
+    uint32_t after = internal_free();
+    s_bt_reclaimed += (after > before) ? after - before : 0;
+    s_bt_released = true;
+
+    diag_metric_set(diag_metric_gauge("prov_bt_reclaimed_bytes",
+                                      "Internal RAM returned to the heap by releasing the BT stack"),
+                    (int32_t)s_bt_reclaimed);
+    ESP_LOGI(TAG, "BT stack released (%s): %lu bytes of internal RAM reclaimed, %lu free",
+             why, (unsigned long)s_bt_reclaimed, (unsigned long)after);
+}
+#endif
+
+/**
+ * Shut down the BT controller and release controller and NimBLE host memory
+ * esp_bt_mem_release() adds their static DRAM to the heap and cannot be
+ * undone: BLE is unavailable until the next reboot.
+ */
+static void release_bt_memory(const char* why)
+{
+#if CONFIG_PROVISIONING_MGR_RELEASE_BT
+    if (s_bt_released) {
+        return;
+    }
+
+    uint32_t before = internal_free();
+
+    // Only provisioning uses BT here; stop the controller if it is still up
+    if (esp_bt_controller_get_status() == ESP_BT_CONTROLLER_STATUS_ENABLED) {
+        esp_bt_controller_disable();
+    }
+    if (esp_bt_controller_get_status() == ESP_BT_CONTROLLER_STATUS_INITED) {
+        esp_bt_controller_deinit();
+    }
+
+    esp_err_t ret = esp_bt_mem_release(ESP_BT_MODE_BTDM);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to release BT memory: %s", esp_err_to_name(ret));
+        return;
+    }
+    record_bt_released(before, why);
+#else
+    (void)why;
+#endif
+}
+
+/**
+ * Deinit the provisioning manager
+ * With BLE, the FREE_BTDM scheme handler releases controller and host
+ * memory on deinit; the heap gained is recorded like an explicit release.
+ */
+static void prov_mgr_deinit(void)
+{
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE && !CONFIG_WIFI_PROV_KEEP_BLE_ON_AFTER_PROV
+    uint32_t before = internal_free();
+    wifi_prov_mgr_deinit();
+    if (!s_bt_released) {
+        record_bt_released(before, "provisioning ended");
+    }
+#else
+    wifi_prov_mgr_deinit();
+#endif
+
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_SOFTAP
+    if (s_ap_netif) {
+        esp_netif_destroy_default_wifi(s_ap_netif);
+        s_ap_netif = NULL;
+    }
+#endif
+}
+
 /**
  * Generate Proof of Possession from device_id
  * Uses hardcoded PoP for consistent provisioning
@@ -54,7 +158,7 @@ static esp_err_t generate_pop_from_device_id(char* pop, size_t pop_len)
 }
 
 /**
- * Generate BLE service name from MAC address
+ * Generate service name (BLE device name or SoftAP SSID) from MAC address
  * Format: "PROV_XXXXXX" where X are last 3 bytes of MAC in hex
  */
 static void generate_service_name(char* service_name, size_t max_len)
@@ -66,7 +170,7 @@ static void generate_service_name(char* service_name, size_t max_len)
     snprintf(service_name, max_len, "%s%02X%02X%02X",
              prefix, eth_mac[3], eth_mac[4], eth_mac[5]);
 
-    ESP_LOGI(TAG, "BLE service name: %s", service_name);
+    ESP_LOGI(TAG, "Provisioning service name: %s", service_name);
 }
 
 /**
@@ -125,7 +229,7 @@ static void prov_event_handler(void* arg, esp_event_base_t event_base,
 
             case WIFI_PROV_END:
                 ESP_LOGI(TAG, "Provisioning ended, deinitializing manager");
-                wifi_prov_mgr_deinit();
+                prov_mgr_deinit();
                 unregister_event_handlers();  // Cleanup handlers to allow future provisioning
                 s_is_provisioning = false;
                 break;
@@ -133,6 +237,7 @@ static void prov_event_handler(void* arg, esp_event_base_t event_base,
             default:
                 break;
         }
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE
     } else if (event_base == PROTOCOMM_TRANSPORT_BLE_EVENT) {
         switch (event_id) {
             case PROTOCOMM_TRANSPORT_BLE_CONNECTED:
@@ -146,6 +251,7 @@ static void prov_event_handler(void* arg, esp_event_base_t event_base,
             default:
                 break;
         }
+#endif
     } else if (event_base == PROTOCOMM_SECURITY_SESSION_EVENT) {
         switch (event_id) {
             case PROTOCOMM_SECURITY_SESSION_SETUP_OK:
@@ -170,17 +276,30 @@ esp_err_t provisioning_mgr_start_if_needed(void)
 {
     ESP_LOGI(TAG, "Checking provisioning status");
 
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_SOFTAP
+    // BT is built in but SoftAP provisioning never uses it
+    release_bt_memory("SoftAP transport");
+#endif
+
     // Check if WiFi credentials exist in config
     char ssid[33] = {0};
     esp_err_t ret = config_mgr_get_string("wifi/ssid", ssid, sizeof(ssid));
 
     if (ret == ESP_OK && strlen(ssid) > 0) {
         ESP_LOGI(TAG, "Wi-Fi credentials found (SSID: %s), skipping provisioning", ssid);
+        release_bt_memory("provisioning skipped");
         return ESP_OK;
     }
 
     ESP_LOGI(TAG, "No Wi-Fi credentials found, starting provisioning");
 
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE
+    if (s_bt_released) {
+        ESP_LOGE(TAG, "BT memory already released, reboot to provision over BLE");
+        return ESP_ERR_INVALID_STATE;
+    }
+#endif
+
     // Generate PoP from device_id
     ret = generate_pop_from_device_id(s_pop, sizeof(s_pop));
     if (ret != ESP_OK) {
@@ -197,6 +316,7 @@ esp_err_t provisioning_mgr_start_if_needed(void)
         return ret;
     }
 
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE
     ret = esp_event_handler_register(PROTOCOMM_TRANSPORT_BLE_EVENT, ESP_EVENT_ANY_ID,
                                       &prov_event_handler, NULL);
     if (ret != ESP_OK) {
@@ -205,23 +325,38 @@ esp_err_t provisioning_mgr_start_if_needed(void)
         esp_event_handler_unregister(WIFI_PROV_EVENT, ESP_EVENT_ANY_ID, &prov_event_handler);
         return ret;
     }
+#endif
 
     ret = esp_event_handler_register(PROTOCOMM_SECURITY_SESSION_EVENT, ESP_EVENT_ANY_ID,
                                       &prov_event_handler, NULL);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register PROTOCOMM event handler: %s",
                  esp_err_to_name(ret));
-        esp_event_handler_unregister(WIFI_PROV_EVENT, ESP_EVENT_ANY_ID, &prov_event_handler);
-        esp_event_handler_unregister(PROTOCOMM_TRANSPORT_BLE_EVENT, ESP_EVENT_ANY_ID,
-                                      &prov_event_handler);
+        unregister_event_handlers();
         return ret;
     }
 
     // Configuration for provisioning manager
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE
     wifi_prov_mgr_config_t config = {
         .scheme = wifi_prov_scheme_ble,  // Use BLE transport
         .scheme_event_handler = WIFI_PROV_SCHEME_BLE_EVENT_HANDLER_FREE_BTDM  // Free BT/BLE after provisioning
     };
+#else
+    // The SoftAP scheme needs an AP interface next to net_mgr's STA one
+    if (!s_ap_netif) {
+        s_ap_netif = esp_netif_create_default_wifi_ap();
+        if (!s_ap_netif) {
+            ESP_LOGE(TAG, "Failed to create SoftAP interface");
+            unregister_event_handlers();
+            return ESP_FAIL;
+        }
+    }
+    wifi_prov_mgr_config_t config = {
+        .scheme = wifi_prov_scheme_softap,
+        .scheme_event_handler = WIFI_PROV_EVENT_HANDLER_NONE
+    };
+#endif
 
     // Initialize provisioning manager
     ret = wifi_prov_mgr_init(config);
@@ -237,19 +372,19 @@ esp_err_t provisioning_mgr_start_if_needed(void)
     ret = wifi_prov_mgr_is_provisioned(&provisioned);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to check provisioning status: %s", esp_err_to_name(ret));
-        wifi_prov_mgr_deinit();
+        prov_mgr_deinit();
         unregister_event_handlers();  // Cleanup handlers on error
         return ret;
     }
 
     if (provisioned) {
         ESP_LOGI(TAG, "Device already provisioned (via prov_mgr state), deinitializing");
-        wifi_prov_mgr_deinit();
+        prov_mgr_deinit();
         unregister_event_handlers();  // Cleanup handlers (not an error, but exiting early)
         return ESP_OK;
     }
 
-    // Generate BLE service name
+    // Generate service name (BLE device name / SoftAP SSID)
     char service_name[12];
     generate_service_name(service_name, sizeof(service_name));
 
@@ -257,6 +392,8 @@ esp_err_t provisioning_mgr_start_if_needed(void)
     // In ESP-IDF, wifi_prov_security1_params_t is just const char* alias
     wifi_prov_security_t security = WIFI_PROV_SECURITY_1;
     const char* sec_params = s_pop;  // PoP string directly
+
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE
     const char* service_key = NULL;  // Not used for BLE
 
     // Set custom BLE service UUID (optional, for device identification)
@@ -265,22 +402,34 @@ esp_err_t provisioning_mgr_start_if_needed(void)
         0xea, 0x4a, 0x82, 0x03, 0x04, 0x90, 0x1a, 0x02,
     };
     wifi_prov_scheme_ble_set_service_uuid(custom_service_uuid);
+#else
+    // SoftAP WPA2 password (NULL = open network)
+    const char* service_key = CONFIG_PROVISIONING_MGR_SOFTAP_PASS[0] ? CONFIG_PROVISIONING_MGR_SOFTAP_PASS : NULL;
+#endif
 
     // Start provisioning service
     ret = wifi_prov_mgr_start_provisioning(security, sec_params,
                                              service_name, service_key);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to start provisioning: %s", esp_err_to_name(ret));
-        wifi_prov_mgr_deinit();
+        prov_mgr_deinit();
         unregister_event_handlers();  // Cleanup handlers on error
         return ret;
     }
 
     s_is_provisioning = true;
+#if CONFIG_PROVISIONING_MGR_TRANSPORT_BLE
     ESP_LOGI(TAG, "Provisioning started - BLE service: %s, PoP: %s", service_name, s_pop);
 
     // Log QR code info for manual provisioning (optional)
     ESP_LOGI(TAG, "Scan QR code or use ESP BLE Prov app");
+#else
+    ESP_LOGI(TAG, "Provisioning started - SoftAP SSID: %s (%s), PoP: %s", service_name,
+             service_key ? "WPA2" : "open", s_pop);
+
+    // Log QR code info for manual provisioning (optional)
+    ESP_LOGI(TAG, "Scan QR code or use ESP SoftAP Prov app");
+#endif
     ESP_LOGI(TAG, "Service: %s, PoP: %s", service_name, s_pop);
 
     return ESP_OK;
@@ -300,9 +449,14 @@ esp_err_t provisioning_mgr_stop(void)
 
     // Stop and deinit provisioning manager
     wifi_prov_mgr_stop_provisioning();
-    wifi_prov_mgr_deinit();
+    prov_mgr_deinit();
 
     s_is_provisioning = false;
 
     return ESP_OK;
 }
+
+uint32_t provisioning_mgr_get_bt_reclaimed(void)
+{
+    return s_bt_reclaimed;
+}
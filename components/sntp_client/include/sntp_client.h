@@ -2,6 +2,8 @@
 
 #include "esp_err.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <time.h>
 
 #ifdef __cplusplus
@@ -16,12 +18,57 @@ extern "C" {
  * - Stops sync when DEVICE_EVENT_NET_LOST received
  * - Reloads config when signaled via sntp_client_reload_config()
  *
- * Uses ESP-IDF's esp_netif_sntp component with:
- * - Primary and secondary NTP servers for redundancy
+ * Runs its own NTP (RFC 5905 client mode) exchange:
+ * - Primary and secondary servers are queried in parallel each poll; the
+ *   reply with the shortest round trip is used
+ * - Offsets up to CONFIG_SNTP_CLIENT_STEP_MS are slewed with adjtime(),
+ *   larger ones (and the first sync after boot) step the clock
+ * - The poll interval doubles from CONFIG_SNTP_CLIENT_MIN_POLL_S to
+ *   CONFIG_SNTP_CLIENT_MAX_POLL_S once synced; failures back off from 2 s
+ * - Successive samples give the drift of the local crystal, which
+ *   sntp_client_now_us() corrects for between polls
  * - Automatic timezone application after sync
- * - Exponential backoff on sync failures
  */
 
+#define SNTP_CLIENT_SERVER_COUNT 2
+
+/**
+ * How far sntp_client_now_us() can be trusted
+ */
+typedef enum {
+    SNTP_TIME_QUALITY_NONE = 0,     // Never synced: system clock as is
+    SNTP_TIME_QUALITY_HOLDOVER,     // Synced before, free-running on the drift estimate since
+    SNTP_TIME_QUALITY_SYNCED,       // Last poll succeeded
+} sntp_time_quality_t;
+
+/**
+ * Last reply from one server
+ */
+typedef struct {
+    char host[64];
+    bool reachable;             // Last poll got a usable reply
+    uint8_t stratum;
+    int32_t offset_us;          // System clock offset (server - local)
+    uint32_t delay_us;          // Round trip, server processing time excluded
+    uint32_t replies;
+    uint32_t failures;          // DNS failures, timeouts and unusable replies
+} sntp_client_server_stats_t;
+
+typedef struct {
+    sntp_time_quality_t quality;
+    uint32_t error_us;          // Current error bound (UINT32_MAX if never synced)
+    int64_t last_sync_us;       // Unix time of the last accepted sample, µs
+    int32_t offset_us;          // Offset corrected by that sample
+    uint32_t delay_us;
+    int32_t drift_ppb;          // Local clock rate error, + = fast
+    bool drift_known;           // Needs two samples at least 60 s apart
+    uint8_t server;             // Index of the server that sample came from
+    uint32_t poll_s;
+    uint32_t steps;
+    uint32_t slews;
+    sntp_client_server_stats_t servers[SNTP_CLIENT_SERVER_COUNT];
+} sntp_client_time_stats_t;
+
 /**
  * SNTP sync status
  */
@@ -78,6 +125,24 @@ esp_err_t sntp_client_get_status(sntp_status_t* status_out);
  */
 esp_err_t sntp_client_get_last_sync_time(time_t* time_out);
 
+/**
+ * Current Unix time in microseconds
+ *
+ * Projected from the last NTP sample on esp_timer with the drift estimate,
+ * so it is monotonic between polls and unaffected by slewing. Safe to call
+ * at high rate (no syscall, one spinlock).
+ *
+ * @param err_us Receives the error bound (may be NULL); UINT32_MAX if never synced
+ * @param quality Receives the time quality (may be NULL)
+ * @return Unix time in µs (the system clock while never synced)
+ */
+int64_t sntp_client_now_us(uint32_t* err_us, sntp_time_quality_t* quality);
+
+/**
+ * Get clock model and per-server statistics
+ */
+esp_err_t sntp_client_get_time_stats(sntp_client_time_stats_t* out);
+
 /**
  * Get current timezone string
  *
@@ -6,12 +6,15 @@
 #include "config_mgr.h"
 #include "event_bus.h"
 #include "net_mgr.h"
+#include "diag.h"
 #include "esp_log.h"
-#include "esp_sntp.h"
-#include "esp_netif_sntp.h"
+#include "esp_timer.h"
+#include "lwip/sockets.h"
+#include "lwip/netdb.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <sys/time.h>
@@ -28,21 +31,369 @@ static bool s_should_run = false;
 static EventGroupHandle_t s_sntp_event_group = NULL;
 #define SNTP_CONFIG_CHANGED_BIT BIT0
 #define SNTP_NETWORK_READY_BIT  BIT1
+#define SNTP_NETWORK_LOST_BIT   BIT2    // Wakes the poll wait; READY tells the current state
 
 // Current configuration (cached)
 static char s_server_primary[128] = {0};
 static char s_server_secondary[128] = {0};
 static char s_timezone[64] = {0};
 
+#define NTP_PORT                "123"
+#define NTP_PACKET_SIZE         48
+#define NTP_UNIX_EPOCH_DELTA    2208988800LL    // 1900-01-01 to 1970-01-01, s
+#define NTP_RETRY_MIN_MS        2000
+#define NTP_RETRY_MAX_MS        64000
+#define DRIFT_MIN_INTERVAL_US   (60 * 1000000LL)    // Shorter spans are dominated by delay jitter
+#define DRIFT_MAX_PPB           500000              // Larger rate errors are taken as a bad sample
+#define DRIFT_UNKNOWN_PPB       20000               // Crystal tolerance assumed until drift is measured
+#define DRIFT_FLOOR_PPB         1000
+
+/*
+ * Clock model from the last accepted sample
+ *
+ * True time at esp_timer time m is ref_unix_us + (m - ref_mono_us) corrected
+ * by drift_ppb, the rate error of the local crystal (+ = runs fast). The
+ * model is kept on esp_timer so slewing or stepping the system clock does
+ * not disturb it. Guarded by s_time_lock (read per UDP datagram).
+ */
+static struct {
+    bool valid;
+    int64_t ref_unix_us;
+    int64_t ref_mono_us;
+    uint32_t ref_err_us;            // Error bound at the reference
+    int32_t drift_ppb;
+    uint32_t drift_uncert_ppb;
+    bool drift_known;
+} s_clock;
+static portMUX_TYPE s_time_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Written by the sync task, read by sntp_client_get_time_stats(); guarded by s_time_lock
+static sntp_client_server_stats_t s_server_stats[SNTP_CLIENT_SERVER_COUNT];
+static sntp_client_time_stats_t s_time_stats;   // Last accepted sample
+static uint32_t s_poll_ms = 0;                  // Interval before the next poll after the last success
+
+static diag_metric_t* s_metric_offset;
+static diag_metric_t* s_metric_drift;
+static diag_metric_t* s_metric_steps;
+
+typedef struct {
+    bool valid;
+    int64_t t4_us;                  // System clock at reception
+    int64_t t4_mono_us;
+    int64_t offset_us;
+    int64_t delay_us;
+    uint32_t root_us;               // Server's root delay / 2 + root dispersion
+} ntp_sample_t;
+
+static int64_t system_now_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+static uint32_t get_be32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void put_be32(uint8_t* p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void ntp_put_ts(uint8_t* p, int64_t unix_us)
+{
+    put_be32(p, (uint32_t)(unix_us / 1000000 + NTP_UNIX_EPOCH_DELTA));
+    put_be32(p + 4, (uint32_t)(((uint64_t)(unix_us % 1000000) << 32) / 1000000));
+}
+
+static int64_t ntp_get_ts(const uint8_t* p)
+{
+    int64_t sec = get_be32(p);
+    if (sec < 0x80000000LL) {
+        sec += 1LL << 32;           // Era 1 (from 2036)
+    }
+    uint64_t frac_us = ((uint64_t)get_be32(p + 4) * 1000000) >> 32;
+    return (sec - NTP_UNIX_EPOCH_DELTA) * 1000000LL + (int64_t)frac_us;
+}
+
+// 16.16 fixed-point seconds to µs
+static uint32_t ntp_short_to_us(uint32_t v)
+{
+    return (uint32_t)(((uint64_t)v * 1000000) >> 16);
+}
+
+static int64_t clock_project_locked(int64_t mono_us)
+{
+    int64_t elapsed = mono_us - s_clock.ref_mono_us;
+    return s_clock.ref_unix_us + elapsed - elapsed * s_clock.drift_ppb / 1000000000LL;
+}
+
+static uint32_t clock_error_locked(int64_t mono_us)
+{
+    int64_t err = s_clock.ref_err_us +
+                  (mono_us - s_clock.ref_mono_us) * (int64_t)s_clock.drift_uncert_ppb / 1000000000LL;
+    return (err >= UINT32_MAX) ? UINT32_MAX - 1 : (uint32_t)err;
+}
+
+static int64_t metric_error_fn(void* ctx)
+{
+    (void)ctx;
+    uint32_t err_us = UINT32_MAX;
+    sntp_client_now_us(&err_us, NULL);
+    return (err_us == UINT32_MAX) ? -1 : (int64_t)err_us;
+}
+
 /**
- * Time sync notification callback
- * Called by ESP-IDF when time is synchronized
+ * Count a failed exchange with server i and mark it unreachable
  */
-static void time_sync_notification_cb(struct timeval *tv)
+static void server_failed(int i)
+{
+    taskENTER_CRITICAL(&s_time_lock);
+    s_server_stats[i].reachable = false;
+    s_server_stats[i].failures++;
+    taskEXIT_CRITICAL(&s_time_lock);
+}
+
+/**
+ * Query every configured server at once and keep each answer
+ * Both requests go out back to back on one socket, so the first sync takes
+ * one round trip to the faster server instead of a timeout per dead one.
+ */
+static void ntp_query_servers(ntp_sample_t samples[SNTP_CLIENT_SERVER_COUNT])
+{
+    const char* hosts[SNTP_CLIENT_SERVER_COUNT] = { s_server_primary, s_server_secondary };
+    struct sockaddr_in addrs[SNTP_CLIENT_SERVER_COUNT] = {0};
+    uint8_t sent_ts[SNTP_CLIENT_SERVER_COUNT][8];
+    int64_t sent_us[SNTP_CLIENT_SERVER_COUNT];
+    int pending = 0;
+
+    memset(samples, 0, sizeof(ntp_sample_t) * SNTP_CLIENT_SERVER_COUNT);
+
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        ESP_LOGE(TAG, "Failed to create NTP socket: errno %d", errno);
+        return;
+    }
+
+    uint32_t pending_mask = 0;
+    for (int i = 0; i < SNTP_CLIENT_SERVER_COUNT; i++) {
+        const struct addrinfo hints = { .ai_family = AF_INET, .ai_socktype = SOCK_DGRAM };
+        struct addrinfo* res = NULL;
+        if (hosts[i][0] == '\0' || getaddrinfo(hosts[i], NTP_PORT, &hints, &res) != 0 || res == NULL) {
+            ESP_LOGD(TAG, "Cannot resolve %s", hosts[i]);
+            server_failed(i);
+            continue;
+        }
+        memcpy(&addrs[i], res->ai_addr, sizeof(addrs[i]));
+        freeaddrinfo(res);
+
+        uint8_t req[NTP_PACKET_SIZE] = {0};
+        req[0] = (0 << 6) | (4 << 3) | 3;   // LI 0, version 4, mode 3 (client)
+        sent_us[i] = system_now_us();
+        ntp_put_ts(&req[40], sent_us[i]);   // Echoed back as the origin timestamp
+        memcpy(sent_ts[i], &req[40], 8);
+        if (sendto(sock, req, sizeof(req), 0, (struct sockaddr*)&addrs[i], sizeof(addrs[i])) < 0) {
+            taskENTER_CRITICAL(&s_time_lock);
+            s_server_stats[i].failures++;
+            taskEXIT_CRITICAL(&s_time_lock);
+            continue;
+        }
+        pending_mask |= 1u << i;
+        pending++;
+    }
+
+    int64_t deadline = esp_timer_get_time() + CONFIG_SNTP_CLIENT_TIMEOUT_MS * 1000LL;
+    while (pending > 0) {
+        int64_t left = deadline - esp_timer_get_time();
+        if (left <= 0) {
+            break;
+        }
+        struct timeval tv = { .tv_sec = left / 1000000, .tv_usec = left % 1000000 };
+        fd_set rfds;
+        FD_ZERO(&rfds);
+        FD_SET(sock, &rfds);
+        if (select(sock + 1, &rfds, NULL, NULL, &tv) <= 0) {
+            break;
+        }
+
+        uint8_t resp[NTP_PACKET_SIZE];
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        int len = recvfrom(sock, resp, sizeof(resp), 0, (struct sockaddr*)&from, &from_len);
+        int64_t t4 = system_now_us();
+        int64_t t4_mono = esp_timer_get_time();
+        if (len < NTP_PACKET_SIZE) {
+            continue;
+        }
+
+        // Match by source and origin timestamp: stale or spoofed replies fail both
+        int i = 0;
+        while (i < SNTP_CLIENT_SERVER_COUNT &&
+               !((pending_mask & (1u << i)) &&
+                 from.sin_addr.s_addr == addrs[i].sin_addr.s_addr &&
+                 from.sin_port == addrs[i].sin_port &&
+                 memcmp(&resp[24], sent_ts[i], 8) == 0)) {
+            i++;
+        }
+        if (i == SNTP_CLIENT_SERVER_COUNT) {
+            continue;
+        }
+        pending_mask &= ~(1u << i);
+        pending--;
+
+        uint8_t leap = resp[0] >> 6;
+        uint8_t mode = resp[0] & 0x07;
+        uint8_t stratum = resp[1];
+        if (mode != 4 || leap == 3 || stratum == 0 || stratum > 15) {
+            // Kiss-o'-death or an unsynchronized server
+            ESP_LOGD(TAG, "%s: unusable reply (mode %u, LI %u, stratum %u)", hosts[i], mode, leap, stratum);
+            server_failed(i);
+            continue;
+        }
+
+        int64_t t1 = sent_us[i];
+        int64_t t2 = ntp_get_ts(&resp[32]);
+        int64_t t3 = ntp_get_ts(&resp[40]);
+        ntp_sample_t* smp = &samples[i];
+        smp->valid = true;
+        smp->t4_us = t4;
+        smp->t4_mono_us = t4_mono;
+        smp->offset_us = ((t2 - t1) + (t3 - t4)) / 2;
+        smp->delay_us = (t4 - t1) - (t3 - t2);
+        if (smp->delay_us < 0) {
+            smp->delay_us = 0;
+        }
+        smp->root_us = ntp_short_to_us(get_be32(&resp[4])) / 2 + ntp_short_to_us(get_be32(&resp[8]));
+
+        int32_t offset_us = (int32_t)((smp->offset_us > INT32_MAX) ? INT32_MAX :
+                                      (smp->offset_us < INT32_MIN) ? INT32_MIN : smp->offset_us);
+        taskENTER_CRITICAL(&s_time_lock);
+        sntp_client_server_stats_t* st = &s_server_stats[i];
+        st->reachable = true;
+        st->stratum = stratum;
+        st->offset_us = offset_us;
+        st->delay_us = (uint32_t)smp->delay_us;
+        st->replies++;
+        taskEXIT_CRITICAL(&s_time_lock);
+    }
+
+    for (int i = 0; i < SNTP_CLIENT_SERVER_COUNT; i++) {
+        if (pending_mask & (1u << i)) {
+            server_failed(i);
+        }
+    }
+    close(sock);
+}
+
+/**
+ * Feed an accepted sample into the clock model and the system clock
+ * Offsets up to CONFIG_SNTP_CLIENT_STEP_MS are slewed with adjtime(); the
+ * first sample after boot and larger errors step the clock.
+ */
+static void clock_update(const ntp_sample_t* smp, int server)
+{
+    int64_t true_us = smp->t4_us + smp->offset_us;
+    uint32_t err_us = (uint32_t)(smp->delay_us / 2) + smp->root_us;
+    bool was_valid;
+    int32_t offset_us;
+    int32_t drift_ppb;
+
+    taskENTER_CRITICAL(&s_time_lock);
+    was_valid = s_clock.valid;
+    if (was_valid) {
+        int64_t elapsed = smp->t4_mono_us - s_clock.ref_mono_us;
+        if (elapsed >= DRIFT_MIN_INTERVAL_US) {
+            // What the model got wrong over elapsed is a rate error
+            int64_t innovation = true_us - clock_project_locked(smp->t4_mono_us);
+            int64_t rate_ppb = -innovation * 1000000000LL / elapsed;
+            if (rate_ppb > -DRIFT_MAX_PPB && rate_ppb < DRIFT_MAX_PPB) {
+                int32_t correction = s_clock.drift_known ? (int32_t)(rate_ppb / 4) : (int32_t)rate_ppb;
+                s_clock.drift_ppb += correction;
+                s_clock.drift_uncert_ppb = (uint32_t)abs(correction);
+                if (s_clock.drift_uncert_ppb < DRIFT_FLOOR_PPB) {
+                    s_clock.drift_uncert_ppb = DRIFT_FLOOR_PPB;
+                }
+                s_clock.drift_known = true;
+            }
+        }
+    } else {
+        s_clock.drift_ppb = 0;
+        s_clock.drift_uncert_ppb = DRIFT_UNKNOWN_PPB;
+        s_clock.drift_known = false;
+    }
+    s_clock.valid = true;
+    s_clock.ref_unix_us = true_us;
+    s_clock.ref_mono_us = smp->t4_mono_us;
+    s_clock.ref_err_us = err_us;
+
+    offset_us = s_server_stats[server].offset_us;
+    drift_ppb = s_clock.drift_ppb;
+    s_time_stats.offset_us = offset_us;
+    s_time_stats.delay_us = (uint32_t)smp->delay_us;
+    s_time_stats.drift_ppb = drift_ppb;
+    s_time_stats.drift_known = s_clock.drift_known;
+    s_time_stats.server = (uint8_t)server;
+    s_time_stats.last_sync_us = true_us;
+    taskEXIT_CRITICAL(&s_time_lock);
+
+    if (!was_valid || llabs(smp->offset_us) > CONFIG_SNTP_CLIENT_STEP_MS * 1000LL) {
+        int64_t now = system_now_us() + smp->offset_us;
+        struct timeval tv = { .tv_sec = now / 1000000, .tv_usec = now % 1000000 };
+        settimeofday(&tv, NULL);
+        taskENTER_CRITICAL(&s_time_lock);
+        s_time_stats.steps++;
+        taskEXIT_CRITICAL(&s_time_lock);
+        diag_metric_inc(s_metric_steps);
+        ESP_LOGI(TAG, "Clock stepped by %lld us (server %d, delay %lld us)",
+                 (long long)smp->offset_us, server + 1, (long long)smp->delay_us);
+    } else {
+        struct timeval delta = { .tv_sec = smp->offset_us / 1000000, .tv_usec = smp->offset_us % 1000000 };
+        adjtime(&delta, NULL);
+        taskENTER_CRITICAL(&s_time_lock);
+        s_time_stats.slews++;
+        taskEXIT_CRITICAL(&s_time_lock);
+        ESP_LOGD(TAG, "Slewing %lld us (server %d, delay %lld us, drift %ld ppb)",
+                 (long long)smp->offset_us, server + 1, (long long)smp->delay_us, (long)drift_ppb);
+    }
+    s_last_sync_time = (time_t)(true_us / 1000000);
+
+    diag_metric_set(s_metric_offset, offset_us);
+    diag_metric_set(s_metric_drift, drift_ppb);
+}
+
+/**
+ * One poll of both servers; the reply with the shortest round trip wins
+ * (its offset has the smallest possible asymmetry error)
+ */
+static bool sntp_sync_once(void)
+{
+    ntp_sample_t samples[SNTP_CLIENT_SERVER_COUNT];
+    ntp_query_servers(samples);
+
+    int best = -1;
+    for (int i = 0; i < SNTP_CLIENT_SERVER_COUNT; i++) {
+        if (samples[i].valid && (best < 0 || samples[i].delay_us < samples[best].delay_us)) {
+            best = i;
+        }
+    }
+    if (best < 0) {
+        return false;
+    }
+    clock_update(&samples[best], best);
+    return true;
+}
+
+/**
+ * First sync of a session: apply the timezone and announce the time
+ */
+static void time_synced(void)
 {
     ESP_LOGI(TAG, "Time synchronized via SNTP");
-    s_last_sync_time = tv->tv_sec;
-    s_status = SNTP_STATUS_SYNCED;
 
     // Apply timezone
     if (strlen(s_timezone) > 0) {
@@ -111,43 +462,6 @@ static esp_err_t load_config(void)
     return ESP_OK;
 }
 
-/**
- * Initialize SNTP with current configuration
- */
-static esp_err_t init_sntp(void)
-{
-    ESP_LOGI(TAG, "Initializing SNTP...");
-
-    // Configure SNTP
-    esp_sntp_config_t config = ESP_NETIF_SNTP_DEFAULT_CONFIG_MULTIPLE(2,
-                               ESP_SNTP_SERVER_LIST(s_server_primary, s_server_secondary));
-    config.sync_cb = time_sync_notification_cb;
-    config.smooth_sync = true;  // Smooth time adjustment instead of step
-
-    // Initialize SNTP
-    esp_err_t ret = esp_netif_sntp_init(&config);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize SNTP: %s", esp_err_to_name(ret));
-        s_status = SNTP_STATUS_ERROR;
-        return ret;
-    }
-
-    ESP_LOGI(TAG, "SNTP initialized successfully");
-    s_status = SNTP_STATUS_SYNCING;
-
-    return ESP_OK;
-}
-
-/**
- * Deinitialize SNTP
- */
-static void deinit_sntp(void)
-{
-    ESP_LOGI(TAG, "Deinitializing SNTP...");
-    esp_netif_sntp_deinit();
-    s_status = SNTP_STATUS_IDLE;
-}
-
 /**
  * Event handler for network state changes
  * - NET_READY: Set network ready bit to allow sync attempts
@@ -169,6 +483,7 @@ static void sntp_network_event_handler(void* arg, esp_event_base_t event_base,
             ESP_LOGW(TAG, "Network lost, pausing SNTP sync");
             if (s_sntp_event_group) {
                 xEventGroupClearBits(s_sntp_event_group, SNTP_NETWORK_READY_BIT);
+                xEventGroupSetBits(s_sntp_event_group, SNTP_NETWORK_LOST_BIT);
             }
         }
     }
@@ -223,21 +538,37 @@ static void sntp_client_task(void* arg)
             continue;  // Reload config and try again
         }
 
-        // Initialize SNTP
-        if (init_sntp() != ESP_OK) {
-            ESP_LOGE(TAG, "SNTP initialization failed, retrying in 30s...");
-            vTaskDelay(pdMS_TO_TICKS(30000));
-            continue;
-        }
+        // Poll until the network goes or the config changes: retries back
+        // off while no server answers, the poll interval grows once synced
+        s_status = SNTP_STATUS_SYNCING;
+        xEventGroupClearBits(s_sntp_event_group, SNTP_NETWORK_LOST_BIT);
+        uint32_t poll_ms = CONFIG_SNTP_CLIENT_MIN_POLL_S * 1000;
+        uint32_t retry_ms = NTP_RETRY_MIN_MS;
 
-        // Monitor for config changes or network loss
         while (s_should_run) {
-            // Check event bits
+            uint32_t wait_ms;
+            if (sntp_sync_once()) {
+                if (s_status != SNTP_STATUS_SYNCED) {
+                    s_status = SNTP_STATUS_SYNCED;
+                    time_synced();
+                }
+                event_bus_post(DEVICE_EVENT, DEVICE_EVENT_TIME_SYNCED, NULL, 0, 0);
+                s_poll_ms = poll_ms;
+                wait_ms = poll_ms;
+                poll_ms = (poll_ms * 2 > CONFIG_SNTP_CLIENT_MAX_POLL_S * 1000) ?
+                          CONFIG_SNTP_CLIENT_MAX_POLL_S * 1000 : poll_ms * 2;
+                retry_ms = NTP_RETRY_MIN_MS;
+            } else {
+                ESP_LOGW(TAG, "No NTP server answered, retrying in %lu ms", (unsigned long)retry_ms);
+                wait_ms = retry_ms;
+                retry_ms = (retry_ms * 2 > NTP_RETRY_MAX_MS) ? NTP_RETRY_MAX_MS : retry_ms * 2;
+            }
+
             bits = xEventGroupWaitBits(s_sntp_event_group,
-                                       SNTP_CONFIG_CHANGED_BIT | SNTP_NETWORK_READY_BIT,
+                                       SNTP_CONFIG_CHANGED_BIT | SNTP_NETWORK_LOST_BIT,
                                        pdFALSE,  // Don't clear bits
                                        pdFALSE,  // Wait for ANY bit (OR)
-                                       pdMS_TO_TICKS(60000));  // Check every minute
+                                       pdMS_TO_TICKS(wait_ms));
 
             if (!s_should_run) {
                 break;
@@ -247,33 +578,21 @@ static void sntp_client_task(void* arg)
             if (bits & SNTP_CONFIG_CHANGED_BIT) {
                 ESP_LOGI(TAG, "Config change detected - restarting SNTP");
                 xEventGroupClearBits(s_sntp_event_group, SNTP_CONFIG_CHANGED_BIT);
-                deinit_sntp();
                 break;  // Exit inner loop to reload config
             }
 
             // Network lost
-            if (!(bits & SNTP_NETWORK_READY_BIT)) {
-                ESP_LOGW(TAG, "Network lost - stopping SNTP");
-                deinit_sntp();
-                break;  // Exit inner loop to wait for network
-            }
-
-            // Update sync status based on ESP-IDF's internal state
-            sntp_sync_status_t sync_status = sntp_get_sync_status();
-            if (sync_status == SNTP_SYNC_STATUS_COMPLETED) {
-                if (s_status != SNTP_STATUS_SYNCED) {
-                    s_status = SNTP_STATUS_SYNCED;
-                    ESP_LOGI(TAG, "SNTP sync completed");
-                }
-            } else if (sync_status == SNTP_SYNC_STATUS_IN_PROGRESS) {
-                if (s_status != SNTP_STATUS_SYNCING) {
-                    s_status = SNTP_STATUS_SYNCING;
+            if (bits & SNTP_NETWORK_LOST_BIT) {
+                xEventGroupClearBits(s_sntp_event_group, SNTP_NETWORK_LOST_BIT);
+                if (!(xEventGroupGetBits(s_sntp_event_group) & SNTP_NETWORK_READY_BIT)) {
+                    ESP_LOGW(TAG, "Network lost - stopping SNTP");
+                    break;  // Exit inner loop to wait for network
                 }
             }
         }
 
-        // Deinitialize before restarting
-        deinit_sntp();
+        // The clock model keeps running (holdover) until the next sync
+        s_status = SNTP_STATUS_IDLE;
     }
 
     ESP_LOGI(TAG, "SNTP client task exiting");
@@ -300,9 +619,15 @@ esp_err_t sntp_client_start(void)
         return ESP_ERR_NO_MEM;
     }
 
+    s_metric_offset = diag_metric_gauge("sntp_offset_us", "System clock offset of the last accepted NTP sample");
+    s_metric_drift = diag_metric_gauge("sntp_drift_ppb", "Estimated local clock rate error (+ = fast)");
+    diag_metric_gauge_fn("sntp_time_error_us", "Error bound of sntp_client_now_us() (-1 = never synced)",
+                         &metric_error_fn, NULL);
+    s_metric_steps = diag_metric_counter("sntp_steps_total", "System clock steps (offsets too large to slew)");
+
     // Register network event handlers
-    esp_err_t ret = esp_event_handler_register(DEVICE_EVENT, DEVICE_EVENT_NET_READY,
-                                                &sntp_network_event_handler, NULL);
+    esp_err_t ret = event_bus_register(DEVICE_EVENT_NET_READY,
+                                       &sntp_network_event_handler, NULL);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register NET_READY handler: %s", esp_err_to_name(ret));
         vEventGroupDelete(s_sntp_event_group);
@@ -310,11 +635,11 @@ esp_err_t sntp_client_start(void)
         return ret;
     }
 
-    ret = esp_event_handler_register(DEVICE_EVENT, DEVICE_EVENT_NET_LOST,
-                                     &sntp_network_event_handler, NULL);
+    ret = event_bus_register(DEVICE_EVENT_NET_LOST,
+                             &sntp_network_event_handler, NULL);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register NET_LOST handler: %s", esp_err_to_name(ret));
-        esp_event_handler_unregister(DEVICE_EVENT, DEVICE_EVENT_NET_READY, &sntp_network_event_handler);
+        event_bus_unregister(DEVICE_EVENT_NET_READY, &sntp_network_event_handler);
         vEventGroupDelete(s_sntp_event_group);
         s_sntp_event_group = NULL;
         return ret;
@@ -334,8 +659,8 @@ esp_err_t sntp_client_start(void)
     BaseType_t task_ret = xTaskCreate(sntp_client_task, "sntp_client", 4096, NULL, 5, &s_sntp_task);
     if (task_ret != pdPASS) {
         ESP_LOGE(TAG, "Failed to create SNTP task");
-        esp_event_handler_unregister(DEVICE_EVENT, DEVICE_EVENT_NET_READY, &sntp_network_event_handler);
-        esp_event_handler_unregister(DEVICE_EVENT, DEVICE_EVENT_NET_LOST, &sntp_network_event_handler);
+        event_bus_unregister(DEVICE_EVENT_NET_READY, &sntp_network_event_handler);
+        event_bus_unregister(DEVICE_EVENT_NET_LOST, &sntp_network_event_handler);
         vEventGroupDelete(s_sntp_event_group);
         s_sntp_event_group = NULL;
         s_should_run = false;
@@ -359,8 +684,8 @@ esp_err_t sntp_client_stop(void)
     ESP_LOGI(TAG, "Stopping SNTP client");
 
     // Unregister network event handlers
-    esp_event_handler_unregister(DEVICE_EVENT, DEVICE_EVENT_NET_READY, &sntp_network_event_handler);
-    esp_event_handler_unregister(DEVICE_EVENT, DEVICE_EVENT_NET_LOST, &sntp_network_event_handler);
+    event_bus_unregister(DEVICE_EVENT_NET_READY, &sntp_network_event_handler);
+    event_bus_unregister(DEVICE_EVENT_NET_LOST, &sntp_network_event_handler);
 
     // Signal task to stop
     s_should_run = false;
@@ -453,3 +778,63 @@ esp_err_t sntp_client_get_timezone(char* tz_buf, size_t tz_buf_len)
 
     return ESP_OK;
 }
+
+/**
+ * Current time from the clock model
+ */
+int64_t sntp_client_now_us(uint32_t* err_us, sntp_time_quality_t* quality)
+{
+    int64_t mono = esp_timer_get_time();
+    int64_t now = 0;
+    uint32_t err = UINT32_MAX;
+    int64_t age_us = 0;
+
+    taskENTER_CRITICAL(&s_time_lock);
+    bool valid = s_clock.valid;
+    if (valid) {
+        now = clock_project_locked(mono);
+        err = clock_error_locked(mono);
+        age_us = mono - s_clock.ref_mono_us;
+    }
+    taskEXIT_CRITICAL(&s_time_lock);
+
+    sntp_time_quality_t q = SNTP_TIME_QUALITY_NONE;
+    if (!valid) {
+        now = system_now_us();
+    } else if (s_status == SNTP_STATUS_SYNCED && age_us <= 2LL * s_poll_ms * 1000) {
+        q = SNTP_TIME_QUALITY_SYNCED;
+    } else {
+        q = SNTP_TIME_QUALITY_HOLDOVER;
+    }
+
+    if (err_us) {
+        *err_us = err;
+    }
+    if (quality) {
+        *quality = q;
+    }
+    return now;
+}
+
+/**
+ * Get clock model and per-server statistics
+ */
+esp_err_t sntp_client_get_time_stats(sntp_client_time_stats_t* out)
+{
+    if (!out) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    taskENTER_CRITICAL(&s_time_lock);
+    *out = s_time_stats;
+    memcpy(out->servers, s_server_stats, sizeof(out->servers));
+    taskEXIT_CRITICAL(&s_time_lock);
+
+    const char* hosts[SNTP_CLIENT_SERVER_COUNT] = { s_server_primary, s_server_secondary };
+    for (int i = 0; i < SNTP_CLIENT_SERVER_COUNT; i++) {
+        strlcpy(out->servers[i].host, hosts[i], sizeof(out->servers[i].host));
+    }
+    sntp_client_now_us(&out->error_us, &out->quality);
+    out->poll_s = s_poll_ms / 1000;
+    return ESP_OK;
+}
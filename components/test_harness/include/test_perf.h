@@ -0,0 +1,88 @@
+#pragma once
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * On-target micro-benchmarks (test builds only)
+ *
+ * A benchmark is an operation run a fixed number of times. Each call is timed
+ * with the CPU cycle counter, and the samples are reduced to a latency
+ * distribution, a throughput and the lowest free heap seen during the run.
+ * test_perf_report() prints one machine-readable line per benchmark:
+ *
+ *   PERF {"name":"...","iterations":N,"p50_ns":...,"pass":true,...}
+ *
+ * and test_perf_print_summary() one PERF_SUMMARY line with every result since
+ * test_perf_reset(), so a host script can diff runs by grepping the console.
+ */
+
+/**
+ * One step of a benchmark
+ * i counts from 0 to iterations - 1. An error is counted in the result but
+ * does not stop the run.
+ */
+typedef esp_err_t (*test_perf_op_t)(void* ctx, uint32_t i);
+
+typedef struct {
+    const char* name;
+    test_perf_op_t setup;       // Untimed, run before each op (NULL = none)
+    test_perf_op_t op;          // Timed
+    void* ctx;
+    uint32_t iterations;
+    uint32_t bytes_per_op;      // Payload per op for kbytes_per_s (0 = n/a)
+} test_perf_bench_t;
+
+typedef struct {
+    const char* name;
+    uint32_t iterations;
+    uint32_t errors;
+    uint32_t min_ns;
+    uint32_t p50_ns;
+    uint32_t p90_ns;
+    uint32_t p99_ns;
+    uint32_t max_ns;
+    uint32_t mean_ns;
+    uint32_t ops_per_s;         // From the summed op times (setup excluded)
+    uint32_t kbytes_per_s;      // 0 when bytes_per_op is 0
+    uint32_t heap_start;        // Free 8-bit heap before the first op
+    uint32_t min_heap;          // Lowest free 8-bit heap during the run
+} test_perf_result_t;
+
+// Regression thresholds for one benchmark; 0 disables a bound
+typedef struct {
+    const char* name;
+    uint32_t max_p99_us;
+    uint32_t min_ops_per_s;
+} test_perf_limit_t;
+
+/**
+ * Run a benchmark
+ * Call from a task pinned to one core (the test menu runs in the main task,
+ * pinned to CPU0), because cycle counters of the two cores are not in step.
+ * Returns ESP_ERR_NO_MEM if the sample buffer cannot be allocated.
+ */
+esp_err_t test_perf_run(const test_perf_bench_t* bench, test_perf_result_t* out);
+
+/**
+ * Print the PERF line for a result, checked against limit (may be NULL)
+ * The result is also kept for the summary. Returns false if a bound is
+ * exceeded or any op failed.
+ */
+bool test_perf_report(const test_perf_result_t* result, const test_perf_limit_t* limit);
+
+// Find the limit entry for name in a table of count entries (NULL if none)
+const test_perf_limit_t* test_perf_find_limit(const test_perf_limit_t* table, size_t count, const char* name);
+
+// Clear the kept results / print them as one PERF_SUMMARY line
+void test_perf_reset(void);
+void test_perf_print_summary(void);
+
+#ifdef __cplusplus
+}
+#endif
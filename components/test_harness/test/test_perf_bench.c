@@ -0,0 +1,292 @@
+#include "unity.h"
+#include "test_perf.h"
+#include "config_store.h"
+#include "config_mgr.h"
+#include "event_bus.h"
+#include "udp_broadcast.h"
+#include "http_ui.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
+#include <errno.h>
+#include <string.h>
+
+/*
+ * [perf] benchmarks
+ *
+ * Not part of "Run ALL"; pick "Performance Benchmarks" in the test menu.
+ * Each case prints a PERF line and fails if its entry in s_limits is
+ * exceeded. The limits are deliberately loose (a few times the figures of
+ * an ESP32 at 240 MHz with the code as of this commit) so that only a real
+ * regression trips them; tighten an entry when a path is optimized.
+ */
+
+#define PERF_NS "perf_ns"
+#define PERF_KEY "perf_key"
+#define PERF_KEY2 "perf_key2"
+#define PERF_UDP_PORT 50999
+#define PERF_UDP_LEN 512
+
+static const test_perf_limit_t s_limits[] = {
+    // name                      max_p99_us  min_ops_per_s
+    {"config_store_get_str",          500,        2000},
+    {"config_store_set_str",        30000,          50},
+    {"config_store_txn_commit",     50000,          30},
+    {"config_mgr_get_cached",          50,       50000},
+    {"config_mgr_get_uncached",       600,        1500},
+    {"udp_build_payload",             200,       10000},
+    {"http_status_build",            2000,        1000},
+    {"event_bus_rtt_fast",            500,        2000},
+    {"event_bus_rtt_normal",          500,        2000},
+    {"udp_sendto_loopback",           500,        2000},
+};
+
+static void run_and_check(const test_perf_bench_t* bench)
+{
+    test_perf_result_t result;
+    TEST_ASSERT_EQUAL(ESP_OK, test_perf_run(bench, &result));
+    const test_perf_limit_t* limit =
+        test_perf_find_limit(s_limits, sizeof(s_limits) / sizeof(s_limits[0]), bench->name);
+    TEST_ASSERT_TRUE_MESSAGE(test_perf_report(&result, limit), bench->name);
+}
+
+// config_mgr_init() loads the RAM cache and is not meant to run twice
+static void perf_config_mgr_init(void)
+{
+    static bool s_done = false;
+    if (!s_done) {
+        TEST_ASSERT_EQUAL(ESP_OK, config_mgr_init());
+        s_done = true;
+    }
+}
+
+/* ---- config_store ---- */
+
+static esp_err_t op_store_get(void* ctx, uint32_t i)
+{
+    char buf[32];
+    return config_store_get_str(PERF_NS, PERF_KEY, buf, sizeof(buf));
+}
+
+static esp_err_t op_store_set(void* ctx, uint32_t i)
+{
+    // Alternate values so every call really writes
+    return config_store_set_str(PERF_NS, PERF_KEY, (i & 1) ? "perf_value_b" : "perf_value_a");
+}
+
+static esp_err_t op_store_txn(void* ctx, uint32_t i)
+{
+    config_store_txn_t* txn = NULL;
+    esp_err_t ret = config_store_txn_begin(PERF_NS, &txn);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    config_store_txn_set_str(txn, PERF_KEY, (i & 1) ? "perf_value_b" : "perf_value_a");
+    config_store_txn_set_u32(txn, PERF_KEY2, i);
+    return config_store_txn_commit(txn);
+}
+
+TEST_CASE("perf_config_store_get_str", "[perf]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, config_store_set_str(PERF_NS, PERF_KEY, "perf_value_a"));
+    test_perf_bench_t bench = {
+        .name = "config_store_get_str", .op = op_store_get, .iterations = 500,
+    };
+    run_and_check(&bench);
+    config_store_erase_key(PERF_NS, PERF_KEY);
+}
+
+TEST_CASE("perf_config_store_set_str", "[perf]")
+{
+    test_perf_bench_t bench = {
+        .name = "config_store_set_str", .op = op_store_set, .iterations = 100,
+        .bytes_per_op = sizeof("perf_value_a") - 1,
+    };
+    run_and_check(&bench);
+    config_store_erase_key(PERF_NS, PERF_KEY);
+}
+
+TEST_CASE("perf_config_store_txn_commit", "[perf]")
+{
+    test_perf_bench_t bench = {
+        .name = "config_store_txn_commit", .op = op_store_txn, .iterations = 100,
+    };
+    run_and_check(&bench);
+    config_store_erase_key(PERF_NS, PERF_KEY);
+    config_store_erase_key(PERF_NS, PERF_KEY2);
+}
+
+/* ---- config_mgr ---- */
+
+static esp_err_t op_mgr_get(void* ctx, uint32_t i)
+{
+    char buf[32];
+    return config_mgr_get_string("sys/device_id", buf, sizeof(buf));
+}
+
+static esp_err_t setup_mgr_invalidate(void* ctx, uint32_t i)
+{
+    config_mgr_cache_invalidate("sys/device_id");
+    return ESP_OK;
+}
+
+TEST_CASE("perf_config_mgr_get_cached", "[perf]")
+{
+    perf_config_mgr_init();
+    test_perf_bench_t bench = {
+        .name = "config_mgr_get_cached", .op = op_mgr_get, .iterations = 1000,
+    };
+    run_and_check(&bench);
+}
+
+TEST_CASE("perf_config_mgr_get_uncached", "[perf]")
+{
+    perf_config_mgr_init();
+    test_perf_bench_t bench = {
+        .name = "config_mgr_get_uncached", .setup = setup_mgr_invalidate,
+        .op = op_mgr_get, .iterations = 500,
+    };
+    run_and_check(&bench);
+}
+
+/* ---- JSON builders ---- */
+
+static esp_err_t op_udp_build(void* ctx, uint32_t i)
+{
+    return udp_broadcast_test_build_payload((size_t*)ctx);
+}
+
+static esp_err_t op_status_build(void* ctx, uint32_t i)
+{
+    return http_ui_test_build_status((size_t*)ctx);
+}
+
+TEST_CASE("perf_udp_build_payload", "[perf]")
+{
+    perf_config_mgr_init();
+    TEST_ASSERT_EQUAL(ESP_OK, event_bus_init());
+    // Start loads the configured format and renders the payload template;
+    // stop again right away so the broadcast timer does not compete
+    TEST_ASSERT_EQUAL(ESP_OK, udp_broadcast_start());
+    TEST_ASSERT_EQUAL(ESP_OK, udp_broadcast_stop());
+
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, udp_broadcast_test_build_payload(&len));
+    test_perf_bench_t bench = {
+        .name = "udp_build_payload", .op = op_udp_build, .ctx = &len,
+        .iterations = 1000, .bytes_per_op = (uint32_t)len,
+    };
+    run_and_check(&bench);
+}
+
+TEST_CASE("perf_http_status_build", "[perf]")
+{
+    perf_config_mgr_init();
+
+    // Wi-Fi is not started in test builds; keep net_mgr's "not initialized"
+    // errors out of the console (and out of the timings)
+    esp_log_level_t level = esp_log_level_get("net_mgr");
+    esp_log_level_set("net_mgr", ESP_LOG_NONE);
+
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, http_ui_test_build_status(&len));
+    test_perf_bench_t bench = {
+        .name = "http_status_build", .op = op_status_build, .ctx = &len,
+        .iterations = 200, .bytes_per_op = (uint32_t)len,
+    };
+    run_and_check(&bench);
+
+    esp_log_level_set("net_mgr", level);
+}
+
+/* ---- event_bus ---- */
+
+static void rtt_handler(void* arg, esp_event_base_t base, int32_t id, void* data)
+{
+    xTaskNotifyGive((TaskHandle_t)arg);
+}
+
+static esp_err_t op_event_rtt(void* ctx, uint32_t i)
+{
+    int32_t id = (int32_t)(intptr_t)ctx;
+    esp_err_t ret = event_bus_post(DEVICE_EVENT, id, NULL, 0, pdMS_TO_TICKS(100));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100)) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+static void run_event_rtt(const char* name, int32_t id)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, event_bus_init());
+    TEST_ASSERT_EQUAL(ESP_OK, event_bus_register(id, rtt_handler, xTaskGetCurrentTaskHandle()));
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    test_perf_bench_t bench = {
+        .name = name, .op = op_event_rtt, .ctx = (void*)(intptr_t)id, .iterations = 500,
+    };
+    run_and_check(&bench);
+
+    event_bus_unregister(id, rtt_handler);
+}
+
+TEST_CASE("perf_event_bus_rtt_fast", "[perf]")
+{
+    run_event_rtt("event_bus_rtt_fast", DEVICE_EVENT_GNSS_FIX_UPDATE);
+}
+
+TEST_CASE("perf_event_bus_rtt_normal", "[perf]")
+{
+    run_event_rtt("event_bus_rtt_normal", DEVICE_EVENT_NTRIP_CONNECTED);
+}
+
+/* ---- UDP send path ---- */
+
+typedef struct {
+    int sock;
+    struct sockaddr_in dest;
+    uint32_t no_mem;
+    uint8_t buf[PERF_UDP_LEN];
+} udp_perf_ctx_t;
+
+static esp_err_t op_udp_send(void* ctx, uint32_t i)
+{
+    udp_perf_ctx_t* c = ctx;
+    c->buf[0] = (uint8_t)i;
+    int sent = sendto(c->sock, c->buf, sizeof(c->buf), 0, (struct sockaddr*)&c->dest, sizeof(c->dest));
+    if (sent == (int)sizeof(c->buf)) {
+        return ESP_OK;
+    }
+    // Out of pbufs at full rate is what this measures, not a failure
+    if (sent < 0 && errno == ENOMEM) {
+        c->no_mem++;
+        return ESP_OK;
+    }
+    return ESP_FAIL;
+}
+
+TEST_CASE("perf_udp_sendto_loopback", "[perf]")
+{
+    // Loopback rather than the Wi-Fi interface: the test build brings up no
+    // station, and this keeps the figure independent of the air
+    static udp_perf_ctx_t c;
+    memset(&c, 0, sizeof(c));
+    c.sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    TEST_ASSERT_TRUE(c.sock >= 0);
+    c.dest.sin_family = AF_INET;
+    c.dest.sin_port = htons(PERF_UDP_PORT);
+    c.dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    test_perf_bench_t bench = {
+        .name = "udp_sendto_loopback", .op = op_udp_send, .ctx = &c,
+        .iterations = 1000, .bytes_per_op = PERF_UDP_LEN,
+    };
+    run_and_check(&bench);
+    if (c.no_mem) {
+        ESP_LOGW("test_perf", "udp_sendto_loopback: %lu sends hit ENOMEM", (unsigned long)c.no_mem);
+    }
+
+    close(c.sock);
+}
@@ -1,4 +1,5 @@
 #include "test_harness.h"
+#include "test_perf.h"
 #include "unity.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
@@ -16,7 +17,12 @@ typedef struct {
 } component_info_t;
 
 static const component_info_t components[] = {
+    {"App Startup Graph", "app_startup"},
+    {"Body Parser", "body_parser"},
     {"Config Store", "config_store"},
+    {"Diag Memory Policy", "diag_mem"},
+    {"JSON Writer", "json_writer"},
+    {"Performance Benchmarks", "perf"},
     // Add more components as tests are created:
     // {"Event Bus", "event_bus"},
     // {"Network Manager", "net_mgr"},
@@ -51,13 +57,26 @@ static void run_component_tests(const char *tag)
     printf("Running tests for [%s]\n", tag);
     printf("========================================\n");
 
+    bool perf = (strcmp(tag, "perf") == 0);
+    if (perf) {
+        test_perf_reset();
+    }
+
     UNITY_BEGIN();
     unity_run_tests_by_tag(tag, false);
     UNITY_END();
+
+    // One line with every benchmark result, for scripts reading the console
+    if (perf) {
+        test_perf_print_summary();
+    }
 }
 
 /**
  * @brief Run all tests across all components
+ *
+ * Benchmarks ([perf]) take a while and write to flash repeatedly, so they
+ * only run when selected on their own.
  */
 static void run_all_tests(void)
 {
@@ -67,7 +86,7 @@ static void run_all_tests(void)
     printf("========================================\n");
 
     UNITY_BEGIN();
-    unity_run_all_tests();
+    unity_run_tests_by_tag("[perf]", true);
     UNITY_END();
 }
 
@@ -82,7 +101,7 @@ static void show_component_menu(void)
         printf("        Component Test Menu\n");
         printf("========================================\n");
         printf("\n");
-        printf("  0. Run ALL Tests (All Components)\n");
+        printf("  0. Run ALL Tests (All Components, without benchmarks)\n");
         printf("\n");
 
         for (size_t i = 0; i < num_components; i++) {
@@ -0,0 +1,226 @@
+#include "test_perf.h"
+#include "json_writer.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "test_perf";
+
+// Results kept for the PERF_SUMMARY line
+#define TEST_PERF_MAX_RESULTS 24
+
+typedef struct {
+    test_perf_result_t result;
+    bool pass;
+} perf_entry_t;
+
+static perf_entry_t s_results[TEST_PERF_MAX_RESULTS];
+static size_t s_result_count = 0;
+
+static int cmp_u32(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static uint32_t percentile(const uint32_t* sorted, uint32_t n, uint32_t pct)
+{
+    uint32_t rank = (uint32_t)(((uint64_t)n * pct + 99) / 100);
+    return sorted[rank ? rank - 1 : 0];
+}
+
+static uint32_t free_heap(void)
+{
+    return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+esp_err_t test_perf_run(const test_perf_bench_t* bench, test_perf_result_t* out)
+{
+    if (!bench || !bench->op || bench->iterations == 0 || !out) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Cycles per sample fit 32 bits for any op shorter than ~17 s at 240 MHz
+    uint32_t* samples = malloc(bench->iterations * sizeof(uint32_t));
+    if (!samples) {
+        ESP_LOGE(TAG, "%s: no memory for %lu samples", bench->name, (unsigned long)bench->iterations);
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->name = bench->name;
+    out->iterations = bench->iterations;
+
+    // Sampling free heap after each op misses allocations an op frees before
+    // returning; the allocator's low-water mark catches those, but only once
+    // it drops below where it stood when the run began.
+    uint32_t lifetime_min_start = (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    out->heap_start = free_heap();
+    out->min_heap = out->heap_start;
+
+    uint32_t ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+    uint64_t total_cycles = 0;
+
+    for (uint32_t i = 0; i < bench->iterations; i++) {
+        if (bench->setup && bench->setup(bench->ctx, i) != ESP_OK) {
+            out->errors++;
+        }
+
+        uint32_t t0 = esp_cpu_get_cycle_count();
+        esp_err_t err = bench->op(bench->ctx, i);
+        uint32_t cycles = esp_cpu_get_cycle_count() - t0;
+
+        if (err != ESP_OK) {
+            out->errors++;
+        }
+        samples[i] = cycles;
+        total_cycles += cycles;
+
+        uint32_t heap = free_heap();
+        if (heap < out->min_heap) {
+            out->min_heap = heap;
+        }
+    }
+
+    uint32_t lifetime_min = (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    if (lifetime_min < lifetime_min_start && lifetime_min < out->min_heap) {
+        out->min_heap = lifetime_min;
+    }
+
+    qsort(samples, bench->iterations, sizeof(uint32_t), cmp_u32);
+
+#define CYCLES_TO_NS(c) ((uint32_t)(((uint64_t)(c) * 1000U) / ticks_per_us))
+    out->min_ns = CYCLES_TO_NS(samples[0]);
+    out->p50_ns = CYCLES_TO_NS(percentile(samples, bench->iterations, 50));
+    out->p90_ns = CYCLES_TO_NS(percentile(samples, bench->iterations, 90));
+    out->p99_ns = CYCLES_TO_NS(percentile(samples, bench->iterations, 99));
+    out->max_ns = CYCLES_TO_NS(samples[bench->iterations - 1]);
+    out->mean_ns = CYCLES_TO_NS(total_cycles / bench->iterations);
+#undef CYCLES_TO_NS
+
+    if (total_cycles > 0) {
+        uint64_t total_us = total_cycles / ticks_per_us;
+        if (total_us == 0) {
+            total_us = 1;
+        }
+        out->ops_per_s = (uint32_t)(((uint64_t)bench->iterations * 1000000ULL) / total_us);
+        if (bench->bytes_per_op) {
+            uint64_t bytes = (uint64_t)bench->iterations * bench->bytes_per_op;
+            out->kbytes_per_s = (uint32_t)((bytes * 1000000ULL / total_us) / 1024U);
+        }
+    }
+
+    free(samples);
+    return ESP_OK;
+}
+
+static esp_err_t stdout_flush(void* ctx, const char* data, size_t len)
+{
+    (void)ctx;
+    return fwrite(data, 1, len, stdout) == len ? ESP_OK : ESP_FAIL;
+}
+
+static void write_result(json_writer_t* w, const char* key, const test_perf_result_t* r, bool pass)
+{
+    json_writer_begin_object(w, key);
+    json_writer_string(w, "name", r->name);
+    json_writer_uint(w, "iterations", r->iterations);
+    json_writer_uint(w, "errors", r->errors);
+    json_writer_uint(w, "min_ns", r->min_ns);
+    json_writer_uint(w, "p50_ns", r->p50_ns);
+    json_writer_uint(w, "p90_ns", r->p90_ns);
+    json_writer_uint(w, "p99_ns", r->p99_ns);
+    json_writer_uint(w, "max_ns", r->max_ns);
+    json_writer_uint(w, "mean_ns", r->mean_ns);
+    json_writer_uint(w, "ops_per_s", r->ops_per_s);
+    if (r->kbytes_per_s) {
+        json_writer_uint(w, "kbytes_per_s", r->kbytes_per_s);
+    }
+    json_writer_uint(w, "heap_start", r->heap_start);
+    json_writer_uint(w, "min_heap", r->min_heap);
+    json_writer_bool(w, "pass", pass);
+    json_writer_end_object(w);
+}
+
+bool test_perf_report(const test_perf_result_t* result, const test_perf_limit_t* limit)
+{
+    if (!result) {
+        return false;
+    }
+
+    bool pass = (result->errors == 0);
+    if (limit && limit->max_p99_us && result->p99_ns > limit->max_p99_us * 1000U) {
+        ESP_LOGW(TAG, "%s: p99 %lu ns over limit %lu us", result->name,
+                 (unsigned long)result->p99_ns, (unsigned long)limit->max_p99_us);
+        pass = false;
+    }
+    if (limit && limit->min_ops_per_s && result->ops_per_s < limit->min_ops_per_s) {
+        ESP_LOGW(TAG, "%s: %lu ops/s under limit %lu", result->name,
+                 (unsigned long)result->ops_per_s, (unsigned long)limit->min_ops_per_s);
+        pass = false;
+    }
+
+    char chunk[128];
+    json_writer_t w;
+    printf("PERF ");
+    json_writer_init(&w, chunk, sizeof(chunk), stdout_flush, NULL);
+    write_result(&w, NULL, result, pass);
+    json_writer_finish(&w);
+    printf("\n");
+
+    if (s_result_count < TEST_PERF_MAX_RESULTS) {
+        s_results[s_result_count].result = *result;
+        s_results[s_result_count].pass = pass;
+        s_result_count++;
+    }
+    return pass;
+}
+
+const test_perf_limit_t* test_perf_find_limit(const test_perf_limit_t* table, size_t count, const char* name)
+{
+    for (size_t i = 0; table && name && i < count; i++) {
+        if (strcmp(table[i].name, name) == 0) {
+            return &table[i];
+        }
+    }
+    return NULL;
+}
+
+void test_perf_reset(void)
+{
+    s_result_count = 0;
+}
+
+void test_perf_print_summary(void)
+{
+    size_t failed = 0;
+    for (size_t i = 0; i < s_result_count; i++) {
+        if (!s_results[i].pass) {
+            failed++;
+        }
+    }
+
+    char chunk[128];
+    json_writer_t w;
+    printf("PERF_SUMMARY ");
+    json_writer_init(&w, chunk, sizeof(chunk), stdout_flush, NULL);
+    json_writer_begin_object(&w, NULL);
+    json_writer_uint(&w, "benchmarks", s_result_count);
+    json_writer_uint(&w, "failed", failed);
+    json_writer_uint(&w, "cpu_mhz", esp_rom_get_cpu_ticks_per_us());
+    json_writer_begin_array(&w, "results");
+    for (size_t i = 0; i < s_result_count; i++) {
+        write_result(&w, NULL, &s_results[i].result, s_results[i].pass);
+    }
+    json_writer_end_array(&w);
+    json_writer_end_object(&w);
+    json_writer_finish(&w);
+    printf("\n");
+    fflush(stdout);
+}
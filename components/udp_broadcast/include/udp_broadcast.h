@@ -1,17 +1,141 @@
 #pragma once
+#include "sdkconfig.h"
 #include "esp_err.h"
+#include "config_mgr.h"
+#include <stddef.h>
 #include <stdint.h>
 
 typedef enum { UDP_MODE_BROADCAST, UDP_MODE_MULTICAST, UDP_MODE_UNICAST } udp_mode_t;
 
+// Datagram encoding (NVS key udp/format)
+typedef enum { UDP_FORMAT_JSON, UDP_FORMAT_BINARY } udp_format_t;
+
+/*
+ * Binary status datagram, version 2 (UDP_FORMAT_BINARY)
+ * All multi-byte integers are little-endian, no padding.
+ *
+ *   off  size  field
+ *   0    2     magic 'X','T' (0x58 0x54)
+ *   2    1     version (UDP_BINARY_VERSION)
+ *   3    1     reserved (0)
+ *   4    6     mac (station MAC, raw bytes)
+ *   10   4     ipv4 (network byte order, as on the wire)
+ *   14   1     device_id length N (<= 31)
+ *   15   N     device_id (ASCII, not NUL-terminated)
+ *   15+N 1     fw_version length M (<= 31)
+ *   16+N M     fw_version (ASCII, not NUL-terminated)
+ *   -- volatile fields, fixed 35 bytes at offset V = 16+N+M --
+ *   V+0  4     uptime_s (u32)
+ *   V+4  4     heap_free (u32)
+ *   V+8  1     rssi (i8, dBm; 0 = unknown)
+ *   V+9  1     ntrip_state (u8, 0 = disabled)
+ *   V+10 4     ntrip_bytes_rx (u32)
+ *   V+14 8     ts_unix (i64, seconds)
+ *   -- version 2 --
+ *   V+22 8     ts_us (i64, Unix microseconds, sntp_client_now_us())
+ *   V+30 4     time_err_us (u32, error bound; 0xFFFFFFFF = never synced)
+ *   V+34 1     time_quality (u8, sntp_time_quality_t: 0 none, 1 holdover, 2 synced)
+ *
+ * Decoders must check magic and version; later versions only append fields.
+ */
+#define UDP_BINARY_MAGIC0 0x58
+#define UDP_BINARY_MAGIC1 0x54
+#define UDP_BINARY_VERSION 2
+
+/*
+ * GNSS stream datagram, version 1 (binary format, streaming mode)
+ * Little-endian, no padding. Sent alongside the status datagram.
+ *
+ *   off  size  field
+ *   0    2     magic 'X','G' (0x58 0x47)
+ *   2    1     version (UDP_GNSS_STREAM_VERSION)
+ *   3    1     sample count N
+ *   4    6     mac (station MAC, raw bytes)
+ *   10   1     time_quality (u8, sntp_time_quality_t when sent; 0 = none)
+ *   11   1     reserved (0)
+ *   12   4     seq (u32, increments per datagram; gaps = lost datagrams)
+ *   16   8     base_ts_us (i64, timestamp of first sample)
+ *   24   20*N  samples:
+ *              +0  4  dt_us (u32, offset from base_ts_us)
+ *              +4  4  lat_e7 (i32)
+ *              +8  4  lon_e7 (i32)
+ *              +12 4  alt_mm (i32)
+ *              +16 2  hacc_cm (u16)
+ *              +18 1  fix_type (u8)
+ *              +19 1  num_sv (u8)
+ *
+ * JSON format sends {"device_id":..,"seq":..,"ts_us":base,"time_quality":..,"gnss":[[dt_us,
+ * lat_e7,lon_e7,alt_mm,hacc_cm,fix_type,num_sv],...]} instead.
+ */
+#define UDP_GNSS_STREAM_MAGIC1 0x47
+#define UDP_GNSS_STREAM_VERSION 1
+
 typedef struct {
     udp_mode_t mode;
     char addr[48];
     uint16_t port;
     uint16_t freq_mhz;  // Frequency in millihertz (1 Hz = 1000 mHz); supports 0.2 Hz to 5 Hz
     uint8_t ttl;
+    udp_format_t format;
 } udp_cfg_t;
 
+// Primary destination (udp_cfg_t) plus up to 3 extra (NVS udp/dest1..3)
+#define UDP_MAX_DESTINATIONS 4
+
+typedef struct {
+    udp_mode_t mode;
+    char addr[48];
+    uint16_t port;
+    uint8_t ttl;
+    uint8_t rate_div;       // Send every Nth status tick (1 = every tick); stream data goes every time
+} udp_dest_t;
+
+typedef struct {
+    udp_dest_t dest;
+    uint32_t packets_sent;
+    uint32_t bytes_sent;
+    uint32_t send_errors;
+    int last_errno;         // errno of the last failed sendto, 0 after a success
+} udp_dest_stats_t;
+
+/*
+ * GNSS fixes travel on an event_bus channel of udp_gnss_sample_t slots.
+ * A GNSS driver can attach with
+ *   event_bus_channel_create(UDP_GNSS_CHANNEL, sizeof(udp_gnss_sample_t),
+ *                            UDP_GNSS_CHANNEL_SLOTS, &ch)
+ * and fill slots in place (reserve/publish) instead of calling
+ * udp_broadcast_push_gnss_sample(). Use one path or the other, not both:
+ * the channel has a single producer.
+ */
+#define UDP_GNSS_CHANNEL "gnss_fix"
+#define UDP_GNSS_CHANNEL_SLOTS 64
+
+// One GNSS fix for streaming mode (udp_broadcast_push_gnss_sample)
+typedef struct {
+    int64_t ts_us;          // Fix time, Unix microseconds (0 = stamp on push with sntp_client_now_us())
+    int32_t lat_e7;         // Latitude, degrees * 1e7
+    int32_t lon_e7;         // Longitude, degrees * 1e7
+    int32_t alt_mm;         // Altitude above MSL, millimetres
+    uint16_t hacc_cm;       // Horizontal accuracy estimate, centimetres
+    uint8_t fix_type;       // Receiver-specific fix quality (0 = no fix)
+    uint8_t num_sv;         // Satellites used
+} udp_gnss_sample_t;
+
+typedef struct {
+    uint32_t packets_sent;          // Status datagrams (reset on reconnect)
+    uint32_t bytes_sent;            // All datagrams (reset on reconnect)
+    uint32_t send_errors;           // Failed builds/sendto (reset on reconnect)
+    uint32_t stream_packets_sent;   // GNSS stream datagrams (since boot)
+    uint32_t stream_samples_sent;   // Samples delivered in stream datagrams
+    uint32_t stream_drops;          // Samples discarded (ring overrun or network down)
+    uint32_t stream_overruns;       // Flush requests lost because the task was behind
+    uint32_t tx_retries;            // sendto passes retried after ENOMEM/ENOBUFS (since boot)
+    uint32_t tx_pool_exhausted;     // Datagrams deferred/skipped, no free send buffer (since boot)
+    uint32_t tx_stale_drops;        // Queued datagrams dropped on socket reopen (since boot)
+    uint32_t tx_latency_last_us;    // Timer tick to sendto return, last status datagram
+    uint32_t tx_latency_max_us;     // Highest tx_latency_last_us since boot
+} udp_broadcast_stats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -21,6 +145,41 @@ esp_err_t udp_broadcast_stop(void);
 esp_err_t udp_broadcast_apply_config(const udp_cfg_t* cfg);
 esp_err_t udp_broadcast_publish_now(void);
 
+/**
+ * Queue a GNSS sample for streaming mode (udp/stream_en = 1)
+ * Samples are batched until udp/stream_n are pending or the oldest is
+ * udp/stream_ms old, then sent as one datagram from the broadcast task.
+ * The sample is written into the UDP_GNSS_CHANNEL ring; if the broadcast
+ * task falls a full ring behind, the oldest samples are overwritten and
+ * counted as drops.
+ * Non-blocking; safe to call from any task (not from ISR).
+ * Returns ESP_ERR_INVALID_STATE if streaming is off.
+ */
+esp_err_t udp_broadcast_push_gnss_sample(const udp_gnss_sample_t* sample);
+
+esp_err_t udp_broadcast_get_stats(udp_broadcast_stats_t* stats);
+
+/**
+ * Extra destinations (beyond the primary udp_cfg_t one)
+ * get reads the stored list; txn_set stages a replacement list into a
+ * config transaction (applied by the next udp_broadcast_start/apply_config).
+ * Stored as "mode,addr,port,ttl,rate_div" strings in udp/dest1..3.
+ */
+esp_err_t udp_broadcast_get_destinations(udp_dest_t* out, size_t max, size_t* count);
+esp_err_t udp_broadcast_txn_set_destinations(config_mgr_txn_t* txn, const udp_dest_t* dests, size_t count);
+
+// Per-destination counters for the running module; index 0 is the primary
+esp_err_t udp_broadcast_get_dest_stats(udp_dest_stats_t* out, size_t max, size_t* count);
+
+#ifdef CONFIG_RUN_UNIT_TESTS
+/**
+ * Benchmark hook: build one status datagram for the current format into the
+ * internal buffer without sending it. Requires udp_broadcast_start() to have
+ * run once; the module may have been stopped since.
+ */
+esp_err_t udp_broadcast_test_build_payload(size_t* len_out);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,7 +9,9 @@
 #include "net_mgr.h"
 #include "diag.h"
 #include "version.h"
+#include "sntp_client.h"
 #include "wdt_mgr.h"
+#include "json_writer.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
@@ -21,7 +23,6 @@
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
-#include <sys/time.h>
 #include <math.h>
 
 static const char *TAG = "udp_broadcast";
@@ -30,31 +31,160 @@ static const char *TAG = "udp_broadcast";
 #define MIN_FREQ_HZ 0.2f
 #define MAX_FREQ_HZ 5.0f
 #define MAX_PAYLOAD_SIZE 512
+// Space kept free after the static prefix for the volatile fields
+#define PAYLOAD_TAIL_RESERVE 240
 
 // Queue configuration (tunable for burst handling)
 #define DEFAULT_QUEUE_SIZE 10
 #define MAX_QUEUE_SIZE 50
 
+// Trigger codes sent to broadcast_task
+#define TRIGGER_WAKE 0      // Re-check state (used by stop)
+#define TRIGGER_STATUS 1    // Send status datagram
+#define TRIGGER_STREAM 2    // GNSS batch is full, flush it
+
+// GNSS streaming limits
+#define STREAM_DEFAULT_BATCH 10
+#define STREAM_MAX_BATCH 32
+#define STREAM_DEFAULT_MAX_AGE_MS 100
+#define STREAM_MIN_MAX_AGE_MS 10
+#define STREAM_MAX_MAX_AGE_MS 1000
+#define MAX_STREAM_PAYLOAD 1200     // Below a 1472-byte UDP payload, no IP fragmentation
+#define STREAM_HEADER_SIZE 24
+#define STREAM_SAMPLE_SIZE 20
+#define STREAM_JSON_SAMPLE_MAX 80   // Worst-case JSON text per sample
+
+// Send pool (see udp_tx_task)
+#define TX_BUF_SIZE MAX_STREAM_PAYLOAD      // Fits either datagram kind
+#define TX_BACKOFF_MIN_MS 2
+#define TX_BACKOFF_MAX_MS 32
+
+_Static_assert(UDP_MAX_DESTINATIONS <= 8, "tx_packet_t.pending is a uint8_t bitmask");
+
+// Item of s_broadcast_queue
+typedef struct {
+    uint8_t code;           // TRIGGER_*
+    int64_t tick_us;        // esp_timer time the trigger was raised
+} broadcast_trigger_t;
+
+#define TX_KIND_STATUS 0
+#define TX_KIND_STREAM 1
+
+// One datagram on its way from broadcast_task to udp_tx_task
+typedef struct {
+    int64_t tick_us;        // Timer tick (status) or oldest sample's publish time (stream)
+    uint32_t gen;           // s_tx_gen when built; stale once sockets are closed
+    uint32_t samples;       // GNSS samples carried (stream)
+    uint16_t len;
+    uint8_t kind;           // TX_KIND_*
+    uint8_t pending;        // Bit i: s_dests[i] still to send
+    uint8_t delivered;      // Destinations that accepted it
+    uint8_t data[TX_BUF_SIZE];
+} tx_packet_t;
+
 // State
 static esp_timer_handle_t s_timer = NULL;
 static SemaphoreHandle_t s_mutex = NULL;
 static TaskHandle_t s_broadcast_task = NULL;
 static QueueHandle_t s_broadcast_queue = NULL;
 static bool s_task_should_run = false;
-static int s_socket = -1;
-static struct sockaddr_in s_dest_addr = {0};
 static udp_cfg_t s_config = {0};
 static bool s_is_running = false;
 static bool s_is_paused = true;  // Start paused, wait for NET_READY
 
+// Destinations: index 0 is the primary (s_config), the rest come from udp/destN
+typedef struct {
+    udp_dest_t cfg;
+    struct sockaddr_in addr;
+    uint32_t tick;              // Status ticks seen, for rate divisor
+    uint32_t packets_sent;
+    uint32_t bytes_sent;
+    uint32_t send_errors;
+    int last_errno;
+} dest_state_t;
+
+static dest_state_t s_dests[UDP_MAX_DESTINATIONS];
+static size_t s_dest_count = 0;
+
+// One socket per destination type, indexed by udp_mode_t
+#define UDP_MODE_COUNT 3
+static int s_sockets[UDP_MODE_COUNT] = { -1, -1, -1 };
+static uint8_t s_socket_ttl[UDP_MODE_COUNT] = {0};
+static bool s_sockets_open = false;
+
+// Send pool: buffers cycle s_tx_free_q -> broadcast_task -> s_tx_queue -> udp_tx_task
+static tx_packet_t* s_tx_pool = NULL;
+static QueueHandle_t s_tx_free_q = NULL;    // tx_packet_t*: ready to fill
+static QueueHandle_t s_tx_queue = NULL;     // tx_packet_t*: waiting for sendto (NULL = wake)
+static TaskHandle_t s_tx_task = NULL;
+static uint32_t s_tx_gen = 0;               // Bumped by close_sockets()
+
+// High-rate output keeps the radio out of modem sleep (see latency_hold_update)
+#define LOW_LATENCY_MIN_FREQ_MHZ 5000   // Periodic broadcasts at or above 5 Hz
+static bool s_low_latency_held = false;
+
 // Statistics
 static uint32_t s_packets_sent = 0;
 static uint32_t s_bytes_sent = 0;
 static uint32_t s_send_errors = 0;
+static uint32_t s_tx_retries = 0;           // sendto retried after ENOMEM/ENOBUFS
+static uint32_t s_tx_pool_exhausted = 0;    // No free buffer when a datagram was due
+static uint32_t s_tx_stale = 0;             // Dropped because the sockets were reopened
+static uint32_t s_tx_latency_last_us = 0;
+static uint32_t s_tx_latency_max_us = 0;
+
+// GNSS streaming: samples are read in place from the channel ring
+static event_bus_channel_t* s_stream_channel = NULL;
+static event_bus_reader_t s_stream_reader;
+static portMUX_TYPE s_stream_push_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool s_stream_enabled = false;
+static uint32_t s_stream_batch = STREAM_DEFAULT_BATCH;
+static uint32_t s_stream_max_age_ms = STREAM_DEFAULT_MAX_AGE_MS;
+static uint32_t s_stream_seq = 0;
+static uint32_t s_stream_packets_sent = 0;
+static uint32_t s_stream_samples_sent = 0;
+static uint32_t s_stream_drops = 0;
+static uint32_t s_stream_overruns = 0;
+
+// Registry metrics (monotonic since boot, unlike the counters above)
+static diag_metric_t* s_m_tx_packets = NULL;
+static diag_metric_t* s_m_tx_bytes = NULL;
+static diag_metric_t* s_m_tx_errors = NULL;
+static diag_metric_t* s_m_stream_batch = NULL;
+static const uint32_t s_stream_batch_bounds[] = { 1, 2, 4, 8, 16, 32 };
+static diag_metric_t* s_m_tx_latency = NULL;
+static diag_metric_t* s_m_stream_latency = NULL;
+static const uint32_t s_tx_latency_bounds[] = { 250, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000 };
+
+// Static identity, captured when the payload template is rendered
+static char s_device_id[32] = {0};
+static uint8_t s_mac_bytes[6] = {0};
+
+// Payload buffer: static prefix rendered once, volatile tail patched per tick
+// Holds either JSON text or the binary datagram depending on s_config.format
+static char s_payload[MAX_PAYLOAD_SIZE];
+static size_t s_payload_prefix_len = 0;
+static bool s_payload_tpl_valid = false;
+static json_writer_t s_payload_tpl_json;   // Writer state after the JSON prefix
+
+// Field sources shared by the JSON and binary encoders
+typedef struct {
+    uint32_t uptime_s;
+    uint32_t heap_free;
+    int rssi;
+    const char* ntrip_state;
+    uint8_t ntrip_state_code;
+    uint32_t ntrip_bytes_rx;
+    int64_t ts_unix;
+    int64_t ts_us;
+    uint32_t time_err_us;
+    sntp_time_quality_t time_quality;
+} payload_volatile_t;
 
 // Forward declarations for helpers
 static void broadcast_timer_callback(void* arg);
 static void broadcast_task(void* arg);
+static void udp_tx_task(void* arg);
 static esp_err_t udp_broadcast_start_timer_and_socket(void);
 static void udp_broadcast_stop_timer_and_socket(void);
 
@@ -76,17 +206,38 @@ static float validate_frequency(float freq_hz)
 }
 
 /**
- * Build JSON payload with device status
- * JSON fields from CLAUDE_TASKS.md:
- * - device_id, ip, mac, fw_version, uptime_s, heap_free, rssi
- * - ntrip_state, ntrip_bytes_rx, ts_unix
+ * Append a length-prefixed string (max 31 bytes) to a binary buffer
  */
-static int build_json_payload(char* buf, size_t buf_len)
+static size_t put_short_str(uint8_t* p, const char* str)
 {
-    if (!buf || buf_len == 0) {
-        return -1;
-    }
+    size_t n = strnlen(str, 31);
+    p[0] = (uint8_t)n;
+    memcpy(p + 1, str, n);
+    return n + 1;
+}
+
+static void put_le32(uint8_t* p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void put_le64(uint8_t* p, uint64_t v)
+{
+    put_le32(p, (uint32_t)v);
+    put_le32(p + 4, (uint32_t)(v >> 32));
+}
 
+/**
+ * Render the static part of the payload into s_payload
+ * device_id, ip, mac and fw_version only change on NET_READY or a config
+ * change, so they are encoded once and reused for every tick.
+ * Assumes mutex is held by caller
+ */
+static esp_err_t render_payload_template(void)
+{
     // Get device ID
     char device_id[32] = {0};
     config_mgr_get_string("sys/device_id", device_id, sizeof(device_id));
@@ -102,59 +253,189 @@ static int build_json_payload(char* buf, size_t buf_len)
     // Get firmware version
     const char* fw_version = version_get_string();
 
+    // Identity shared with the GNSS stream encoder
+    strlcpy(s_device_id, device_id, sizeof(s_device_id));
+    unsigned int mac[6] = {0};
+    sscanf(mac_str, "%x:%x:%x:%x:%x:%x", &mac[0], &mac[1], &mac[2], &mac[3], &mac[4], &mac[5]);
+    for (int i = 0; i < 6; i++) {
+        s_mac_bytes[i] = (uint8_t)mac[i];
+    }
+
+    int len;
+    if (s_config.format == UDP_FORMAT_BINARY) {
+        uint8_t* p = (uint8_t*)s_payload;
+        p[0] = UDP_BINARY_MAGIC0;
+        p[1] = UDP_BINARY_MAGIC1;
+        p[2] = UDP_BINARY_VERSION;
+        p[3] = 0;
+        memcpy(&p[4], s_mac_bytes, 6);
+
+        struct in_addr ip = {0};
+        inet_aton(ip_str, &ip);
+        memcpy(&p[10], &ip.s_addr, 4);
+
+        size_t off = 14;
+        off += put_short_str(&p[off], device_id);
+        off += put_short_str(&p[off], fw_version);
+        len = (int)off;
+    } else {
+        // Build static prefix (no secrets, per requirement); the object is
+        // left open and each tick continues from a copy of the writer
+        json_writer_t* w = &s_payload_tpl_json;
+        json_writer_init(w, s_payload, sizeof(s_payload), NULL, NULL);
+        json_writer_begin_object(w, NULL);
+        json_writer_string(w, "device_id", device_id);
+        json_writer_string(w, "ip", ip_str);
+        json_writer_string(w, "mac", mac_str);
+        json_writer_string(w, "fw_version", fw_version);
+        len = (w->err == ESP_OK) ? (int)w->len : -1;
+    }
+
+    if (len < 0 || len + PAYLOAD_TAIL_RESERVE > (int)sizeof(s_payload)) {
+        ESP_LOGE(TAG, "Payload template too large (%d bytes)", len);
+        s_payload_tpl_valid = false;
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    s_payload_prefix_len = (size_t)len;
+    s_payload_tpl_valid = true;
+    ESP_LOGD(TAG, "Payload template rendered (%d bytes static, %s)", len,
+             s_config.format == UDP_FORMAT_BINARY ? "binary" : "json");
+    return ESP_OK;
+}
+
+/**
+ * Mark the payload template stale; it is re-rendered on the next send
+ * Assumes mutex is held by caller
+ */
+static void invalidate_payload_template(void)
+{
+    s_payload_tpl_valid = false;
+}
+
+/**
+ * Sample the per-tick fields (same sources for every encoding)
+ */
+static void collect_volatile_fields(payload_volatile_t* v)
+{
     // Get uptime
-    uint32_t uptime_s = (uint32_t)(esp_timer_get_time() / 1000000ULL);
+    v->uptime_s = (uint32_t)(esp_timer_get_time() / 1000000ULL);
 
     // Get heap free
-    uint32_t heap_free = esp_get_free_heap_size();
+    v->heap_free = esp_get_free_heap_size();
 
     // Get RSSI
-    int rssi = 0;
-    net_mgr_get_rssi(&rssi);
+    v->rssi = 0;
+    net_mgr_get_rssi(&v->rssi);
 
     // Get NTRIP state (placeholder - will be implemented in Task 6)
-    const char* ntrip_state = "disabled";
-    uint32_t ntrip_bytes_rx = 0;
-
-    // Get Unix timestamp
-    struct timeval tv_now;
-    gettimeofday(&tv_now, NULL);
-    int64_t ts_unix = (int64_t)tv_now.tv_sec;
-
-    // Build JSON (no secrets, per requirement)
-    int len = snprintf(buf, buf_len,
-        "{"
-        "\"device_id\":\"%s\","
-        "\"ip\":\"%s\","
-        "\"mac\":\"%s\","
-        "\"fw_version\":\"%s\","
-        "\"uptime_s\":%lu,"
-        "\"heap_free\":%lu,"
-        "\"rssi\":%d,"
-        "\"ntrip_state\":\"%s\","
-        "\"ntrip_bytes_rx\":%lu,"
-        "\"ts_unix\":%lld"
-        "}",
-        device_id, ip_str, mac_str, fw_version,
-        uptime_s, heap_free, rssi,
-        ntrip_state, ntrip_bytes_rx, ts_unix
-    );
+    v->ntrip_state = "disabled";
+    v->ntrip_state_code = 0;
+    v->ntrip_bytes_rx = 0;
+
+    // Timestamp from the SNTP clock model, with its error bound
+    v->ts_us = sntp_client_now_us(&v->time_err_us, &v->time_quality);
+    v->ts_unix = v->ts_us / 1000000;
+}
+
+static const char* time_quality_name(sntp_time_quality_t q)
+{
+    return (q == SNTP_TIME_QUALITY_SYNCED) ? "synced" :
+           (q == SNTP_TIME_QUALITY_HOLDOVER) ? "holdover" : "none";
+}
+
+/**
+ * Build JSON payload with device status in s_payload
+ * JSON fields from CLAUDE_TASKS.md:
+ * - device_id, ip, mac, fw_version, uptime_s, heap_free, rssi
+ * - ntrip_state, ntrip_bytes_rx, ts_unix
+ * - ts_us, time_err_us (absent while never synced), time_quality
+ * Only the volatile tail is formatted here; the static prefix comes from
+ * render_payload_template().
+ * Assumes mutex is held by caller
+ */
+static int build_json_payload(const payload_volatile_t* v)
+{
+    json_writer_t w = s_payload_tpl_json;
+    json_writer_uint(&w, "uptime_s", v->uptime_s);
+    json_writer_uint(&w, "heap_free", v->heap_free);
+    json_writer_int(&w, "rssi", v->rssi);
+    json_writer_string(&w, "ntrip_state", v->ntrip_state);
+    json_writer_uint(&w, "ntrip_bytes_rx", v->ntrip_bytes_rx);
+    json_writer_int(&w, "ts_unix", v->ts_unix);
+    json_writer_int(&w, "ts_us", v->ts_us);
+    if (v->time_err_us != UINT32_MAX) {
+        json_writer_uint(&w, "time_err_us", v->time_err_us);
+    }
+    json_writer_string(&w, "time_quality", time_quality_name(v->time_quality));
+    json_writer_end_object(&w);
 
     // Check payload size (CLAUDE_TASKS.md requirement: max 512 bytes)
-    if (len >= (int)buf_len) {
-        ESP_LOGW(TAG, "JSON payload truncated: would be %d bytes, clamped to %zu bytes", len, buf_len - 1);
-        // Clamp to actual bytes written (buf_len - 1 for null terminator)
-        len = (int)buf_len - 1;
+    esp_err_t err = json_writer_finish(&w);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "JSON payload does not fit in %zu bytes: %s",
+                 sizeof(s_payload), esp_err_to_name(err));
+        return -1;
+    }
+
+    return (int)w.len;
+}
+
+/**
+ * Build binary payload (see schema in udp_broadcast.h) in s_payload
+ * Assumes mutex is held by caller
+ */
+static int build_binary_payload(const payload_volatile_t* v)
+{
+    uint8_t* p = (uint8_t*)s_payload + s_payload_prefix_len;
+
+    int rssi = v->rssi;
+    if (rssi < INT8_MIN) rssi = INT8_MIN;
+    if (rssi > INT8_MAX) rssi = INT8_MAX;
+
+    put_le32(&p[0], v->uptime_s);
+    put_le32(&p[4], v->heap_free);
+    p[8] = (uint8_t)(int8_t)rssi;
+    p[9] = v->ntrip_state_code;
+    put_le32(&p[10], v->ntrip_bytes_rx);
+    put_le64(&p[14], (uint64_t)v->ts_unix);
+    put_le64(&p[22], (uint64_t)v->ts_us);
+    put_le32(&p[30], v->time_err_us);
+    p[34] = (uint8_t)v->time_quality;
+
+    return (int)s_payload_prefix_len + 35;
+}
+
+/**
+ * Build the datagram for the configured format in s_payload
+ * Assumes mutex is held by caller
+ */
+static int build_payload(void)
+{
+    if (!s_payload_tpl_valid && render_payload_template() != ESP_OK) {
+        return -1;
+    }
+
+    payload_volatile_t v;
+    collect_volatile_fields(&v);
+
+    if (s_config.format == UDP_FORMAT_BINARY) {
+        return build_binary_payload(&v);
     }
+    return build_json_payload(&v);
+}
 
-    return len;
+static const char* mode_to_string(udp_mode_t mode)
+{
+    return (mode == UDP_MODE_BROADCAST) ? "broadcast" :
+           (mode == UDP_MODE_MULTICAST) ? "multicast" : "unicast";
 }
 
 /**
- * Create socket for configured mode
+ * Create one socket for a destination type
  * Based on ESP-IDF udp_client and udp_multicast examples
  */
-static int create_socket(void)
+static int create_socket(udp_mode_t mode)
 {
     int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
     if (sock < 0) {
@@ -162,87 +443,463 @@ static int create_socket(void)
         return -1;
     }
 
-    // Set TTL for broadcast/multicast
-    if (s_config.mode == UDP_MODE_BROADCAST || s_config.mode == UDP_MODE_MULTICAST) {
-        uint8_t ttl = s_config.ttl;
+    if (mode == UDP_MODE_BROADCAST) {
+        // Enable broadcast on socket (from udp_client pattern)
+        int broadcast = 1;
+        if (setsockopt(sock, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast)) < 0) {
+            ESP_LOGE(TAG, "Failed to set SO_BROADCAST: errno %d", errno);
+            close(sock);
+            return -1;
+        }
+    } else if (mode == UDP_MODE_MULTICAST) {
+        // For multicast, join each group (from udp_multicast pattern)
+        for (size_t i = 0; i < s_dest_count; i++) {
+            if (s_dests[i].cfg.mode != UDP_MODE_MULTICAST) {
+                continue;
+            }
+
+            struct ip_mreq imreq = {0};
+            imreq.imr_multiaddr = s_dests[i].addr.sin_addr;
 
-        if (s_config.mode == UDP_MODE_BROADCAST) {
-            // Enable broadcast on socket (from udp_client pattern)
-            int broadcast = 1;
-            if (setsockopt(sock, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast)) < 0) {
-                ESP_LOGE(TAG, "Failed to set SO_BROADCAST: errno %d", errno);
-                close(sock);
-                return -1;
+            // Validate it's actually a multicast address
+            if (!IP_MULTICAST(ntohl(imreq.imr_multiaddr.s_addr))) {
+                ESP_LOGW(TAG, "Address %s is not a valid multicast address", s_dests[i].cfg.addr);
+                continue;
             }
-        } else {
-            // Set multicast TTL (from udp_multicast pattern)
-            if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0) {
-                ESP_LOGE(TAG, "Failed to set IP_MULTICAST_TTL: errno %d", errno);
-                close(sock);
-                return -1;
+
+            // Use INADDR_ANY for interface (listen on all interfaces)
+            imreq.imr_interface.s_addr = IPADDR_ANY;
+
+            if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &imreq, sizeof(imreq)) < 0) {
+                ESP_LOGW(TAG, "Failed to join multicast group %s: errno %d", s_dests[i].cfg.addr, errno);
+            } else {
+                ESP_LOGI(TAG, "Joined multicast group %s", s_dests[i].cfg.addr);
             }
         }
+    }
+
+    return sock;
+}
+
+/**
+ * Apply TTL on a shared socket if it differs from what is already set
+ * Lets destinations of the same type keep individual TTLs
+ */
+static void apply_socket_ttl(udp_mode_t mode, uint8_t ttl)
+{
+    int sock = s_sockets[mode];
+    if (sock < 0 || mode == UDP_MODE_BROADCAST || s_socket_ttl[mode] == ttl) {
+        return;
+    }
 
-        ESP_LOGI(TAG, "Socket TTL set to %d", ttl);
+    int ret;
+    if (mode == UDP_MODE_MULTICAST) {
+        // Set multicast TTL (from udp_multicast pattern)
+        ret = setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    } else {
+        int ttl_int = ttl;
+        ret = setsockopt(sock, IPPROTO_IP, IP_TTL, &ttl_int, sizeof(ttl_int));
     }
 
-    // For multicast, join the group (from udp_multicast pattern)
-    if (s_config.mode == UDP_MODE_MULTICAST) {
-        struct ip_mreq imreq = {0};
+    if (ret < 0) {
+        ESP_LOGW(TAG, "Failed to set %s TTL %u: errno %d", mode_to_string(mode), ttl, errno);
+    } else {
+        s_socket_ttl[mode] = ttl;
+    }
+}
 
-        // Parse multicast address
-        if (inet_aton(s_config.addr, &imreq.imr_multiaddr) == 0) {
-            ESP_LOGE(TAG, "Invalid multicast address: %s", s_config.addr);
-            close(sock);
-            return -1;
+/**
+ * Create the sockets needed by the destination list
+ * One socket per destination type, shared by all destinations of that type
+ */
+static esp_err_t open_sockets(void)
+{
+    bool needed[UDP_MODE_COUNT] = {false};
+    for (size_t i = 0; i < s_dest_count; i++) {
+        needed[s_dests[i].cfg.mode] = true;
+    }
+
+    for (int m = 0; m < UDP_MODE_COUNT; m++) {
+        s_socket_ttl[m] = 0;
+        if (!needed[m]) {
+            continue;
+        }
+        s_sockets[m] = create_socket((udp_mode_t)m);
+        if (s_sockets[m] < 0) {
+            // Other destination types still work
+            ESP_LOGE(TAG, "No %s socket, those destinations are skipped", mode_to_string((udp_mode_t)m));
         }
+    }
 
-        // Validate it's actually a multicast address
-        if (!IP_MULTICAST(ntohl(imreq.imr_multiaddr.s_addr))) {
-            ESP_LOGW(TAG, "Address %s is not a valid multicast address", s_config.addr);
+    for (int m = 0; m < UDP_MODE_COUNT; m++) {
+        if (s_sockets[m] >= 0) {
+            s_sockets_open = true;
+            return ESP_OK;
         }
+    }
+    return ESP_FAIL;
+}
 
-        // Use INADDR_ANY for interface (listen on all interfaces)
-        imreq.imr_interface.s_addr = IPADDR_ANY;
+/**
+ * Close sockets and leave multicast groups if needed
+ */
+static void close_sockets(void)
+{
+    s_sockets_open = false;
+    s_tx_gen++;     // Datagrams still queued for these sockets are dropped
 
-        // Join multicast group
-        if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &imreq, sizeof(imreq)) < 0) {
-            ESP_LOGE(TAG, "Failed to join multicast group: errno %d", errno);
-            close(sock);
-            return -1;
+    for (int m = 0; m < UDP_MODE_COUNT; m++) {
+        int sock = s_sockets[m];
+        if (sock < 0) {
+            continue;
         }
 
-        ESP_LOGI(TAG, "Joined multicast group %s", s_config.addr);
+        // Leave multicast groups before closing (from udp_multicast pattern)
+        if (m == UDP_MODE_MULTICAST) {
+            for (size_t i = 0; i < s_dest_count; i++) {
+                if (s_dests[i].cfg.mode != UDP_MODE_MULTICAST) {
+                    continue;
+                }
+                struct ip_mreq imreq = {0};
+                imreq.imr_multiaddr = s_dests[i].addr.sin_addr;
+                imreq.imr_interface.s_addr = IPADDR_ANY;
+                if (setsockopt(sock, IPPROTO_IP, IP_DROP_MEMBERSHIP, &imreq, sizeof(imreq)) < 0) {
+                    ESP_LOGW(TAG, "Failed to leave multicast group %s: errno %d", s_dests[i].cfg.addr, errno);
+                } else {
+                    ESP_LOGI(TAG, "Left multicast group %s", s_dests[i].cfg.addr);
+                }
+            }
+        }
+
+        shutdown(sock, SHUT_RDWR);
+        close(sock);
+        s_sockets[m] = -1;
     }
+}
 
-    return sock;
+/**
+ * Take a free datagram buffer from the send pool (non-blocking)
+ * Returns NULL if every buffer is still queued for sending
+ * Assumes mutex is held by caller
+ */
+static tx_packet_t* tx_packet_get(void)
+{
+    tx_packet_t* pkt = NULL;
+    if (!s_tx_free_q || xQueueReceive(s_tx_free_q, &pkt, 0) != pdTRUE) {
+        s_tx_pool_exhausted++;
+        return NULL;
+    }
+    return pkt;
+}
+
+static void tx_packet_put(tx_packet_t* pkt)
+{
+    xQueueSend(s_tx_free_q, &pkt, 0);
+}
+
+/**
+ * Pick the destinations a datagram goes to, as a bitmask of s_dests indices
+ * status_tick applies each destination's rate divisor.
+ * Assumes mutex is held by caller
+ */
+static uint8_t tx_select_destinations(bool status_tick)
+{
+    uint8_t mask = 0;
+
+    for (size_t i = 0; i < s_dest_count; i++) {
+        dest_state_t* d = &s_dests[i];
+        if (status_tick && d->cfg.rate_div > 1) {
+            uint32_t tick = d->tick++;
+            if (tick % d->cfg.rate_div != 0) {
+                continue;
+            }
+        }
+        mask |= (uint8_t)(1u << i);
+    }
+    return mask;
+}
+
+/**
+ * Stamp a filled buffer and queue it for udp_tx_task
+ * The queue is as long as the pool, so this cannot fail.
+ * Assumes mutex is held by caller
+ */
+static void tx_packet_queue(tx_packet_t* pkt, uint8_t kind, int len, uint8_t dests, int64_t tick_us)
+{
+    pkt->tick_us = tick_us;
+    pkt->gen = s_tx_gen;
+    pkt->len = (uint16_t)len;
+    pkt->kind = kind;
+    pkt->pending = dests;
+    pkt->delivered = 0;
+    xQueueSend(s_tx_queue, &pkt, 0);
+}
+
+static void tx_record_error(dest_state_t* d, int err)
+{
+    // Log on change only; an unreachable target would otherwise flood the log
+    if (err != d->last_errno) {
+        ESP_LOGW(TAG, "sendto %s:%u failed: errno %d", d->cfg.addr, d->cfg.port, err);
+    }
+    d->last_errno = err;
+    d->send_errors++;
+    s_send_errors++;
+    diag_metric_inc(s_m_tx_errors);
 }
 
 /**
- * Close socket and leave multicast group if needed
+ * Account a datagram every destination has answered for
+ * Latency runs from the timer tick (or, for the stream, the oldest sample's
+ * publish) to the return of the last sendto.
+ * Assumes mutex is held by caller
  */
-static void close_socket(void)
+static void tx_complete(const tx_packet_t* pkt)
 {
-    if (s_socket < 0) {
+    int64_t latency = esp_timer_get_time() - pkt->tick_us;
+    if (latency < 0) latency = 0;
+    if (latency > UINT32_MAX) latency = UINT32_MAX;
+
+    if (pkt->kind == TX_KIND_STATUS) {
+        s_packets_sent += pkt->delivered;
+        if (pkt->delivered) {
+            s_tx_latency_last_us = (uint32_t)latency;
+            if (s_tx_latency_last_us > s_tx_latency_max_us) {
+                s_tx_latency_max_us = s_tx_latency_last_us;
+            }
+            diag_metric_observe(s_m_tx_latency, (uint32_t)latency);
+        }
         return;
     }
 
-    // Leave multicast group before closing (from udp_multicast pattern)
-    if (s_config.mode == UDP_MODE_MULTICAST) {
-        struct ip_mreq imreq = {0};
-        if (inet_aton(s_config.addr, &imreq.imr_multiaddr) != 0) {
-            imreq.imr_interface.s_addr = IPADDR_ANY;
-            if (setsockopt(s_socket, IPPROTO_IP, IP_DROP_MEMBERSHIP, &imreq, sizeof(imreq)) < 0) {
-                ESP_LOGW(TAG, "Failed to leave multicast group: errno %d", errno);
-            } else {
-                ESP_LOGI(TAG, "Left multicast group %s", s_config.addr);
+    if (pkt->delivered == 0) {
+        s_stream_drops += pkt->samples;
+        return;
+    }
+    s_stream_packets_sent++;
+    s_stream_samples_sent += pkt->samples;
+    diag_metric_observe(s_m_stream_batch, pkt->samples);
+    diag_metric_observe(s_m_stream_latency, (uint32_t)latency);
+}
+
+/**
+ * One pass of sendto over the destinations a datagram still owes
+ * sendto uses MSG_DONTWAIT so a destination that cannot take the packet
+ * (ARP pending, full TX queue) is counted and skipped instead of stalling
+ * the others. ENOMEM/ENOBUFS (lwIP out of pbufs) leaves the destination
+ * pending for another pass unless this is the last one.
+ * Returns true once the datagram is done with
+ * Assumes mutex is held by caller
+ */
+static bool tx_attempt(tx_packet_t* pkt, bool last)
+{
+    if (pkt->gen != s_tx_gen) {
+        s_tx_stale++;
+        pkt->pending = 0;
+    }
+
+    for (size_t i = 0; i < s_dest_count && pkt->pending; i++) {
+        uint8_t bit = (uint8_t)(1u << i);
+        if (!(pkt->pending & bit)) {
+            continue;
+        }
+        dest_state_t* d = &s_dests[i];
+
+        int sock = s_sockets[d->cfg.mode];
+        if (sock < 0) {
+            d->send_errors++;
+            s_send_errors++;
+            diag_metric_inc(s_m_tx_errors);
+            pkt->pending &= (uint8_t)~bit;
+            continue;
+        }
+
+        apply_socket_ttl(d->cfg.mode, d->cfg.ttl);
+
+        // Send packet (from udp_client pattern)
+        int sent = sendto(sock, pkt->data, pkt->len, MSG_DONTWAIT,
+                          (struct sockaddr *)&d->addr, sizeof(d->addr));
+        if (sent < 0) {
+            int err = errno;
+            if ((err == ENOMEM || err == ENOBUFS) && !last) {
+                continue;
+            }
+            tx_record_error(d, err);
+            pkt->pending &= (uint8_t)~bit;
+            continue;
+        }
+
+        d->last_errno = 0;
+        d->packets_sent++;
+        d->bytes_sent += sent;
+        s_bytes_sent += sent;
+        diag_metric_inc(s_m_tx_packets);
+        diag_metric_add(s_m_tx_bytes, (uint32_t)sent);
+        pkt->delivered++;
+        pkt->pending &= (uint8_t)~bit;
+
+        ESP_LOGD(TAG, "Sent %d bytes to %s:%d", sent, d->cfg.addr, d->cfg.port);
+    }
+
+    // Destinations removed since the datagram was built
+    pkt->pending &= (uint8_t)((1u << s_dest_count) - 1);
+
+    if (pkt->pending) {
+        s_tx_retries++;
+        return false;
+    }
+    tx_complete(pkt);
+    return true;
+}
+
+/**
+ * Send one datagram, backing off while lwIP is out of buffers
+ * The mutex is held for one pass at a time only, so a config change or a
+ * network event is never kept waiting behind a retry.
+ */
+static void tx_send(tx_packet_t* pkt)
+{
+    uint32_t backoff_ms = TX_BACKOFF_MIN_MS;
+
+    for (uint32_t attempt = 0; ; attempt++) {
+        bool last = (attempt >= CONFIG_UDP_BROADCAST_TX_RETRIES);
+
+        if (xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+            bool done = tx_attempt(pkt, last);
+            xSemaphoreGive(s_mutex);
+            if (done) {
+                return;
             }
+        } else if (last) {
+            ESP_LOGW(TAG, "Failed to acquire mutex for send, datagram dropped");
+            return;
+        }
+
+        TickType_t delay = pdMS_TO_TICKS(backoff_ms);
+        vTaskDelay(delay ? delay : 1);
+        backoff_ms *= 2;
+        if (backoff_ms > TX_BACKOFF_MAX_MS) {
+            backoff_ms = TX_BACKOFF_MAX_MS;
         }
     }
+}
+
+/**
+ * Allocate the send pool (once; it is kept across stop/start)
+ */
+static esp_err_t tx_pool_init(void)
+{
+    const int count = CONFIG_UDP_BROADCAST_TX_BUFFERS;
+
+    if (s_tx_pool) {
+        return ESP_OK;
+    }
+
+    s_tx_free_q = xQueueCreate(count, sizeof(tx_packet_t*));
+    s_tx_queue = xQueueCreate(count + 1, sizeof(tx_packet_t*));    // +1 for the stop wake-up
+    s_tx_pool = diag_mem_alloc(DIAG_MEM_NET, count * sizeof(tx_packet_t));
+    if (!s_tx_free_q || !s_tx_queue || !s_tx_pool) {
+        ESP_LOGE(TAG, "Failed to allocate send pool");
+        if (s_tx_free_q) {
+            vQueueDelete(s_tx_free_q);
+            s_tx_free_q = NULL;
+        }
+        if (s_tx_queue) {
+            vQueueDelete(s_tx_queue);
+            s_tx_queue = NULL;
+        }
+        diag_mem_free(s_tx_pool);
+        s_tx_pool = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (int i = 0; i < count; i++) {
+        tx_packet_put(&s_tx_pool[i]);
+    }
+    ESP_LOGI(TAG, "Send pool: %d x %u bytes (%s)", count, (unsigned)sizeof(tx_packet_t),
+             diag_mem_in_psram(s_tx_pool) ? "PSRAM" : "internal");
+    return ESP_OK;
+}
+
+/**
+ * Parse an extra destination string "mode,addr,port,ttl,rate_div"
+ * mode is broadcast|multicast|unicast; ttl and rate_div are optional
+ */
+static bool parse_destination(const char* str, udp_dest_t* out)
+{
+    char mode[12] = {0};
+    char addr[48] = {0};
+    unsigned int port = 0, ttl = 1, div = 1;
+
+    memset(out, 0, sizeof(*out));
+    int n = sscanf(str, "%11[^,],%47[^,],%u,%u,%u", mode, addr, &port, &ttl, &div);
+    if (n < 3) {
+        return false;
+    }
+
+    if (strcmp(mode, "broadcast") == 0) {
+        out->mode = UDP_MODE_BROADCAST;
+    } else if (strcmp(mode, "multicast") == 0) {
+        out->mode = UDP_MODE_MULTICAST;
+    } else if (strcmp(mode, "unicast") == 0) {
+        out->mode = UDP_MODE_UNICAST;
+    } else {
+        return false;
+    }
+
+    struct in_addr test_addr;
+    if (port == 0 || port > 65535 || inet_aton(addr, &test_addr) == 0) {
+        return false;
+    }
+
+    strlcpy(out->addr, addr, sizeof(out->addr));
+    out->port = (uint16_t)port;
+    out->ttl = (ttl >= 1 && ttl <= 255) ? (uint8_t)ttl : 1;
+    out->rate_div = (div >= 1 && div <= 255) ? (uint8_t)div : 1;
+    return true;
+}
+
+/**
+ * Add a destination to the active list
+ * Assumes mutex is held by caller
+ */
+static esp_err_t add_destination(const udp_dest_t* cfg)
+{
+    if (s_dest_count >= UDP_MAX_DESTINATIONS) {
+        return ESP_ERR_NO_MEM;
+    }
 
-    shutdown(s_socket, SHUT_RDWR);
-    close(s_socket);
-    s_socket = -1;
+    dest_state_t* d = &s_dests[s_dest_count];
+    memset(d, 0, sizeof(*d));
+    d->cfg = *cfg;
+    d->addr.sin_family = AF_INET;
+    d->addr.sin_port = htons(cfg->port);
+    if (inet_aton(cfg->addr, &d->addr.sin_addr) == 0) {
+        ESP_LOGE(TAG, "Invalid destination address: %s", cfg->addr);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    s_dest_count++;
+    return ESP_OK;
+}
+
+/**
+ * Hold or drop net_mgr's low-latency profile
+ * Held while sending is active and either the GNSS stream is on or the
+ * periodic rate is high enough that modem sleep wake-ups would show as
+ * jitter. Assumes mutex is held by caller.
+ */
+static void latency_hold_update(bool active)
+{
+    bool want = active && (s_stream_enabled || s_config.freq_mhz >= LOW_LATENCY_MIN_FREQ_MHZ);
+    if (want == s_low_latency_held) {
+        return;
+    }
+    if (want) {
+        net_mgr_request_low_latency();
+    } else {
+        net_mgr_release_low_latency();
+    }
+    s_low_latency_held = want;
 }
 
 /**
@@ -254,23 +911,32 @@ static esp_err_t udp_broadcast_start_timer_and_socket(void)
 {
     esp_err_t ret;
 
-    // Close existing socket if any (handle quick bounce)
-    if (s_socket >= 0) {
-        ESP_LOGW(TAG, "Socket already exists, closing before restart");
-        close_socket();
+    // Close existing sockets if any (handle quick bounce)
+    if (s_sockets_open) {
+        ESP_LOGW(TAG, "Sockets already exist, closing before restart");
+        close_sockets();
     }
 
-    // Create socket
-    s_socket = create_socket();
-    if (s_socket < 0) {
+    // Create sockets
+    if (open_sockets() != ESP_OK) {
         ESP_LOGE(TAG, "Failed to create socket");
         return ESP_FAIL;
     }
 
+    // IP may have changed across the reconnect
+    invalidate_payload_template();
+
     // Reset stats on network reconnect
     s_packets_sent = 0;
     s_bytes_sent = 0;
     s_send_errors = 0;
+    for (size_t i = 0; i < s_dest_count; i++) {
+        s_dests[i].tick = 0;
+        s_dests[i].packets_sent = 0;
+        s_dests[i].bytes_sent = 0;
+        s_dests[i].send_errors = 0;
+        s_dests[i].last_errno = 0;
+    }
 
     // Create periodic timer if not exists
     if (!s_timer) {
@@ -281,7 +947,7 @@ static esp_err_t udp_broadcast_start_timer_and_socket(void)
         ret = esp_timer_create(&timer_args, &s_timer);
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "Failed to create timer: %s", esp_err_to_name(ret));
-            close_socket();
+            close_sockets();
             return ret;
         }
     }
@@ -299,13 +965,14 @@ static esp_err_t udp_broadcast_start_timer_and_socket(void)
     ret = esp_timer_start_periodic(s_timer, period_us);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to start timer: %s", esp_err_to_name(ret));
-        close_socket();
+        close_sockets();
         return ret;
     }
 
     s_is_paused = false;
-    ESP_LOGI(TAG, "UDP broadcasts active: %s:%d @ %.2f Hz",
-             s_config.addr, s_config.port, validated_freq);
+    latency_hold_update(true);
+    ESP_LOGI(TAG, "UDP broadcasts active: %s:%d @ %.2f Hz (%u destinations)",
+             s_config.addr, s_config.port, validated_freq, (unsigned)s_dest_count);
 
     return ESP_OK;
 }
@@ -325,45 +992,236 @@ static void udp_broadcast_stop_timer_and_socket(void)
         ESP_LOGI(TAG, "Timer stopped");
     }
 
-    // Close socket
-    close_socket();
+    // Close sockets
+    close_sockets();
+    latency_hold_update(false);
 
     ESP_LOGI(TAG, "UDP broadcasts paused (network lost)");
 }
 
 /**
- * Send UDP broadcast packet
+ * Build the status datagram and queue it for udp_tx_task
+ * tick_us is when the send was asked for (timer tick or publish_now).
+ * Assumes mutex is held by caller
  */
-static void send_udp_packet(void)
+static void send_udp_packet(int64_t tick_us)
 {
     // Don't send if paused
     if (s_is_paused) {
         return;
     }
 
-    // Build JSON payload
-    char payload[MAX_PAYLOAD_SIZE];
-    int payload_len = build_json_payload(payload, sizeof(payload));
+    tx_packet_t* pkt = tx_packet_get();
+    if (!pkt) {
+        ESP_LOGD(TAG, "Send pool exhausted, status datagram skipped");
+        return;
+    }
+
+    uint8_t dests = tx_select_destinations(true);
+    if (!dests) {
+        tx_packet_put(pkt);     // Every destination divided this tick out
+        return;
+    }
+
+    // Build payload (patches volatile fields into the cached template)
+    int payload_len = build_payload();
     if (payload_len < 0) {
-        ESP_LOGE(TAG, "Failed to build JSON payload");
+        ESP_LOGE(TAG, "Failed to build payload");
         s_send_errors++;
+        tx_packet_put(pkt);
         return;
     }
 
-    // Send packet (from udp_client pattern)
-    int sent = sendto(s_socket, payload, payload_len, 0,
-                      (struct sockaddr *)&s_dest_addr, sizeof(s_dest_addr));
+    // Same payload to every destination
+    memcpy(pkt->data, s_payload, payload_len);
+    pkt->samples = 0;
+    tx_packet_queue(pkt, TX_KIND_STATUS, payload_len, dests, tick_us);
+}
 
-    if (sent < 0) {
-        ESP_LOGE(TAG, "sendto failed: errno %d", errno);
-        s_send_errors++;
+/**
+ * Fold samples the ring overwrote before the reader got to them into drops
+ */
+static void stream_account_missed(void)
+{
+    if (s_stream_reader.missed) {
+        s_stream_drops += s_stream_reader.missed;
+        s_stream_reader.missed = 0;
+    }
+}
+
+/**
+ * Encode up to s_stream_batch pending samples into buf (cap bytes)
+ * Samples are encoded straight from their ring slots and only consumed
+ * once they fit, so a partial batch stays pending. A sample overwritten
+ * while it was being encoded is rolled back and counted as a drop.
+ * Returns payload length (0 if nothing pending), *count set to samples used
+ * Assumes mutex is held by caller
+ */
+static int build_stream_payload(char* buf, size_t cap, uint32_t* count)
+{
+    event_bus_entry_t entry;
+    int64_t base_ts = 0;
+    uint32_t n = 0;
+    size_t off;
+    bool binary = (s_config.format == UDP_FORMAT_BINARY);
+    sntp_time_quality_t quality = SNTP_TIME_QUALITY_NONE;
+
+    *count = 0;
+    if (!event_bus_channel_peek(s_stream_channel, &s_stream_reader, &entry)) {
+        return 0;
+    }
+    base_ts = ((const udp_gnss_sample_t*)entry.data)->ts_us;
+    if (!event_bus_channel_valid(s_stream_channel, entry.seq)) {
+        base_ts = 0;    // Overwritten under us; dt values are clamped below
+    }
+    sntp_client_now_us(NULL, &quality);
+
+    if (binary) {
+        off = STREAM_HEADER_SIZE;
+    } else {
+        // Header through the writer so device_id is escaped; the gnss
+        // array is left open and the samples are appended after it
+        json_writer_t w;
+        json_writer_init(&w, buf, cap, NULL, NULL);
+        json_writer_begin_object(&w, NULL);
+        json_writer_string(&w, "device_id", s_device_id);
+        json_writer_uint(&w, "seq", s_stream_seq);
+        json_writer_int(&w, "ts_us", base_ts);
+        json_writer_string(&w, "time_quality", time_quality_name(quality));
+        json_writer_begin_array(&w, "gnss");
+        if (w.err != ESP_OK) {
+            return -1;
+        }
+        off = w.len;
+    }
+
+    while (n < s_stream_batch) {
+        size_t need = binary ? STREAM_SAMPLE_SIZE : STREAM_JSON_SAMPLE_MAX;
+        if (off + need + 2 > cap) {
+            break;
+        }
+        if (!event_bus_channel_next(s_stream_channel, &s_stream_reader, &entry)) {
+            break;
+        }
+
+        const udp_gnss_sample_t* g = (const udp_gnss_sample_t*)entry.data;
+        int64_t dt = g->ts_us - base_ts;
+        if (dt < 0) dt = 0;
+        if (dt > UINT32_MAX) dt = UINT32_MAX;
+
+        size_t start = off;
+        if (binary) {
+            uint8_t* p = (uint8_t*)buf + off;
+            put_le32(&p[0], (uint32_t)dt);
+            put_le32(&p[4], (uint32_t)g->lat_e7);
+            put_le32(&p[8], (uint32_t)g->lon_e7);
+            put_le32(&p[12], (uint32_t)g->alt_mm);
+            p[16] = (uint8_t)g->hacc_cm;
+            p[17] = (uint8_t)(g->hacc_cm >> 8);
+            p[18] = g->fix_type;
+            p[19] = g->num_sv;
+            off += STREAM_SAMPLE_SIZE;
+        } else {
+            int len = snprintf(buf + off, cap - off,
+                               "%s[%lu,%ld,%ld,%ld,%u,%u,%u]", n ? "," : "",
+                               (unsigned long)dt, (long)g->lat_e7, (long)g->lon_e7, (long)g->alt_mm,
+                               g->hacc_cm, g->fix_type, g->num_sv);
+            off += (size_t)len;
+        }
+
+        if (!event_bus_channel_valid(s_stream_channel, entry.seq)) {
+            off = start;
+            s_stream_drops++;
+            continue;
+        }
+        n++;
+    }
+    stream_account_missed();
+
+    if (binary) {
+        uint8_t* p = (uint8_t*)buf;
+        p[0] = UDP_BINARY_MAGIC0;
+        p[1] = UDP_GNSS_STREAM_MAGIC1;
+        p[2] = UDP_GNSS_STREAM_VERSION;
+        p[3] = (uint8_t)n;
+        memcpy(&p[4], s_mac_bytes, 6);
+        p[10] = (uint8_t)quality;
+        p[11] = 0;
+        put_le32(&p[12], s_stream_seq);
+        put_le64(&p[16], (uint64_t)base_ts);
+    } else {
+        buf[off++] = ']';
+        buf[off++] = '}';
+    }
+
+    *count = n;
+    return (int)off;
+}
+
+/**
+ * Decide whether pending GNSS samples are due: batch full or oldest too old
+ */
+static bool stream_flush_due(void)
+{
+    uint32_t pending = event_bus_channel_pending(s_stream_channel, &s_stream_reader);
+    if (pending == 0) {
+        return false;
+    }
+    if (pending >= s_stream_batch) {
+        return true;
+    }
+
+    event_bus_entry_t oldest;
+    if (!event_bus_channel_peek(s_stream_channel, &s_stream_reader, &oldest)) {
+        return false;
+    }
+    return (esp_timer_get_time() - oldest.published_us) >= (int64_t)s_stream_max_age_ms * 1000;
+}
+
+/**
+ * Queue every due GNSS batch for udp_tx_task
+ * While paused pending samples are skipped and counted as drops so stale fixes
+ * are not sent in a burst after reconnect
+ * Assumes mutex is held by caller
+ */
+static void send_stream_packets(void)
+{
+    if (s_is_paused || !s_sockets_open) {
+        s_stream_drops += event_bus_reader_skip(s_stream_channel, &s_stream_reader);
+        stream_account_missed();
         return;
     }
 
-    s_packets_sent++;
-    s_bytes_sent += sent;
+    if (!s_payload_tpl_valid) {
+        render_payload_template();
+    }
+
+    while (stream_flush_due()) {
+        // Out of buffers: samples stay pending (the ring counts overruns)
+        tx_packet_t* pkt = tx_packet_get();
+        if (!pkt) {
+            return;
+        }
+
+        event_bus_entry_t oldest;
+        int64_t tick_us = esp_timer_get_time();
+        if (event_bus_channel_peek(s_stream_channel, &s_stream_reader, &oldest)) {
+            tick_us = oldest.published_us;
+        }
+
+        uint32_t count = 0;
+        int len = build_stream_payload((char*)pkt->data, sizeof(pkt->data), &count);
+        if (len <= 0 || count == 0) {
+            ESP_LOGE(TAG, "Failed to build GNSS stream payload");
+            s_send_errors++;
+            tx_packet_put(pkt);
+            return;
+        }
 
-    ESP_LOGD(TAG, "Sent %d bytes to %s:%d", sent, s_config.addr, s_config.port);
+        s_stream_seq++;
+        pkt->samples = count;
+        tx_packet_queue(pkt, TX_KIND_STREAM, len, tx_select_destinations(false), tick_us);
+    }
 }
 
 /**
@@ -376,12 +1234,12 @@ static void broadcast_timer_callback(void* arg)
     (void)arg;
 
     // Quick check without mutex - if paused, don't queue work
-    if (s_is_paused || s_socket < 0) {
+    if (s_is_paused || !s_sockets_open) {
         return;
     }
 
     // Signal broadcast task (non-blocking queue send from ISR)
-    uint8_t trigger = 1;
+    broadcast_trigger_t trigger = { .code = TRIGGER_STATUS, .tick_us = esp_timer_get_time() };
     BaseType_t high_priority_woken = pdFALSE;
     xQueueSendFromISR(s_broadcast_queue, &trigger, &high_priority_woken);
 
@@ -392,18 +1250,20 @@ static void broadcast_timer_callback(void* arg)
 
 /**
  * Dedicated task for UDP broadcast
- * Handles actual network I/O separately from timer callbacks
+ * Builds datagrams separately from timer callbacks and hands them to
+ * udp_tx_task, so the mutex is never held across sendto retries
  * Registered with watchdog manager to detect stuck states
  */
 static void broadcast_task(void* arg)
 {
     (void)arg;
-    uint8_t trigger;
+    broadcast_trigger_t trigger;
 
     ESP_LOGI(TAG, "Broadcast task started");
 
     // Register with watchdog (max expected delay: 1s queue wait + 100ms mutex + send time)
-    esp_err_t ret = wdt_mgr_register_task("udp_broadcast", NULL, 5000);
+    wdt_mgr_handle_t wdt = NULL;
+    esp_err_t ret = wdt_mgr_register_task("udp_broadcast", NULL, 5000, &wdt);
     if (ret != ESP_OK) {
         ESP_LOGW(TAG, "Failed to register with watchdog: %s", esp_err_to_name(ret));
         // Continue anyway - non-critical for operation
@@ -411,23 +1271,42 @@ static void broadcast_task(void* arg)
 
     while (s_task_should_run) {
         // Feed watchdog before potentially blocking operations
-        wdt_mgr_feed("udp_broadcast");
+        wdt_mgr_feed_handle(wdt);
+
+        // In streaming mode wake at least every max-age period to flush partial batches
+        TickType_t wait = pdMS_TO_TICKS(1000);
+        if (s_stream_enabled && s_stream_max_age_ms < 1000) {
+            wait = pdMS_TO_TICKS(s_stream_max_age_ms);
+            if (wait == 0) {
+                wait = 1;
+            }
+        }
 
         // Wait for timer callback to signal (wake periodically to check stop flag)
-        if (xQueueReceive(s_broadcast_queue, &trigger, pdMS_TO_TICKS(1000)) == pdTRUE) {
-            // Lock mutex for thread safety
-            if (xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                // Double-check state after acquiring mutex
-                if (!s_is_paused && s_socket >= 0) {
-                    send_udp_packet();
-                }
-                xSemaphoreGive(s_mutex);
-            } else {
-                ESP_LOGW(TAG, "Failed to acquire mutex for broadcast");
-            }
-        } else if (!s_task_should_run) {
+        bool got = (xQueueReceive(s_broadcast_queue, &trigger, wait) == pdTRUE);
+        if (!got && !s_task_should_run) {
             break;
         }
+
+        bool send_status = got && trigger.code == TRIGGER_STATUS;
+        bool send_stream = s_stream_enabled && s_stream_channel && stream_flush_due();
+        if (!send_status && !send_stream) {
+            continue;
+        }
+
+        // Lock mutex for thread safety
+        if (xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+            // Double-check state after acquiring mutex
+            if (send_status && !s_is_paused && s_sockets_open) {
+                send_udp_packet(trigger.tick_us);
+            }
+            if (send_stream && s_stream_enabled) {
+                send_stream_packets();
+            }
+            xSemaphoreGive(s_mutex);
+        } else {
+            ESP_LOGW(TAG, "Failed to acquire mutex for broadcast");
+        }
     }
 
     // Unregister from watchdog before exiting
@@ -438,6 +1317,49 @@ static void broadcast_task(void* arg)
     vTaskDelete(NULL);
 }
 
+/**
+ * Send task: owns every sendto
+ * Takes datagrams from s_tx_queue in order and returns each buffer to the
+ * pool once all its destinations have answered. Backoff on ENOMEM happens
+ * here with the mutex released (see tx_send).
+ */
+static void udp_tx_task(void* arg)
+{
+    (void)arg;
+    tx_packet_t* pkt;
+
+    // Worst case per datagram: retries x (100ms mutex + 32ms backoff)
+    wdt_mgr_handle_t wdt = NULL;
+    esp_err_t ret = wdt_mgr_register_task("udp_tx", NULL, 5000, &wdt);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to register with watchdog: %s", esp_err_to_name(ret));
+    }
+
+    while (s_task_should_run) {
+        wdt_mgr_feed_handle(wdt);
+
+        if (xQueueReceive(s_tx_queue, &pkt, pdMS_TO_TICKS(1000)) != pdTRUE || !pkt) {
+            continue;
+        }
+        tx_send(pkt);
+        tx_packet_put(pkt);
+    }
+
+    // Sockets are closed by now, so whatever is left is stale: account it
+    // (stream samples become drops) and hand the buffers back
+    while (xQueueReceive(s_tx_queue, &pkt, 0) == pdTRUE) {
+        if (pkt) {
+            tx_send(pkt);
+            tx_packet_put(pkt);
+        }
+    }
+
+    wdt_mgr_unregister_task("udp_tx");
+
+    s_tx_task = NULL;
+    vTaskDelete(NULL);
+}
+
 /**
  * Event handler for network events
  * Uses short blocking timeout to handle mutex contention gracefully
@@ -460,6 +1382,9 @@ static void udp_event_handler(void* arg, esp_event_base_t event_base,
                     esp_err_t ret = udp_broadcast_start_timer_and_socket();
                     if (ret != ESP_OK) {
                         ESP_LOGE(TAG, "Failed to start timer and socket: %s", esp_err_to_name(ret));
+                    } else {
+                        // Broadcasts resumed
+                        event_bus_post(DEVICE_EVENT, DEVICE_EVENT_UDP_STARTED, NULL, 0, 0);
                     }
                 }
                 xSemaphoreGive(s_mutex);
@@ -482,11 +1407,50 @@ static void udp_event_handler(void* arg, esp_event_base_t event_base,
     }
 }
 
+static int64_t read_u32_metric(void* ctx)
+{
+    return *(volatile uint32_t*)ctx;
+}
+
+/**
+ * Register with the diag metrics registry (idempotent across restarts)
+ */
+static void register_metrics(void)
+{
+    if (s_m_tx_packets) {
+        return;
+    }
+
+    s_m_tx_packets = diag_metric_counter("udp_tx_packets_total", "Datagrams accepted by sendto, all destinations");
+    s_m_tx_bytes = diag_metric_counter("udp_tx_bytes_total", "Bytes accepted by sendto, all destinations");
+    s_m_tx_errors = diag_metric_counter("udp_tx_errors_total", "Failed sends, all destinations");
+    diag_metric_counter_fn("udp_stream_samples_total", "GNSS samples delivered in stream datagrams",
+                           read_u32_metric, &s_stream_samples_sent);
+    diag_metric_counter_fn("udp_stream_drops_total", "GNSS samples dropped (ring overrun or network down)",
+                           read_u32_metric, &s_stream_drops);
+    s_m_stream_batch = diag_metric_histogram("udp_stream_batch_samples", "Samples per GNSS stream datagram",
+                                             s_stream_batch_bounds,
+                                             sizeof(s_stream_batch_bounds) / sizeof(s_stream_batch_bounds[0]));
+    s_m_tx_latency = diag_metric_histogram("udp_tx_latency_us", "Status datagram timer tick to last sendto return",
+                                           s_tx_latency_bounds,
+                                           sizeof(s_tx_latency_bounds) / sizeof(s_tx_latency_bounds[0]));
+    s_m_stream_latency = diag_metric_histogram("udp_stream_latency_us", "Oldest GNSS sample published to last sendto return",
+                                               s_tx_latency_bounds,
+                                               sizeof(s_tx_latency_bounds) / sizeof(s_tx_latency_bounds[0]));
+    diag_metric_counter_fn("udp_tx_nomem_retries_total", "sendto passes retried after ENOMEM/ENOBUFS",
+                           read_u32_metric, &s_tx_retries);
+    diag_metric_counter_fn("udp_tx_pool_exhausted_total", "Datagrams deferred or skipped for want of a send buffer",
+                           read_u32_metric, &s_tx_pool_exhausted);
+    diag_metric_counter_fn("udp_tx_stale_drops_total", "Queued datagrams dropped because the sockets were reopened",
+                           read_u32_metric, &s_tx_stale);
+}
+
 esp_err_t udp_broadcast_start(void)
 {
     esp_err_t ret;
 
     ESP_LOGI(TAG, "Starting UDP broadcast");
+    register_metrics();
 
     // Create mutex if not exists
     if (!s_mutex) {
@@ -507,7 +1471,7 @@ esp_err_t udp_broadcast_start(void)
         if (queue_size < 1) queue_size = 1;
         if (queue_size > MAX_QUEUE_SIZE) queue_size = MAX_QUEUE_SIZE;
 
-        s_broadcast_queue = xQueueCreate(queue_size, sizeof(uint8_t));
+        s_broadcast_queue = xQueueCreate(queue_size, sizeof(broadcast_trigger_t));
         if (!s_broadcast_queue) {
             ESP_LOGE(TAG, "Failed to create broadcast queue");
             return ESP_ERR_NO_MEM;
@@ -515,9 +1479,14 @@ esp_err_t udp_broadcast_start(void)
         ESP_LOGI(TAG, "Broadcast queue created (size: %lu)", queue_size);
     }
 
-    // Create dedicated broadcast task
+    ret = tx_pool_init();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // Create dedicated broadcast and send tasks
+    s_task_should_run = true;
     if (!s_broadcast_task) {
-        s_task_should_run = true;
         BaseType_t task_created = xTaskCreate(
             broadcast_task,
             "udp_broadcast",
@@ -532,6 +1501,13 @@ esp_err_t udp_broadcast_start(void)
             return ESP_ERR_NO_MEM;
         }
     }
+    if (!s_tx_task) {
+        if (xTaskCreate(udp_tx_task, "udp_tx", 3072, NULL, 5, &s_tx_task) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create send task");
+            s_task_should_run = false;
+            return ESP_ERR_NO_MEM;
+        }
+    }
 
     if (xSemaphoreTake(s_mutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
         ESP_LOGE(TAG, "Failed to acquire mutex");
@@ -560,6 +1536,10 @@ esp_err_t udp_broadcast_start(void)
     uint32_t freq_mhz = 1000;  // Stored as millihertz (1 Hz = 1000 mHz)
     uint32_t ttl = 1;
     uint32_t mode = 0;
+    uint32_t format = UDP_FORMAT_JSON;
+    uint32_t stream_en = 0;
+    uint32_t stream_batch = STREAM_DEFAULT_BATCH;
+    uint32_t stream_ms = STREAM_DEFAULT_MAX_AGE_MS;
 
     config_mgr_get_string("udp/addr", addr, sizeof(addr));
     config_mgr_get_u32("udp/port", &port);
@@ -569,6 +1549,10 @@ esp_err_t udp_broadcast_start(void)
     }
     config_mgr_get_u32("udp/ttl", &ttl);
     config_mgr_get_u32("udp/mode", &mode);
+    config_mgr_get_u32("udp/format", &format);
+    config_mgr_get_u32("udp/stream_en", &stream_en);
+    config_mgr_get_u32("udp/stream_n", &stream_batch);
+    config_mgr_get_u32("udp/stream_ms", &stream_ms);
 
     // Validate configuration at load time
     // Clamp port to valid range
@@ -586,7 +1570,7 @@ esp_err_t udp_broadcast_start(void)
     }
 
     // Validate mode
-    if (mode > UDP_MODE_MULTICAST) {
+    if (mode > UDP_MODE_UNICAST) {
         ESP_LOGW(TAG, "Invalid mode %lu, using broadcast", mode);
         mode = UDP_MODE_BROADCAST;
     }
@@ -597,6 +1581,34 @@ esp_err_t udp_broadcast_start(void)
         ttl = 1;
     }
 
+    // Validate format
+    if (format > UDP_FORMAT_BINARY) {
+        ESP_LOGW(TAG, "Invalid format %lu, using json", format);
+        format = UDP_FORMAT_JSON;
+    }
+
+    // Clamp streaming batch limits
+    if (stream_batch < 1) stream_batch = 1;
+    if (stream_batch > STREAM_MAX_BATCH) stream_batch = STREAM_MAX_BATCH;
+    if (stream_ms < STREAM_MIN_MAX_AGE_MS) stream_ms = STREAM_MIN_MAX_AGE_MS;
+    if (stream_ms > STREAM_MAX_MAX_AGE_MS) stream_ms = STREAM_MAX_MAX_AGE_MS;
+
+    if (stream_en && !s_stream_channel) {
+        esp_err_t ch_ret = event_bus_channel_create(UDP_GNSS_CHANNEL, sizeof(udp_gnss_sample_t),
+                                                    UDP_GNSS_CHANNEL_SLOTS, &s_stream_channel);
+        if (ch_ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to attach GNSS channel (%s), streaming disabled",
+                     esp_err_to_name(ch_ret));
+            s_stream_channel = NULL;
+            stream_en = 0;
+        } else {
+            event_bus_reader_init(s_stream_channel, &s_stream_reader);
+        }
+    }
+    s_stream_batch = stream_batch;
+    s_stream_max_age_ms = stream_ms;
+    s_stream_enabled = (stream_en != 0);
+
     // Convert millihertz to Hz for validation
     float freq_hz = (float)freq_mhz / 1000.0f;
 
@@ -606,6 +1618,7 @@ esp_err_t udp_broadcast_start(void)
     s_config.port = (uint16_t)port;
     s_config.freq_mhz = (uint16_t)freq_mhz;  // Store millihertz directly
     s_config.ttl = (uint8_t)ttl;
+    s_config.format = (udp_format_t)format;
 
     // Validate frequency
     float validated_freq = validate_frequency(freq_hz);
@@ -613,28 +1626,44 @@ esp_err_t udp_broadcast_start(void)
         ESP_LOGW(TAG, "Frequency adjusted from %.2f Hz to %.2f Hz", freq_hz, validated_freq);
     }
 
-    // Setup destination address
-    memset(&s_dest_addr, 0, sizeof(s_dest_addr));
-    s_dest_addr.sin_family = AF_INET;
-    s_dest_addr.sin_port = htons(s_config.port);
-    if (inet_aton(s_config.addr, &s_dest_addr.sin_addr) == 0) {
-        ESP_LOGE(TAG, "Invalid destination address: %s", s_config.addr);
+    // Setup destination list: primary first, then extra destinations
+    s_dest_count = 0;
+    udp_dest_t primary = {
+        .mode = s_config.mode,
+        .port = s_config.port,
+        .ttl = s_config.ttl,
+        .rate_div = 1,
+    };
+    strlcpy(primary.addr, s_config.addr, sizeof(primary.addr));
+    ret = add_destination(&primary);
+    if (ret != ESP_OK) {
         xSemaphoreGive(s_mutex);
-        return ESP_ERR_INVALID_ARG;
+        return ret;
+    }
+
+    udp_dest_t extra[UDP_MAX_DESTINATIONS - 1];
+    size_t extra_count = 0;
+    udp_broadcast_get_destinations(extra, UDP_MAX_DESTINATIONS - 1, &extra_count);
+    for (size_t i = 0; i < extra_count; i++) {
+        if (add_destination(&extra[i]) == ESP_OK) {
+            ESP_LOGI(TAG, "Extra destination: %s %s:%u (TTL=%u, every %u)",
+                     mode_to_string(extra[i].mode), extra[i].addr, extra[i].port,
+                     extra[i].ttl, extra[i].rate_div);
+        }
     }
 
     // Register event handlers for NET_READY/NET_LOST (before creating socket/timer)
-    ret = esp_event_handler_register(DEVICE_EVENT, DEVICE_EVENT_NET_READY, &udp_event_handler, NULL);
+    ret = event_bus_register(DEVICE_EVENT_NET_READY, &udp_event_handler, NULL);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register NET_READY handler: %s", esp_err_to_name(ret));
         xSemaphoreGive(s_mutex);
         return ret;
     }
 
-    ret = esp_event_handler_register(DEVICE_EVENT, DEVICE_EVENT_NET_LOST, &udp_event_handler, NULL);
+    ret = event_bus_register(DEVICE_EVENT_NET_LOST, &udp_event_handler, NULL);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register NET_LOST handler: %s", esp_err_to_name(ret));
-        esp_event_handler_unregister(DEVICE_EVENT, DEVICE_EVENT_NET_READY, &udp_event_handler);
+        event_bus_unregister(DEVICE_EVENT_NET_READY, &udp_event_handler);
         xSemaphoreGive(s_mutex);
         return ret;
     }
@@ -642,10 +1671,13 @@ esp_err_t udp_broadcast_start(void)
     s_is_running = true;
     s_is_paused = true;  // Start paused, will check network status below
 
-    const char* mode_str = (s_config.mode == UDP_MODE_BROADCAST) ? "broadcast" :
-                           (s_config.mode == UDP_MODE_MULTICAST) ? "multicast" : "unicast";
-    ESP_LOGI(TAG, "UDP %s module initialized: %s:%d @ %.2f Hz (TTL=%d)",
-             mode_str, s_config.addr, s_config.port, validated_freq, s_config.ttl);
+    // Config (e.g. device_id) may have changed since the last start
+    invalidate_payload_template();
+
+    const char* mode_str = mode_to_string(s_config.mode);
+    ESP_LOGI(TAG, "UDP %s module initialized: %s:%d @ %.2f Hz (TTL=%d, %s)",
+             mode_str, s_config.addr, s_config.port, validated_freq, s_config.ttl,
+             s_config.format == UDP_FORMAT_BINARY ? "binary" : "json");
 
     // CRITICAL: Check if network is already up (race condition fix)
     // If NET_READY already fired before handler registration, we need to start now
@@ -663,6 +1695,14 @@ esp_err_t udp_broadcast_start(void)
         ESP_LOGI(TAG, "Waiting for network (NET_READY event)...");
     }
 
+    if (s_stream_enabled) {
+        ESP_LOGI(TAG, "GNSS streaming enabled: batch %lu samples / %lu ms",
+                 s_stream_batch, s_stream_max_age_ms);
+    }
+
+    // Post UDP_STARTED event (also covers the restart in apply_config)
+    event_bus_post(DEVICE_EVENT, DEVICE_EVENT_UDP_STARTED, NULL, 0, 0);
+
     xSemaphoreGive(s_mutex);
     return ESP_OK;
 }
@@ -690,12 +1730,19 @@ esp_err_t udp_broadcast_stop(void)
     udp_broadcast_stop_timer_and_socket();
 
     // Unregister event handlers
-    esp_event_handler_unregister(DEVICE_EVENT, DEVICE_EVENT_NET_READY, &udp_event_handler);
-    esp_event_handler_unregister(DEVICE_EVENT, DEVICE_EVENT_NET_LOST, &udp_event_handler);
+    event_bus_unregister(DEVICE_EVENT_NET_READY, &udp_event_handler);
+    event_bus_unregister(DEVICE_EVENT_NET_LOST, &udp_event_handler);
 
     s_is_running = false;
     s_task_should_run = false;
 
+    // Reject further samples and discard anything still pending
+    s_stream_enabled = false;
+    if (s_stream_channel) {
+        event_bus_reader_skip(s_stream_channel, &s_stream_reader);
+        s_stream_reader.missed = 0;
+    }
+
     ESP_LOGI(TAG, "UDP broadcast stopped (sent %lu packets, %lu bytes, %lu errors)",
              s_packets_sent, s_bytes_sent, s_send_errors);
 
@@ -704,14 +1751,18 @@ esp_err_t udp_broadcast_stop(void)
 
     xSemaphoreGive(s_mutex);
 
-    // Wake broadcast task so it can exit if it's blocking on the queue
+    // Wake both tasks so they can exit if they are blocking on their queues
     if (s_broadcast_queue) {
-        uint8_t trigger = 0;
+        broadcast_trigger_t trigger = { .code = TRIGGER_WAKE };
         xQueueSend(s_broadcast_queue, &trigger, 0);
     }
+    if (s_tx_queue) {
+        tx_packet_t* wake = NULL;
+        xQueueSend(s_tx_queue, &wake, 0);
+    }
 
-    // Wait briefly for the task to cleanly exit
-    for (int i = 0; i < 10 && s_broadcast_task != NULL; i++) {
+    // Wait briefly for the tasks to cleanly exit
+    for (int i = 0; i < 10 && (s_broadcast_task != NULL || s_tx_task != NULL); i++) {
         vTaskDelay(pdMS_TO_TICKS(50));
     }
 
@@ -735,8 +1786,8 @@ esp_err_t udp_broadcast_apply_config(const udp_cfg_t* cfg)
     // Use rounding to avoid truncation (e.g., 0.2*1000=199.999... → 200, not 199)
     uint32_t freq_mhz = (uint32_t)lroundf(validated_freq * 1000.0f);
 
-    ESP_LOGI(TAG, "UDP config: mode=%d addr=%s port=%u freq=%.2f Hz (%lu mHz) ttl=%u",
-             cfg->mode, cfg->addr, cfg->port, validated_freq, freq_mhz, cfg->ttl);
+    ESP_LOGI(TAG, "UDP config: mode=%d addr=%s port=%u freq=%.2f Hz (%lu mHz) ttl=%u format=%d",
+             cfg->mode, cfg->addr, cfg->port, validated_freq, freq_mhz, cfg->ttl, cfg->format);
 
     // Restart if running
     bool was_running = s_is_running;
@@ -748,13 +1799,22 @@ esp_err_t udp_broadcast_apply_config(const udp_cfg_t* cfg)
         }
     }
 
-    // Update config in NVS
+    // Update config in NVS as one transaction (single commit)
     // Store frequency as millihertz to preserve fractional values (e.g., 0.2 Hz = 200 mHz)
-    config_mgr_set_u32("udp/mode", (uint32_t)cfg->mode);
-    config_mgr_set_string("udp/addr", cfg->addr);
-    config_mgr_set_u32("udp/port", (uint32_t)cfg->port);
-    config_mgr_set_u32("udp/freq_mhz", freq_mhz);  // Store as millihertz (key name matches units)
-    config_mgr_set_u32("udp/ttl", (uint32_t)cfg->ttl);
+    config_mgr_txn_t* txn = NULL;
+    esp_err_t txn_ret = config_mgr_txn_begin(&txn);
+    if (txn_ret == ESP_OK) {
+        config_mgr_txn_set_u32(txn, "udp/mode", (uint32_t)cfg->mode);
+        config_mgr_txn_set_string(txn, "udp/addr", cfg->addr);
+        config_mgr_txn_set_u32(txn, "udp/port", (uint32_t)cfg->port);
+        config_mgr_txn_set_u32(txn, "udp/freq_mhz", freq_mhz);  // Store as millihertz (key name matches units)
+        config_mgr_txn_set_u32(txn, "udp/ttl", (uint32_t)cfg->ttl);
+        config_mgr_txn_set_u32(txn, "udp/format", (uint32_t)cfg->format);
+        txn_ret = config_mgr_txn_commit(txn);
+    }
+    if (txn_ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save UDP config: %s", esp_err_to_name(txn_ret));
+    }
 
     // Restart if was running
     if (was_running) {
@@ -782,7 +1842,164 @@ esp_err_t udp_broadcast_publish_now(void)
         return ESP_ERR_INVALID_STATE;
     }
 
-    send_udp_packet();
+    send_udp_packet(esp_timer_get_time());
+
+    xSemaphoreGive(s_mutex);
+    return ESP_OK;
+}
+
+#ifdef CONFIG_RUN_UNIT_TESTS
+esp_err_t udp_broadcast_test_build_payload(size_t* len_out)
+{
+    if (!s_mutex) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (xSemaphoreTake(s_mutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+        return ESP_FAIL;
+    }
+    int len = build_payload();
+    xSemaphoreGive(s_mutex);
+
+    if (len < 0) {
+        return ESP_FAIL;
+    }
+    if (len_out) {
+        *len_out = (size_t)len;
+    }
+    return ESP_OK;
+}
+#endif
+
+esp_err_t udp_broadcast_push_gnss_sample(const udp_gnss_sample_t* sample)
+{
+    if (!sample) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_stream_enabled || !s_stream_channel) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    int64_t ts_us = sample->ts_us;
+    if (ts_us == 0) {
+        ts_us = sntp_client_now_us(NULL, NULL);
+    }
+
+    // Serialize callers so the ring keeps a single producer
+    taskENTER_CRITICAL(&s_stream_push_lock);
+    udp_gnss_sample_t* slot = event_bus_channel_reserve(s_stream_channel);
+    *slot = *sample;
+    slot->ts_us = ts_us;
+    event_bus_channel_publish(s_stream_channel);
+    taskEXIT_CRITICAL(&s_stream_push_lock);
+
+    // Wake the task as soon as a full batch is ready; partial batches are
+    // flushed by the task's max-age timeout
+    if (event_bus_channel_pending(s_stream_channel, &s_stream_reader) >= s_stream_batch) {
+        broadcast_trigger_t trigger = { .code = TRIGGER_STREAM };
+        if (xQueueSend(s_broadcast_queue, &trigger, 0) != pdTRUE) {
+            s_stream_overruns++;
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t udp_broadcast_get_stats(udp_broadcast_stats_t* stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    stats->packets_sent = s_packets_sent;
+    stats->bytes_sent = s_bytes_sent;
+    stats->send_errors = s_send_errors;
+    stats->stream_packets_sent = s_stream_packets_sent;
+    stats->stream_samples_sent = s_stream_samples_sent;
+    stats->stream_drops = s_stream_drops;
+    stats->stream_overruns = s_stream_overruns;
+    stats->tx_retries = s_tx_retries;
+    stats->tx_pool_exhausted = s_tx_pool_exhausted;
+    stats->tx_stale_drops = s_tx_stale;
+    stats->tx_latency_last_us = s_tx_latency_last_us;
+    stats->tx_latency_max_us = s_tx_latency_max_us;
+    return ESP_OK;
+}
+
+esp_err_t udp_broadcast_get_destinations(udp_dest_t* out, size_t max, size_t* count)
+{
+    if (!out || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *count = 0;
+    for (int i = 1; i < UDP_MAX_DESTINATIONS && *count < max; i++) {
+        char key[16];
+        char val[80] = {0};
+        snprintf(key, sizeof(key), "udp/dest%d", i);
+        if (config_mgr_get_string(key, val, sizeof(val)) != ESP_OK || val[0] == '\0') {
+            continue;
+        }
+        if (!parse_destination(val, &out[*count])) {
+            ESP_LOGW(TAG, "Ignoring invalid %s: '%s'", key, val);
+            continue;
+        }
+        (*count)++;
+    }
+    return ESP_OK;
+}
+
+esp_err_t udp_broadcast_txn_set_destinations(config_mgr_txn_t* txn, const udp_dest_t* dests, size_t count)
+{
+    if (!txn || (count > 0 && !dests) || count > UDP_MAX_DESTINATIONS - 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int i = 1; i < UDP_MAX_DESTINATIONS; i++) {
+        char key[16];
+        char val[80] = {0};
+        snprintf(key, sizeof(key), "udp/dest%d", i);
+
+        if ((size_t)i <= count) {
+            const udp_dest_t* d = &dests[i - 1];
+            struct in_addr test_addr;
+            if (d->mode > UDP_MODE_UNICAST || d->port == 0 || inet_aton(d->addr, &test_addr) == 0) {
+                ESP_LOGE(TAG, "Invalid destination %d: %s:%u", i, d->addr, d->port);
+                return ESP_ERR_INVALID_ARG;
+            }
+            snprintf(val, sizeof(val), "%s,%s,%u,%u,%u", mode_to_string(d->mode), d->addr, d->port,
+                     d->ttl ? d->ttl : 1, d->rate_div ? d->rate_div : 1);
+        }
+
+        // Empty string clears the slot
+        esp_err_t ret = config_mgr_txn_set_string(txn, key, val);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t udp_broadcast_get_dest_stats(udp_dest_stats_t* out, size_t max, size_t* count)
+{
+    if (!out || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *count = 0;
+    if (!s_mutex || xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (size_t i = 0; i < s_dest_count && i < max; i++) {
+        out[i].dest = s_dests[i].cfg;
+        out[i].packets_sent = s_dests[i].packets_sent;
+        out[i].bytes_sent = s_dests[i].bytes_sent;
+        out[i].send_errors = s_dests[i].send_errors;
+        out[i].last_errno = s_dests[i].last_errno;
+        (*count)++;
+    }
 
     xSemaphoreGive(s_mutex);
     return ESP_OK;
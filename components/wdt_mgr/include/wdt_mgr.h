@@ -16,13 +16,14 @@
  * @code
  * void my_task(void *arg) {
  *     // Register with watchdog
- *     wdt_mgr_register_task("my_task", xTaskGetCurrentTaskHandle(), 10000);
+ *     wdt_mgr_handle_t wdt = NULL;
+ *     wdt_mgr_register_task("my_task", xTaskGetCurrentTaskHandle(), 10000, &wdt);
  *
  *     while (1) {
  *         // Do work...
  *
  *         // Feed watchdog periodically (must be within timeout period)
- *         wdt_mgr_feed("my_task");
+ *         wdt_mgr_feed_handle(wdt);
  *
  *         vTaskDelay(pdMS_TO_TICKS(2000));
  *     }
@@ -34,11 +35,19 @@
  * - ntrip_client (connection management task)
  * - udp_broadcast (broadcast_task)
  *
+ * Each feed records the gap since the previous one. Gaps of at least
+ * CONFIG_WDT_MGR_NEAR_MISS_PCT percent of the task's timeout count as near
+ * misses; the longest and average gap and the near misses are exported per
+ * task as wdt_feed_interval_max_ms, wdt_feed_interval_avg_ms and
+ * wdt_near_misses_total, so a task drifting towards a bark shows up first.
+ *
  * Tasks excluded (with rationale):
  * - http_ui: Uses ESP-IDF httpd thread pool with built-in timeout management,
  *   no long-running dedicated task that could block indefinitely
  */
 #pragma once
+#include <stddef.h>
+#include <stdint.h>
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -47,6 +56,26 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Registered task, for wdt_mgr_feed_handle()
+ *
+ * Valid until the task is unregistered.
+ */
+typedef struct wdt_mgr_task* wdt_mgr_handle_t;
+
+/**
+ * @brief Feed statistics of one registered task
+ */
+typedef struct {
+    char name[32];
+    uint32_t timeout_ms;        // Effective timeout near misses are measured against
+    uint32_t feeds;
+    uint32_t max_interval_ms;   // Longest gap between feeds since registration
+    uint32_t avg_interval_ms;   // Moving average of the gap (weight 1/8)
+    uint32_t near_misses;
+    uint32_t since_feed_ms;     // Time since the last feed (0 before the first)
+} wdt_mgr_task_stats_t;
+
 /**
  * @brief Initialize the watchdog manager
  *
@@ -63,13 +92,15 @@ esp_err_t wdt_mgr_init(void);
 /**
  * @brief Register a task with the watchdog
  *
- * Tasks must call this before using wdt_mgr_feed(). The timeout_ms parameter
- * is for informational purposes only; the actual timeout is global and set
- * via CONFIG_ESP_TASK_WDT_TIMEOUT_S in sdkconfig.
+ * Tasks must call this before feeding. The bark itself uses the global
+ * timeout set via CONFIG_ESP_TASK_WDT_TIMEOUT_S in sdkconfig; timeout_ms
+ * (if it is shorter) is what near misses are measured against.
  *
  * @param name Unique name for this task (max 31 chars)
  * @param handle Task handle or NULL for current task
- * @param timeout_ms Expected feed interval in ms (informational)
+ * @param timeout_ms Expected feed interval in ms (0 = the TWDT timeout)
+ * @param out Receives the handle for wdt_mgr_feed_handle() (may be NULL);
+ *            an already registered name returns its existing handle
  *
  * @return
  *  - ESP_OK: Success
@@ -78,16 +109,27 @@ esp_err_t wdt_mgr_init(void);
  *  - ESP_ERR_NO_MEM: Too many tasks registered (max 8)
  *  - Other: TWDT registration failed
  */
-esp_err_t wdt_mgr_register_task(const char* name, TaskHandle_t handle, int timeout_ms);
+esp_err_t wdt_mgr_register_task(const char* name, TaskHandle_t handle, int timeout_ms,
+                                wdt_mgr_handle_t* out);
 
 /**
- * @brief Feed the watchdog for a named task
+ * @brief Feed the watchdog for a registered task
  *
- * Tasks must call this periodically (within the configured timeout) to
- * prevent watchdog events. A successful feed resets the bark counter to 0,
- * allowing the system to recover from previous failures.
+ * Constant time: no name lookup. Tasks must call this periodically (within
+ * the configured timeout) to prevent watchdog events. A successful feed
+ * resets the bark counter to 0, allowing the system to recover from
+ * previous failures. Call it only from the task the handle belongs to,
+ * which owns its feed statistics. NULL handles are ignored.
  *
- * Safe to call from any context.
+ * @param handle Handle from wdt_mgr_register_task()
+ */
+void wdt_mgr_feed_handle(wdt_mgr_handle_t handle);
+
+/**
+ * @brief Feed the watchdog for a named task
+ *
+ * Same as wdt_mgr_feed_handle() after a lookup by name; prefer the handle
+ * in loops.
  *
  * @param name Task name used in wdt_mgr_register_task()
  */
@@ -108,6 +150,14 @@ void wdt_mgr_feed(const char* name);
  */
 esp_err_t wdt_mgr_unregister_task(const char* name);
 
+/**
+ * @brief Copy the feed statistics of every registered task
+ *
+ * @param out Array of max entries
+ * @param count Entries written
+ */
+esp_err_t wdt_mgr_get_stats(wdt_mgr_task_stats_t* out, size_t max, size_t* count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,8 +1,11 @@
 #include "wdt_mgr.h"
 #include "event_bus.h"
+#include "diag.h"
 #include "esp_log.h"
 #include "esp_task_wdt.h"
 #include "esp_system.h"
+#include "esp_timer.h"
+#include <stdio.h>
 #include <string.h>
 
 static const char *TAG = "wdt_mgr";
@@ -16,20 +19,102 @@ static const char *TAG = "wdt_mgr";
 #define CONFIG_ESP_TASK_WDT_TIMEOUT_S 10
 #endif
 
-typedef struct {
+#define INTERVAL_AVG_SHIFT 3  // Moving average weight 1/8
+
+// Slot for one registered task; a wdt_mgr_handle_t points at it
+typedef struct wdt_mgr_task {
     char name[MAX_TASK_NAME_LEN];
     TaskHandle_t handle;
     esp_task_wdt_user_handle_t wdt_handle;
     bool active;
+    uint32_t timeout_ms;        // Smaller of the task's timeout and the TWDT timeout
+    int64_t near_miss_us;       // Feed interval counted as a near miss
+    // Written only by the feeding task; read by metrics and wdt_mgr_get_stats()
+    int64_t last_feed_us;
+    uint32_t feeds;
+    uint32_t max_interval_us;
+    uint32_t avg_interval_us;
+    uint32_t near_misses;
 } registered_task_t;
 
 static registered_task_t s_registered_tasks[MAX_REGISTERED_TASKS];
 static volatile int s_bark_count = 0;
 static bool s_initialized = false;
+static diag_metric_t* s_m_barks = NULL;
 
 // Forward declaration of ISR handler
 void esp_task_wdt_isr_user_handler(void);
 
+/**
+ * Per-task feed metrics, labelled with the task name
+ * Rendered per scrape rather than registered per task, so each family's
+ * rows stay together under one TYPE line whatever order tasks register in.
+ */
+static esp_err_t write_task_metrics(diag_metrics_sink_t sink, void* ctx) {
+    static const struct {
+        const char* name;
+        const char* type;
+        const char* help;
+    } families[] = {
+        { "wdt_feed_interval_max_ms", "gauge", "Longest gap between watchdog feeds" },
+        { "wdt_feed_interval_avg_ms", "gauge", "Moving average of the gap between watchdog feeds" },
+        { "wdt_near_misses_total", "counter", "Feeds that came within WDT_MGR_NEAR_MISS_PCT of the timeout" },
+    };
+    // Longest row: the avg family, a full task name and a 10-digit value
+    char line[128];
+    esp_err_t ret;
+    int len;
+
+    for (size_t f = 0; f < sizeof(families) / sizeof(families[0]); f++) {
+        len = snprintf(line, sizeof(line), "# HELP %s %s\n", families[f].name, families[f].help);
+        if ((ret = sink(line, len, ctx)) != ESP_OK) {
+            return ret;
+        }
+        len = snprintf(line, sizeof(line), "# TYPE %s %s\n", families[f].name, families[f].type);
+        if ((ret = sink(line, len, ctx)) != ESP_OK) {
+            return ret;
+        }
+
+        for (int i = 0; i < MAX_REGISTERED_TASKS; i++) {
+            const registered_task_t* t = &s_registered_tasks[i];
+            if (!t->active) {
+                continue;
+            }
+            uint32_t v = f == 0 ? t->max_interval_us / 1000 :
+                         f == 1 ? t->avg_interval_us / 1000 : t->near_misses;
+            len = snprintf(line, sizeof(line), "%s{task=\"%.*s\"} %lu\n", families[f].name,
+                           MAX_TASK_NAME_LEN - 1, t->name, (unsigned long)v);
+            if (len <= 0 || (size_t)len >= sizeof(line)) {
+                continue;   // Never cut a row into a malformed one
+            }
+            if ((ret = sink(line, len, ctx)) != ESP_OK) {
+                return ret;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+static registered_task_t* find_task(const char* name) {
+    for (int i = 0; i < MAX_REGISTERED_TASKS; i++) {
+        if (s_registered_tasks[i].active && strcmp(s_registered_tasks[i].name, name) == 0) {
+            return &s_registered_tasks[i];
+        }
+    }
+    return NULL;
+}
+
+static int64_t count_registered_tasks(void* ctx) {
+    (void)ctx;
+    int64_t n = 0;
+    for (int i = 0; i < MAX_REGISTERED_TASKS; i++) {
+        if (s_registered_tasks[i].active) {
+            n++;
+        }
+    }
+    return n;
+}
+
 esp_err_t wdt_mgr_init(void) {
     if (s_initialized) {
         ESP_LOGW(TAG, "WDT manager already initialized");
@@ -55,13 +140,19 @@ esp_err_t wdt_mgr_init(void) {
     s_initialized = true;
     s_bark_count = 0;
 
+    s_m_barks = diag_metric_counter("wdt_barks_total", "Task watchdog timeouts (barks)");
+    diag_metric_gauge_fn("wdt_registered_tasks", "Tasks registered with the watchdog manager",
+                         count_registered_tasks, NULL);
+    diag_metrics_add_writer(write_task_metrics);
+
     ESP_LOGI(TAG, "WDT manager initialized (timeout=%u ms, bark_threshold=%d)",
              twdt_config.timeout_ms, BARK_THRESHOLD);
 
     return ESP_OK;
 }
 
-esp_err_t wdt_mgr_register_task(const char* name, TaskHandle_t handle, int timeout_ms) {
+esp_err_t wdt_mgr_register_task(const char* name, TaskHandle_t handle, int timeout_ms,
+                                wdt_mgr_handle_t* out) {
     if (!s_initialized) {
         ESP_LOGE(TAG, "WDT manager not initialized");
         return ESP_ERR_INVALID_STATE;
@@ -73,11 +164,13 @@ esp_err_t wdt_mgr_register_task(const char* name, TaskHandle_t handle, int timeo
     }
 
     // Check if task already registered
-    for (int i = 0; i < MAX_REGISTERED_TASKS; i++) {
-        if (s_registered_tasks[i].active && strcmp(s_registered_tasks[i].name, name) == 0) {
-            ESP_LOGW(TAG, "Task '%s' already registered", name);
-            return ESP_OK;
+    registered_task_t* existing = find_task(name);
+    if (existing) {
+        ESP_LOGW(TAG, "Task '%s' already registered", name);
+        if (out) {
+            *out = existing;
         }
+        return ESP_OK;
     }
 
     // Find empty slot
@@ -103,17 +196,70 @@ esp_err_t wdt_mgr_register_task(const char* name, TaskHandle_t handle, int timeo
     }
 
     // Store task information
-    strncpy(s_registered_tasks[slot].name, name, MAX_TASK_NAME_LEN - 1);
-    s_registered_tasks[slot].name[MAX_TASK_NAME_LEN - 1] = '\0';
-    s_registered_tasks[slot].handle = handle;
-    s_registered_tasks[slot].wdt_handle = wdt_handle;
-    s_registered_tasks[slot].active = true;
+    registered_task_t* t = &s_registered_tasks[slot];
+    memset(t, 0, sizeof(*t));
+    strncpy(t->name, name, MAX_TASK_NAME_LEN - 1);
+    t->name[MAX_TASK_NAME_LEN - 1] = '\0';
+    t->handle = handle;
+    t->wdt_handle = wdt_handle;
+    t->timeout_ms = CONFIG_ESP_TASK_WDT_TIMEOUT_S * 1000;
+    if (timeout_ms > 0 && (uint32_t)timeout_ms < t->timeout_ms) {
+        t->timeout_ms = (uint32_t)timeout_ms;
+    }
+    t->near_miss_us = (int64_t)t->timeout_ms * 10 * CONFIG_WDT_MGR_NEAR_MISS_PCT;
+    t->active = true;
+
+    if (out) {
+        *out = t;
+    }
 
     ESP_LOGI(TAG, "Registered task '%s' with TWDT (timeout=%d ms)", name, timeout_ms);
 
     return ESP_OK;
 }
 
+void wdt_mgr_feed_handle(wdt_mgr_handle_t handle) {
+    registered_task_t* t = handle;
+    if (t == NULL || !t->active) {
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+    esp_err_t ret = esp_task_wdt_reset_user(t->wdt_handle);
+    if (ret == ESP_OK) {
+        // Successfully fed - reset bark counter to allow recovery
+        // This ensures we only count consecutive barks, not lifetime barks
+        if (s_bark_count > 0) {
+            ESP_LOGD(TAG, "Task '%s' recovered, resetting bark counter from %d to 0",
+                     t->name, s_bark_count);
+        }
+        s_bark_count = 0;
+    } else if (ret != ESP_ERR_NOT_FOUND) {
+        // Only log if it's an actual error (not just task not found)
+        ESP_LOGD(TAG, "Failed to feed watchdog for '%s': %s", t->name, esp_err_to_name(ret));
+    }
+
+    if (t->last_feed_us != 0) {
+        int64_t gap = now - t->last_feed_us;
+        uint32_t interval = (gap > UINT32_MAX) ? UINT32_MAX : (uint32_t)gap;
+        if (interval > t->max_interval_us) {
+            t->max_interval_us = interval;
+        }
+        if (t->feeds <= 1) {
+            t->avg_interval_us = interval;
+        } else {
+            t->avg_interval_us += ((int32_t)(interval - t->avg_interval_us)) >> INTERVAL_AVG_SHIFT;
+        }
+        if (gap >= t->near_miss_us) {
+            t->near_misses++;
+            ESP_LOGW(TAG, "Task '%s' fed after %lu ms (timeout %lu ms)", t->name,
+                     (unsigned long)(interval / 1000), (unsigned long)t->timeout_ms);
+        }
+    }
+    t->last_feed_us = now;
+    t->feeds++;
+}
+
 void wdt_mgr_feed(const char* name) {
     if (!s_initialized) {
         return;
@@ -123,27 +269,37 @@ void wdt_mgr_feed(const char* name) {
         return;
     }
 
-    // Find task by name
-    for (int i = 0; i < MAX_REGISTERED_TASKS; i++) {
-        if (s_registered_tasks[i].active && strcmp(s_registered_tasks[i].name, name) == 0) {
-            esp_err_t ret = esp_task_wdt_reset_user(s_registered_tasks[i].wdt_handle);
-            if (ret == ESP_OK) {
-                // Successfully fed - reset bark counter to allow recovery
-                // This ensures we only count consecutive barks, not lifetime barks
-                if (s_bark_count > 0) {
-                    ESP_LOGD(TAG, "Task '%s' recovered, resetting bark counter from %d to 0",
-                             name, s_bark_count);
-                }
-                s_bark_count = 0;
-            } else if (ret != ESP_ERR_NOT_FOUND) {
-                // Only log if it's an actual error (not just task not found)
-                ESP_LOGD(TAG, "Failed to feed watchdog for '%s': %s", name, esp_err_to_name(ret));
-            }
-            return;
-        }
+    registered_task_t* t = find_task(name);
+    if (t == NULL) {
+        ESP_LOGD(TAG, "Task '%s' not found in registered tasks", name);
+        return;
+    }
+    wdt_mgr_feed_handle(t);
+}
+
+esp_err_t wdt_mgr_get_stats(wdt_mgr_task_stats_t* out, size_t max, size_t* count) {
+    if (out == NULL || count == NULL) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-    ESP_LOGD(TAG, "Task '%s' not found in registered tasks", name);
+    int64_t now = esp_timer_get_time();
+    size_t n = 0;
+    for (int i = 0; i < MAX_REGISTERED_TASKS && n < max; i++) {
+        const registered_task_t* t = &s_registered_tasks[i];
+        if (!t->active) {
+            continue;
+        }
+        wdt_mgr_task_stats_t* st = &out[n++];
+        strlcpy(st->name, t->name, sizeof(st->name));
+        st->timeout_ms = t->timeout_ms;
+        st->feeds = t->feeds;
+        st->max_interval_ms = t->max_interval_us / 1000;
+        st->avg_interval_ms = t->avg_interval_us / 1000;
+        st->near_misses = t->near_misses;
+        st->since_feed_ms = t->last_feed_us ? (uint32_t)((now - t->last_feed_us) / 1000) : 0;
+    }
+    *count = n;
+    return ESP_OK;
 }
 
 esp_err_t wdt_mgr_unregister_task(const char* name) {
@@ -158,26 +314,25 @@ esp_err_t wdt_mgr_unregister_task(const char* name) {
     }
 
     // Find and unregister task
-    for (int i = 0; i < MAX_REGISTERED_TASKS; i++) {
-        if (s_registered_tasks[i].active && strcmp(s_registered_tasks[i].name, name) == 0) {
-            esp_err_t ret = esp_task_wdt_delete_user(s_registered_tasks[i].wdt_handle);
-            if (ret != ESP_OK) {
-                ESP_LOGW(TAG, "Failed to unregister task '%s' from TWDT: %s",
-                         name, esp_err_to_name(ret));
-                // Continue cleanup even if TWDT delete fails
-            }
-
-            // Clear slot
-            s_registered_tasks[i].active = false;
-            memset(&s_registered_tasks[i], 0, sizeof(registered_task_t));
+    registered_task_t* t = find_task(name);
+    if (t == NULL) {
+        ESP_LOGW(TAG, "Task '%s' not found in registered tasks", name);
+        return ESP_ERR_NOT_FOUND;
+    }
 
-            ESP_LOGI(TAG, "Unregistered task '%s' from TWDT", name);
-            return ESP_OK;
-        }
+    esp_err_t ret = esp_task_wdt_delete_user(t->wdt_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to unregister task '%s' from TWDT: %s",
+                 name, esp_err_to_name(ret));
+        // Continue cleanup even if TWDT delete fails
     }
 
-    ESP_LOGW(TAG, "Task '%s' not found in registered tasks", name);
-    return ESP_ERR_NOT_FOUND;
+    // Clear slot (its feed statistics stop with it)
+    t->active = false;
+    memset(t, 0, sizeof(registered_task_t));
+
+    ESP_LOGI(TAG, "Unregistered task '%s' from TWDT", name);
+    return ESP_OK;
 }
 
 // ISR handler for TWDT timeout (bark event)
@@ -185,17 +340,18 @@ esp_err_t wdt_mgr_unregister_task(const char* name) {
 //
 // Bark/bite semantics:
 // - s_bark_count tracks CONSECUTIVE barks (failures to feed)
-// - Counter is reset to 0 in wdt_mgr_feed() on successful feed (recovery)
+// - Counter is reset to 0 in wdt_mgr_feed_handle() on successful feed (recovery)
 // - Only 3 consecutive barks without any successful feeds trigger a bite (reboot)
 // - This prevents lifetime accumulation and allows recovery
 void esp_task_wdt_isr_user_handler(void) {
     s_bark_count++;
+    diag_metric_inc(s_m_barks);
 
     // Take snapshot of volatile variable for ISR post (avoid volatile pointer warning)
     int bark = s_bark_count;
 
     // Post bark event (ISR-safe)
-    esp_event_isr_post(DEVICE_EVENT, DEVICE_EVENT_WDT_BARK, &bark, sizeof(bark), NULL);
+    event_bus_isr_post(DEVICE_EVENT_WDT_BARK, &bark, sizeof(bark), NULL);
 
     // If consecutive bark count exceeds threshold, trigger bite (reboot)
     if (s_bark_count >= BARK_THRESHOLD) {
@@ -203,7 +359,7 @@ void esp_task_wdt_isr_user_handler(void) {
         int bite = s_bark_count;
 
         // Post bite event before reboot
-        esp_event_isr_post(DEVICE_EVENT, DEVICE_EVENT_WDT_BITE, &bite, sizeof(bite), NULL);
+        event_bus_isr_post(DEVICE_EVENT_WDT_BITE, &bite, sizeof(bite), NULL);
 
         // Note: We cannot use ESP_LOGE here (ISR context), so the bite event
         // handler should log the reboot reason
@@ -48,7 +48,7 @@ void app_main(void)
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
 
-    // Run generic startup (Phases 1-3)
+    // Run generic startup (stage graph, see app_startup.h)
     // This initializes: config_store (NVS), event_bus, config_mgr, wdt_mgr,
     // net_mgr, provisioning, sntp_client, http_ui, ota_mgr, udp_broadcast
     app_startup_run_generic();